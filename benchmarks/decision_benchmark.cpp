@@ -0,0 +1,90 @@
+// Per-decision cost of the ModeDecisionEngine.
+//
+// Usage: decision_benchmark [iterations]
+//
+// The engine is fed a repeating mix of load levels and fault inputs, both
+// through decide() on extracted inputs and through makeDecision() on full
+// SystemMetrics. The figure reported is the mean wall time per decision.
+// The budget is 1us per decision.
+
+#include <chronovyan/log_sink.hpp>
+#include <chronovyan/mode_decision_engine.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace chronovyan;
+
+namespace {
+
+constexpr double kBudgetMicros = 1.0;
+constexpr int kMix = 8;
+
+DecisionInputs mix(int i) {
+    static const double kLoads[kMix] = {20.0, 50.0, 92.0, 35.0, 70.0, 88.0, 10.0, 60.0};
+    DecisionInputs inputs;
+    inputs.cpu = kLoads[i];
+    inputs.memory = kLoads[(i + 3) % kMix];
+    inputs.gpu = kLoads[(i + 5) % kMix];
+    inputs.available = DecisionInputs::kAll;
+    if (i == 4) {
+        inputs.has_exception = true;
+        inputs.has_timeout = true;
+        inputs.failed_source = MetricRegistry::kGpu;
+    } else if (i == 6) {
+        inputs.available = DecisionInputs::kCpu | DecisionInputs::kMemory;  // gpu dropped out
+    }
+    return inputs;
+}
+
+template <typename Decide>
+bool run(const char* name, long iterations, Decide decide) {
+    for (long i = 0; i < 1000; ++i) {
+        decide(i);
+    }
+    long held = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        held += decide(i).code == DecisionReason::Hysteresis;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double micros = std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+    bool within = micros < kBudgetMicros;
+    std::printf("%-14s %8.1fns/decision  held=%ld  %s\n", name, micros * 1000.0, held,
+                within ? "ok" : "OVER BUDGET");
+    return within;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (iterations <= 0) {
+        iterations = 1000000;
+    }
+    LogSink::instance().set_level(LogLevel::Warn);
+
+    DecisionInputs inputs[kMix];
+    SystemMetrics metrics[kMix];
+    for (int i = 0; i < kMix; ++i) {
+        inputs[i] = mix(i);
+        metrics[i].cpu_usage = inputs[i].cpu;
+        metrics[i].memory_usage = inputs[i].memory;
+        metrics[i].gpu_usage = inputs[i].gpu;
+        metrics[i].metrics[MetricRegistry::kCpu].value = inputs[i].cpu;
+        metrics[i].metrics[MetricRegistry::kMemory].value = inputs[i].memory;
+        metrics[i].metrics[MetricRegistry::kGpu].value = inputs[i].gpu;
+        metrics[i].metrics[MetricRegistry::kGpu].is_available =
+            (inputs[i].available & DecisionInputs::kGpu) != 0;
+        metrics[i].has_exception = inputs[i].has_exception;
+        metrics[i].has_timeout = inputs[i].has_timeout;
+        metrics[i].exception_metric = inputs[i].failed_source;
+    }
+
+    ModeDecisionEngine engine;
+    bool within = run("decide", iterations,
+                      [&](long i) { return engine.decide(inputs[i % kMix]); });
+    within = run("makeDecision", iterations,
+                 [&](long i) { return engine.makeDecision(metrics[i % kMix]); }) && within;
+    return within ? 0 : 1;
+}
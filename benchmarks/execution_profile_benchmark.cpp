@@ -0,0 +1,176 @@
+// Interpreter throughput, retained memory and synchronizer tick cost under
+// each execution profile.
+//
+// Usage: execution_profile_benchmark [rounds] [sync_seconds]
+//
+// For each mode a fresh interpreter and synchronizer are bound to an
+// ExecutionProfileSwitch set to that mode. The interpreter runs `rounds`
+// rounds of a fixed workload: an assignment to each of 32 ECHO variables,
+// a CONF/REB binary operation and a read of a 64-outcome WEAVER variable.
+// Reported are operations per second and the heap bytes still held when
+// the workload ends. The synchronizer is then polled every millisecond
+// through synchronize_if_due() for `sync_seconds`; reported are the ticks
+// run and the CPU time they took.
+
+#include <chronovyan/execution_profile.hpp>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include "interpreter.h"
+#include <malloc.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+
+namespace {
+
+std::atomic<long long> g_live_bytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    g_live_bytes.fetch_add(static_cast<long long>(malloc_usable_size(p)), std::memory_order_relaxed);
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    if (p) {
+        g_live_bytes.fetch_sub(static_cast<long long>(malloc_usable_size(p)), std::memory_order_relaxed);
+        std::free(p);
+    }
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+namespace {
+
+constexpr int kEchoVariables = 32;
+constexpr int kWeaverOutcomes = 64;
+constexpr int kOpsPerRound = kEchoVariables + 2;
+
+struct Workload {
+    std::vector<std::unique_ptr<ExprNode>> echo_assignments;
+    std::unique_ptr<ExprNode> mixed;
+    std::unique_ptr<ExprNode> weaver_read;
+};
+
+void declare(Interpreter& interpreter, const std::string& name, VariableModifier modifier,
+             std::vector<VariableFlag> flags) {
+    VariableDeclStmtNode stmt(name, nullptr, modifier, std::move(flags),
+                              std::make_unique<LiteralExprNode>(int64_t(0)));
+    interpreter.execute(stmt);
+}
+
+Workload prepare(Interpreter& interpreter) {
+    Workload workload;
+    for (int v = 0; v < kEchoVariables; ++v) {
+        std::string name = "echo" + std::to_string(v);
+        declare(interpreter, name, VariableModifier::CONF, {VariableFlag::ECHO});
+        workload.echo_assignments.push_back(std::make_unique<AssignExprNode>(
+            name, std::make_unique<LiteralExprNode>(int64_t(v))));
+    }
+    declare(interpreter, "conf", VariableModifier::CONF, {});
+    declare(interpreter, "reb", VariableModifier::REB, {});
+    workload.mixed = std::make_unique<BinaryExprNode>(std::make_unique<VariableExprNode>("conf"),
+                                                      Token(TokenType::PLUS, "+", SourceLocation()),
+                                                      std::make_unique<VariableExprNode>("reb"));
+
+    Value weaver(int64_t(0));
+    weaver.addFlag(VariableFlag::WEAVER);
+    std::map<Value, double> distribution;
+    double total = kWeaverOutcomes * (kWeaverOutcomes + 1) / 2.0;
+    for (int64_t i = 1; i <= kWeaverOutcomes; ++i) {
+        distribution[Value(i)] = static_cast<double>(i) / total;
+    }
+    weaver.setProbabilisticValue(distribution);
+    interpreter.getGlobalEnvironment()->define("weaver", weaver);
+    workload.weaver_read = std::make_unique<VariableExprNode>("weaver");
+    return workload;
+}
+
+const char* name_of(PerformanceMode mode) {
+    switch (mode) {
+    case PerformanceMode::HighFidelity:
+        return "HighFidelity";
+    case PerformanceMode::Balanced:
+        return "Balanced";
+    case PerformanceMode::Lean:
+        return "Lean";
+    }
+    return "?";
+}
+
+void run(PerformanceMode mode, long rounds, double sync_seconds) {
+    long long baseline = g_live_bytes.load();
+    double ops_per_second = 0.0;
+    long long retained = 0;
+    {
+        auto interpreter = std::make_unique<Interpreter>();
+        ExecutionProfileSwitch profiles(mode);
+        profiles.add_target([&](const ExecutionProfile& p) { interpreter->setExecutionProfile(p); });
+
+        Workload workload = prepare(*interpreter);
+        auto start = std::chrono::steady_clock::now();
+        int64_t sink = 0;
+        for (long r = 0; r < rounds; ++r) {
+            for (const auto& assignment : workload.echo_assignments) {
+                interpreter->evaluate(*assignment);
+            }
+            sink += interpreter->evaluate(*workload.mixed).asInteger();
+            sink += interpreter->evaluate(*workload.weaver_read).asInteger();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ops_per_second = rounds * kOpsPerRound / seconds;
+        retained = g_live_bytes.load() - baseline;
+        if (sink == -1) {
+            std::printf("unreachable\n");
+        }
+    }
+
+    sync::TemporalSynchronizer synchronizer;
+    synchronizer.apply_profile(profile_for(mode));
+    long ticks = 0;
+    std::clock_t cpu_start = std::clock();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(sync_seconds);
+    while (std::chrono::steady_clock::now() < deadline) {
+        ticks += synchronizer.synchronize_if_due();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double cpu_ms = 1000.0 * (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    std::printf("%-13s %10.0f ops/s  %9.1f KiB retained  %5ld ticks  %7.1f ms cpu\n",
+                name_of(mode), ops_per_second, retained / 1024.0, ticks, cpu_ms);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long rounds = argc > 1 ? std::atol(argv[1]) : 20000;
+    if (rounds <= 0) {
+        rounds = 20000;
+    }
+    double sync_seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    if (sync_seconds <= 0.0) {
+        sync_seconds = 2.0;
+    }
+
+    for (PerformanceMode mode : {PerformanceMode::HighFidelity, PerformanceMode::Balanced,
+                                 PerformanceMode::Lean}) {
+        run(mode, rounds, sync_seconds);
+    }
+    return 0;
+}
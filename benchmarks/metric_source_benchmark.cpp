@@ -0,0 +1,60 @@
+// Sampling cost of the Linux procfs/cgroup metric sources.
+//
+// Usage: metric_source_benchmark [iterations]
+//
+// Each source is sampled back to back through IMetricSource::getValue();
+// the figure reported is the mean wall time per sample, including the
+// pread system call. The budget is 10us per source.
+
+#include <chronovyan/procfs_metric_sources.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+using namespace chronovyan;
+
+namespace {
+
+constexpr double kBudgetMicros = 10.0;
+
+bool run(const std::string& name, const IMetricSource& source, long iterations) {
+    if (!source.isAvailable()) {
+        std::printf("%-12s unavailable\n", name.c_str());
+        return true;
+    }
+    for (long i = 0; i < 100; ++i) {
+        source.getValue();
+    }
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        sink += source.getValue();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double micros = std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+    bool within = micros < kBudgetMicros;
+    std::printf("%-12s %8.2fus/sample  mean=%6.2f  %s\n", name.c_str(), micros,
+                sink / iterations, within ? "ok" : "OVER BUDGET");
+    return within;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 20000;
+    if (iterations <= 0) {
+        iterations = 20000;
+    }
+
+    bool within = true;
+    for (const char* type : {"cpu", "memory", "process_cpu", "process_rss"}) {
+        within = run(type, *create_metric_source(type), iterations) && within;
+    }
+
+    CpuUsageSource cpu;
+    cpu.getValue();
+    std::printf("cpu cores: %zu\n", cpu.core_count());
+    return within ? 0 : 1;
+}
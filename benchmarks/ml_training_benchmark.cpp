@@ -0,0 +1,144 @@
+// Training and scoring throughput of MLModel, in samples per second.
+//
+// Usage: ml_training_benchmark [features] [passes]
+//
+// A synthetic, linearly separable dataset of 8192 rows is trained on with
+// the per-sample update() path and with train_batch() under both
+// optimizers and two batch sizes, then scored with per-row predict() and
+// with predict_batch() over 4096-row blocks. Each figure is the number of
+// rows processed over `passes` passes divided by the wall time.
+
+#include <chronovyan/ml_model.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+constexpr size_t kRows = 8192;
+constexpr size_t kScoreBlock = 4096;
+
+struct Dataset {
+    size_t features;
+    std::vector<double> x;  // row-major
+    std::vector<double> y;
+};
+
+Dataset make_dataset(size_t features) {
+    std::mt19937 gen(17);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<double> truth(features);
+    for (double& w : truth) {
+        w = dist(gen);
+    }
+    Dataset data{features, {}, {}};
+    data.x.reserve(kRows * features);
+    for (size_t r = 0; r < kRows; ++r) {
+        double z = 0.0;
+        for (size_t i = 0; i < features; ++i) {
+            double v = dist(gen);
+            data.x.push_back(v);
+            z += truth[i] * v;
+        }
+        data.y.push_back(z > 0.0 ? 1.0 : 0.0);
+    }
+    return data;
+}
+
+MLModel make_model(size_t features, GradientOptimizer optimizer) {
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < features; ++i) {
+        columns.push_back("f" + std::to_string(i));
+    }
+    MLModel model("logistic", columns, 0.01, 42);
+    MLHyperparameters params = model.get_hyperparameters();
+    params.optimizer = optimizer;
+    model.set_hyperparameters(params);
+    return model;
+}
+
+template <typename Pass>
+void report(const char* name, int passes, Pass pass) {
+    pass();  // warm-up
+    auto start = std::chrono::steady_clock::now();
+    double sink = 0.0;
+    for (int p = 0; p < passes; ++p) {
+        sink += pass();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-28s %12.0f samples/s  (checksum %.3g)\n", name, passes * kRows / seconds, sink);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long features_arg = argc > 1 ? std::atol(argv[1]) : 16;
+    size_t features = features_arg > 0 ? static_cast<size_t>(features_arg) : 16;
+    int passes = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (passes <= 0) {
+        passes = 20;
+    }
+    Dataset data = make_dataset(features);
+    std::printf("%zu rows x %zu features, %d passes\n", kRows, features, passes);
+
+    {
+        MLModel model = make_model(features, GradientOptimizer::MomentumSGD);
+        std::vector<double> row(features);
+        report("update (per sample)", passes, [&] {
+            for (size_t r = 0; r < kRows; ++r) {
+                std::copy_n(data.x.begin() + r * features, features, row.begin());
+                model.update(row);
+            }
+            return model.predict(row);
+        });
+    }
+
+    struct Config {
+        const char* name;
+        GradientOptimizer optimizer;
+        size_t batch;
+    };
+    const Config configs[] = {
+        {"train_batch sgd  batch=64", GradientOptimizer::MomentumSGD, 64},
+        {"train_batch adam batch=64", GradientOptimizer::Adam, 64},
+        {"train_batch adam batch=512", GradientOptimizer::Adam, 512},
+    };
+    for (const Config& config : configs) {
+        MLModel model = make_model(features, config.optimizer);
+        report(config.name, passes, [&] {
+            double loss = 0.0;
+            for (size_t start = 0; start < kRows; start += config.batch) {
+                loss = model.train_batch(data.x.data() + start * features, data.y.data() + start,
+                                         std::min(config.batch, kRows - start));
+            }
+            return loss;
+        });
+    }
+
+    MLModel model = make_model(features, GradientOptimizer::Adam);
+    std::vector<double> row(features);
+    report("predict (per row)", passes, [&] {
+        double sum = 0.0;
+        for (size_t r = 0; r < kRows; ++r) {
+            std::copy_n(data.x.begin() + r * features, features, row.begin());
+            sum += model.predict(row);
+        }
+        return sum;
+    });
+    std::vector<double> scores(kScoreBlock);
+    report("predict_batch (4096 rows)", passes, [&] {
+        double sum = 0.0;
+        for (size_t start = 0; start < kRows; start += kScoreBlock) {
+            model.predict_batch(data.x.data() + start * features, kScoreBlock, scores.data());
+            sum += scores[0];
+        }
+        return sum;
+    });
+    return 0;
+}
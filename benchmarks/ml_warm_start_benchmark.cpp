@@ -0,0 +1,173 @@
+// Cold start versus warm start of MLModel from a saved model file.
+//
+// Usage: ml_warm_start_benchmark [features] [target_loss]
+//
+// A cold model (random initialization) is trained with train_batch() on a
+// stream of 64-row batches from a fixed hyperplane until the mean loss of
+// the last 10 batches falls below `target_loss`; the batches and time this
+// took are reported. The model is saved, and a warm model loaded from the
+// file is trained on a fresh stream from the same distribution, reporting
+// the same figures. Also reported: the cost of mapping and of fully loading
+// the file, and train_batch throughput with and without a ModelCheckpointer
+// being offered the model after every batch.
+
+#include <chronovyan/ml_model_store.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+constexpr size_t kBatch = 64;
+constexpr size_t kMaxBatches = 200000;
+
+class Stream {
+public:
+    Stream(size_t features, unsigned seed) : features_(features), gen_(seed), truth_(features) {
+        std::mt19937 truth_gen(99);
+        std::normal_distribution<double> dist(0.0, 1.0);
+        for (double& w : truth_) {
+            w = dist(truth_gen);
+        }
+    }
+
+    void next(std::vector<double>& x, std::vector<double>& y) {
+        std::normal_distribution<double> dist(0.0, 1.0);
+        x.resize(kBatch * features_);
+        y.resize(kBatch);
+        for (size_t r = 0; r < kBatch; ++r) {
+            double z = 0.0;
+            for (size_t i = 0; i < features_; ++i) {
+                double v = dist(gen_);
+                x[r * features_ + i] = v;
+                z += truth_[i] * v;
+            }
+            y[r] = z > 0.0 ? 1.0 : 0.0;
+        }
+    }
+
+private:
+    size_t features_;
+    std::mt19937 gen_;
+    std::vector<double> truth_;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Batches until the trailing 10-batch mean loss is below target
+void converge(const char* name, MLModel& model, Stream& stream, double target) {
+    std::vector<double> x, y;
+    std::deque<double> recent;
+    size_t batches = 0;
+    double first_loss = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    while (batches < kMaxBatches) {
+        stream.next(x, y);
+        double loss = model.train_batch(x, y);
+        if (batches++ == 0) {
+            first_loss = loss;
+        }
+        recent.push_back(loss);
+        if (recent.size() > 10) {
+            recent.pop_front();
+        }
+        if (recent.size() == 10 && std::accumulate(recent.begin(), recent.end(), 0.0) / 10.0 < target) {
+            break;
+        }
+    }
+    std::printf("%-12s first loss %.3f  %7zu batches  %9.2f ms to loss < %.2f\n", name, first_loss,
+                batches, 1000.0 * seconds_since(start), target);
+}
+
+MLModel make_model(size_t features) {
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < features; ++i) {
+        columns.push_back("f" + std::to_string(i));
+    }
+    MLModel model("logistic", columns, 0.01, 42);
+    MLHyperparameters params = model.get_hyperparameters();
+    params.learning_rate = 0.05;
+    params.regularization = 1e-4;
+    model.set_hyperparameters(params);
+    return model;
+}
+
+double train_throughput(MLModel& model, Stream& stream, ModelCheckpointer* checkpointer) {
+    std::vector<double> x, y;
+    stream.next(x, y);
+    const int batches = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < batches; ++b) {
+        model.train_batch(x, y);
+        if (checkpointer) {
+            checkpointer->offer(model);
+        }
+    }
+    return batches * kBatch / seconds_since(start);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long features_arg = argc > 1 ? std::atol(argv[1]) : 32;
+    size_t features = features_arg > 0 ? static_cast<size_t>(features_arg) : 32;
+    double target = argc > 2 ? std::atof(argv[2]) : 0.15;
+    if (target <= 0.0) {
+        target = 0.15;
+    }
+    std::string path = "/tmp/chronovyan_warm_start_" + std::to_string(::getpid()) + ".bin";
+    std::printf("%zu features, %zu-row batches\n", features, kBatch);
+
+    MLModel cold = make_model(features);
+    Stream first(features, 1);
+    converge("cold start", cold, first, target);
+    cold.save(path);
+
+    const int loads = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) {
+        MappedModel mapped(path);
+        if (mapped.feature_count() != features) {
+            return 1;
+        }
+    }
+    double map_us = 1e6 * seconds_since(start) / loads;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loads; ++i) {
+        MLModel loaded = MLModel::load(path);
+        if (loaded.feature_count() != features) {
+            return 1;
+        }
+    }
+    double load_us = 1e6 * seconds_since(start) / loads;
+    std::printf("map %.1f us, load %.1f us\n", map_us, load_us);
+
+    MLModel warm = MLModel::load(path);
+    Stream second(features, 2);
+    converge("warm start", warm, second, target);
+
+    Stream third(features, 3);
+    double plain = train_throughput(warm, third, nullptr);
+    double checkpointed = 0.0;
+    size_t written = 0;
+    {
+        ModelCheckpointer checkpointer(path, std::chrono::milliseconds(5));
+        checkpointed = train_throughput(warm, third, &checkpointer);
+        checkpointer.flush();
+        written = checkpointer.written();
+    }
+    std::printf("train_batch %.0f samples/s, with 5 ms checkpoints %.0f samples/s (%zu written)\n",
+                plain, checkpointed, written);
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Mode switching under recorded and synthetic load traces.
+//
+// Usage: mode_replay [trace.csv ...]
+//
+// Each trace is replayed through a ModeDecisionEngine twice: once with the
+// default single-sample load decisions and once with smoothing enabled.
+// Reported per run: the number of mode switches and the share of time
+// spent in each mode.
+//
+// Besides the built-in synthetic traces, any CSV file with
+// "time_ms,cpu,memory,gpu" lines can be passed in.
+
+#include <chronovyan/mode_decision_engine.hpp>
+#include <chronovyan/mode_smoother.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Trace {
+    std::string name;
+    std::vector<ReplaySample> samples;
+};
+
+// Moderate load with short bursts past the high-load threshold
+Trace bursty_trace() {
+    Trace trace{"bursty(50%+95% bursts)", {}};
+    std::mt19937 rng(11);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    std::bernoulli_distribution burst(0.04);
+    int remaining = 0;
+    for (auto t = 0ms; t < 600s; t += 100ms) {
+        if (remaining == 0 && burst(rng)) {
+            remaining = 3;
+        }
+        double cpu = (remaining > 0 ? 95.0 : 50.0) + noise(rng);
+        remaining = remaining > 0 ? remaining - 1 : 0;
+        trace.samples.push_back({t, cpu, 45.0 + noise(rng), 30.0 + noise(rng)});
+    }
+    return trace;
+}
+
+// Load hovering around the low-load threshold
+Trace hovering_trace() {
+    Trace trace{"hovering(40%+-6)", {}};
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 6.0);
+    for (auto t = 0ms; t < 600s; t += 100ms) {
+        trace.samples.push_back({t, 40.0 + noise(rng), 30.0, 20.0});
+    }
+    return trace;
+}
+
+// Slow daily-shaped swing between idle and saturated, compressed to 10 minutes
+Trace swing_trace() {
+    Trace trace{"swing(20%..95%)", {}};
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0.0, 4.0);
+    const double pi = std::acos(-1.0);
+    for (auto t = 0ms; t < 600s; t += 100ms) {
+        double phase = 2.0 * pi * t.count() / 300000.0;
+        trace.samples.push_back({t, 57.5 - 37.5 * std::cos(phase) + noise(rng), 40.0, 35.0});
+    }
+    return trace;
+}
+
+void report(const char* label, const ReplayReport& result) {
+    std::printf("  %-9s switches=%-5zu high_fidelity=%5.1f%%  balanced=%5.1f%%  lean=%5.1f%%\n", label,
+                result.switches, 100.0 * result.fraction(PerformanceMode::HighFidelity),
+                100.0 * result.fraction(PerformanceMode::Balanced),
+                100.0 * result.fraction(PerformanceMode::Lean));
+}
+
+void run(const Trace& trace) {
+    if (trace.samples.empty()) {
+        std::printf("%s: empty\n", trace.name.c_str());
+        return;
+    }
+    std::printf("%s: %zu samples over %.0fs\n", trace.name.c_str(), trace.samples.size(),
+                std::chrono::duration<double>(trace.samples.back().time).count());
+
+    ModeDecisionEngine raw;
+    report("raw", replay_trace(raw, trace.samples));
+
+    ModeDecisionEngine smoothed;
+    smoothed.enable_smoothing();
+    report("smoothed", replay_trace(smoothed, trace.samples));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<Trace> traces = {bursty_trace(), hovering_trace(), swing_trace()};
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i]);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        traces.push_back({argv[i], read_replay_trace(file)});
+    }
+    for (const Trace& trace : traces) {
+        run(trace);
+    }
+    return 0;
+}
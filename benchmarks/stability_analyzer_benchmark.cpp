@@ -0,0 +1,160 @@
+// Event ingestion rate and analyze_stability() latency of StabilityAnalyzer.
+//
+// Usage: stability_analyzer_benchmark [events_per_producer]
+//
+// Ingestion: 1 to 16 producer threads call add_event() while one consumer
+// thread calls process() in a loop; reported are add_event() calls and
+// accepted events per second across all producers, and the number dropped
+// because the queue was full while the consumer held it.
+// Latency: for windows of 256, 4K and 64K samples, analyze_stability() is
+// timed with the windows full and 64 new events queued before each call.
+// A rescan baseline, which keeps the window in a deque under a mutex and
+// recomputes mean and variance from scratch on each call, is timed
+// alongside.
+
+#include <chronovyan/stability_analyzer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::stability;
+
+namespace {
+
+class RescanBaseline {
+public:
+    explicit RescanBaseline(size_t window) : window_(window), samples_(5) {}
+
+    void add_event(const StabilityEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& samples = samples_[static_cast<size_t>(event.type)];
+        samples.push_back(event.value);
+        if (samples.size() > window_) {
+            samples.pop_front();
+        }
+    }
+
+    StabilityMetrics analyze_stability() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        StabilityMetrics metrics;
+        metrics.temporal_stability = score(samples_[0]);
+        metrics.resource_stability = score(samples_[1]);
+        metrics.performance_stability = score(samples_[2]);
+        metrics.error_stability = score(samples_[3]);
+        metrics.overall_stability = (metrics.temporal_stability + metrics.resource_stability +
+                                     metrics.performance_stability + metrics.error_stability) / 4.0;
+        return metrics;
+    }
+
+private:
+    static double score(const std::deque<double>& samples) {
+        if (samples.empty()) {
+            return 1.0;
+        }
+        double mean = 0.0;
+        for (double x : samples) {
+            mean += x;
+        }
+        mean /= samples.size();
+        double variance = 0.0;
+        for (double x : samples) {
+            variance += (x - mean) * (x - mean);
+        }
+        variance /= samples.size();
+        return mean == 0.0 ? 0.0 : 1.0 / (1.0 + std::sqrt(variance) / std::fabs(mean));
+    }
+
+    size_t window_;
+    mutable std::mutex mutex_;
+    std::vector<std::deque<double>> samples_;
+};
+
+StabilityEvent make_event(std::mt19937& gen, size_t i) {
+    std::normal_distribution<double> noise(0.0, 0.1);
+    return StabilityEvent(std::chrono::system_clock::now(), static_cast<StabilityMetricType>(i % 4),
+                          1.0 + noise(gen), "jitter sample");
+}
+
+template <typename Analyzer>
+double analyze_latency_ns(Analyzer& analyzer, size_t window) {
+    std::mt19937 gen(7);
+    for (size_t i = 0; i < 4 * window; ++i) {
+        analyzer.add_event(make_event(gen, i));
+    }
+    const int calls = 2000;
+    std::vector<StabilityEvent> batch;
+    for (size_t i = 0; i < 64; ++i) {
+        batch.push_back(make_event(gen, i));
+    }
+    double total = 0.0;
+    volatile double sink = 0.0;
+    for (int c = 0; c < calls; ++c) {
+        for (const auto& event : batch) {
+            analyzer.add_event(event);
+        }
+        auto start = std::chrono::steady_clock::now();
+        sink = sink + analyzer.analyze_stability().overall_stability;
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    return total / calls;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t per_producer = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500000;
+
+    std::printf("ingestion (one consumer calling process())\n");
+    std::printf("%9s %14s %14s %12s\n", "producers", "M calls/s", "M accepted/s", "dropped");
+    for (int producers : {1, 2, 4, 8, 16}) {
+        StabilityAnalyzer analyzer(1024, 1 << 14);
+        std::atomic<bool> done{false};
+        std::thread consumer([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                if (analyzer.process() == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                std::mt19937 gen(p);
+                StabilityEvent event = make_event(gen, p);
+                for (size_t i = 0; i < per_producer; ++i) {
+                    event.type = static_cast<StabilityMetricType>(i % 4);
+                    analyzer.add_event(event);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        done = true;
+        consumer.join();
+        const double calls = static_cast<double>(producers * per_producer);
+        const double dropped = static_cast<double>(analyzer.dropped());
+        std::printf("%9d %14.2f %14.2f %12.0f\n", producers, calls / seconds / 1e6,
+                    (calls - dropped) / seconds / 1e6, dropped);
+    }
+
+    std::printf("\nanalyze_stability() latency with 64 queued events per call\n");
+    std::printf("%8s %16s %16s\n", "window", "streaming ns", "rescan ns");
+    for (size_t window : {256, 4096, 65536}) {
+        StabilityAnalyzer analyzer(window, 1 << 16);
+        RescanBaseline baseline(window);
+        std::printf("%8zu %16.0f %16.0f\n", window, analyze_latency_ns(analyzer, window),
+                    analyze_latency_ns(baseline, window));
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Lexer throughput over a synthetic script, and interpreter throughput over
+// a prebuilt expression tree.
+
+#include <benchmark/benchmark.h>
+#include "interpreter.h"
+#include "lexer.h"
+#include "source_file.h"
+#include <memory>
+#include <string>
+
+using namespace chronovyan;
+
+namespace {
+
+const char kSnippet[] =
+    "DECLARE CONF::STATIC rate : FLOAT = 1.25;\n"
+    "DECLARE REB::ECHO counter : INT = 0;\n"
+    "FOR_CHRONON (i = 0; i < 100; i++) {\n"
+    "    counter = counter + rate * 2; // accumulate\n"
+    "    IF (counter >= 42) { print(\"threshold reached\"); }\n"
+    "}\n";
+
+std::string script(size_t bytes) {
+    std::string source;
+    while (source.size() < bytes) {
+        source += kSnippet;
+    }
+    return source;
+}
+
+// A left-leaning chain of `nodes` additions over literals
+std::unique_ptr<ExprNode> addition_chain(int nodes) {
+    std::unique_ptr<ExprNode> expr = std::make_unique<LiteralExprNode>(int64_t{1});
+    for (int i = 1; i < nodes; i += 2) {
+        expr = std::make_unique<BinaryExprNode>(std::move(expr), Token(TokenType::PLUS, "+", SourceLocation()),
+                                                std::make_unique<LiteralExprNode>(int64_t{i}));
+    }
+    return expr;
+}
+
+} // namespace
+
+// Bytes lexed per second, whole script tokenized per iteration
+static void BM_LexerTokenize(benchmark::State& state) {
+    auto source = std::make_shared<SourceFile>(script(static_cast<size_t>(state.range(0))), "<bench>");
+    size_t tokens = 0;
+    for (auto _ : state) {
+        Lexer lexer(source);
+        auto all = lexer.tokenizeAll();
+        tokens = all.size();
+        benchmark::DoNotOptimize(all.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source->getSource().size()));
+    state.counters["tokens"] = static_cast<double>(tokens);
+}
+BENCHMARK(BM_LexerTokenize)->Arg(4 << 10)->Arg(256 << 10);
+
+// AST nodes evaluated per second. Parser::parse() is still a stub that
+// returns an empty program, so the tree is built directly.
+static void BM_InterpretExpressionTree(benchmark::State& state) {
+    const int nodes = static_cast<int>(state.range(0));
+    auto expr = addition_chain(nodes);
+    Interpreter interpreter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.evaluate(*expr));
+    }
+    state.SetItemsProcessed(state.iterations() * nodes);
+}
+BENCHMARK(BM_InterpretExpressionTree)->Arg(15)->Arg(255);
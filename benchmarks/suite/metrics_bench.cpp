@@ -0,0 +1,72 @@
+// Metric collection and mode decisions.
+
+#include <benchmark/benchmark.h>
+#include <chronovyan/metric_collector.hpp>
+#include <chronovyan/mode_decision_engine.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace chronovyan;
+
+namespace {
+
+class ConstantSource : public IMetricSource {
+public:
+    explicit ConstantSource(double value) : value_(value) {}
+    double getValue() const override { return value_; }
+    bool isAvailable() const override { return true; }
+    std::chrono::system_clock::time_point getLastUpdateTime() const override {
+        return std::chrono::system_clock::now();
+    }
+
+private:
+    double value_;
+};
+
+} // namespace
+
+// Sources polled on the calling thread
+static void BM_CollectMetricsPolled(benchmark::State& state) {
+    ConstantSource cpu(40.0), memory(55.0), gpu(20.0);
+    MetricCollector collector(&cpu, &memory, &gpu);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collector.collect_metrics());
+    }
+}
+BENCHMARK(BM_CollectMetricsPolled);
+
+// Background sampling: collect_metrics() only reads the published snapshot
+static void BM_CollectMetricsSampled(benchmark::State& state) {
+    ConstantSource cpu(40.0), memory(55.0), gpu(20.0);
+    MetricCollector collector;
+    collector.addSource("cpu", &cpu);
+    collector.addSource("memory", &memory);
+    collector.addSource("gpu", &gpu);
+    collector.startSampling();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collector.collect_metrics());
+    }
+    collector.stopSampling();
+}
+BENCHMARK(BM_CollectMetricsSampled);
+
+static void BM_MakeDecision(benchmark::State& state) {
+    static const double kLoads[] = {20.0, 50.0, 92.0, 35.0, 70.0, 88.0, 10.0, 60.0};
+    SystemMetrics samples[8];
+    for (int i = 0; i < 8; ++i) {
+        const auto now = std::chrono::system_clock::now();
+        samples[i].metrics[MetricRegistry::kCpu] = MetricData{kLoads[i], now, true};
+        samples[i].metrics[MetricRegistry::kMemory] = MetricData{kLoads[(i + 3) % 8], now, true};
+        samples[i].metrics[MetricRegistry::kGpu] = MetricData{kLoads[(i + 5) % 8], now, true};
+        samples[i].cpu_usage = kLoads[i];
+        samples[i].memory_usage = kLoads[(i + 3) % 8];
+        samples[i].gpu_usage = kLoads[(i + 5) % 8];
+    }
+    ModeDecisionEngine engine;
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.makeDecision(samples[i++ & 7]));
+    }
+}
+BENCHMARK(BM_MakeDecision);
@@ -0,0 +1,75 @@
+// MLModel online updates and predictions.
+
+#include <benchmark/benchmark.h>
+#include <chronovyan/ml_model.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+std::vector<std::vector<double>> rows(size_t features, size_t count) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> out(count, std::vector<double>(features));
+    for (auto& row : out) {
+        for (double& x : row) {
+            x = value(gen);
+        }
+    }
+    return out;
+}
+
+MLModel make_model(const std::string& type, size_t features) {
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < features; ++i) {
+        columns.push_back("f" + std::to_string(i));
+    }
+    return MLModel(type, columns, 0.01, 42);
+}
+
+} // namespace
+
+static void BM_MLModelUpdate(benchmark::State& state) {
+    const size_t features = static_cast<size_t>(state.range(0));
+    MLModel model = make_model("logistic", features);
+    auto data = rows(features, 256);
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& row = data[i++ & 255];
+        model.update(row, row[0] > 0.5 ? 1.0 : 0.0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MLModelUpdate)->Arg(8)->Arg(64);
+
+static void BM_MLModelPredict(benchmark::State& state) {
+    const size_t features = static_cast<size_t>(state.range(0));
+    MLModel model = make_model("logistic", features);
+    auto data = rows(features, 256);
+    for (const auto& row : data) {
+        model.update(row, row[0] > 0.5 ? 1.0 : 0.0);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.predict(data[i++ & 255]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MLModelPredict)->Arg(8)->Arg(64);
+
+static void BM_GradientBoostPredict(benchmark::State& state) {
+    MLModel model = make_model("gradient_boost", 8);
+    auto data = rows(8, 1024);
+    for (const auto& row : data) {
+        model.update(row, row[0] + row[1] > 1.0 ? 1.0 : 0.0);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.predict(data[i++ & 1023]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GradientBoostPredict);
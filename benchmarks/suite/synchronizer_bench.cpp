@@ -0,0 +1,15 @@
+// TemporalSynchronizer ticks.
+
+#include <benchmark/benchmark.h>
+#include <chronovyan/temporal_synchronizer.hpp>
+
+using namespace chronovyan::sync;
+
+static void BM_SynchronizeTemporalFlows(benchmark::State& state) {
+    TemporalSynchronizer synchronizer;
+    for (auto _ : state) {
+        synchronizer.synchronize_temporal_flows();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SynchronizeTemporalFlows);
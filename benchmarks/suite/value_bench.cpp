@@ -0,0 +1,70 @@
+// Value arithmetic and copies, and Environment lookups through nested scopes.
+
+#include <benchmark/benchmark.h>
+#include "environment.h"
+#include "value.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace chronovyan;
+
+static void BM_ValueAddInteger(benchmark::State& state) {
+    Value a(int64_t{40});
+    Value b(int64_t{2});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(add(a, b));
+    }
+}
+BENCHMARK(BM_ValueAddInteger);
+
+static void BM_ValueMultiplyMixed(benchmark::State& state) {
+    Value a(int64_t{3});
+    Value b(1.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(multiply(a, b));
+    }
+}
+BENCHMARK(BM_ValueMultiplyMixed);
+
+static void BM_ValueAddString(benchmark::State& state) {
+    Value a(std::string("temporal "));
+    Value b(std::string("flow"));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(add(a, b));
+    }
+}
+BENCHMARK(BM_ValueAddString);
+
+// Copying a value that carries flags and an ECHO history of range(0) entries
+static void BM_ValueCopy(benchmark::State& state) {
+    Value value(int64_t{7});
+    value.setModifier(VariableModifier::REB);
+    value.addFlag(VariableFlag::ECHO);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        value.echoAssign(Value(i), static_cast<size_t>(state.range(0)));
+    }
+    for (auto _ : state) {
+        Value copy = value;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_ValueCopy)->Arg(0)->Arg(64);
+
+// get() of a variable defined range(0) scopes above the innermost one
+static void BM_EnvironmentLookup(benchmark::State& state) {
+    auto global = std::make_shared<Environment>();
+    for (int i = 0; i < 32; ++i) {
+        global->define("global_" + std::to_string(i), Value(int64_t{i}));
+    }
+    std::shared_ptr<Environment> scope = global;
+    for (int64_t depth = 0; depth < state.range(0); ++depth) {
+        scope = std::make_shared<Environment>(scope);
+        scope->define("local_" + std::to_string(depth), Value(depth));
+    }
+    const std::string name = "global_17";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scope->get(name));
+    }
+}
+BENCHMARK(BM_EnvironmentLookup)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
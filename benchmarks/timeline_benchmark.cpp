@@ -0,0 +1,123 @@
+// Append throughput of Timeline and the TimelineManager event log under
+// concurrent producers.
+//
+// Usage: timeline_benchmark [appends_per_producer]
+//
+// For 1 to 16 producer threads, each thread appends the given number of
+// sync points to one shared Timeline, then the same number of events to a
+// TimelineManager (descriptions drawn from 32 distinct texts). A baseline
+// reproducing the previous design, a std::vector behind a std::mutex that
+// erases from the front once full, is timed alongside. A reader thread
+// polls the 100 most recent records throughout every run.
+
+#include <chronovyan/timeline.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+constexpr size_t kRetained = 4096;
+
+class MutexTimeline {
+public:
+    void add_sync_point(const SyncPoint& point) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        points_.push_back(point);
+        if (points_.size() > kRetained) {
+            points_.erase(points_.begin());
+        }
+    }
+
+    std::vector<SyncPoint> get_recent_sync_points(size_t count) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t start = points_.size() > count ? points_.size() - count : 0;
+        return std::vector<SyncPoint>(points_.begin() + start, points_.end());
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<SyncPoint> points_;
+};
+
+// Millions of appends per second across all producers
+template <typename Append, typename Read>
+double run(int producers, size_t appends, Append append, Read read) {
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            read();
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (size_t k = 0; k < appends; ++k) {
+                append(p, k);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    reader.join();
+    return producers * appends / seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t appends = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+
+    std::vector<std::string> texts;
+    for (int i = 0; i < 32; ++i) {
+        texts.push_back("pattern transition " + std::to_string(i));
+    }
+
+    std::printf("%9s %16s %16s %20s\n", "producers", "timeline Mops/s", "events Mops/s", "mutex+vector Mops/s");
+    for (int producers : {1, 2, 4, 8, 16}) {
+        TimelineRetention retention;
+        retention.max_count = kRetained;
+
+        Timeline timeline(retention);
+        double ring = run(
+            producers, appends,
+            [&](int p, size_t k) {
+                timeline.add_sync_point(SyncPoint(Clock::now(), 0.5, 0.5, 0.5, static_cast<int>(p + k)));
+            },
+            [&] { timeline.get_recent_sync_points(100); });
+
+        TimelineManager manager(retention, retention);
+        double events = run(
+            producers, appends,
+            [&](int p, size_t k) {
+                manager.add_event(TimelineEvent(TimelineEventType::Pattern, Clock::now(), texts[(p + k) % 32],
+                                                static_cast<int>(k)));
+            },
+            [&] { manager.get_recent_events(100); });
+
+        MutexTimeline baseline;
+        double locked = run(
+            producers, appends / 4,
+            [&](int p, size_t k) {
+                baseline.add_sync_point(SyncPoint(Clock::now(), 0.5, 0.5, 0.5, static_cast<int>(p + k)));
+            },
+            [&] { baseline.get_recent_sync_points(100); });
+
+        std::printf("%9d %16.2f %16.2f %20.2f\n", producers, ring, events, locked);
+    }
+    return 0;
+}
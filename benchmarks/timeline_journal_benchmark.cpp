@@ -0,0 +1,125 @@
+// Write throughput and replay speed of TimelineJournal.
+//
+// Usage: timeline_journal_benchmark [directory] [records]
+//
+// Durable appends: 1 to 16 producer threads each append and then wait for
+// their record to reach disk. With one producer every record costs its own
+// fdatasync; with more, records that arrive during a sync share the next
+// one (group commit). Buffered appends: one thread appends every record
+// and flushes once at the end. Replay: the journal is reopened (recovery
+// reads the sealed segments' indices and scans the active one), replayed
+// in full, and replayed from a timestamp near the end, which the sparse
+// index turns into a seek. Results depend heavily on the storage under
+// `directory` (default /tmp).
+
+#include <chronovyan/timeline_journal.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string fresh_directory(const std::string& parent) {
+    std::string pattern = parent + "/chronovyan_journal_bench_XXXXXX";
+    if (!mkdtemp(&pattern[0])) {
+        std::perror("mkdtemp");
+        std::exit(1);
+    }
+    return pattern;
+}
+
+void remove_directory(const std::string& directory) {
+    std::system(("rm -rf " + directory).c_str());
+}
+
+TimelineEvent make_event(size_t i, Clock::time_point base) {
+    return TimelineEvent(TimelineEventType::Pattern, base + std::chrono::milliseconds(i),
+                         "pattern transition " + std::to_string(i % 32), static_cast<int>(i));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string parent = argc > 1 ? argv[1] : "/tmp";
+    const size_t records = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    const Clock::time_point base = Clock::now();
+
+    std::printf("durable appends (append + wait_durable per record)\n");
+    std::printf("%9s %14s\n", "producers", "records/s");
+    for (int producers : {1, 4, 16}) {
+        const std::string directory = fresh_directory(parent);
+        const size_t per_producer = producers == 1 ? 2000 : 8000;
+        {
+            TimelineJournal journal(directory);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    for (size_t k = 0; k < per_producer; ++k) {
+                        journal.wait_durable(journal.append(make_event(p * per_producer + k, base)));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            std::printf("%9d %14.0f\n", producers, producers * per_producer / seconds_since(start));
+        }
+        remove_directory(directory);
+    }
+
+    const std::string directory = fresh_directory(parent);
+    {
+        TimelineJournal journal(directory);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < records; ++i) {
+            journal.append(make_event(i, base));
+        }
+        journal.flush();
+        double elapsed = seconds_since(start);
+        std::printf("\nbuffered appends: %zu records in %.3f s (%.2f M records/s), %zu segments\n", records,
+                    elapsed, records / elapsed / 1e6, journal.segment_count());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TimelineJournal journal(directory);
+    double open_seconds = seconds_since(start);
+    std::printf("\nreopen: %.2f ms (%zu segments, %zu scanned, %llu records)\n", open_seconds * 1e3,
+                journal.recovery().segments, journal.recovery().scanned_segments,
+                static_cast<unsigned long long>(journal.recovery().records));
+
+    size_t text_bytes = 0;
+    start = std::chrono::steady_clock::now();
+    size_t replayed = journal.replay([&](const JournalEntry& entry) {
+        text_bytes += entry.text.size();
+        return true;
+    });
+    double replay_seconds = seconds_since(start);
+    std::printf("full replay: %zu records in %.3f s (%.2f M records/s, %zu bytes of text)\n", replayed,
+                replay_seconds, replayed / replay_seconds / 1e6, text_bytes);
+
+    start = std::chrono::steady_clock::now();
+    size_t tail = journal.replay([](const JournalEntry&) { return true; },
+                                 base + std::chrono::milliseconds(records - records / 100));
+    std::printf("seek to last 1%%: %zu records in %.2f ms\n", tail, seconds_since(start) * 1e3);
+
+    TimelineManager manager;
+    start = std::chrono::steady_clock::now();
+    size_t restored = journal.restore(manager);
+    std::printf("restore into TimelineManager: %zu records in %.3f s\n", restored, seconds_since(start));
+
+    remove_directory(directory);
+    return 0;
+}
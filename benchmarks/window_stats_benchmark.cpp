@@ -0,0 +1,116 @@
+// Per-update cost of RealTimeOptimizer::update_metrics as the window grows.
+//
+// Usage: window_stats_benchmark [updates]
+//
+// For windows of 100, 10K and 1M samples the optimizer is first filled to
+// capacity, then timed over `updates` further updates so every one of them
+// evicts a sample. A rescan baseline reproducing the previous design (vector
+// erase from the front, then full passes through std::function selectors)
+// is timed alongside for windows small enough to finish in reasonable time.
+
+#include <chronovyan/real_time_optimizer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+class RescanBaseline {
+public:
+    explicit RescanBaseline(size_t window_size) : window_size(window_size) {}
+
+    void update_metrics(const OptimizationMetrics& metrics) {
+        history.push_back(metrics);
+        if (history.size() > window_size) {
+            history.erase(history.begin());
+        }
+        threshold += 0.01 * (average([](const OptimizationMetrics& m) { return m.sync_efficiency; }) - 0.5);
+        result = weighted([](const OptimizationMetrics& m) { return m.stability; });
+    }
+
+    double threshold = 0.5;
+    double result = 0.0;
+
+private:
+    double average(std::function<double(const OptimizationMetrics&)> selector) const {
+        double sum = 0.0;
+        for (const auto& m : history) {
+            sum += selector(m);
+        }
+        return sum / history.size();
+    }
+
+    double weighted(std::function<double(const OptimizationMetrics&)> selector) const {
+        double sum = 0.0;
+        double weight_sum = 0.0;
+        for (size_t i = 0; i < history.size(); ++i) {
+            double weight = std::exp(-0.1 * (history.size() - i - 1));
+            sum += weight * selector(history[i]);
+            weight_sum += weight;
+        }
+        return sum / weight_sum;
+    }
+
+    size_t window_size;
+    std::vector<OptimizationMetrics> history;
+};
+
+std::vector<OptimizationMetrics> make_stream(size_t n) {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<OptimizationMetrics> stream(n);
+    for (auto& m : stream) {
+        m.sync_efficiency = dist(gen);
+        m.stability = dist(gen);
+        m.error_rate = 100.0 * dist(gen);
+    }
+    return stream;
+}
+
+template <typename Optimizer>
+double ns_per_update(Optimizer& optimizer, const std::vector<OptimizationMetrics>& stream,
+                     size_t fill, long updates) {
+    for (size_t i = 0; i < fill; ++i) {
+        optimizer.update_metrics(stream[i % stream.size()]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < updates; ++i) {
+        optimizer.update_metrics(stream[i % stream.size()]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 1e9 * seconds / updates;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long updates = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if (updates <= 0) {
+        updates = 1000000;
+    }
+    std::vector<OptimizationMetrics> stream = make_stream(1 << 16);
+
+    std::printf("%10s %16s %16s\n", "window", "incremental", "rescan");
+    for (size_t window : {size_t(100), size_t(10000), size_t(1000000)}) {
+        RealTimeOptimizer optimizer(0.5, 0.1, 0.9, window);
+        double incremental = ns_per_update(optimizer, stream, window, updates);
+        std::printf("%10zu %13.1f ns", window, incremental);
+        if (window <= 10000) {
+            RescanBaseline baseline(window);
+            long baseline_updates = std::max(1L, updates / static_cast<long>(window));
+            double rescan = ns_per_update(baseline, stream, window, baseline_updates);
+            std::printf(" %13.1f ns", rescan);
+        } else {
+            std::printf(" %16s", "(skipped)");
+        }
+        std::printf("   (threshold %.3f)\n", optimizer.get_current_threshold());
+    }
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include "variant_fix.h"
 #include "token.h"
 #include "source_location.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -618,10 +619,20 @@ public:
      */
     BlockStmtNode& getBody() { return *m_body; }
 
+    /**
+     * @brief Get the id of this statement's loop profiling site
+     *
+     * Unique for the life of the process: ids are never reused, even after
+     * the statement is destroyed, so a profiler keyed by them cannot mix up
+     * loops of different programs.
+     */
+    uint64_t getSiteId() const { return m_siteId; }
+
 private:
     TemporalOpType m_opType;
     std::vector<std::unique_ptr<ExprNode>> m_arguments;
     std::unique_ptr<BlockStmtNode> m_body;
+    uint64_t m_siteId;
 };
 
 /**
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace chronovyan {
+namespace sync {
+
+// Online anomaly detector over a fixed set of metric streams ("factors").
+// Each factor keeps an EWMA baseline (optionally split into a level and a
+// seasonal component), an EWMA variance for z-scores, and a two-sided CUSUM,
+// in standard deviations, for slow level shifts. update() is O(factors) with
+// memory fixed at construction and never allocates. Not internally
+// synchronized; callers serialize access.
+class StreamingAnomalyDetector {
+public:
+    struct Config {
+        double alpha = 0.05;              // EWMA weight for level and variance
+        double z_threshold = 4.0;         // |z| that scores exactly anomaly_threshold
+        double min_stddev = 0.02;         // floor so flat streams do not divide by zero
+        double cusum_drift = 0.5;         // slack per CUSUM step, in standard deviations
+        double cusum_threshold = 8.0;     // CUSUM sum (in standard deviations) scoring anomaly_threshold
+        size_t season_length = 0;         // samples per season; 0 or 1 disables seasonality
+        double season_gamma = 0.1;        // EWMA weight for the seasonal component
+        size_t warmup_samples = 1;        // samples before update() may raise
+        double anomaly_threshold = 0.7;   // score at which a sample is anomalous
+    };
+
+    enum class Kind {
+        None,
+        Spike,        // single-sample deviation (z-score)
+        ChangePoint   // sustained shift (CUSUM)
+    };
+
+    struct Score {
+        double value{0.0};                // max factor score, in [0, 1)
+        Kind kind{Kind::None};
+        size_t factor{0};                 // factor with the highest score
+    };
+
+    explicit StreamingAnomalyDetector(std::vector<std::string> factor_names);
+    StreamingAnomalyDetector(std::vector<std::string> factor_names, const Config& config);
+
+    // Learn one sample per factor. Returns true when the stream turns anomalous
+    // (edge-triggered: it re-arms once the score falls below the threshold).
+    bool update(const double* values);
+
+    // Score values against the learned baseline without learning from them.
+    // factor_scores, if non-null, receives one score per factor.
+    Score evaluate(const double* values, double* factor_scores) const;
+
+    // Score of the most recent update()
+    const Score& last_score() const { return latest; }
+    double factor_score(size_t factor) const { return channels[factor].last_score; }
+
+    size_t factor_count() const { return names.size(); }
+    const std::string& factor_name(size_t factor) const { return names[factor]; }
+    const Config& get_config() const { return config; }
+    size_t sample_count() const { return samples; }
+
+    void reset();
+
+    static const char* kind_name(Kind kind);
+
+private:
+    struct Channel {
+        double level{0.0};
+        double variance{0.0};
+        double cusum_up{0.0};
+        double cusum_down{0.0};
+        double last_score{0.0};
+    };
+
+    double seasonal(size_t factor) const;
+    double scale(double ratio) const;
+    double score_channel(size_t factor, double value, Channel& state, Kind* kind) const;
+
+    std::vector<std::string> names;
+    Config config;
+    std::vector<Channel> channels;
+    std::vector<double> seasonal_components;  // factors x season_length
+    size_t samples{0};
+    Score latest;
+    bool raised{false};
+};
+
+} // namespace sync
+} // namespace chronovyan
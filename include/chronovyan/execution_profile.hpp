@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "chronovyan/common_types.hpp"
+#include "chronovyan/notification_service.hpp"
+
+namespace chronovyan {
+
+// Resource knobs a PerformanceMode maps to. The defaults are the Balanced
+// profile, so a default-constructed interpreter or synchronizer behaves as
+// it did before profiles existed.
+struct ExecutionProfile {
+    PerformanceMode mode = PerformanceMode::Balanced;
+
+    // Interpreter
+    size_t echo_history_capacity = 64;  // previous values kept per ECHO variable
+    size_t weaver_outcomes = 16;        // most probable WEAVER outcomes kept for sampling; 0 keeps all
+    bool paradox_tracking = true;       // per-operation CONF/REB paradox bookkeeping
+
+    // TemporalSynchronizer
+    std::chrono::milliseconds sync_tick_interval{100};  // minimum time between due ticks
+    size_t sync_history_size = 10;                      // stability/coherence history length
+};
+
+// Built-in profile for a mode: Lean trades history and precision for
+// throughput and memory, HighFidelity does the reverse
+ExecutionProfile profile_for(PerformanceMode mode);
+
+// Applies the profile of the active mode to its targets and re-applies it
+// on every mode change, so switches take effect while the targets run.
+// It is an INotificationService: hand it to a StateController or subscribe
+// it to a NotificationBus.
+//
+// Targets are invoked in registration order with the switch's lock held,
+// so they see profiles in the order the switches happened; they must not
+// call back into the switch.
+class ExecutionProfileSwitch : public INotificationService {
+public:
+    using Target = std::function<void(const ExecutionProfile&)>;
+
+    explicit ExecutionProfileSwitch(PerformanceMode initial = PerformanceMode::Balanced);
+
+    // Replaces the profile used for a mode; re-applied at once if the mode is active
+    void set_profile(PerformanceMode mode, const ExecutionProfile& profile);
+    ExecutionProfile profile(PerformanceMode mode) const;
+
+    // Registers a target and applies the active profile to it immediately
+    void add_target(Target target);
+
+    void apply(PerformanceMode mode);
+    ExecutionProfile current() const;
+    // Number of profiles applied after a mode change
+    uint64_t switches() const;
+
+    // INotificationService
+    void notifyModeChange(PerformanceMode new_mode, const std::string& reason) override;
+    void notifyError(const std::string& error_message) override;
+
+private:
+    void apply_locked();
+
+    mutable std::mutex mutex_;
+    std::array<ExecutionProfile, 3> profiles_;
+    PerformanceMode current_;
+    std::vector<Target> targets_;
+    uint64_t switches_ = 0;
+};
+
+} // namespace chronovyan
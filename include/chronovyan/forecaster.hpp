@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace chronovyan {
+namespace sync {
+
+// Point forecast with a Gaussian prediction interval
+struct Forecast {
+    double mean{0.0};
+    double stddev{0.0};
+    double lower{0.0};
+    double upper{0.0};
+};
+
+// Probability that the forecast value falls below threshold
+double probability_below(const Forecast& forecast, double threshold);
+
+// Probability that the forecast lands within +/- tolerance of the actual value
+double probability_within(const Forecast& forecast, double tolerance);
+
+// Additive Holt-Winters (level, trend, optional season). One-step residual
+// variance is tracked with an EWMA; h-step intervals use the standard
+// additive-model variance multipliers.
+class HoltWintersForecaster {
+public:
+    static constexpr size_t kMaxSeasonLength = 64;
+
+    struct Config {
+        double alpha = 0.3;            // level smoothing
+        double beta = 0.05;            // trend smoothing
+        double gamma = 0.1;            // seasonal smoothing
+        size_t season_length = 0;      // 0 or 1 disables seasonality; capped at kMaxSeasonLength
+        double variance_alpha = 0.05;  // EWMA weight for squared residuals
+    };
+
+    HoltWintersForecaster();
+    explicit HoltWintersForecaster(const Config& config);
+
+    void update(double value);
+    Forecast forecast(size_t horizon, double z) const;
+
+    size_t sample_count() const { return samples; }
+
+private:
+    double seasonal_at(size_t offset) const;
+
+    Config config;
+    double level{0.0};
+    double trend{0.0};
+    std::array<double, kMaxSeasonLength> seasonal{};
+    size_t samples{0};
+    size_t residual_count{0};
+    double residual_variance{0.0};
+};
+
+// AR(p) with intercept, fit by recursive least squares with exponential
+// forgetting. Each update is O(p^2); h-step intervals use the model's
+// psi (MA-infinity) weights.
+class AutoRegressiveForecaster {
+public:
+    static constexpr size_t kMaxOrder = 8;
+
+    struct Config {
+        size_t order = 3;                 // capped at kMaxOrder
+        double forgetting = 0.995;        // RLS forgetting factor lambda
+        double initial_covariance = 100.0;
+        double variance_alpha = 0.05;
+    };
+
+    AutoRegressiveForecaster();
+    explicit AutoRegressiveForecaster(const Config& config);
+
+    void update(double value);
+    Forecast forecast(size_t horizon, double z) const;
+
+    // True once p lags have been seen and the model produces forecasts
+    bool is_ready() const { return samples > order; }
+    size_t sample_count() const { return samples; }
+
+private:
+    static constexpr size_t kTerms = kMaxOrder + 1;  // intercept + lags
+
+    double lag(size_t k) const;  // x_{t-k}, k >= 1
+    double predict(const std::array<double, kTerms>& regressor) const;
+
+    Config config;
+    size_t order;
+    std::array<double, kTerms> coefficients{};      // [intercept, a_1 .. a_p]
+    std::array<double, kTerms * kTerms> covariance{};
+    std::array<double, kMaxOrder> lags{};           // ring of recent values
+    size_t lag_head{0};
+    size_t samples{0};
+    size_t residual_count{0};
+    double residual_variance{0.0};
+};
+
+// Runs both models on one series and blends them with inverse one-step MSE
+// weights. The blended interval uses the mixture variance, so disagreement
+// between the models widens it. Fixed size and allocation-free.
+class SeriesForecaster {
+public:
+    struct Config {
+        HoltWintersForecaster::Config holt_winters;
+        AutoRegressiveForecaster::Config autoregressive;
+        double error_alpha = 0.05;   // EWMA weight for each model's squared one-step error
+        double min_stddev = 1e-3;    // interval floor; no forecast is treated as certain
+    };
+
+    SeriesForecaster();
+    explicit SeriesForecaster(const Config& config);
+
+    void update(double value);
+
+    // z is the normal quantile for the interval (1.96 for 95%)
+    Forecast forecast(size_t horizon, double z) const;
+
+    // Blend weight of the Holt-Winters model; AR gets the remainder
+    double holt_winters_weight() const;
+    size_t sample_count() const { return holt_winters.sample_count(); }
+
+private:
+    Config config;
+    HoltWintersForecaster holt_winters;
+    AutoRegressiveForecaster autoregressive;
+    double holt_winters_mse{0.0};
+    double autoregressive_mse{0.0};
+    size_t autoregressive_scored{0};
+};
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chronovyan {
+namespace sync {
+
+struct TreeEnsembleConfig {
+    size_t max_depth = 3;
+    size_t min_samples_split = 2;
+    size_t max_trees = 64;
+    size_t histogram_bins = 32;     // at most 256
+    size_t sample_buffer = 4096;    // rows kept for training
+    double shrinkage = 0.1;
+    double l2 = 1.0;                // leaf weight penalty
+};
+
+// Flattened trees, read-only. Every tree is a complete binary tree of
+// `depth` levels stored breadth-first (node i has children 2i+1 and 2i+2),
+// so scoring is fixed index arithmetic with no pointers or branches on
+// node type. A node that was not split has threshold +inf and sends every
+// row left; all leaves below it hold the same value. The arrays are laid
+// out tree after tree and can point straight into a mapped model file.
+struct TreeView {
+    const uint32_t* split_feature = nullptr;   // tree_count x internal_nodes()
+    const double* split_threshold = nullptr;   // tree_count x internal_nodes()
+    const double* leaf_value = nullptr;        // tree_count x leaves()
+    size_t tree_count = 0;
+    size_t depth = 0;
+    double base_score = 0.0;                   // log-odds before any tree
+
+    size_t internal_nodes() const { return (size_t(1) << depth) - 1; }
+    size_t leaves() const { return size_t(1) << depth; }
+
+    // Log-odds for one row
+    double raw_score(const double* features) const;
+    // Log-odds for `rows` row-major rows. Rows are scored in blocks, tree
+    // by tree, so each tree stays in cache across the block.
+    void raw_scores(const double* features, size_t rows, size_t feature_count, double* out) const;
+};
+
+// Gradient-boosted decision trees for binary classification (logistic
+// loss). Labeled rows go into a bounded ring buffer; each boosting round
+// grows one tree on the gradients of the whole buffer, choosing splits
+// from per-feature quantile histograms. Once the ensemble holds max_trees
+// trees it is compacted: refit from scratch on the current buffer with
+// half that many, which keeps memory and scoring cost bounded and lets the
+// model follow drift in the buffer. Inputs are not validated here; MLModel
+// does that.
+class GradientBoostedTrees {
+public:
+    explicit GradientBoostedTrees(size_t feature_count = 0, TreeEnsembleConfig config = {});
+
+    // Takes effect at the next compaction for max_depth and
+    // histogram_bins; a smaller sample_buffer drops the oldest rows now
+    void set_config(const TreeEnsembleConfig& config);
+    const TreeEnsembleConfig& config() const { return config_; }
+
+    size_t feature_count() const { return feature_count_; }
+    size_t tree_count() const { return tree_count_; }
+    size_t buffered() const { return size_; }
+
+    // Appends rows (row-major), overwriting the oldest when the buffer is full
+    void add_samples(const double* features, const double* targets, size_t rows);
+
+    // Grows one tree. Returns the mean log loss of the buffer before the
+    // round, or 0 if the buffer is empty (in which case nothing happens).
+    double boost_round();
+
+    double predict(const double* features) const;
+    void predict_batch(const double* features, size_t rows, double* out) const;
+
+    // Split gain per feature over the current trees, normalized to sum to 1
+    // (all zero before the first split)
+    std::vector<double> importance() const;
+
+    TreeView view() const;
+    const std::vector<double>& split_gain() const { return split_gain_; }
+
+    // Replaces the ensemble with saved trees; `split_gain` has one entry
+    // per internal node. The sample buffer is left empty.
+    void assign(const TreeView& trees, const double* split_gain);
+
+private:
+    struct Histogram {
+        double gradient;
+        double hessian;
+    };
+
+    void refit(size_t rounds);
+    void compute_bins();
+    void bin_row(size_t slot);
+    void grow_tree();
+    void grow_node(size_t tree, size_t node, size_t level, size_t begin, size_t end);
+    void make_leaf(size_t tree, size_t node, size_t level, size_t begin, size_t end);
+    double mean_loss() const;
+
+    size_t feature_count_;
+    TreeEnsembleConfig config_;
+
+    // Ensemble, flattened as described for TreeView
+    size_t depth_ = 0;
+    size_t tree_count_ = 0;
+    double base_score_ = 0.0;
+    std::vector<uint32_t> split_feature_;
+    std::vector<double> split_threshold_;
+    std::vector<double> split_gain_;
+    std::vector<double> leaf_value_;
+
+    // Sample ring buffer with cached raw scores and bin codes per row
+    std::vector<double> features_;
+    std::vector<double> targets_;
+    std::vector<double> scores_;
+    std::vector<uint8_t> codes_;
+    size_t capacity_ = 0;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    // Per feature: ascending bin upper edges; code(x) = #edges below x
+    std::vector<std::vector<double>> edges_;
+    size_t bin_stride_ = 0;  // histogram entries per feature
+
+    // Scratch for tree growth
+    std::vector<uint32_t> rows_;
+    std::vector<double> gradients_;
+    std::vector<double> hessians_;
+    std::vector<Histogram> histogram_;
+};
+
+} // namespace sync
+} // namespace chronovyan
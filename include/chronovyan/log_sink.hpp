@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "chronovyan/mpmc_queue.hpp"
+
+namespace chronovyan {
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+const char* to_string(LogLevel level);
+
+// One queued log entry. Records are not formatted when they are logged:
+// the message must be a string with static storage duration (normally a
+// literal) and numeric arguments are kept as values until the record is
+// written out.
+struct LogRecord {
+    static constexpr size_t kMaxValues = 4;
+
+    LogLevel level = LogLevel::Info;
+    std::chrono::system_clock::time_point time;
+    const char* message = "";
+    std::array<double, kMaxValues> values{};
+    uint8_t value_count = 0;
+};
+
+// Leveled, non-blocking log sink. log() never locks, allocates or waits:
+// records go into a fixed-size multi-producer queue and are dropped (and
+// counted) when the queue is full. A background thread drains the queue
+// and hands each record to the writer, which defaults to std::clog.
+// Records below the current level are rejected with a single relaxed load,
+// so disabled log statements cost next to nothing on hot paths.
+class LogSink {
+public:
+    using Writer = std::function<void(const LogRecord&)>;
+
+    // The process-wide sink; its drain thread starts on first use
+    static LogSink& instance();
+
+    // capacity is rounded up to a power of two
+    explicit LogSink(size_t capacity = 1024, LogLevel level = LogLevel::Warn);
+    ~LogSink();
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    void set_level(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+    bool enabled(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::Off;
+    }
+
+    // Queues a record. Returns false if the level is disabled or the queue
+    // is full. At most LogRecord::kMaxValues values are kept.
+    bool log(LogLevel level, const char* message, std::initializer_list<double> values = {});
+
+    // Replaces the writer; called from the draining thread only
+    void set_writer(Writer writer);
+
+    // Starts or stops the background drain thread. stop() drains what is
+    // left before returning.
+    void start();
+    void stop();
+
+    // Writes out all queued records on the calling thread
+    size_t drain();
+
+    // Records rejected because the queue was full
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // "[level] message (v1, v2, ...)"
+    static std::string format(const LogRecord& record);
+
+private:
+    void run();
+
+    std::atomic<LogLevel> level_;
+    MpmcQueue<LogRecord> queue_;
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex drain_mutex_;
+    Writer writer_;
+
+    std::mutex wait_mutex_;
+    std::condition_variable wake_;
+    bool running_ = false;
+    std::thread thread_;
+};
+
+} // namespace chronovyan
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "chronovyan/common_types.hpp"
+
+// The interpreter's loop profiling hooks are compiled in unless this is
+// defined to 0 (CMake option CHRONOVYAN_LOOP_PROFILING=OFF). Compiled out,
+// the loops carry no profiling code at all and an attached LoopProfiler
+// never receives samples.
+#ifndef CHRONOVYAN_LOOP_PROFILING
+#define CHRONOVYAN_LOOP_PROFILING 1
+#endif
+
+namespace chronovyan {
+
+enum class LoopKind { ForChronon, WhileEvent, TemporalEchoLoop };
+
+// The metrics of docs/specifications/Chronovyan_Loop_Stability_Metrics.md
+enum class LoopMetric {
+    LoopEntropy,         // LOOP_ENTROPY
+    IterationStability,  // ITERATION_STABILITY_QUOTIENT (ISQ)
+    ChrononEfficiency,   // CHRONON_EFFICIENCY_RATIO (CER)
+    RecursionDepth,      // TEMPORAL_RECURSION_DEPTH (TRD)
+    ParadoxPotential     // PARADOX_POTENTIAL_INDEX (PPI)
+};
+
+enum class LoopAlert { None, Warning, Critical, Emergency };
+
+const char* to_string(LoopKind kind);
+const char* to_string(LoopMetric metric);
+const char* to_string(LoopAlert alert);
+
+// Constants of the metric formulas; the defaults are the specification's
+struct LoopMetricParameters {
+    double base_entropy = 0.01;
+    double entropy_factor = 0.001;       // entropy per iteration at a REB ratio of 1
+    double expected_variation = 0.05;    // coefficient of variation at which ISQ reaches 0
+    double max_recursion_depth = 12.0;   // TRD that normalizes to 1 in the PPI
+};
+
+// What one iteration of a loop body did, as counted by the interpreter
+struct LoopIterationSample {
+    uint64_t operations = 0;           // binary operations evaluated
+    uint64_t reb_operations = 0;       // those with a REB operand
+    uint64_t direct_references = 0;    // writes that carry a previous iteration forward
+    uint64_t indirect_references = 0;  // reads of values carried forward
+};
+
+struct LoopMetrics {
+    double loop_entropy = 0.0;
+    double iteration_stability = 1.0;
+    double chronon_efficiency = 1.0;
+    double recursion_depth = 0.0;
+    double paradox_potential = 0.0;
+
+    double value(LoopMetric metric) const;
+};
+
+struct LoopSiteReport {
+    std::string label;
+    LoopKind kind = LoopKind::ForChronon;
+    uint64_t executions = 0;
+    uint64_t iterations = 0;
+    double resources = 0.0;  // chronons and aethel drawn from the runtime
+    std::chrono::nanoseconds elapsed{0};
+    LoopMetrics metrics;
+    LoopAlert alert = LoopAlert::None;  // worst alert over the metrics
+};
+
+// Counters of one loop site (one loop statement). Interpreters running
+// the same program on several threads record into the same site, so every
+// counter is a relaxed atomic add; report() may run concurrently on any
+// thread and reads each counter individually.
+class LoopSite {
+public:
+    LoopSite(LoopKind kind, std::string label);
+
+    LoopSite(const LoopSite&) = delete;
+    LoopSite& operator=(const LoopSite&) = delete;
+
+    LoopKind kind() const { return kind_; }
+    const std::string& label() const { return label_; }
+
+    void record_iteration(const LoopIterationSample& sample) {
+        bump(iterations_, uint64_t{1});
+        bump(operations_, sample.operations);
+        bump(reb_operations_, sample.reb_operations);
+        bump(direct_references_, sample.direct_references);
+        bump(indirect_references_, sample.indirect_references);
+        // Work per iteration, whose spread across iterations is the ISQ's variation
+        const double work = static_cast<double>(sample.operations + sample.direct_references +
+                                                sample.indirect_references);
+        bump(work_sum_, work);
+        bump(work_squares_, work * work);
+    }
+
+    // Called once per execution of the loop, after its last iteration
+    void record_execution(double resources, std::chrono::nanoseconds elapsed) {
+        bump(executions_, uint64_t{1});
+        bump(resources_, resources);
+        bump(elapsed_ns_, static_cast<int64_t>(elapsed.count()));
+    }
+
+    uint64_t iterations() const { return iterations_.load(std::memory_order_relaxed); }
+
+    LoopSiteReport report(const LoopMetricParameters& parameters = LoopMetricParameters()) const;
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    static void bump(std::atomic<int64_t>& counter, int64_t delta) {
+        counter.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    // std::atomic<double> has no fetch_add before C++20
+    static void bump(std::atomic<double>& counter, double delta) {
+        double current = counter.load(std::memory_order_relaxed);
+        while (!counter.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+
+    const LoopKind kind_;
+    const std::string label_;
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> iterations_{0};
+    std::atomic<uint64_t> operations_{0};
+    std::atomic<uint64_t> reb_operations_{0};
+    std::atomic<uint64_t> direct_references_{0};
+    std::atomic<uint64_t> indirect_references_{0};
+    std::atomic<double> work_sum_{0.0};
+    std::atomic<double> work_squares_{0.0};
+    std::atomic<double> resources_{0.0};
+    std::atomic<int64_t> elapsed_ns_{0};
+};
+
+// Live loop stability metrics, per loop site.
+//
+// Attach a profiler to an Interpreter (Interpreter::setLoopProfiler) and
+// every FOR_CHRONON, WHILE_EVENT and TEMPORAL_ECHO_LOOP it runs records
+// into the site of its statement: one LoopIterationSample per iteration
+// and the resources and time of each execution. The metrics are derived
+// from those counters whenever they are read, never on the loop's path:
+//
+//   LOOP_ENTROPY  base_entropy + iterations * entropy_factor * REB_ratio^2,
+//                 capped at 1, where REB_ratio is the share of the body's
+//                 binary operations with a REB operand
+//   ISQ           1 - cv / expected_variation, clamped to [0, 1], where cv
+//                 is the coefficient of variation of per-iteration work
+//                 (operations and references) across iterations
+//   CER           iterations / (chronons + aethel consumed); 1 for a loop
+//                 that consumed nothing
+//   TRD           (direct + 0.5 * indirect references) per iteration
+//   PPI           0.4 LE + 0.3 (1 - ISQ) + 0.2 clamp(1 - CER, 0, 1)
+//                 + 0.1 min(TRD / max_recursion_depth, 1)
+//
+// Alerts use the specification's warning/critical/emergency thresholds.
+// Sites are keyed by the statement's site id (TemporalOpStmtNode::
+// getSiteId), which is never reused: a loop of a freed program keeps its
+// site and a later program's loops never land in it.
+class LoopProfiler {
+public:
+    explicit LoopProfiler(const LoopMetricParameters& parameters = LoopMetricParameters());
+
+    LoopProfiler(const LoopProfiler&) = delete;
+    LoopProfiler& operator=(const LoopProfiler&) = delete;
+
+    // A disabled profiler keeps its sites but loops stop recording; checked
+    // once per loop execution
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // The site of `key`, created with `kind` and `label` on first use.
+    // Sites live as long as the profiler.
+    LoopSite& site(uint64_t key, LoopKind kind, const std::string& label);
+    LoopSite* find(uint64_t key) const;
+    size_t site_count() const;
+
+    // Every site that has run an iteration, highest PPI first
+    std::vector<LoopSiteReport> reports() const;
+
+    // The worst value of `metric` over the sites that have run an
+    // iteration (the lowest ISQ and CER, the highest of the rest)
+    double worst(LoopMetric metric) const;
+
+    // Plain-text table of reports() with the alert of each site
+    void report(std::ostream& out) const;
+
+    const LoopMetricParameters& parameters() const { return parameters_; }
+
+    // worst(metric) as an IMetricSource for MetricCollector, scaled to
+    // 0-100: LE, ISQ and PPI as percentages, CER against 2 (highly
+    // efficient) and TRD against max_recursion_depth. Unavailable until a
+    // loop has run an iteration. The profiler must outlive the source.
+    std::unique_ptr<IMetricSource> metric_source(LoopMetric metric) const;
+
+    static LoopAlert alert(LoopMetric metric, double value);
+    static LoopAlert alert(const LoopMetrics& metrics);
+
+private:
+    const LoopMetricParameters parameters_;
+    std::atomic<bool> enabled_{true};
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::unique_ptr<LoopSite>> sites_;
+};
+
+} // namespace chronovyan
@@ -1,36 +1,22 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 #include "chronovyan/common_types.hpp"
+#include "chronovyan/metric_history.hpp"
+#include "chronovyan/metric_registry.hpp"
 
 namespace chronovyan {
 
-// Structure to hold individual metric data
-struct MetricData {
-    double value = 0.0;
-    std::chrono::system_clock::time_point timestamp;
-    bool is_available = true;
-};
-
-// Structure to hold all system metrics
-struct SystemMetrics {
-    // Modern approach: use a map of metrics
-    std::map<std::string, MetricData> metrics;
-    bool is_stale = false;
-    bool is_valid = true;
-    
-    // Exception tracking
-    bool has_exception = false;
-    std::string exception_source;
-    std::string exception_message;
-    
-    // Legacy fields for compatibility with tests
-    double cpu_usage = 0.0;
-    double memory_usage = 0.0;
-    double gpu_usage = 0.0;
+// How often a source is sampled in the background, and how long a single
+// sample may take before the source is reported as timed out
+struct SamplingPolicy {
+    std::chrono::milliseconds interval{100};
+    std::chrono::milliseconds timeout{1000};
 };
 
 class MetricCollector {
@@ -51,12 +37,39 @@ public:
         IMetricSource* gpu_source
     );
     
-    // Add a source with a name
+    // Stops background sampling, if running
+    ~MetricCollector();
+
+    MetricCollector(const MetricCollector&) = delete;
+    MetricCollector& operator=(const MetricCollector&) = delete;
+    
+    // Add a source with a name. Sources cannot be added while sampling.
     void addSource(const std::string& name, IMetricSource* source);
+    void addSource(const std::string& name, IMetricSource* source, const SamplingPolicy& policy);
+    
+    // Background sampling: every registered source is polled on its own
+    // thread at its policy's interval and the latest results are published
+    // to per-source seqlocked slots. While sampling, collect_metrics() only
+    // reads those slots, each as one consistent sample and without locking,
+    // and never calls into a source, so a slow source cannot stall the
+    // caller; a sample still in flight past its deadline is reported as a
+    // timeout. stopSampling() waits for in-flight samples. Starting and
+    // stopping must not race with collect_metrics().
+    void startSampling();
+    void stopSampling();
+    bool isSampling() const;
     
-    // Main method to collect all metrics
+    // Main method to collect all metrics. Without background sampling the
+    // sources are polled on the calling thread, and a sample slower than
+    // its source's policy timeout is only detected once it returns.
     SystemMetrics collect_metrics() const;
     
+    // Recorded samples and rollups for every source. Successful samples
+    // are recorded by the background samplers, or by collect_metrics()
+    // when not sampling; in that mode collect_metrics() must not be called
+    // from several threads at once.
+    const MetricHistory& history() const { return history_; }
+    
     // Individual metric getters
     double get_cpu_usage() const;
     double get_memory_usage() const;
@@ -67,8 +80,21 @@ public:
     static bool getForceRefreshForTesting();
     
 private:
+    // Outcome of polling one source
+    enum class SampleStatus {
+        Ok,
+        OutOfRange,  // value was NaN or outside [0, 100] and was replaced or clamped
+        Unavailable,
+        Exception,
+        Timeout
+    };
+    struct Sampler;  // background sampling state for one source
+    
     // Helper methods
-    double collect_metric(IMetricSource* source) const;
+    const SamplingPolicy& policy_for(const std::string& name) const;
+    double collect_metric(const std::string& name, IMetricSource* source) const;
+    double collect_metric(const std::string& name, IMetricSource* source, SampleStatus& status) const;
+    SystemMetrics read_snapshot() const;
     bool is_metric_stale(IMetricSource* source) const;
     double clamp_metric(double value) const;
     
@@ -79,6 +105,14 @@ private:
     
     // Named sources for extensibility
     std::map<std::string, IMetricSource*> sources_;
+    std::map<std::string, SamplingPolicy> policies_;
+    
+    // One sampler per source while background sampling is running
+    std::vector<std::unique_ptr<Sampler>> samplers_;
+    std::atomic<bool> sampling_{false};
+    
+    // History is written from collect_metrics() const on the synchronous path
+    mutable MetricHistory history_;
     
     // Static member to force refresh for testing
     static bool force_refresh_for_testing_;
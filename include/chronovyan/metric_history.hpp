@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "chronovyan/metric_registry.hpp"
+
+namespace chronovyan {
+
+// One full-resolution sample
+struct MetricPoint {
+    std::chrono::system_clock::time_point time;
+    double value = 0.0;
+};
+
+// Aggregate of the samples that fell into one rollup interval
+struct MetricRollup {
+    std::chrono::system_clock::time_point start;
+    uint32_t count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double avg = 0.0;
+    double p99 = 0.0;  // from a log-bucketed sketch, within ~2% of the true value
+};
+
+enum class RollupResolution {
+    OneSecond,
+    TenSeconds,
+    OneMinute
+};
+
+namespace detail {
+
+inline int64_t history_nanos(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+inline std::chrono::system_clock::time_point history_time(int64_t nanos) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+// Records are stored field by field in relaxed atomics so that readers can
+// load them in place while the writer runs
+struct PointRecord {
+    std::atomic<int64_t> time{0};
+    std::atomic<double> value{0.0};
+
+    int64_t key() const { return time.load(std::memory_order_relaxed); }
+    MetricPoint load() const {
+        return {history_time(key()), value.load(std::memory_order_relaxed)};
+    }
+    void store(const MetricPoint& point) {
+        time.store(history_nanos(point.time), std::memory_order_relaxed);
+        value.store(point.value, std::memory_order_relaxed);
+    }
+};
+
+struct RollupRecord {
+    std::atomic<int64_t> start{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<double> min{0.0};
+    std::atomic<double> max{0.0};
+    std::atomic<double> avg{0.0};
+    std::atomic<double> p99{0.0};
+
+    int64_t key() const { return start.load(std::memory_order_relaxed); }
+    MetricRollup load() const {
+        MetricRollup rollup;
+        rollup.start = history_time(key());
+        rollup.count = count.load(std::memory_order_relaxed);
+        rollup.min = min.load(std::memory_order_relaxed);
+        rollup.max = max.load(std::memory_order_relaxed);
+        rollup.avg = avg.load(std::memory_order_relaxed);
+        rollup.p99 = p99.load(std::memory_order_relaxed);
+        return rollup;
+    }
+    void store(const MetricRollup& rollup) {
+        start.store(history_nanos(rollup.start), std::memory_order_relaxed);
+        count.store(rollup.count, std::memory_order_relaxed);
+        min.store(rollup.min, std::memory_order_relaxed);
+        max.store(rollup.max, std::memory_order_relaxed);
+        avg.store(rollup.avg, std::memory_order_relaxed);
+        p99.store(rollup.p99, std::memory_order_relaxed);
+    }
+};
+
+// Single-writer ring. Sequence number s lives at index s % capacity.
+// claimed is raised before a slot is overwritten and published after it
+// is complete, which lets readers detect records overwritten under them.
+template <typename Record>
+struct HistoryRing {
+    explicit HistoryRing(size_t capacity) : records(capacity < 2 ? 2 : capacity) {}
+
+    template <typename Value>
+    void push(const Value& value) {
+        uint64_t next = published.load(std::memory_order_relaxed);
+        claimed.store(next + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        records[next % records.size()].store(value);
+        published.store(next + 1, std::memory_order_release);
+    }
+
+    std::vector<Record> records;
+    std::atomic<uint64_t> claimed{0};
+    std::atomic<uint64_t> published{0};
+};
+
+} // namespace detail
+
+// Zero-copy view of consecutive records in a history ring. Elements are
+// loaded from the ring as they are accessed. The writer keeps running
+// while a view is held and may overwrite its oldest records; intact()
+// reports whether everything read through the view so far was current,
+// and should be checked after reading.
+template <typename Record, typename Value>
+class HistoryView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Value;
+
+        iterator(const detail::HistoryRing<Record>* ring, uint64_t sequence)
+            : ring_(ring), sequence_(sequence) {}
+
+        Value operator*() const { return ring_->records[sequence_ % ring_->records.size()].load(); }
+        iterator& operator++() {
+            ++sequence_;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator previous = *this;
+            ++sequence_;
+            return previous;
+        }
+        bool operator==(const iterator& other) const { return sequence_ == other.sequence_; }
+        bool operator!=(const iterator& other) const { return sequence_ != other.sequence_; }
+
+    private:
+        const detail::HistoryRing<Record>* ring_;
+        uint64_t sequence_;
+    };
+
+    HistoryView() = default;
+    HistoryView(const detail::HistoryRing<Record>* ring, uint64_t first, uint64_t count)
+        : ring_(ring), first_(first), count_(count) {}
+
+    size_t size() const { return static_cast<size_t>(count_); }
+    bool empty() const { return count_ == 0; }
+    iterator begin() const { return iterator(ring_, first_); }
+    iterator end() const { return iterator(ring_, first_ + count_); }
+    Value operator[](size_t index) const { return *iterator(ring_, first_ + index); }
+    Value front() const { return (*this)[0]; }
+    Value back() const { return (*this)[size() - 1]; }
+
+    bool intact() const {
+        if (!ring_ || count_ == 0) {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ring_->claimed.load(std::memory_order_relaxed) <= first_ + ring_->records.size();
+    }
+
+private:
+    const detail::HistoryRing<Record>* ring_ = nullptr;
+    uint64_t first_ = 0;
+    uint64_t count_ = 0;
+};
+
+using MetricPointView = HistoryView<detail::PointRecord, MetricPoint>;
+using MetricRollupView = HistoryView<detail::RollupRecord, MetricRollup>;
+
+// Embedded time-series store: for each tracked metric, a ring of samples
+// at full resolution plus rings of 1s, 10s and 1m rollups (min, max, avg,
+// p99). All memory is allocated when a metric is tracked, so the cost is
+// fixed and recording never allocates. Each metric must have a single
+// writer; any number of threads may query concurrently without locks.
+class MetricHistory {
+public:
+    struct Config {
+        size_t raw_capacity = 4096;        // full-resolution samples per metric
+        size_t second_buckets = 600;       // 10 minutes of 1s rollups
+        size_t ten_second_buckets = 360;   // 1 hour of 10s rollups
+        size_t minute_buckets = 1440;      // 24 hours of 1m rollups
+    };
+
+    MetricHistory();
+    explicit MetricHistory(const Config& config);
+    ~MetricHistory();
+
+    MetricHistory(const MetricHistory&) = delete;
+    MetricHistory& operator=(const MetricHistory&) = delete;
+
+    // Allocates the metric's rings; idempotent. Call before recording.
+    void track(MetricHandle handle);
+    bool is_tracked(MetricHandle handle) const;
+
+    // Appends a sample. Samples for untracked metrics are dropped; a time
+    // earlier than the previous sample is clamped to it. Closes any rollup
+    // intervals the sample moves past.
+    void record(MetricHandle handle, std::chrono::system_clock::time_point time, double value);
+
+    // Samples with time in [from, to]
+    MetricPointView range(MetricHandle handle,
+                          std::chrono::system_clock::time_point from,
+                          std::chrono::system_clock::time_point to) const;
+
+    // The most recent count samples (fewer if not yet recorded)
+    MetricPointView latest(MetricHandle handle, size_t count) const;
+
+    // Closed rollup intervals starting in [from, to]; the interval still
+    // accumulating samples is not included
+    MetricRollupView rollups(MetricHandle handle, RollupResolution resolution,
+                             std::chrono::system_clock::time_point from,
+                             std::chrono::system_clock::time_point to) const;
+
+    const Config& config() const { return config_; }
+
+private:
+    struct Series;
+
+    const Series* series(MetricHandle handle) const;
+
+    Config config_;
+    std::mutex track_mutex_;
+    std::vector<std::unique_ptr<Series>> owned_;
+    std::array<std::atomic<Series*>, MetricRegistry::kMaxMetrics> series_{};
+};
+
+} // namespace chronovyan
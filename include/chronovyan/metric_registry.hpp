@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chronovyan {
+
+using MetricId = uint16_t;
+
+// Reference to a registered metric. Handles are only issued by
+// MetricRegistry, so a valid handle always indexes a registered slot and
+// lookups through it are plain array loads.
+class MetricHandle {
+public:
+    static constexpr MetricId kInvalid = 0xFFFF;
+
+    constexpr MetricHandle() = default;
+
+    constexpr MetricId id() const { return id_; }
+    constexpr bool valid() const { return id_ != kInvalid; }
+
+    friend constexpr bool operator==(MetricHandle a, MetricHandle b) { return a.id_ == b.id_; }
+    friend constexpr bool operator!=(MetricHandle a, MetricHandle b) { return a.id_ != b.id_; }
+
+private:
+    friend class MetricRegistry;
+    friend class MetricTable;
+    constexpr explicit MetricHandle(MetricId id) : id_(id) {}
+
+    MetricId id_ = kInvalid;
+};
+
+// Assigns integer ids to metric names. Registration takes a lock and is
+// meant for setup time; the decision path works with handles only. The
+// built-in cpu, memory and gpu metrics have fixed ids so they need no
+// lookup at all.
+class MetricRegistry {
+public:
+    static constexpr size_t kMaxMetrics = 64;
+
+    static constexpr MetricHandle kCpu{0};
+    static constexpr MetricHandle kMemory{1};
+    static constexpr MetricHandle kGpu{2};
+
+    // The process-wide registry shared by collectors, engines and
+    // SystemMetrics name lookups
+    static MetricRegistry& instance();
+
+    MetricRegistry();
+
+    // Returns the existing handle if the name is already registered.
+    // Throws std::length_error once kMaxMetrics names are registered.
+    MetricHandle register_metric(const std::string& name);
+
+    // Invalid handle if the name is unknown
+    MetricHandle find(const std::string& name) const;
+
+    std::string name(MetricHandle handle) const;
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, MetricId> ids_;
+    std::vector<std::string> names_;
+};
+
+// Structure to hold individual metric data
+struct MetricData {
+    double value = 0.0;
+    std::chrono::system_clock::time_point timestamp;
+    bool is_available = true;
+};
+
+// Current metric values stored flat, indexed by metric id. Copies are a
+// fixed-size memcpy with no allocation. The string overloads resolve names
+// through MetricRegistry::instance() and exist for callers that have not
+// resolved handles.
+class MetricTable {
+public:
+    // Inserts a default entry if the metric is not present
+    MetricData& operator[](MetricHandle handle) {
+        check(handle);
+        present_ |= bit(handle);
+        return slots_[handle.id()];
+    }
+
+    bool contains(MetricHandle handle) const {
+        return handle.valid() && handle.id() < MetricRegistry::kMaxMetrics &&
+               (present_ & bit(handle)) != 0;
+    }
+
+    // Throws std::out_of_range if the metric is not present
+    const MetricData& at(MetricHandle handle) const {
+        if (!contains(handle)) {
+            throw std::out_of_range("Metric not present");
+        }
+        return slots_[handle.id()];
+    }
+
+    // Present and marked available
+    bool is_available(MetricHandle handle) const {
+        return contains(handle) && slots_[handle.id()].is_available;
+    }
+
+    void erase(MetricHandle handle) {
+        if (contains(handle)) {
+            present_ &= ~bit(handle);
+            slots_[handle.id()] = MetricData();
+        }
+    }
+
+    MetricData& operator[](const std::string& name) {
+        return (*this)[MetricRegistry::instance().register_metric(name)];
+    }
+    const MetricData& at(const std::string& name) const {
+        return at(MetricRegistry::instance().find(name));
+    }
+    size_t count(const std::string& name) const {
+        return contains(MetricRegistry::instance().find(name)) ? 1 : 0;
+    }
+
+    size_t size() const;
+    bool empty() const { return present_ == 0; }
+
+    // Calls fn(MetricHandle, const MetricData&) for each present metric in id order
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (MetricId id = 0; id < MetricRegistry::kMaxMetrics; ++id) {
+            if (present_ & (uint64_t{1} << id)) {
+                fn(MetricHandle(id), slots_[id]);
+            }
+        }
+    }
+
+private:
+    static_assert(MetricRegistry::kMaxMetrics <= 64, "presence mask is a single word");
+
+    static uint64_t bit(MetricHandle handle) { return uint64_t{1} << handle.id(); }
+    static void check(MetricHandle handle) {
+        if (!handle.valid() || handle.id() >= MetricRegistry::kMaxMetrics) {
+            throw std::out_of_range("Invalid metric handle");
+        }
+    }
+
+    uint64_t present_ = 0;
+    std::array<MetricData, MetricRegistry::kMaxMetrics> slots_{};
+};
+
+// Structure to hold all system metrics
+struct SystemMetrics {
+    // Values of every collected metric, indexed by registry id
+    MetricTable metrics;
+    bool is_stale = false;
+    bool is_valid = true;
+
+    // Exception tracking. Timeouts are reported as exceptions with
+    // has_timeout set; exception_source names the first failing source and
+    // exception_metric is its handle (invalid if the source is unknown).
+    bool has_exception = false;
+    bool has_timeout = false;
+    MetricHandle exception_metric;
+    std::string exception_source;
+    std::string exception_message;
+
+    // A source reported NaN or a value outside [0, 100], which the
+    // collector replaced or clamped
+    bool has_out_of_range = false;
+
+    // Legacy fields for compatibility with tests; the collector mirrors the
+    // cpu, memory and gpu entries of the table here
+    double cpu_usage = 0.0;
+    double memory_usage = 0.0;
+    double gpu_usage = 0.0;
+};
+
+} // namespace chronovyan
@@ -1,14 +1,46 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <map>
 #include <optional>
+#include "chronovyan/gradient_boosting.hpp"
 #include "chronovyan/optimization_metrics.hpp"
 
 namespace chronovyan {
 namespace sync {
 
+// Weight update rule used by train_batch()
+enum class GradientOptimizer {
+    MomentumSGD,
+    Adam
+};
+
+struct MLHyperparameters {
+    double learning_rate = 0.01;
+    double regularization = 0.01;  // L2 penalty
+    double momentum = 0.9;         // MomentumSGD velocity decay
+    double beta1 = 0.9;            // Adam first-moment decay
+    double beta2 = 0.999;          // Adam second-moment decay
+    double epsilon = 1e-8;
+    int max_depth = 3;
+    int min_samples_split = 2;
+    GradientOptimizer optimizer = GradientOptimizer::Adam;
+
+    // Tree ensemble ("gradient_boost" models); see TreeEnsembleConfig
+    double shrinkage = 0.1;
+    double tree_l2 = 1.0;
+    int max_trees = 64;
+    int histogram_bins = 32;
+    int sample_buffer = 4096;
+};
+
+class MappedModel;
+
+// Binary classifier behind the optimizer. The "gradient_boost" model type
+// is a gradient-boosted tree ensemble (GradientBoostedTrees) trained from
+// labeled rows; every other type is logistic regression on one weight
+// vector. Both sit behind the same predict/train/importance API.
 class MLModel {
 public:
     MLModel(
@@ -18,24 +50,82 @@ public:
         std::optional<unsigned int> seed = std::nullopt
     );
 
+    // Warm start from a saved model: weights, importance, hyperparameters
+    // and optimizer state are copied out of the mapping, so training picks
+    // up where the saved model stopped
+    explicit MLModel(const MappedModel& saved);
+    static MLModel load(const std::string& path);
+
+    // Writes the model in the ModelFileHeader format (ml_model_store.hpp).
+    // save() replaces `path` atomically and throws std::runtime_error on
+    // I/O failure; serialize() reuses the capacity of `out`.
+    void save(const std::string& path) const;
+    void serialize(std::vector<char>& out) const;
+
+    // Unlabeled update of the linear weights (the original online rule).
+    // Tree ensembles only learn from labeled rows, so on a tree model this
+    // throws std::logic_error.
     void update(const std::vector<double>& features);
+    // One labeled row. Linear models take an optimizer step on it; tree
+    // models buffer it and grow a tree every kTreeUpdateRows rows.
+    void update(const std::vector<double>& features, double target);
     void update_hyperparameters(const OptimizationMetrics& metrics);
     double predict(const std::vector<double>& features) const;
     std::vector<double> get_feature_importance() const;
 
+    // One optimizer step of logistic regression on a minibatch. `features`
+    // is row-major, rows x feature count; `targets` holds one label in
+    // [0, 1] per row. Returns the mean cross-entropy of the batch before
+    // the step. Throws std::invalid_argument on non-finite input, leaving
+    // the model untouched.
+    double train_batch(const double* features, const double* targets, size_t rows);
+    double train_batch(const std::vector<double>& features, const std::vector<double>& targets);
+
+    // Scores `rows` row-major feature rows into `out`. Input is validated
+    // once per call rather than once per row.
+    void predict_batch(const double* features, size_t rows, double* out) const;
+    std::vector<double> predict_batch(const std::vector<double>& features) const;
+
+    const MLHyperparameters& get_hyperparameters() const { return hyperparameters; }
+    // Optimizer state is reset when the optimizer changes
+    void set_hyperparameters(const MLHyperparameters& params);
+
+    size_t feature_count() const { return feature_columns.size(); }
+    bool uses_trees() const { return tree_backend; }
+    const GradientBoostedTrees& trees() const { return ensemble; }
+
+    static constexpr size_t kTreeUpdateRows = 64;
+
 private:
     void initialize_model();
     void train_model(const std::vector<double>& features);
     void update_feature_importance();
+    void reset_optimizer_state();
+    double score(const double* features) const;
+    TreeEnsembleConfig tree_config() const;
+    double train_trees(const double* features, const double* targets, size_t rows);
 
     std::string model_type;
     std::vector<std::string> feature_columns;
     std::vector<double> feature_weights;
     std::vector<double> feature_importance;
-    std::map<std::string, double> hyperparameters;
+    MLHyperparameters hyperparameters;
     double learning_rate;
     std::optional<unsigned int> seed;
+
+    // Minibatch training state, sized once so training never allocates.
+    // Index feature_count() holds the bias.
+    double bias = 0.0;
+    std::vector<double> gradient;
+    std::vector<double> first_moment;   // momentum velocity or Adam m
+    std::vector<double> second_moment;  // Adam v
+    size_t optimizer_steps = 0;
+
+    // Tree backend; rows from single-row updates wait here for a round
+    bool tree_backend = false;
+    GradientBoostedTrees ensemble;
+    size_t rows_since_round = 0;
 };
 
 } // namespace sync
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "chronovyan/ml_model.hpp"
+
+namespace chronovyan {
+namespace sync {
+
+// On-disk MLModel format. The file is the in-memory layout of a header
+// followed by 8-byte aligned sections, so a mapped file is used in place:
+//
+//   ModelFileHeader
+//   weights         (feature_count + 1) doubles, bias last
+//   importance      feature_count doubles
+//   moments         2 x (feature_count + 1) doubles: first, then second
+//   trees           the flattened ensemble of a "gradient_boost" model
+//                   (see TreeView): split thresholds, split gains and leaf
+//                   values as doubles, then split features as uint32
+//                   padded to 8 bytes; empty for other model types
+//   string index    (feature_count + 1) x {offset, length}; entry 0 is the
+//                   model type, then one entry per feature column
+//   string bytes    not NUL-terminated
+//
+// Files are written in native byte order; a file from a host of the other
+// endianness is rejected rather than converted.
+//
+// Version 4 records in flags whether the model scores with its trees.
+// Older files are still read and infer it: versions 2 and 3 use the trees
+// of "gradient_boost" models, and version 1 predates the tree settings and
+// the trees section, so its header is shorter and its models are linear
+// whatever their type. Version 3 started checksumming the header too;
+// version 2 checksums only the sections.
+struct ModelFileHeader {
+    static constexpr char kMagic[8] = {'C', 'V', 'M', 'L', 'M', 'O', 'D', 'L'};
+    static constexpr uint32_t kVersion = 4;
+    static constexpr uint32_t kMinVersion = 1;  // oldest version still read
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+    static constexpr uint32_t kTreeBackend = 1;  // flags: predict() scores with the trees
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t checksum;  // FNV-1a over the whole file with this field zero
+    uint64_t feature_count;
+    uint64_t optimizer_steps;
+
+    double base_learning_rate;  // the constructor's rate, used by update()
+    double learning_rate;
+    double regularization;
+    double momentum;
+    double beta1;
+    double beta2;
+    double epsilon;
+    int32_t max_depth;
+    int32_t min_samples_split;
+    uint32_t optimizer;
+    uint32_t flags;  // reserved (zero) before version 4
+    double shrinkage;
+    double tree_l2;
+    int32_t max_trees;
+    int32_t histogram_bins;
+    int32_t sample_buffer;
+    uint32_t tree_depth;
+    uint64_t tree_count;
+    double base_score;
+
+    uint64_t weights_offset;
+    uint64_t importance_offset;
+    uint64_t moments_offset;
+    uint64_t trees_offset;
+    uint64_t strings_offset;
+};
+
+// Read-only view of a model file mapped into memory. Opening checks the
+// checksum, then the header and the section bounds; only the header is
+// copied (and widened, for version 1), and predict() scores straight from
+// the mapping. Throws
+// std::runtime_error when the file cannot be mapped or is not a valid
+// model of this format version.
+class MappedModel {
+public:
+    explicit MappedModel(const std::string& path);
+    ~MappedModel();
+
+    MappedModel(const MappedModel&) = delete;
+    MappedModel& operator=(const MappedModel&) = delete;
+    MappedModel(MappedModel&& other) noexcept;
+    MappedModel& operator=(MappedModel&& other) noexcept;
+
+    uint32_t version() const { return header().version; }
+    // Whether the saved model scores with its trees (see ModelFileHeader)
+    bool uses_trees() const { return tree_backend_; }
+    size_t feature_count() const { return static_cast<size_t>(header().feature_count); }
+    std::string_view model_type() const { return string_at(0); }
+    std::string_view feature_name(size_t i) const { return string_at(i + 1); }
+
+    const double* weights() const { return section(header().weights_offset); }
+    double bias() const { return weights()[feature_count()]; }
+    const double* importance() const { return section(header().importance_offset); }
+    const double* first_moment() const { return section(header().moments_offset); }
+    const double* second_moment() const { return first_moment() + feature_count() + 1; }
+    uint64_t optimizer_steps() const { return header().optimizer_steps; }
+    double base_learning_rate() const { return header().base_learning_rate; }
+    MLHyperparameters hyperparameters() const;
+
+    // The saved tree ensemble, pointing into the mapping (no trees for
+    // linear models), and one split gain per internal node
+    TreeView trees() const;
+    const double* split_gain() const;
+
+    // Same score as MLModel::predict() for the saved model; `features`
+    // holds feature_count() values and is not validated
+    double predict(const double* features) const;
+
+private:
+    const ModelFileHeader& header() const { return header_; }
+    const double* section(uint64_t offset) const {
+        return reinterpret_cast<const double*>(static_cast<const char*>(data_) + offset);
+    }
+    std::string_view string_at(size_t index) const;
+    void unmap();
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    ModelFileHeader header_{};
+    bool tree_backend_ = false;
+};
+
+// Writes periodic model checkpoints on a background thread. The training
+// thread calls offer() after update() or train_batch(); when a checkpoint
+// is due the model is serialized into a reusable buffer and handed to the
+// writer, which writes it to a temporary file and renames it over `path`,
+// so readers only ever see complete files. offer() never waits: if the
+// writer is holding the hand-off at that moment the snapshot is skipped
+// and retried on the next call.
+class ModelCheckpointer {
+public:
+    ModelCheckpointer(std::string path, std::chrono::milliseconds interval);
+    // Writes the last offered snapshot, if still pending, then stops
+    ~ModelCheckpointer();
+
+    ModelCheckpointer(const ModelCheckpointer&) = delete;
+    ModelCheckpointer& operator=(const ModelCheckpointer&) = delete;
+
+    // Returns true when a snapshot of `model` was taken
+    bool offer(const MLModel& model);
+
+    // Blocks until every snapshot taken so far has been written
+    void flush();
+
+    size_t written() const { return written_.load(std::memory_order_relaxed); }
+    size_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+    size_t failures() const { return failures_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point next_due_;  // training thread only
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::vector<char> pending_;
+    std::vector<char> writing_;
+    bool has_pending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+
+    std::atomic<size_t> written_{0};
+    std::atomic<size_t> skipped_{0};
+    std::atomic<size_t> failures_{0};
+    std::thread thread_;
+};
+
+} // namespace sync
+} // namespace chronovyan
@@ -2,9 +2,11 @@
 
 #include "chronovyan/common_types.hpp"
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include "metric_collector.hpp"
+#include "chronovyan/mode_smoother.hpp"
 #include <memory>
 
 namespace chronovyan {
@@ -13,37 +15,100 @@ namespace chronovyan {
 class MetricCollector;
 struct SystemMetrics;
 
+/**
+ * @brief Why the ModeDecisionEngine chose a mode
+ *
+ * Decisions carry one of these codes instead of text; the text is only
+ * produced when it is asked for (see ModeDecision::reason_text()).
+ */
+enum class DecisionReason : uint8_t {
+    Custom,                 ///< Free-form reason supplied by the caller
+    Forced,                 ///< Mode forced through the testing hook
+    InvalidMetrics,         ///< A metric value is NaN or infinite
+    SourceTimeout,          ///< A metric source missed its deadline
+    SourceException,        ///< A metric source threw
+    CompleteSensorFailure,  ///< No metric source is available
+    PartialSensorFailure,   ///< Some metric sources are unavailable
+    StaleMetrics,           ///< Metric timestamps are too old
+    Recovered,              ///< A previously unavailable source is back
+    OutOfRange,             ///< A source reported a value outside [0, 100]
+    HighLoad,               ///< A resource is above the high-load threshold
+    LowLoad,                ///< All resources are at or below the low-load threshold
+    NormalLoad,             ///< Load is between the thresholds
+    Hysteresis,             ///< Previous mode held to avoid oscillation
+    RisingLoad              ///< Smoothed load is rising faster than SmoothingConfig::rise_rate
+};
+
+/**
+ * @brief Human-readable text for a decision reason
+ */
+const char* to_string(DecisionReason reason);
+
 /**
  * @brief Decision made by the ModeDecisionEngine
  */
 struct ModeDecision {
-    PerformanceMode mode;              ///< The recommended performance mode
-    std::string reason;               ///< The reason for the mode change
+    PerformanceMode mode{PerformanceMode::Balanced}; ///< The recommended performance mode
+    DecisionReason code{DecisionReason::Custom}; ///< Why this mode was chosen
+    std::string reason;               ///< Free-form reason; empty for engine decisions except forced ones
     std::string details;              ///< Additional details about the decision
+    MetricHandle source;              ///< Failing source for SourceTimeout/SourceException
     bool is_error_state{false};       ///< Whether this decision is due to an error state
     bool is_fallback_mode{false};     ///< Whether this is a fallback mode decision
     bool is_conservative{false};      ///< Whether this is a conservative decision
     bool requires_fallback{false};    ///< Whether this decision requires a fallback mode
+
+    /**
+     * @brief The reason as text: the free-form reason if set, otherwise
+     * the text for code (with the source name for source failures)
+     */
+    std::string reason_text() const;
+};
+
+/**
+ * @brief Numeric inputs to a decision, extracted from SystemMetrics
+ */
+struct DecisionInputs {
+    static constexpr uint8_t kCpu = 1u << 0;
+    static constexpr uint8_t kMemory = 1u << 1;
+    static constexpr uint8_t kGpu = 1u << 2;
+    static constexpr uint8_t kAll = kCpu | kMemory | kGpu;
+
+    double cpu = 0.0;
+    double memory = 0.0;
+    double gpu = 0.0;
+    uint8_t available = 0;            ///< Bit set of available sources
+    bool is_stale = false;
+    bool has_exception = false;
+    bool has_timeout = false;
+    bool has_out_of_range = false;
+    MetricHandle failed_source;
 };
 
 /**
  * @brief Engine responsible for making mode decisions based on system metrics
+ *
+ * Decisions are made by a fixed rule table: the inputs are reduced to a
+ * bit set of conditions, and the first rule whose conditions are all
+ * present determines the mode, reason code and flags. Outside the testing
+ * hooks a decision performs no allocation and no I/O; diagnostics go to
+ * LogSink at debug level.
+ *
+ * By default load decisions follow the latest sample, with a fixed hold
+ * before stepping to a less conservative mode. With smoothing enabled they
+ * come from a ModeSmoother fed with the peak utilisation instead; fault
+ * and data-quality rules are unaffected.
  */
 class ModeDecisionEngine {
 public:
     /**
      * Construct a new Mode Decision Engine
      */
-    ModeDecisionEngine() 
-        : last_decision_time_(std::chrono::system_clock::now()),
-          force_mode_for_testing_(false),
+    ModeDecisionEngine()
+        : force_mode_for_testing_(false),
           forced_mode_(PerformanceMode::Balanced),
-          forced_reason_("Mode forced for testing"),
-          had_previous_source_failure_(false),
-          cpu_was_unavailable_(false),
-          memory_was_unavailable_(false),
-          gpu_was_unavailable_(false) {}
-    
+          forced_reason_("Mode forced for testing") {}
+
     /**
      * Evaluate system metrics to determine the appropriate performance mode
      *
@@ -51,16 +116,48 @@ public:
      * @return ModeDecision The recommended mode and reason
      */
     ModeDecision evaluate_metrics(const SystemMetrics& metrics);
-    
+
     /**
      * Process system metrics and make a decision on the appropriate mode
-     * This is the primary interface for mode decision logic
+     * This is the primary interface for mode decision logic; unlike
+     * evaluate_metrics() it also records the metrics for getLastProcessedMetrics()
      *
      * @param metrics The current system metrics
      * @return ModeDecision The recommended mode and reason
      */
     ModeDecision makeDecision(const SystemMetrics& metrics);
-    
+
+    /**
+     * Decide on already extracted inputs
+     *
+     * @param inputs Numeric decision inputs
+     * @return ModeDecision The recommended mode and reason code
+     */
+    ModeDecision decide(const DecisionInputs& inputs);
+
+    /**
+     * Decide on already extracted inputs sampled at the given time; used to
+     * replay recorded traces
+     */
+    ModeDecision decide(const DecisionInputs& inputs, std::chrono::steady_clock::time_point now);
+
+    /**
+     * Route load decisions through a ModeSmoother with the given tuning
+     */
+    void enable_smoothing(const SmoothingConfig& config = SmoothingConfig());
+
+    /**
+     * Return to single-sample load decisions
+     */
+    void disable_smoothing() { smoothing_enabled_ = false; }
+
+    bool smoothing_enabled() const { return smoothing_enabled_; }
+
+    /**
+     * Extract the decision inputs from system metrics
+     */
+    static DecisionInputs inputs_from(const SystemMetrics& metrics);
+
     /**
      * For testing purposes only - force a specific mode
      *
@@ -74,70 +171,62 @@ public:
         force_mode_for_testing_ = enable;
         forced_reason_ = reason;
     }
-    
+
     /**
      * For testing purposes - force stable mode for rapid fluctuation test
      *
      * @param enable Whether to force stability
      */
     static void setForceStableForTesting(bool enable);
-    
+
     /**
      * Get the current value of force_stable_for_testing_
-     * 
+     *
      * @return Current value of force_stable_for_testing_
      */
     static bool getForceStableForTesting();
-    
+
     /**
      * @brief Gets the last decision made by the engine
      * @return The last ModeDecision
      */
     const ModeDecision& get_last_decision() const { return last_decision_; }
-    
+
     /**
      * @brief Gets the last metrics processed by the engine
      * @return The last metrics processed
      */
     const SystemMetrics& getLastProcessedMetrics() const { return last_processed_metrics_; }
-    
+
     /**
      * For testing purposes only - simulate source recovery for test
-     * 
+     *
      * @param had_previous_failure Whether any previous failure was detected
      * @param cpu_failure Whether CPU source should be considered as previously unavailable
      * @param memory_failure Whether memory source should be considered as previously unavailable
      */
     void setSourceRecoveryTestingState(bool had_previous_failure, bool cpu_failure, bool memory_failure) {
-        had_previous_source_failure_ = had_previous_failure;
-        cpu_was_unavailable_ = cpu_failure;
-        memory_was_unavailable_ = memory_failure;
-        gpu_was_unavailable_ = false;  // Always reset GPU for consistency
+        unavailable_ = 0;
+        if (had_previous_failure) {
+            unavailable_ |= cpu_failure ? DecisionInputs::kCpu : 0;
+            unavailable_ |= memory_failure ? DecisionInputs::kMemory : 0;
+        }
     }
 
-private:
-    // Helper methods
-    bool is_metric_stale(const std::chrono::system_clock::time_point& timestamp) const;
-    bool should_apply_hysteresis(const ModeDecision& new_decision) const;
-    ModeDecision make_conservative_decision(const std::string& reason, const std::string& details) const;
-    bool is_metric_valid(double value) const;
-    
     // Constants
     static constexpr double kHighLoadThreshold = 85.0;      ///< Threshold for high load (percentage)
     static constexpr double kLowLoadThreshold = 40.0;       ///< Threshold for low load (percentage)
-    static constexpr int kStaleMetricThreshold = 30;        ///< Threshold for stale metrics (seconds)
-    
+    static constexpr std::chrono::seconds kHysteresisHold{5}; ///< Minimum time before a load-based step to a less conservative mode
+
+private:
     // State
     ModeDecision last_decision_;
-    std::chrono::system_clock::time_point last_decision_time_;
+    std::chrono::steady_clock::time_point last_mode_change_;  ///< When the load-based mode last changed
     SystemMetrics last_processed_metrics_;  ///< The last metrics processed by the engine
-    
-    // Tracking for source recovery detection
-    bool had_previous_source_failure_;      ///< Whether any source was unavailable before
-    bool cpu_was_unavailable_;              ///< Whether CPU source was unavailable in the previous evaluation
-    bool memory_was_unavailable_;           ///< Whether memory source was unavailable in the previous evaluation
-    bool gpu_was_unavailable_;              ///< Whether GPU source was unavailable in the previous evaluation
-    
+    uint8_t unavailable_ = 0;               ///< Sources unavailable in the previous evaluation
+    bool smoothing_enabled_ = false;
+    ModeSmoother smoother_;
+
     // Testing hooks
     bool force_mode_for_testing_;
     PerformanceMode forced_mode_;
@@ -145,4 +234,4 @@ private:
     static bool force_stable_for_testing_;
 };
 
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <vector>
+#include "chronovyan/common_types.hpp"
+
+namespace chronovyan {
+
+class ModeDecisionEngine;
+
+// Load band of one mode: the mode is entered when the smoothed load crosses
+// enter and left when it crosses back over exit. The gap between the two is
+// the hysteresis band.
+struct ModeBand {
+    double enter = 0.0;
+    double exit = 0.0;
+};
+
+// Tuning of ModeSmoother. The defaults keep the engine's 85%/40% thresholds
+// as enter points.
+struct SmoothingConfig {
+    // EWMA time constants. The short average drives entering a more
+    // conservative mode, the long one confirms stepping down to HighFidelity.
+    std::chrono::milliseconds short_window{2000};
+    std::chrono::milliseconds long_window{30000};
+
+    // Lean: entered above enter, left below exit
+    ModeBand lean{85.0, 70.0};
+    // HighFidelity: entered when both averages are at or below enter, left above exit
+    ModeBand high_fidelity{40.0, 55.0};
+
+    // Minimum time in a mode before stepping to a less conservative one.
+    // Steps to a more conservative mode are never delayed.
+    std::chrono::milliseconds lean_dwell{5000};
+    std::chrono::milliseconds balanced_dwell{5000};
+
+    // Slope of the short average, in percent per second, that moves
+    // straight to Lean before the level reaches lean.enter. 0 disables it.
+    // A step of d points moves the short average at up to d / short_window,
+    // so this must stay above that for the largest step that should be
+    // ridden out (60 points at the defaults).
+    double rise_rate = 30.0;
+};
+
+// Result of one smoother update
+struct SmoothedMode {
+    PerformanceMode mode = PerformanceMode::Balanced;
+    bool held = false;            // a step down was delayed by the dwell time
+    bool rate_triggered = false;  // Lean was entered on slope, not level
+    double short_average = 0.0;
+    double long_average = 0.0;
+    double rate = 0.0;            // slope of the short average, percent per second
+};
+
+// Turns a stream of load samples into a mode with hysteresis. Each update
+// is O(1) and allocation-free: two time-weighted EWMAs (so irregular
+// sample spacing is handled), the slope of the short one, and the time the
+// current mode was entered.
+class ModeSmoother {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ModeSmoother(const SmoothingConfig& config = SmoothingConfig());
+
+    const SmoothingConfig& config() const { return config_; }
+
+    // load is the peak utilisation across resources, in percent
+    SmoothedMode update(Clock::time_point time, double load);
+
+    PerformanceMode mode() const { return mode_; }
+
+    // Forgets the averages; the next update starts afresh
+    void reset();
+
+private:
+    std::chrono::milliseconds dwell(PerformanceMode mode) const;
+
+    SmoothingConfig config_;
+    bool primed_ = false;
+    Clock::time_point last_time_;
+    Clock::time_point mode_since_;
+    double short_average_ = 0.0;
+    double long_average_ = 0.0;
+    double rate_ = 0.0;
+    PerformanceMode mode_ = PerformanceMode::Balanced;
+};
+
+// One recorded sample of a metric trace; time is relative to the start
+struct ReplaySample {
+    std::chrono::milliseconds time{0};
+    double cpu = 0.0;
+    double memory = 0.0;
+    double gpu = 0.0;
+};
+
+// Outcome of replaying a trace through a ModeDecisionEngine
+struct ReplayReport {
+    size_t samples = 0;
+    size_t switches = 0;
+    // Indexed by PerformanceMode; each sample's mode is held until the next sample
+    std::array<std::chrono::milliseconds, 3> time_in_mode{};
+
+    std::chrono::milliseconds duration() const;
+    double fraction(PerformanceMode mode) const;
+};
+
+// Reads a CSV trace of "time_ms,cpu,memory,gpu" lines. Blank lines, lines
+// starting with '#' and lines that do not parse (such as a header) are
+// skipped.
+std::vector<ReplaySample> read_replay_trace(std::istream& input);
+
+// Feeds the trace through engine.decide() at the recorded times and counts
+// mode switches and the time spent in each mode
+ReplayReport replay_trace(ModeDecisionEngine& engine, const std::vector<ReplaySample>& trace);
+
+} // namespace chronovyan
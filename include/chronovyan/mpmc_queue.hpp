@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace chronovyan {
+
+// Bounded multi-producer, multi-consumer queue (Vyukov). Every cell carries
+// a sequence number: a producer claims a position with a CAS on the enqueue
+// counter and publishes the cell by advancing its sequence; a consumer
+// claims it the same way on the dequeue counter and hands the cell back to
+// producers one lap ahead. Neither side locks, allocates or waits, and a
+// full or empty queue is reported rather than waited on.
+//
+// Cells are reused in place, so T's buffers (a string's, say) are kept
+// across laps when entries are assigned rather than constructed.
+template <typename T>
+class MpmcQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit MpmcQueue(size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1),
+          cells_(new Cell[mask_ + 1]) {
+        for (uint64_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    size_t capacity() const { return static_cast<size_t>(mask_ + 1); }
+
+    // Claims a cell and calls fill(T&) to write the entry in place.
+    // Returns false, without calling fill, when the queue is full.
+    template <typename Fill>
+    bool try_emplace(Fill fill) {
+        uint64_t position = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    fill(cell.value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_push(const T& value) {
+        return try_emplace([&](T& slot) { slot = value; });
+    }
+
+    bool try_push(T&& value) {
+        return try_emplace([&](T& slot) { slot = std::move(value); });
+    }
+
+    // Calls consume(T&) on the oldest entry and releases its cell. Returns
+    // false, without calling consume, when the queue is empty.
+    template <typename Consume>
+    bool try_consume(Consume consume) {
+        uint64_t position = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    consume(cell.value);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value) {
+        return try_consume([&](T& entry) { value = std::move(entry); });
+    }
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> sequence{0};
+        T value{};
+    };
+
+    static uint64_t round_up_pow2(size_t value) {
+        uint64_t capacity = 2;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    const uint64_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<uint64_t> enqueue_pos_{0};
+    alignas(64) std::atomic<uint64_t> dequeue_pos_{0};
+};
+
+} // namespace chronovyan
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include "chronovyan/mpmc_queue.hpp"
+
+namespace chronovyan {
+
+// Bounded history written by many threads and read by snapshot. push() is
+// lock-free: entries go into an MpmcQueue. Readers move queued entries into
+// a FIFO that keeps the most recent `retained` entries and copy that out.
+// The queue is drained by whichever reader holds the consumer lock, so a
+// producer that finds it full drains it too if the lock is free; only if a
+// reader is busy at that moment is the entry dropped (and counted).
+template <typename T>
+class MpscLog {
+public:
+    // capacity is rounded up to a power of two
+    MpscLog(size_t capacity, size_t retained)
+        : queue_(capacity),
+          retained_(retained) {}
+
+    MpscLog(const MpscLog&) = delete;
+    MpscLog& operator=(const MpscLog&) = delete;
+
+    bool push(T value) {
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (queue_.try_push(std::move(value))) {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(consumer_mutex_, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                break;
+            }
+            drain_locked();
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The retained entries, oldest first
+    std::deque<T> snapshot() const {
+        std::lock_guard<std::mutex> lock(consumer_mutex_);
+        drain_locked();
+        return history_;
+    }
+
+    // Calls fn(const T&) on each retained entry, oldest first, without copying
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        std::lock_guard<std::mutex> lock(consumer_mutex_);
+        drain_locked();
+        for (const T& entry : history_) {
+            fn(entry);
+        }
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void drain_locked() const {
+        while (queue_.try_consume([this](T& entry) { history_.push_back(std::move(entry)); })) {
+            if (history_.size() > retained_) {
+                history_.pop_front();
+            }
+        }
+    }
+
+    mutable MpmcQueue<T> queue_;
+    const size_t retained_;
+    std::atomic<uint64_t> dropped_{0};
+
+    // Consumer side; guarded by consumer_mutex_
+    mutable std::mutex consumer_mutex_;
+    mutable std::deque<T> history_;
+};
+
+} // namespace chronovyan
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "chronovyan/common_types.hpp"
+#include "chronovyan/notification_service.hpp"
+
+namespace chronovyan {
+
+// What a subscriber queue does with an event when it is full
+enum class OverflowPolicy {
+    DropNewest,  // reject the new event
+    DropOldest,  // evict the oldest queued event
+    // A mode change replaces any mode change still queued, full or not, so a
+    // slow subscriber skips intermediate modes and sees the latest one.
+    // Errors are never coalesced; when full they evict the oldest event.
+    Coalesce
+};
+
+struct SubscriberOptions {
+    size_t capacity = 64;                                // queued events per subscriber
+    OverflowPolicy policy = OverflowPolicy::DropOldest;
+    size_t max_batch = 32;                               // events handed over per wakeup
+};
+
+// Delivery counters of one subscriber. Latency runs from publication to the
+// return of the subscriber's callback.
+struct SubscriberStats {
+    uint64_t published = 0;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
+    uint64_t coalesced = 0;
+    uint64_t batches = 0;
+    std::chrono::nanoseconds mean_latency{0};
+    std::chrono::nanoseconds max_latency{0};
+};
+
+// Publish/subscribe bus for mode and error events. The bus is itself an
+// INotificationService, so a StateController can publish into it; any
+// number of INotificationService subscribers receive the events.
+//
+// Publishing only copies the event into each subscriber's bounded queue
+// and never waits on a subscriber. Each subscriber is served by its own
+// delivery thread, which takes queued events in batches and invokes the
+// callbacks, so a slow subscriber delays and drops only its own events.
+class NotificationBus : public INotificationService {
+public:
+    using SubscriptionId = uint64_t;
+
+    NotificationBus() = default;
+    ~NotificationBus() override;
+
+    NotificationBus(const NotificationBus&) = delete;
+    NotificationBus& operator=(const NotificationBus&) = delete;
+
+    SubscriptionId subscribe(std::shared_ptr<INotificationService> subscriber,
+                             const SubscriberOptions& options = SubscriberOptions());
+
+    // Stops delivery to the subscriber; queued events are discarded.
+    // Returns false for an unknown id.
+    bool unsubscribe(SubscriptionId id);
+
+    // INotificationService: publish to all subscribers
+    void notifyModeChange(PerformanceMode new_mode, const std::string& reason) override;
+    void notifyError(const std::string& error_message) override;
+
+    // Blocks until every event published so far has been delivered or dropped
+    void flush();
+
+    size_t subscriber_count() const;
+
+    // Throws std::out_of_range for an unknown id
+    SubscriberStats stats(SubscriptionId id) const;
+    // Totals over current subscribers
+    SubscriberStats totals() const;
+
+private:
+    struct Event {
+        bool is_error = false;
+        PerformanceMode mode = PerformanceMode::Balanced;
+        std::string text;
+        std::chrono::steady_clock::time_point published;
+    };
+
+    class Subscriber;
+
+    void publish(Event event);
+
+    mutable std::mutex mutex_;  // guards subscribers_ and next_id_
+    std::map<SubscriptionId, std::shared_ptr<Subscriber>> subscribers_;
+    SubscriptionId next_id_ = 1;
+};
+
+} // namespace chronovyan
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace chronovyan {
+namespace sync {
+
+// Incremental clustering over row-major pattern samples.
+// Mini-batch k-means keeps its centroids between calls, so each call refines
+// the previous model instead of starting over; DBSCAN is available for
+// irregular (anomaly-shaped) groups and reports noise separately.
+class PatternClusterer {
+public:
+    enum class Algorithm {
+        MiniBatchKMeans,
+        DBSCAN
+    };
+
+    struct Config {
+        Algorithm algorithm = Algorithm::MiniBatchKMeans;
+        size_t cluster_count = 3;       // k for k-means
+        size_t batch_size = 64;         // samples per mini-batch
+        size_t iterations = 8;          // mini-batches per cluster() call
+        double epsilon = 0.05;          // DBSCAN neighbourhood radius
+        size_t min_points = 4;          // DBSCAN core point threshold
+        unsigned int seed = 42;
+    };
+
+    static constexpr int kNoise = -1;
+
+    struct Result {
+        size_t dimensions{0};
+        std::vector<double> centroids;  // cluster count x dimensions, row-major
+        std::vector<int> labels;        // one per sample, kNoise for DBSCAN outliers
+        std::vector<size_t> sizes;      // samples per cluster
+        std::vector<double> quality;    // per-cluster separation score in [0, 1]
+        size_t noise_count{0};
+
+        size_t cluster_count() const { return sizes.size(); }
+    };
+
+    PatternClusterer();
+    explicit PatternClusterer(const Config& config);
+
+    void set_config(const Config& config);
+    Config get_config() const;
+
+    // Refine the k-means centroids with mini-batches drawn from the samples
+    void partial_fit(const double* samples, size_t sample_count, size_t dimensions);
+
+    // Refine the model and label every sample. Empty clusters are dropped.
+    Result cluster(const double* samples, size_t sample_count, size_t dimensions);
+
+    // Forget learned centroids
+    void reset();
+
+private:
+    void initialize_centroids(const double* samples, size_t sample_count, size_t dimensions);
+    void run_mini_batches(const double* samples, size_t sample_count, size_t dimensions);
+    size_t nearest_centroid(const double* sample, double* distance) const;
+    Result label_kmeans(const double* samples, size_t sample_count, size_t dimensions) const;
+    Result label_dbscan(const double* samples, size_t sample_count, size_t dimensions) const;
+    void score_clusters(Result& result, const double* samples, size_t sample_count) const;
+
+    mutable std::mutex mutex;
+    Config config;
+    std::mt19937 rng;
+
+    size_t dimensions{0};
+    std::vector<double> centroids;      // k x dimensions, row-major
+    std::vector<double> centroid_counts;
+    std::vector<size_t> batch_indices;  // reused scratch buffer
+};
+
+} // namespace sync
+} // namespace chronovyan
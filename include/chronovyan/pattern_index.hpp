@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chronovyan {
+namespace sync {
+
+// Nearest-neighbour library of fixed-dimension pattern signatures.
+// Signatures are stored as one contiguous row-major float matrix. Small
+// libraries are searched by a linear scan; once the library passes
+// ivf_threshold an inverted-file (IVF) index is trained so queries only scan
+// the lists closest to the query. The library is bounded: when full, the
+// oldest signature is overwritten.
+//
+// Training clusters a snapshot of the library without holding the index
+// lock, so searches and adds carry on against the previous index meanwhile;
+// the new index is swapped in when done, refiling the rows added since the
+// snapshot. The caller whose add() triggers a retrain (or rebuild()'s
+// caller) does the training work.
+class PatternIndex {
+public:
+    struct Config {
+        size_t capacity = size_t(1) << 20;  // maximum stored signatures
+        size_t ivf_threshold = 8192;        // switch from linear scan to IVF
+        size_t ivf_lists = 0;               // 0 = sqrt(size) at training time
+        size_t ivf_probes = 8;              // lists scanned per query
+        bool auto_rebuild = true;           // retrain whenever the size doubles
+    };
+
+    struct Neighbor {
+        size_t id{0};
+        std::string label;
+        double distance{0.0};    // Euclidean
+        double similarity{0.0};  // 1 / (1 + distance), in (0, 1]
+    };
+
+    explicit PatternIndex(size_t dimensions);
+    PatternIndex(size_t dimensions, const Config& config);
+
+    // Store a signature and return its id. Values beyond `dimensions` are
+    // ignored and missing ones are zero.
+    size_t add(const std::vector<double>& signature, const std::string& label);
+
+    // Up to k nearest stored signatures, closest first
+    std::vector<Neighbor> search(const std::vector<double>& query, size_t k) const;
+
+    // Retrain the IVF index now rather than waiting for auto_rebuild; waits
+    // for a training already in progress first
+    void rebuild();
+
+    void clear();
+
+    size_t size() const;
+    size_t dimensions() const { return dims; }
+    bool is_indexed() const;
+
+private:
+    using Candidate = std::pair<float, uint32_t>;  // squared distance, slot
+
+    void store_row(size_t slot, const std::vector<double>& signature);
+    uint32_t intern_label(const std::string& label);
+    struct InvertedList {
+        std::vector<float> rows;      // copies of member rows, contiguous for scanning
+        std::vector<uint32_t> slots;
+    };
+
+    // Trains on a snapshot with `lock` (on mutex) released, then installs
+    // the result; returns with `lock` held
+    void train_ivf(std::unique_lock<std::mutex>& lock);
+    size_t nearest_list(const float* row) const;
+    static size_t nearest_centroid(const float* row, const std::vector<float>& centroids, size_t dims);
+    void insert_into_list(uint32_t slot);
+    void remove_from_list(uint32_t slot);
+    static void offer(std::vector<Candidate>& best, size_t k, float distance, uint32_t slot);
+
+    const size_t dims;
+    const Config config;
+    mutable std::mutex mutex;
+
+    std::vector<float> rows;          // slots x dims
+    std::vector<uint32_t> row_labels; // label id per slot
+    std::vector<std::string> label_names;
+    std::unordered_map<std::string, uint32_t> label_ids;
+    size_t count{0};
+    size_t next_slot{0};
+
+    // IVF state; empty until trained
+    std::vector<float> list_centroids;  // lists x dims
+    std::vector<InvertedList> lists;
+    std::vector<uint32_t> slot_list;     // list containing each slot
+    std::vector<uint32_t> slot_position; // position of each slot inside its list
+    size_t trained_size{0};
+
+    // Training in progress: slots stored since its snapshot, refiled when
+    // the new index is installed
+    bool training{false};
+    std::vector<uint32_t> pending_slots;
+    std::condition_variable training_done;
+    uint64_t clear_generation{0};  // bumped by clear(); a training that spans one is discarded
+};
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "chronovyan/metric_source.hpp"
+
+namespace chronovyan {
+
+// A procfs/sysfs file held open for repeated sampling. Each read() preads
+// from offset 0 until EOF into a buffer sized at construction, so sampling
+// never allocates and never re-resolves the path.
+class ProcFile {
+public:
+    static constexpr size_t kDefaultBufferSize = 16384;
+
+    ProcFile() = default;
+    explicit ProcFile(const std::string& path, size_t buffer_size = kDefaultBufferSize);
+    ~ProcFile();
+
+    ProcFile(const ProcFile&) = delete;
+    ProcFile& operator=(const ProcFile&) = delete;
+    ProcFile(ProcFile&& other) noexcept;
+    ProcFile& operator=(ProcFile&& other) noexcept;
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // Reads the file from the start; returns the number of bytes kept, or
+    // -1 on error. The contents are NUL-terminated and stay valid until the
+    // next read(). Files larger than the buffer are cut after their last
+    // complete line, so a truncated line is never parsed.
+    long read();
+
+    const char* data() const { return buffer_.empty() ? "" : buffer_.data(); }
+
+private:
+    int fd_ = -1;
+    std::vector<char> buffer_;
+};
+
+// System CPU utilisation from /proc/stat, as the busy share of jiffies
+// since the previous sample (0-100). The first sample covers the time
+// since boot. Per-core figures come from the same read.
+class CpuUsageSource : public IMetricSource {
+public:
+    static constexpr size_t kMaxCores = 256;
+    // A cpuN line is at most ~220 bytes (ten 20-digit counters); the
+    // headroom covers the aggregate line and the intr/softirq lines after
+    // the per-core ones
+    static constexpr size_t kStatBufferSize = kMaxCores * 256 + 16384;
+
+    explicit CpuUsageSource(const std::string& stat_path = "/proc/stat");
+
+    double getValue() const override;
+    bool isAvailable() const override;
+    std::chrono::system_clock::time_point getLastUpdateTime() const override;
+
+    // Per-core usage from the most recent getValue()
+    size_t core_count() const;
+    double core_usage(size_t core) const;
+
+private:
+    struct Jiffies {
+        uint64_t busy = 0;
+        uint64_t total = 0;
+    };
+
+    bool sample() const;
+
+    mutable std::mutex mutex_;
+    mutable ProcFile stat_;
+    mutable bool available_ = false;
+    mutable std::chrono::system_clock::time_point last_update_{};
+    mutable Jiffies previous_total_;
+    mutable double total_usage_ = 0.0;
+    mutable size_t core_count_ = 0;
+    mutable std::array<Jiffies, kMaxCores> previous_cores_{};
+    mutable std::array<double, kMaxCores> core_usage_{};
+};
+
+// Memory utilisation (0-100). Inside a cgroup v2 hierarchy with a limit,
+// this is memory.current against memory.max; otherwise, or when the
+// cgroup is unlimited, it is (MemTotal - MemAvailable) / MemTotal from
+// /proc/meminfo.
+class MemoryUsageSource : public IMetricSource {
+public:
+    struct Paths {
+        std::string meminfo = "/proc/meminfo";
+        // cgroup v2 directory holding memory.current/memory.max. Empty means
+        // resolve the calling process's cgroup from /proc/self/cgroup.
+        std::string cgroup_dir;
+    };
+
+    MemoryUsageSource();
+    explicit MemoryUsageSource(const Paths& paths);
+
+    double getValue() const override;
+    bool isAvailable() const override;
+    std::chrono::system_clock::time_point getLastUpdateTime() const override;
+
+    // True when the value is taken from a limited cgroup
+    bool is_cgroup_limited() const;
+    uint64_t used_bytes() const;
+    uint64_t limit_bytes() const;
+
+private:
+    bool sample() const;
+    bool sample_cgroup() const;
+    bool sample_meminfo() const;
+
+    mutable std::mutex mutex_;
+    mutable ProcFile meminfo_;
+    mutable ProcFile cgroup_current_;
+    mutable ProcFile cgroup_max_;
+    mutable bool available_ = false;
+    mutable bool cgroup_limited_ = false;
+    mutable std::chrono::system_clock::time_point last_update_{};
+    mutable uint64_t used_bytes_ = 0;
+    mutable uint64_t limit_bytes_ = 0;
+};
+
+// Resource usage of a single process (default: the calling process).
+// Cpu is the share of total machine capacity consumed since the previous
+// sample (0 on the first sample, which sets the baseline); Rss is resident
+// memory as a share of physical memory.
+class ProcessUsageSource : public IMetricSource {
+public:
+    enum class Metric {
+        Cpu,
+        Rss
+    };
+
+    // pid 0 means the calling process
+    explicit ProcessUsageSource(Metric metric, int pid = 0);
+
+    double getValue() const override;
+    bool isAvailable() const override;
+    std::chrono::system_clock::time_point getLastUpdateTime() const override;
+
+    uint64_t resident_bytes() const;
+
+private:
+    bool sample() const;
+
+    Metric metric_;
+    long ticks_per_second_;
+    long page_size_;
+    long cpu_count_;
+    uint64_t physical_bytes_;
+
+    mutable std::mutex mutex_;
+    mutable ProcFile stat_;
+    mutable ProcFile statm_;
+    mutable bool available_ = false;
+    mutable std::chrono::system_clock::time_point last_update_{};
+    mutable std::chrono::steady_clock::time_point last_sample_{};
+    mutable uint64_t previous_ticks_ = 0;
+    mutable bool has_previous_ = false;
+    mutable double value_ = 0.0;
+    mutable uint64_t resident_bytes_ = 0;
+};
+
+} // namespace chronovyan
@@ -1,8 +1,9 @@
 #pragma once
 
-#include <vector>
-#include <functional>
+#include <array>
+#include <cstddef>
 #include "chronovyan/optimization_metrics.hpp"
+#include "chronovyan/windowed_stats.hpp"
 
 namespace chronovyan {
 namespace sync {
@@ -21,21 +22,28 @@ public:
     OptimizationMetrics get_performance_metrics() const;
     
 private:
+    // Fields tracked over the window, in WindowedStats column order
+    template <double OptimizationMetrics::*... Fields>
+    struct FieldSelector {
+        static constexpr size_t count = sizeof...(Fields);
+        static std::array<double, count> extract(const OptimizationMetrics& m) {
+            return {{(m.*Fields)...}};
+        }
+    };
+    using Tracked = FieldSelector<&OptimizationMetrics::sync_efficiency,
+                                  &OptimizationMetrics::stability,
+                                  &OptimizationMetrics::error_rate>;
+    enum Column : size_t { kEfficiency, kStability, kErrorRate };
+
     void update_thresholds();
     void calculate_performance_metrics();
-    double calculate_moving_average(
-        std::function<double(const OptimizationMetrics&)> metric_selector
-    ) const;
-    double calculate_weighted_moving_average(
-        std::function<double(const OptimizationMetrics&)> metric_selector
-    ) const;
     void calculate_trend_indicators();
     
     double current_threshold;
     double min_threshold;
     double max_threshold;
     size_t window_size;
-    std::vector<OptimizationMetrics> metrics_history;
+    WindowedStats<Tracked::count> window;
     OptimizationMetrics performance_metrics;
 };
 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace chronovyan {
+
+// Bounded append-only log of trivially copyable records, written by any
+// number of threads and read without locks.
+//
+// Records get consecutive indices from a single fetch_add and live in
+// fixed-size segments that are allocated on first use, so memory grows
+// with the log up to `capacity` records and is never moved or reallocated.
+// Past capacity the oldest slots are reused. Every slot carries a sequence
+// word (a seqlock): 2i+1 while record i is being written, 2i+2 once it is
+// complete. read() copies the slot and checks the sequence before and
+// after, so a reader never blocks a writer and never returns a record that
+// is incomplete or was overwritten while it was being copied. The payload
+// is stored as relaxed atomic words, which keeps concurrent copying free
+// of data races.
+//
+// A writer only waits if the slot it needs still holds a record whose
+// writer has not finished, i.e. when a writer stalls for a whole lap of
+// the ring.
+template <typename T>
+class SegmentedRing {
+    static_assert(std::is_trivially_copyable<T>::value, "records are copied as raw words");
+    static_assert(sizeof(T) % sizeof(uint64_t) == 0, "records must be a whole number of words");
+
+public:
+    static constexpr size_t kWords = sizeof(T) / sizeof(uint64_t);
+
+    // Bytes of ring storage per record
+    static constexpr size_t kSlotBytes = (kWords + 1) * sizeof(uint64_t);
+
+    explicit SegmentedRing(size_t capacity, size_t segment_size = 256)
+        : capacity_(std::max<size_t>(capacity, 1)),
+          segment_size_(std::min(std::max<size_t>(segment_size, 1), capacity_)),
+          segment_count_((capacity_ + segment_size_ - 1) / segment_size_),
+          slots_(segment_count_ * segment_size_),
+          segments_(new std::atomic<Slot*>[segment_count_]) {
+        for (size_t s = 0; s < segment_count_; ++s) {
+            segments_[s].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~SegmentedRing() {
+        for (size_t s = 0; s < segment_count_; ++s) {
+            delete[] segments_[s].load(std::memory_order_relaxed);
+        }
+    }
+
+    SegmentedRing(const SegmentedRing&) = delete;
+    SegmentedRing& operator=(const SegmentedRing&) = delete;
+
+    // Appends a record and returns its index
+    uint64_t push(const T& record) {
+        const uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = claim_slot(index);
+
+        // Claim the slot once the record it held a lap ago is complete
+        const uint64_t previous = index >= slots_ ? 2 * (index - slots_) + 2 : 0;
+        uint64_t expected = previous;
+        while (!slot.sequence.compare_exchange_weak(expected, 2 * index + 1, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+            expected = previous;
+            std::this_thread::yield();
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t words[kWords];
+        std::memcpy(words, &record, sizeof(T));
+        for (size_t w = 0; w < kWords; ++w) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        return index;
+    }
+
+    // Copies record `index` into `out`. Returns false if the record is not
+    // complete yet, has been overwritten or lies before the retained range.
+    bool read(uint64_t index, T& out) const {
+        if (index < begin()) {
+            return false;
+        }
+        const Slot* slot = find_slot(index);
+        if (!slot) {
+            return false;
+        }
+        const uint64_t complete = 2 * index + 2;
+        if (slot->sequence.load(std::memory_order_acquire) != complete) {
+            return false;
+        }
+        uint64_t words[kWords];
+        for (size_t w = 0; w < kWords; ++w) {
+            words[w] = slot->words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != complete) {
+            return false;
+        }
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    // One past the newest index handed out (its record may still be in flight)
+    uint64_t end() const { return next_.load(std::memory_order_acquire); }
+
+    // Oldest index still retained
+    uint64_t begin() const {
+        uint64_t last = end();
+        uint64_t lap = last > capacity_ ? last - capacity_ : 0;
+        return std::max(lap, floor_.load(std::memory_order_acquire));
+    }
+
+    // Drops every record before `index` (used for age retention and clear)
+    void discard_before(uint64_t index) {
+        uint64_t current = floor_.load(std::memory_order_relaxed);
+        while (current < index &&
+               !floor_.compare_exchange_weak(current, index, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // Bytes held by the segments allocated so far
+    size_t allocated_bytes() const {
+        size_t bytes = 0;
+        for (size_t s = 0; s < segment_count_; ++s) {
+            if (segments_[s].load(std::memory_order_relaxed)) {
+                bytes += segment_size_ * sizeof(Slot);
+            }
+        }
+        return bytes;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> words[kWords] = {};
+    };
+
+    // The slot for `index`, allocating its segment on first use
+    Slot& claim_slot(uint64_t index) {
+        const size_t position = static_cast<size_t>(index % slots_);
+        std::atomic<Slot*>& segment = segments_[position / segment_size_];
+        Slot* slots = segment.load(std::memory_order_acquire);
+        if (!slots) {
+            Slot* fresh = new Slot[segment_size_];
+            if (segment.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+                slots = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        return slots[position % segment_size_];
+    }
+
+    const Slot* find_slot(uint64_t index) const {
+        const size_t position = static_cast<size_t>(index % slots_);
+        const Slot* slots = segments_[position / segment_size_].load(std::memory_order_acquire);
+        return slots ? &slots[position % segment_size_] : nullptr;
+    }
+
+    const size_t capacity_;       // records retained
+    const size_t segment_size_;
+    const size_t segment_count_;
+    const size_t slots_;          // physical slots, a whole number of segments
+    std::unique_ptr<std::atomic<Slot*>[]> segments_;
+    alignas(64) std::atomic<uint64_t> next_{0};
+    alignas(64) std::atomic<uint64_t> floor_{0};
+};
+
+} // namespace chronovyan
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "chronovyan/mpmc_queue.hpp"
+#include "chronovyan/stability.hpp"
+#include "chronovyan/windowed_stats.hpp"
+
+namespace chronovyan {
+namespace stability {
+
+// Streaming IStabilityAnalyzer.
+//
+// Each event's value is one sample of its metric type. Every type keeps a
+// sliding window of its last `window` samples, and its stability is
+// 1 / (1 + cv), where cv = stddev / |mean| over the window (1 for a
+// constant signal; a zero-mean signal that varies scores 0). A type with
+// no samples scores 1. overall_stability is the mean of the temporal,
+// resource, performance and error scores; Custom samples are windowed and
+// reported through stability() and callbacks, but not folded into
+// StabilityMetrics.
+//
+// add_event() never locks: events go into an MpmcQueue. Queued events
+// are applied to the windows, O(1) each, by whichever thread next calls
+// analyze_stability(), stability() or process(). A producer that finds
+// the queue full applies it itself if no other thread is doing so;
+// otherwise the event is dropped and counted.
+//
+// Scores are checked against the thresholds as each event is applied.
+// Callbacks fire only when a type's score moves into a different band
+// (below critical, critical, warning, good, excellent), with an event
+// holding the new score and a description of the crossing. Crossings are
+// delivered in the order they happened, outside the analyzer's lock, by
+// one thread at a time: a thread that finds another delivering leaves its
+// crossings to that thread. Callbacks may query the analyzer but must not
+// add callbacks.
+class StabilityAnalyzer : public IStabilityAnalyzer {
+public:
+    static constexpr size_t kMetricTypes = 5;
+
+    // queue_capacity is rounded up to a power of two
+    explicit StabilityAnalyzer(size_t window = 256, size_t queue_capacity = 4096);
+
+    StabilityAnalyzer(const StabilityAnalyzer&) = delete;
+    StabilityAnalyzer& operator=(const StabilityAnalyzer&) = delete;
+
+    StabilityMetrics analyze_stability() const override;
+    void add_event(const StabilityEvent& event) override;
+    // Re-evaluates every type against the new thresholds
+    void set_thresholds(const StabilityThresholds& thresholds) override;
+    StabilityThresholds get_thresholds() const override;
+    // Empties the queue and the windows; every score returns to 1
+    void clear_events() override;
+
+    void add_callback(StabilityCallback callback);
+
+    double stability(StabilityMetricType type) const;
+
+    // Applies the queued events now and returns how many there were
+    size_t process();
+
+    // Events rejected because the queue was full
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // 0 below critical, 1 critical, 2 warning, 3 good, 4 excellent
+    static int band(double score, const StabilityThresholds& thresholds);
+
+private:
+    using Window = sync::WindowedStats<2>;  // value, value squared
+
+    size_t drain_locked() const;
+    void evaluate_locked(size_t type, std::chrono::system_clock::time_point timestamp) const;
+    double score_locked(size_t type) const;
+    // Called with consumer_mutex_ held; returns with it released
+    void deliver(std::unique_lock<std::mutex>& lock) const;
+
+    mutable MpmcQueue<StabilityEvent> queue_;
+    std::atomic<uint64_t> dropped_{0};
+
+    // Consumer side; guarded by consumer_mutex_
+    mutable std::mutex consumer_mutex_;
+    const size_t window_;
+    mutable std::vector<Window> windows_;
+    mutable std::array<int, kMetricTypes> bands_;
+    StabilityThresholds thresholds_;
+    mutable std::vector<StabilityEvent> crossings_;  // not yet delivered, oldest first
+    mutable bool delivering_ = false;
+
+    mutable std::mutex callbacks_mutex_;
+    std::vector<StabilityCallback> callbacks_;
+};
+
+} // namespace stability
+} // namespace chronovyan
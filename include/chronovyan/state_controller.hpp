@@ -3,126 +3,168 @@
 #include "chronovyan/common_types.hpp"
 #include "chronovyan/notification_service.hpp"
 #include "chronovyan/mode_decision_engine.hpp"
+#include "chronovyan/mpsc_log.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
+#include <mutex>
 #include <string>
-#include <vector>
 #include <memory>
 #include <utility>
 
 namespace chronovyan {
 
+/**
+ * @brief Published state of a StateController
+ *
+ * Every change of mode or flags increments version, so a reader can tell
+ * whether anything changed since it last looked.
+ */
+struct ModeSnapshot {
+    PerformanceMode mode = PerformanceMode::Balanced;
+    bool is_fallback_mode = false;
+    bool is_error_state = false;
+    bool is_cooling_down = false;  ///< A cooldown was started by the last switch
+    uint64_t version = 0;
+};
+
+/**
+ * @brief Per-instance StateController settings
+ */
+struct StateControllerConfig {
+    std::chrono::milliseconds cooldown{1000};  ///< Minimum time between mode switches
+    size_t history_entries = 50;               ///< Decisions and transitions kept
+};
+
 /**
  * @brief Controller for managing system performance mode transitions.
- * 
+ *
  * This class handles transitions between different performance modes
  * based on decisions from the ModeDecisionEngine. It enforces cooldown periods,
  * validates transitions, and manages error and fallback states.
+ *
+ * The current mode and flags are published as a single atomic word, so
+ * getCurrentMode() and getModeSnapshot() are lock-free and may be called
+ * from any number of threads. updateMode() may also be called from several
+ * threads; updates are applied one at a time and notifications are sent
+ * after the new state is published, outside any lock. Decision and
+ * transition history are kept in bounded MPSC logs.
  */
 class StateController {
 public:
     // Constants
-    static constexpr std::chrono::milliseconds kModeSwitchCooldown{1000};  // Minimum time between mode switches
-    static constexpr size_t kMaxHistoryEntries = 50;                // Maximum number of history entries to keep
-    static constexpr size_t kMaxTransitionEntries = 50;             // Maximum number of transition entries to keep
+    static constexpr std::chrono::milliseconds kModeSwitchCooldown{1000};  // Default minimum time between mode switches
+    static constexpr size_t kMaxHistoryEntries = 50;                // Default number of history entries to keep
+    static constexpr size_t kMaxTransitionEntries = 50;             // Default number of transition entries to keep
+
+    using Transition = std::pair<PerformanceMode, std::string>;
 
     // Constructor and main methods
     StateController(
         std::shared_ptr<ModeDecisionEngine> decision_engine,
-        std::shared_ptr<INotificationService> notification_service);
+        std::shared_ptr<INotificationService> notification_service,
+        const StateControllerConfig& config = StateControllerConfig());
     void updateMode(const ModeDecision& decision);
-    
-    // State accessors
+
+    // State accessors; lock-free
     PerformanceMode getCurrentMode() const;
+    ModeSnapshot getModeSnapshot() const;
+    uint64_t getModeVersion() const { return getModeSnapshot().version; }
     bool isInFallbackMode() const;
     bool isInErrorState() const;
     bool isInCooldown() const;
-    
+
     // Cooldown-related methods
     std::chrono::milliseconds timeUntilNextSwitch() const;
-    std::chrono::system_clock::time_point getCooldownEndTime() const {
-        return last_update_time_ + kModeSwitchCooldown;
-    }
-    
+    std::chrono::steady_clock::time_point getCooldownEndTime() const;
+
     /**
      * Bypass cooldown for the next mode update call.
      * This flag will be reset after updateMode is called.
-     * 
+     *
      * @param bypass Whether to bypass cooldown for the next update
      */
     void setBypassCooldownForNextUpdate(bool bypass);
-    
+
     // Error-related methods
     std::string getErrorDetails() const;
-    
-    // History and transitions accessors
-    const std::vector<ModeDecision>& getModeHistory() const;
-    const std::vector<std::pair<PerformanceMode, std::string>>& getTransitionHistory() const;
-    
-    // Static methods for testing
-    static void setForceCooldownForTesting(bool force_cooldown);
-    static bool getForceCooldownForTesting();
-    static void setDirectModeSetForTesting(bool enable);
-    
+
+    // History and transitions, oldest first; each call returns a snapshot
+    std::deque<ModeDecision> getModeHistory() const;
+    std::deque<Transition> getTransitionHistory() const;
+
+    // Testing hooks; they only affect this instance
+    void setForceCooldownForTesting(bool force_cooldown);
+    bool getForceCooldownForTesting() const;
+    // Let the next update bypass normal checks for direct mode setting
+    void setDirectModeSetForTesting(bool enable);
+
     // Additional testing method to directly set the mode
-    void setCurrentModeForTesting(PerformanceMode mode) {
-        current_mode_ = mode;
-    }
+    void setCurrentModeForTesting(PerformanceMode mode);
 
     // Additional method to manipulate mode history for testing
     void addModeDecisionForTesting(const ModeDecision& decision) {
-        mode_decision_history_.push_back(decision);
+        decision_history_.push(decision);
     }
 
     // Additional method to manipulate transitions for testing
     void addTransitionForTesting(PerformanceMode from_mode, const std::string& reason) {
-        mode_transition_history_.emplace_back(from_mode, reason);
+        transition_history_.push(Transition(from_mode, reason));
     }
 
-    // Additional test methods for direct access to history
-    std::vector<ModeDecision>& getModeHistoryForTesting() { return mode_decision_history_; }
-    std::vector<std::pair<PerformanceMode, std::string>>& getTransitionHistoryForTesting() { return mode_transition_history_; }
+private:
+    // Mutable state; written under update_mutex_ and published by publish()
+    struct State {
+        PerformanceMode mode = PerformanceMode::Balanced;
+        bool is_fallback_mode = false;
+        bool is_error_state = false;
+        bool is_cooling_down = false;
+    };
 
-    // Public static variables for testing
-    static bool is_direct_mode_set_; ///< Flag to bypass normal checks for direct mode setting
+    // Notifications collected while applying an update, sent afterwards
+    struct Notifications {
+        bool error = false;
+        std::string error_message;
+        bool mode_change = false;
+        PerformanceMode mode = PerformanceMode::Balanced;
+        std::string reason;
+    };
 
-private:
-    // State
-    PerformanceMode current_mode_ = PerformanceMode::Balanced;
-    bool is_in_fallback_mode_ = false;
-    bool is_in_error_state_ = false;
-    bool is_in_cooldown_ = false;
-    std::string error_details_;
-    
-    // Flag to bypass cooldown for a single update
-    bool bypass_cooldown_for_mode_switch_ = false;
-    
-    // Time of the last mode change (for cooldown)
-    std::chrono::system_clock::time_point last_update_time_;
-    
-    // History of mode changes
-    std::vector<ModeDecision> mode_decision_history_;
-    
-    // History of mode transitions
-    std::vector<std::pair<PerformanceMode, std::string>> mode_transition_history_;
-    
-    // Notification service for callbacks
+    StateControllerConfig config_;
     std::shared_ptr<INotificationService> notification_service_;
-    
+
+    // Published state: mode, flags and version packed in one word
+    std::atomic<uint64_t> published_{0};
+    // steady_clock time of the last mode switch, in nanoseconds
+    std::atomic<int64_t> last_switch_nanos_{0};
+
+    std::mutex update_mutex_;
+    State state_;  // guarded by update_mutex_
+
+    mutable std::mutex error_mutex_;
+    std::string error_details_;  // guarded by error_mutex_
+
+    // Per-instance testing flags
+    std::atomic<bool> bypass_cooldown_for_mode_switch_{false};
+    std::atomic<bool> force_cooldown_for_testing_{false};
+    std::atomic<bool> is_direct_mode_set_{false};
+
+    MpscLog<ModeDecision> decision_history_;
+    MpscLog<Transition> transition_history_;
+
     // Helper methods
+    void apply(ModeDecision& decision, bool bypass_cooldown, Notifications& out);
+    void publish();
+    void switchMode(PerformanceMode from_mode, PerformanceMode mode, const std::string& reason,
+                    bool bypass_cooldown, Notifications& out);
     bool canSwitchMode() const;
-    void recordModeChange(const ModeDecision& decision, PerformanceMode old_mode, std::chrono::system_clock::time_point timestamp, bool bypass_cooldown = false);
-    void handleErrorState(const ModeDecision& decision, std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now(), bool bypass_cooldown = false);
-    void handleFallbackMode(const ModeDecision& decision, std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now(), bool bypass_cooldown = false);
-    
-    // Static members for testing
-    static bool force_cooldown_for_testing_;
-    
-    // Member variables for tracking error states
-    std::chrono::system_clock::time_point partial_sensor_failure_time_;
+    void handleErrorState(const ModeDecision& decision, bool bypass_cooldown, Notifications& out);
+    void handleFallbackMode(const ModeDecision& decision, bool bypass_cooldown, Notifications& out);
+    void setErrorDetails(const std::string& details);
 
     // Helper method to validate performance mode values
     bool isValidPerformanceMode(PerformanceMode mode) const;
 };
 
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <chrono>
@@ -15,6 +16,11 @@
 #include <cmath>
 #include <thread>
 #include "optimization_metrics.hpp"
+#include "pattern_clusterer.hpp"
+#include "pattern_index.hpp"
+#include "anomaly_detector.hpp"
+#include "forecaster.hpp"
+#include "execution_profile.hpp"
 
 namespace chronovyan {
 namespace sync {
@@ -91,12 +97,36 @@ public:
         coherence_threshold = std::clamp(threshold, 0.0, 1.0); 
     }
     
+    // Resizing keeps the newest history samples
     void set_history_size(size_t size) {
         if (size < 1) throw std::invalid_argument("History size must be at least 1");
-        history_size = size;
+        {
+            std::lock_guard<std::mutex> lock(sync_mutex);
+            history_size = size;
+        }
         resize_histories();
     }
     
+    // Minimum time between ticks run through synchronize_if_due()
+    void set_tick_interval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        tick_interval = interval;
+    }
+    
+    std::chrono::milliseconds get_tick_interval() const {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        return tick_interval;
+    }
+    
+    // Runs synchronize_temporal_flows() unless the previous due tick was less
+    // than the tick interval ago; returns whether it ran. Drivers that poll
+    // this get the tick rate of the active execution profile.
+    bool synchronize_if_due();
+    
+    // Applies the synchronizer knobs of an execution profile (tick interval
+    // and history size); safe while another thread is ticking
+    void apply_profile(const ExecutionProfile& profile);
+    
     void set_recovery_timeout(std::chrono::milliseconds timeout) {
         std::lock_guard<std::mutex> lock(sync_mutex);
         recovery_timeout = timeout;
@@ -153,12 +183,17 @@ public:
     
     // Advanced performance monitoring
     struct PerformanceMetrics {
-        std::chrono::microseconds last_sync_duration;
+        static constexpr size_t kRecentDurationWindow = 10;
+        
+        std::chrono::microseconds last_sync_duration{0};
         size_t total_sync_operations{0};
         size_t error_count{0};
-        double average_sync_time{0.0};
+        double average_sync_time{0.0};  // microseconds, averaged over recent_durations
         std::chrono::system_clock::time_point last_error_time;
-        std::vector<std::chrono::microseconds> recent_durations;
+        // Fixed-size ring of the most recent tick durations; the oldest entry is
+        // overwritten once recent_duration_count reaches kRecentDurationWindow.
+        std::array<std::chrono::duration<double, std::micro>, kRecentDurationWindow> recent_durations{};
+        size_t recent_duration_count{0};
         double sync_success_rate{1.0};
         double response_time{0.0};
         double resource_efficiency{1.0};
@@ -183,6 +218,19 @@ public:
     
     void set_error_handler(std::function<void(const ErrorInfo&)> handler);
     
+    struct AnomalyDetection;
+    
+    // Immutable table of user callbacks. Setters publish a new table (copy-on-write),
+    // so a sync tick only has to copy one shared_ptr instead of every std::function.
+    struct CallbackTable {
+        std::function<void(double)> sync_callback;
+        std::function<void(const std::exception&)> error_callback;
+        std::function<void(const ErrorInfo&)> error_handler;
+        std::function<void()> custom_recovery_strategy;
+        std::function<void(bool)> recovery_callback;
+        std::function<void(const AnomalyDetection&)> anomaly_callback;
+    };
+    
     // Advanced recovery strategies
     enum class RecoveryStrategy {
         Automatic,
@@ -195,18 +243,22 @@ public:
         recovery_strategy = strategy;
         
         // If setting to Custom but no custom strategy is set, initialize with a default one
-        if (strategy == RecoveryStrategy::Custom && !custom_recovery_strategy) {
-            custom_recovery_strategy = [this]() {
-                initialize_sync_points();
-                initialize_sync_patterns();
-                initialize_sync_metrics();
-            };
+        if (strategy == RecoveryStrategy::Custom && !callbacks->custom_recovery_strategy) {
+            publish_callbacks([this](CallbackTable& table) {
+                table.custom_recovery_strategy = [this]() {
+                    initialize_sync_points();
+                    initialize_sync_patterns();
+                    initialize_sync_metrics();
+                };
+            });
         }
     }
     
     void set_custom_recovery_strategy(std::function<void()> strategy) {
         std::lock_guard<std::mutex> lock(sync_mutex);
-        custom_recovery_strategy = std::move(strategy);
+        publish_callbacks([&](CallbackTable& table) {
+            table.custom_recovery_strategy = std::move(strategy);
+        });
     }
     
     // Advanced synchronization control
@@ -225,17 +277,23 @@ public:
     // Advanced monitoring
     void set_sync_callback(std::function<void(double)> callback) {
         std::lock_guard<std::mutex> lock(sync_mutex);
-        sync_callback = std::move(callback);
+        publish_callbacks([&](CallbackTable& table) {
+            table.sync_callback = std::move(callback);
+        });
     }
     
     void set_error_callback(std::function<void(const std::exception&)> callback) {
         std::lock_guard<std::mutex> lock(sync_mutex);
-        error_callback = std::move(callback);
+        publish_callbacks([&](CallbackTable& table) {
+            table.error_callback = std::move(callback);
+        });
     }
     
     void set_recovery_callback(std::function<void(bool)> callback) {
         std::lock_guard<std::mutex> lock(sync_mutex);
-        recovery_callback = std::move(callback);
+        publish_callbacks([&](CallbackTable& table) {
+            table.recovery_callback = std::move(callback);
+        });
     }
     
     // Existing methods...
@@ -265,6 +323,9 @@ public:
         std::vector<double> contributing_factors;
     };
     
+    // Probability that any overall metric falls below its threshold on the next
+    // tick, from the metric forecasters; contributing_factors holds the
+    // per-metric probabilities (sync, stability, coherence).
     ErrorPrediction predict_next_error() const;
     
     struct StateAnalysis {
@@ -313,8 +374,20 @@ public:
         std::chrono::system_clock::time_point match_time;
     };
     
+    // Best match from the pattern library; match_confidence holds the
+    // similarities of the top candidates, best first
     PatternMatch find_similar_pattern(const std::vector<double>& pattern) const;
     
+    // Up to k library matches for the pattern, best first. The library holds
+    // reference patterns plus every recorded sync-pattern snapshot; patterns
+    // are only compared with library entries of the same length. Snapshots
+    // are PATTERN_DIMENSIONS (10) values, primary then secondary then
+    // tertiary, so only a pattern of that length can match the history; a
+    // shorter or longer one matches reference patterns of its length only.
+    std::vector<PatternMatch> find_similar_patterns(const std::vector<double>& pattern, size_t k) const;
+    
+    void add_reference_pattern(const std::string& label, const std::vector<double>& pattern);
+    
     struct ErrorAnalysis {
         double severity_score{0.0};
         std::string root_cause;
@@ -326,13 +399,29 @@ public:
     
     struct PatternPrediction {
         std::vector<double> predicted_values;
+        std::vector<double> lower_bounds;   // prediction interval per value
+        std::vector<double> upper_bounds;
         double confidence{0.0};
         std::chrono::system_clock::time_point prediction_time;
         std::vector<std::string> influencing_factors;
     };
     
+    // One-step forecast of the pattern snapshot, always PATTERN_DIMENSIONS
+    // values; before the first tick it is the live snapshot itself with zero
+    // confidence. confidence is the mean probability, under the forecast
+    // error model, that each value lands within
+    // ForecastConfig::pattern_tolerance of the prediction.
     PatternPrediction predict_next_pattern() const;
     
+    struct ForecastConfig {
+        SeriesForecaster::Config model;
+        double interval_z = 1.96;         // normal quantile for the prediction intervals
+        double pattern_tolerance = 0.05;
+    };
+    
+    // Replaces the forecasting models and discards their history
+    void set_forecast_config(const ForecastConfig& config);
+    
     struct AdaptiveOptimizationConfig {
         double learning_rate{0.01};
         double exploration_rate{0.1};
@@ -360,8 +449,21 @@ public:
         std::chrono::system_clock::time_point detection_time;
     };
     
+    // Scores the current metrics against the streaming baseline. Per-factor
+    // scores appear in contributing_factors as "factor:score", highest first.
     AnomalyDetection detect_anomalies() const;
     
+    // Invoked from the sync tick, outside sync_mutex, when the metric stream turns anomalous
+    void set_anomaly_callback(std::function<void(const AnomalyDetection&)> callback) {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        publish_callbacks([&](CallbackTable& table) {
+            table.anomaly_callback = std::move(callback);
+        });
+    }
+    
+    // Replaces the detector configuration and discards the learned baseline
+    void set_anomaly_detection_config(const StreamingAnomalyDetector::Config& config);
+    
     struct PerformanceProfile {
         std::vector<double> cpu_usage_history;
         std::vector<double> memory_usage_history;
@@ -403,6 +505,15 @@ public:
     
     void configure_pattern_recognition(const PatternRecognitionConfig& config);
     
+    // Algorithm and parameters used by cluster_patterns()
+    void set_clustering_config(const PatternClusterer::Config& config) {
+        pattern_clusterer.set_config(config);
+    }
+    
+    PatternClusterer::Config get_clustering_config() const {
+        return pattern_clusterer.get_config();
+    }
+    
     struct ErrorPredictionConfig {
         bool enable_error_prediction = true;
         size_t prediction_window = 100;
@@ -439,31 +550,91 @@ private:
     
     std::unique_ptr<SyncState> last_good_state;
     PerformanceMetrics performance_metrics;
-    
-    std::function<void(const ErrorInfo&)> error_handler;
-    std::function<void(bool)> recovery_callback;
+    size_t recent_duration_head{0};
+    double recent_duration_sum{0.0};
     
     double sync_threshold = 0.8;
     double stability_threshold = 0.8;
     double coherence_threshold = 0.8;
     size_t history_size = 10;
+    std::chrono::milliseconds tick_interval{ExecutionProfile().sync_tick_interval};
+    std::chrono::steady_clock::time_point last_due_tick;
+    
+    // Published callback table; replaced wholesale under sync_mutex, never mutated in place.
+    // Readers copy the pointer under sync_mutex too, so every access is serialized.
+    std::shared_ptr<const CallbackTable> callbacks{std::make_shared<CallbackTable>()};
+    
+    // Must be called with sync_mutex held
+    template <typename Mutator>
+    void publish_callbacks(Mutator&& mutate) {
+        auto table = std::make_shared<CallbackTable>(*callbacks);
+        mutate(*table);
+        callbacks = std::move(table);
+    }
     
-    std::function<void()> custom_recovery_strategy;
-    std::function<void(double)> sync_callback;
-    std::function<void(const std::exception&)> error_callback;
+    // Preallocated error objects so the sync tick never builds exception strings
+    const std::runtime_error forced_error{"Forced error state for testing"};
+    const std::runtime_error verification_error{
+        "Synchronization verification failed - metrics below threshold"};
+    ErrorInfo verification_error_info{"Synchronization issue detected", {}, 0.0, 0.0, 0.0};
     
     // Flag to indicate a forced error state
     bool forced_error_state{false};
     
     // Pattern analysis
+    static constexpr size_t MAX_PATTERN_HISTORY = 1000;
+    static constexpr size_t PATTERN_DIMENSIONS = 10;  // primary + secondary + tertiary
+    
+    // Fixed-capacity ring of pattern snapshots, one row per sync tick
     struct PatternHistory {
-        std::deque<std::vector<double>> recent_patterns;
-        std::unordered_map<std::string, size_t> pattern_frequencies;
+        std::vector<double> samples;  // MAX_PATTERN_HISTORY x PATTERN_DIMENSIONS, row-major
+        size_t next{0};
+        size_t count{0};
+        size_t total{0};              // snapshots ever recorded
+        mutable size_t indexed{0};    // snapshots already added to the library
         std::chrono::system_clock::time_point last_analysis;
     };
     
     PatternHistory pattern_history;
-    static constexpr size_t MAX_PATTERN_HISTORY = 1000;
+    PatternRecognitionConfig pattern_config;
+    mutable PatternClusterer pattern_clusterer;
+    
+    // Streaming anomaly detection over the per-tick metrics; guarded by sync_mutex
+    static constexpr size_t ANOMALY_FACTORS = 5;
+    StreamingAnomalyDetector anomaly_detector{anomaly_factor_names()};
+    
+    static std::vector<std::string> anomaly_factor_names();
+    std::array<double, ANOMALY_FACTORS> anomaly_sample() const;
+    AnomalyDetection describe_anomaly(const StreamingAnomalyDetector::Score& score,
+                                      const double* factor_scores) const;
+    
+    // Forecasting over the per-tick history; guarded by sync_mutex
+    static constexpr size_t FORECAST_METRICS = 3;  // sync, stability, coherence
+    static constexpr size_t MAX_ERROR_HORIZON = 256;
+    ForecastConfig forecast_config;
+    ErrorPredictionConfig error_prediction_config;
+    std::array<SeriesForecaster, PATTERN_DIMENSIONS> pattern_forecasters;
+    std::array<SeriesForecaster, FORECAST_METRICS> metric_forecasters;
+    std::array<double, FORECAST_METRICS> observed_metrics{};  // metrics as the last tick left them
+    std::chrono::steady_clock::time_point last_tick_time;
+    double tick_interval_seconds{0.0};
+    
+    void update_forecasters();
+    void remember_observed_metrics();
+    
+    // Similarity libraries keyed by pattern length; entries are never removed
+    mutable std::mutex library_mutex;
+    mutable std::unordered_map<size_t, std::unique_ptr<PatternIndex>> pattern_libraries;
+    
+    PatternIndex& pattern_library(size_t dimensions) const;
+    void index_pattern_history() const;
+    
+    // Writes the live pattern as PATTERN_DIMENSIONS values, zero-padded
+    void write_pattern_snapshot(double* row) const;
+    void record_pattern_snapshot();
+    
+    // Copies the newest `window` snapshots, oldest first; call with sync_mutex held
+    size_t copy_recent_patterns(size_t window, std::vector<double>& out) const;
     
     PatternAnalysis perform_pattern_analysis() const;
     
@@ -554,7 +725,7 @@ private:
     bool validate_timeouts(const SyncConfig& config) const;
     bool validate_performance_settings(const SyncConfig& config) const;
     
-    void update_performance_metrics(std::chrono::microseconds duration);
+    void update_performance_metrics(std::chrono::nanoseconds duration);
     void initialize_sync_points();
     void initialize_sync_patterns();
     void initialize_sync_metrics();
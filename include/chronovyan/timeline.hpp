@@ -1,46 +1,75 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
 #include <functional>
 #include <map>
+#include <mutex>
 #include "chronovyan/quantum.hpp"
+#include "chronovyan/segmented_ring.hpp"
 
 namespace chronovyan {
 namespace sync {
 
-// Timeline represents a sequence of temporal events
+// Bounds on what a timeline or the event log keeps. Records beyond
+// max_count, older than max_age (by their own timestamp) or past max_bytes
+// of ring storage are dropped, oldest first. Zero disables the age and
+// byte limits.
+struct TimelineRetention {
+    size_t max_count = 4096;
+    size_t max_bytes = 0;
+    std::chrono::milliseconds max_age{0};
+};
+
+// Timeline represents a sequence of temporal events.
+// Any number of threads may add sync points concurrently; all readers are
+// lock-free and never block writers. A sync point that is still being
+// written when a reader looks is not returned yet.
 class Timeline {
 public:
-    Timeline() = default;
+    Timeline() : Timeline(TimelineRetention{}) {}
+    explicit Timeline(const TimelineRetention& retention);
     ~Timeline() = default;
-    
+
     // Prevent copying
     Timeline(const Timeline&) = delete;
     Timeline& operator=(const Timeline&) = delete;
-    
+
     // Add a synchronization point to the timeline
     void add_sync_point(const SyncPoint& point);
-    
-    // Get the current sync point
+
+    // Get the current sync point (a default SyncPoint if there is none)
     SyncPoint get_current_sync_point() const;
-    
-    // Get the most recent sync points, up to 'count'
+
+    // Get the most recent sync points, up to 'count', oldest first
     std::vector<SyncPoint> get_recent_sync_points(size_t count) const;
-    
+
     // Clear all sync points
     void clear();
-    
+
     // Get the number of sync points in the timeline
     size_t size() const;
-    
+
     // Check if the timeline is empty
     bool empty() const;
-    
+
+    const TimelineRetention& retention() const { return retention_; }
+
 private:
-    std::vector<SyncPoint> sync_points_;
+    struct StoredPoint {
+        int64_t timestamp;  // system_clock ticks
+        double accuracy;
+        double precision;
+        double recall;
+        int64_t sequence_id;
+    };
+
+    TimelineRetention retention_;
+    SegmentedRing<StoredPoint> sync_points_;
 };
 
 // Timeline event types
@@ -59,9 +88,9 @@ struct TimelineEvent {
     std::string description;
     int sequence_id;
     double importance;
-    
+
     TimelineEvent() = default;
-    TimelineEvent(TimelineEventType t, 
+    TimelineEvent(TimelineEventType t,
                  std::chrono::system_clock::time_point ts,
                  const std::string& desc,
                  int seq = 0,
@@ -69,35 +98,79 @@ struct TimelineEvent {
         : type(t), timestamp(ts), description(desc), sequence_id(seq), importance(imp) {}
 };
 
-// Timeline manager - manages multiple timelines
+// Timeline manager - manages multiple timelines.
+// The global event log takes events from any number of threads without
+// locking and is read lock-free. Descriptions are interned: each distinct
+// text is stored once, and logged events refer to it by id. At most
+// max_descriptions distinct texts are kept; events with a new text after
+// that are logged with kDescriptionOverflow as their description.
 class TimelineManager {
 public:
-    TimelineManager() = default;
-    ~TimelineManager() = default;
-    
+    static constexpr const char* kDescriptionOverflow = "(description table full)";
+
+    explicit TimelineManager(TimelineRetention timeline_retention = {},
+                             TimelineRetention event_retention = {},
+                             size_t max_descriptions = 4096);
+    ~TimelineManager();
+
     // Prevent copying
     TimelineManager(const TimelineManager&) = delete;
     TimelineManager& operator=(const TimelineManager&) = delete;
-    
-    // Get a timeline by name (creates it if it doesn't exist)
+
+    // Get a timeline by name (creates it if it doesn't exist). The
+    // reference stays valid until that timeline is removed.
     Timeline& get_timeline(const std::string& name);
-    
+
     // Check if a timeline exists
     bool has_timeline(const std::string& name) const;
-    
+
     // Remove a timeline
     void remove_timeline(const std::string& name);
-    
+
     // Add an event to the global event log
     void add_event(const TimelineEvent& event);
-    
-    // Get recent events from the global log, up to 'count'
+
+    // Get recent events from the global log, up to 'count', oldest first
     std::vector<TimelineEvent> get_recent_events(size_t count) const;
-    
+
+    // Distinct descriptions interned so far
+    size_t description_count() const;
+
 private:
-    std::map<std::string, Timeline> timelines_;
-    std::vector<TimelineEvent> event_log_;
+    struct StoredEvent {
+        int64_t timestamp;  // system_clock ticks
+        uint32_t type;
+        uint32_t description;
+        int64_t sequence_id;
+        double importance;
+    };
+
+    struct Description {
+        std::string text;
+        uint64_t hash;
+        uint32_t id;
+    };
+
+    static constexpr uint32_t kOverflowId = UINT32_MAX;
+
+    uint32_t intern(const std::string& text);
+
+    TimelineRetention timeline_retention_;
+    TimelineRetention event_retention_;
+
+    mutable std::mutex timelines_mutex_;
+    std::map<std::string, std::unique_ptr<Timeline>> timelines_;
+
+    SegmentedRing<StoredEvent> event_log_;
+
+    // Open-addressing table of interned descriptions (never removed) and
+    // the same entries by id
+    const size_t max_descriptions_;
+    const size_t intern_mask_;
+    std::unique_ptr<std::atomic<const Description*>[]> intern_table_;
+    std::unique_ptr<std::atomic<const Description*>[]> descriptions_;
+    std::atomic<uint32_t> next_description_{0};
 };
 
 } // namespace sync
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
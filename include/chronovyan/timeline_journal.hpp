@@ -0,0 +1,216 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "chronovyan/timeline.hpp"
+
+namespace chronovyan {
+namespace sync {
+
+// On-disk layout of a TimelineJournal. The journal is a directory of
+// segment files named by the index of their first record
+// (<16 hex digits>.cvtl). Each segment is preallocated to
+// segment_bytes and holds
+//
+//   JournalSegmentHeader
+//   frames          JournalFrameHeader, payload, zero padding to 8 bytes
+//   zeros           unused space up to segment_bytes
+//
+// Record indices run on without gaps from one segment to the next. A
+// frame's checksum covers its header (with the checksum field zero) and
+// its padded payload, so a frame that was only partly written before a
+// crash is recognised and dropped on recovery. When a segment fills up it
+// is sealed: its sparse time index is written next to it (same name,
+// .cvtx), and recovery reads that instead of scanning the segment.
+// Files are written in native byte order.
+struct JournalSegmentHeader {
+    static constexpr char kMagic[8] = {'C', 'V', 'T', 'L', 'S', 'E', 'G', 'M'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t first_index;
+    uint64_t reserved;
+};
+
+enum class JournalRecordKind : uint16_t {
+    SyncPoint = 1,
+    Event = 2
+};
+
+struct JournalFrameHeader {
+    uint32_t payload_bytes;  // before padding
+    uint16_t kind;           // JournalRecordKind
+    uint16_t reserved;
+    uint64_t index;
+    int64_t timestamp;       // system_clock ticks
+    uint64_t checksum;
+};
+
+// Sidecar of a sealed segment: this header, then entry_count
+// JournalIndexEntry. Entry k marks the frame at `offset`; every record
+// before it in the segment has a timestamp <= prefix_max, so a seek can
+// start at the last entry whose prefix_max is below the target even when
+// timestamps are not monotonic.
+struct JournalIndexEntry {
+    int64_t prefix_max;
+    uint64_t offset;
+};
+
+struct JournalIndexHeader {
+    static constexpr char kMagic[8] = {'C', 'V', 'T', 'L', 'I', 'N', 'D', 'X'};
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t first_index;
+    uint64_t record_count;
+    uint64_t end_offset;
+    int64_t min_timestamp;
+    int64_t max_timestamp;
+    uint64_t entry_count;
+    uint64_t checksum;  // FNV-1a over the header (checksum zero) and entries
+};
+
+struct TimelineJournalOptions {
+    size_t segment_bytes = 16u << 20;
+    // Extra time the writer waits to gather appends into one fsync. With
+    // zero, appends arriving during an fsync still share the next one.
+    std::chrono::microseconds commit_delay{0};
+    size_t index_stride = 256;          // records between sparse index entries
+    size_t max_pending_bytes = 4u << 20;  // appends wait beyond this backlog
+};
+
+// What opening the journal found
+struct JournalRecovery {
+    size_t segments = 0;
+    size_t scanned_segments = 0;  // read frame by frame rather than via .cvtx
+    uint64_t records = 0;
+    bool torn_tail = false;       // an incomplete last frame was dropped
+    std::chrono::microseconds elapsed{0};
+};
+
+// One replayed record. The string views point into the mapped segment and
+// are valid only during the visitor call.
+struct JournalEntry {
+    JournalRecordKind kind;
+    uint64_t index;
+    std::chrono::system_clock::time_point timestamp;
+    std::string_view text;  // timeline name for sync points, else the description
+    SyncPoint point;        // sync points only
+    TimelineEventType event_type = TimelineEventType::SyncPoint;  // events only
+    int sequence_id = 0;
+    double importance = 0.0;
+};
+
+// Append-only, crash-safe log of sync points and timeline events.
+//
+// append() only copies the encoded record into a buffer and returns its
+// index; a background thread writes the buffer to the active segment and
+// makes it durable with one fdatasync per batch (group commit). Callers
+// that need durability wait for their index with wait_durable(). Replay
+// maps the segments read-only and uses the sparse index to start near the
+// requested time. Opening an existing directory recovers it: sealed
+// segments are taken from their index files, the active one is scanned and
+// any torn frame at its end is discarded and zeroed before appending
+// resumes. Throws std::runtime_error on I/O failure or on a corrupt sealed
+// segment; once a write has failed, every later append or wait rethrows.
+class TimelineJournal {
+public:
+    using Visitor = std::function<bool(const JournalEntry&)>;  // false stops replay
+
+    explicit TimelineJournal(std::string directory, TimelineJournalOptions options = {});
+    // Writes out every pending record
+    ~TimelineJournal();
+
+    TimelineJournal(const TimelineJournal&) = delete;
+    TimelineJournal& operator=(const TimelineJournal&) = delete;
+
+    uint64_t append(const std::string& timeline, const SyncPoint& point);
+    uint64_t append(const TimelineEvent& event);
+
+    // Blocks until record `index` is on disk
+    void wait_durable(uint64_t index);
+    // Blocks until everything appended so far is on disk
+    void flush();
+
+    uint64_t next_index() const;
+    // Records below this index are on disk
+    uint64_t durable_index() const;
+
+    // Visits the durable records with timestamp >= from in index order and
+    // returns how many were visited
+    size_t replay(const Visitor& visit,
+                  std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min()) const;
+
+    // Replays into `manager`: sync points into their named timelines,
+    // events into the event log
+    size_t restore(TimelineManager& manager,
+                   std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min()) const;
+
+    const JournalRecovery& recovery() const { return recovery_; }
+    const std::string& directory() const { return directory_; }
+    size_t segment_count() const;
+
+private:
+    struct Segment {
+        std::string path;
+        uint64_t first_index = 0;
+        uint64_t record_count = 0;
+        uint64_t end_offset = 0;
+        int64_t min_timestamp = INT64_MAX;
+        int64_t max_timestamp = INT64_MIN;
+        std::vector<JournalIndexEntry> index;
+    };
+
+    uint64_t enqueue(JournalRecordKind kind, int64_t timestamp, const void* payload, size_t payload_bytes,
+                     std::string_view text);
+    void recover();
+    bool scan_segment(Segment& segment, bool active);
+    bool load_index(Segment& segment) const;
+    void write_index(const Segment& segment) const;
+    void open_segment(uint64_t first_index);
+    void seal_active();
+    void write_batch(const std::vector<char>& batch);
+    void note_frame(const JournalFrameHeader& frame, uint64_t offset);
+    void publish();
+    void check_failed() const;
+    void run();
+
+    std::string directory_;
+    TimelineJournalOptions options_;
+    JournalRecovery recovery_;
+
+    // Writer thread only (and the constructor before it starts)
+    int fd_ = -1;
+    Segment active_;
+    std::vector<char> writing_;
+
+    // Published segment metadata, covering durable records only
+    mutable std::mutex segments_mutex_;
+    std::vector<Segment> segments_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable durable_;
+    std::condition_variable drained_;
+    std::vector<char> pending_;
+    uint64_t next_index_ = 0;
+    uint64_t durable_index_ = 0;
+    std::string error_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+
+namespace chronovyan {
+namespace sync {
+
+// Dense-vector kernels shared by the pattern analysis and ML components.
+// Each loop keeps four independent accumulators so the compiler can map it
+// onto SSE/AVX/NEON lanes at -O2/-O3 without intrinsics or -ffast-math.
+
+template <typename T>
+inline T squared_distance(const T* a, const T* b, size_t n) {
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        T d0 = a[i] - b[i];
+        T d1 = a[i + 1] - b[i + 1];
+        T d2 = a[i + 2] - b[i + 2];
+        T d3 = a[i + 3] - b[i + 3];
+        s0 += d0 * d0;
+        s1 += d1 * d1;
+        s2 += d2 * d2;
+        s3 += d3 * d3;
+    }
+    for (; i < n; ++i) {
+        T d = a[i] - b[i];
+        s0 += d * d;
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+template <typename T>
+inline T dot_product(const T* a, const T* b, size_t n) {
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+// y += a * x
+template <typename T>
+inline void axpy(T a, const T* x, T* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        y[i] += a * x[i];
+    }
+}
+
+// x - x is NaN exactly for NaN and +-Inf, so one branch-free, vectorizable
+// pass checks a whole buffer
+template <typename T>
+inline bool all_finite(const T* x, size_t n) {
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i] - x[i];
+        s1 += x[i + 1] - x[i + 1];
+        s2 += x[i + 2] - x[i + 2];
+        s3 += x[i + 3] - x[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += x[i] - x[i];
+    }
+    return (s0 + s1) + (s2 + s3) == 0;
+}
+
+} // namespace sync
+} // namespace chronovyan
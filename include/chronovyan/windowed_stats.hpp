@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace chronovyan {
+namespace sync {
+
+// Sliding window over the last `capacity` samples of N fields with O(1)
+// updates and queries. Per field it maintains:
+//   mean()          plain average, from a compensated running sum
+//   weighted_mean() average with weight decay^age (age 0 = newest)
+//   trend()         exponential moving average seeded with the oldest
+//                   sample and folded towards the newest with factor alpha
+// Evicted samples are subtracted out of each aggregate, so the results
+// match a full rescan of the window; only the samples themselves are kept.
+template <size_t N>
+class WindowedStats {
+public:
+    using Sample = std::array<double, N>;
+
+    explicit WindowedStats(size_t capacity, double decay = std::exp(-0.1), double alpha = 0.3)
+        : capacity_(capacity),
+          decay_(decay),
+          alpha_(alpha),
+          decay_pow_(std::pow(decay, static_cast<double>(capacity))),
+          keep_pow_(std::pow(1.0 - alpha, static_cast<double>(capacity))),
+          samples_(capacity) {}
+
+    void push(const Sample& sample) {
+        if (capacity_ == 0) {
+            return;
+        }
+        if (size_ < capacity_) {
+            for (size_t f = 0; f < N; ++f) {
+                double x = sample[f];
+                add(f, x);
+                weighted_[f] = decay_ * weighted_[f] + x;
+                trend_[f] = size_ == 0 ? x : (1.0 - alpha_) * trend_[f] + alpha_ * x;
+            }
+            weight_total_ = decay_ * weight_total_ + 1.0;
+            samples_[(head_ + size_) % capacity_] = sample;
+            ++size_;
+            return;
+        }
+
+        // Full: the oldest sample leaves and the next one becomes the seed
+        const Sample& oldest = samples_[head_];
+        const Sample& seed = capacity_ == 1 ? sample : samples_[(head_ + 1) % capacity_];
+        for (size_t f = 0; f < N; ++f) {
+            double x = sample[f];
+            add(f, x);
+            add(f, -oldest[f]);
+            weighted_[f] = decay_ * weighted_[f] + x - decay_pow_ * oldest[f];
+            trend_[f] = (1.0 - alpha_) * trend_[f] + alpha_ * x + keep_pow_ * (seed[f] - oldest[f]);
+        }
+        samples_[head_] = sample;
+        head_ = (head_ + 1) % capacity_;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    double mean(size_t field) const {
+        return size_ == 0 ? 0.0 : (sum_[field] + compensation_[field]) / static_cast<double>(size_);
+    }
+
+    double weighted_mean(size_t field) const {
+        return size_ == 0 ? 0.0 : weighted_[field] / weight_total_;
+    }
+
+    double trend(size_t field) const {
+        return trend_[field];
+    }
+
+    // i = 0 is the oldest sample in the window
+    const Sample& at(size_t i) const {
+        return samples_[(head_ + i) % capacity_];
+    }
+
+private:
+    // Neumaier summation keeps the running sum exact to rounding over any
+    // number of additions and evictions
+    void add(size_t field, double x) {
+        double& sum = sum_[field];
+        double t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) {
+            compensation_[field] += (sum - t) + x;
+        } else {
+            compensation_[field] += (x - t) + sum;
+        }
+        sum = t;
+    }
+
+    size_t capacity_;
+    double decay_;
+    double alpha_;
+    double decay_pow_;  // decay^capacity: weight an evicted sample would have had
+    double keep_pow_;   // (1 - alpha)^capacity
+    std::vector<Sample> samples_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    std::array<double, N> sum_{};
+    std::array<double, N> compensation_{};
+    std::array<double, N> weighted_{};
+    double weight_total_ = 0.0;
+    std::array<double, N> trend_{};
+};
+
+} // namespace sync
+} // namespace chronovyan
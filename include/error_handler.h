@@ -78,6 +78,11 @@ public:
      */
     void clearErrors();
 
+    /**
+     * @brief Clear the errors reported after the first `count`, keeping earlier ones
+     */
+    void clearErrorsAfter(size_t count);
+
     /**
      * @brief Get a singleton instance of the error handler
      */
@@ -4,6 +4,10 @@
 #include "ast_nodes.h"
 #include "environment.h"
 #include "temporal_runtime.h"
+#include "chronovyan/execution_profile.hpp"
+#include "chronovyan/loop_profiler.hpp"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <stack>
 
@@ -27,6 +31,28 @@ public:
      */
     Value interpret(const ProgramNode& program);
     
+    /**
+     * @brief Run a program, letting its errors propagate
+     *
+     * Like interpret(), but a failing program throws to the caller instead
+     * of being reported to the ErrorHandler, which is shared by the whole
+     * process and not thread-safe. This is what an embedding host wants
+     * for per-request errors.
+     * @param program The program to run
+     * @return The result of the last expression, or nil
+     */
+    Value run(const ProgramNode& program);
+    
+    /**
+     * @brief Return the interpreter to its just-constructed state
+     *
+     * Drops the variables of earlier programs and gives the program that
+     * runs next a fresh temporal runtime (resources and paradox level),
+     * keeping the execution profile and loop profiler. Lets one interpreter
+     * serve a sequence of independent runs.
+     */
+    void reset();
+    
     /**
      * @brief Execute a single statement
      * @param stmt The statement to execute
@@ -55,6 +81,36 @@ public:
      */
     std::shared_ptr<Environment> getCurrentEnvironment() const;
     
+    /**
+     * @brief Apply the interpreter knobs of an execution profile
+     *
+     * Safe to call from another thread while a program runs; the new
+     * settings take effect from the next operation that uses them. ECHO
+     * histories longer than the new capacity shrink on their next
+     * assignment.
+     */
+    void setExecutionProfile(const ExecutionProfile& profile);
+    
+    /**
+     * @brief Number of binary operations with a REB operand seen by paradox bookkeeping
+     */
+    uint64_t getParadoxOperationCount() const;
+    
+    /**
+     * @brief Record loop stability metrics into a profiler
+     *
+     * Every FOR_CHRONON, WHILE_EVENT and TEMPORAL_ECHO_LOOP run while the
+     * profiler is attached and enabled records into the site of its
+     * statement. Pass nullptr to detach. Without CHRONOVYAN_LOOP_PROFILING
+     * the profiler is kept but never receives samples.
+     */
+    void setLoopProfiler(std::shared_ptr<LoopProfiler> profiler);
+    
+    /**
+     * @brief The attached loop profiler, or nullptr
+     */
+    std::shared_ptr<LoopProfiler> getLoopProfiler() const;
+    
 private:
     std::shared_ptr<Environment> m_globals;
     std::shared_ptr<Environment> m_environment;
@@ -67,6 +123,26 @@ private:
     bool m_isBreaking = false;
     bool m_isContinuing = false;
     
+    // Execution profile knobs; atomic so a profile switch can land
+    // mid-program, and held by pointer so the interpreter stays assignable
+    struct ProfileKnobs {
+        std::atomic<size_t> echoHistoryCapacity{ExecutionProfile().echo_history_capacity};
+        std::atomic<size_t> weaverOutcomes{ExecutionProfile().weaver_outcomes};
+        std::atomic<bool> paradoxTracking{ExecutionProfile().paradox_tracking};
+    };
+    std::shared_ptr<ProfileKnobs> m_profile = std::make_shared<ProfileKnobs>();
+    
+    // Paradox bookkeeping
+    uint64_t m_paradoxOperations = 0;
+    int m_unresolvedParadoxes = 0;  // CONF/REB mixes not yet raised as paradox level
+    
+    // Loop profiling
+    std::shared_ptr<LoopProfiler> m_loopProfiler;
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopIterationSample m_loopTotals;  // running totals, diffed around each loop iteration
+    uint64_t m_echoLoopDepth = 0;      // TEMPORAL_ECHO_LOOPs currently executing
+#endif
+    
     // Visitor methods for expressions
     void visitLiteralExpr(const LiteralExprNode& expr) override;
     void visitVariableExpr(const VariableExprNode& expr) override;
@@ -102,6 +178,10 @@ private:
     void executeBranchTimeline(const TemporalOpStmtNode& stmt);
     void executeMergeTimelines(const TemporalOpStmtNode& stmt);
     void executeTemporalEchoLoop(const TemporalOpStmtNode& stmt);
+    int64_t evaluateLoopCount(const TemporalOpStmtNode& stmt);
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopSite* profiledLoopSite(const TemporalOpStmtNode& stmt, LoopKind kind);
+#endif
     
     // Native function definitions
     void defineNativeFunctions();
@@ -0,0 +1,167 @@
+#ifndef CHRONOVYAN_SCRIPT_HOST_H
+#define CHRONOVYAN_SCRIPT_HOST_H
+
+#include "ast_nodes.h"
+#include "interpreter.h"
+#include "source_file.h"
+#include "value.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chronovyan {
+
+/**
+ * @class CompiledScript
+ * @brief A parsed program, ready to run any number of times
+ *
+ * Immutable once built, so one compiled script can run on several
+ * interpreters and threads at once.
+ */
+class CompiledScript {
+public:
+    /**
+     * @brief Wrap a program, e.g. one built directly as an AST
+     * @param name The script name, used in error messages
+     * @param program The program
+     * @param source The source the program was parsed from, if any
+     */
+    CompiledScript(std::string name, std::unique_ptr<ProgramNode> program,
+                   std::shared_ptr<SourceFile> source = nullptr);
+
+    /**
+     * @brief Get the script name
+     */
+    const std::string& getName() const { return m_name; }
+
+    /**
+     * @brief Get the program
+     */
+    const ProgramNode& getProgram() const { return *m_program; }
+
+private:
+    std::string m_name;
+    std::unique_ptr<ProgramNode> m_program;
+    std::shared_ptr<SourceFile> m_source;  // Kept alive for the locations in the AST
+};
+
+/**
+ * @class ScriptHost
+ * @brief Compiles and runs scripts on behalf of a long-lived embedding process
+ *
+ * compile() lexes and parses a source once and caches the result by name
+ * and source text, so a script served on every request is parsed on its
+ * first request only. run() executes a compiled script on an interpreter
+ * taken from a pool and reset()s it on the way back, so every run starts
+ * with no variables and a full resource budget, and idle interpreters keep
+ * nothing of earlier requests. Both may be called from any number of
+ * threads.
+ */
+class ScriptHost {
+public:
+    /**
+     * @brief Create a host
+     * @param cacheCapacity Compiled scripts kept, least recently used evicted first
+     */
+    explicit ScriptHost(size_t cacheCapacity = 64);
+
+    /**
+     * @brief Compile a source, or return its cached compilation
+     * @param source The script source
+     * @param name The script name, used in error messages
+     * @return The compiled script
+     * @throws ChronovyanParseError if the source does not parse; the
+     *         message lists every error reported while parsing it, and
+     *         those errors are taken back out of the ErrorHandler
+     *
+     * Parser::parse() does not parse statements yet and returns an empty
+     * program for any source, so until it does a compiled script runs
+     * nothing and run() returns nil.
+     */
+    std::shared_ptr<const CompiledScript> compile(const std::string& source,
+                                                  const std::string& name = "<embedded>");
+
+    /**
+     * @brief Run a compiled script on a pooled interpreter
+     * @param script The script
+     * @return The result of the last expression, or nil
+     * @throws ChronovyanException or std::runtime_error when the script fails
+     */
+    Value run(const CompiledScript& script);
+
+    /**
+     * @brief Compile (or look up) and run a source
+     */
+    Value run(const std::string& source, const std::string& name = "<embedded>");
+
+    /**
+     * @brief Apply an execution profile to the interpreters, from their next run
+     */
+    void setExecutionProfile(const ExecutionProfile& profile);
+
+    /**
+     * @brief Record loop stability metrics of every later run into a profiler
+     *
+     * A loop's site accumulates across all the requests that run the same
+     * compiled program; a program compiled again after eviction starts
+     * new sites. Pass nullptr to detach.
+     */
+    void setLoopProfiler(std::shared_ptr<LoopProfiler> profiler);
+
+    /**
+     * @brief Number of compile() calls answered from the cache
+     */
+    uint64_t getCacheHits() const;
+
+    /**
+     * @brief Number of compile() calls that parsed their source
+     */
+    uint64_t getCacheMisses() const;
+
+    /**
+     * @brief Number of compiled scripts currently cached
+     */
+    size_t getCachedScriptCount() const;
+
+    /**
+     * @brief Number of interpreters created, idle or in use
+     */
+    size_t getInterpreterCount() const;
+
+private:
+    struct CacheEntry {
+        std::string key;
+        std::shared_ptr<const CompiledScript> script;
+    };
+
+    std::unique_ptr<Interpreter> acquire();
+    void release(std::unique_ptr<Interpreter> interpreter);
+
+    const size_t m_cacheCapacity;
+
+    // Compilation cache, most recently used first
+    mutable std::mutex m_cacheMutex;
+    std::list<CacheEntry> m_cache;
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> m_cacheIndex;
+    uint64_t m_cacheHits = 0;
+    uint64_t m_cacheMisses = 0;
+
+    // Parsing reports into the process-wide ErrorHandler, so it is serialized
+    std::mutex m_compileMutex;
+
+    // Interpreter pool and the settings every interpreter gets
+    mutable std::mutex m_poolMutex;
+    std::vector<std::unique_ptr<Interpreter>> m_idle;
+    size_t m_interpreterCount = 0;
+    ExecutionProfile m_profile;
+    std::shared_ptr<LoopProfiler> m_loopProfiler;
+};
+
+} // namespace chronovyan
+
+#endif // CHRONOVYAN_SCRIPT_HOST_H
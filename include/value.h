@@ -5,6 +5,7 @@
 #include "variant_fix.h"  // Include the variant fix first
 #include <variant>
 #include <vector>
+#include <deque>
 #include <map>
 #include <string>
 #include <memory>
@@ -139,13 +140,32 @@ public:
     
     // For variables with ECHO flag
     void addValueToHistory(const Value& value);
-    const std::vector<Value>& getValueHistory() const;
+    const std::deque<Value>& getValueHistory() const;
+    
+    /**
+     * @brief Assign to an ECHO variable, moving the current value into its history
+     * @param next The new value
+     * @param historyCapacity Entries kept; the oldest are dropped beyond it
+     *
+     * The modifier, flags and history of this variable are kept. History
+     * entries carry no history of their own.
+     */
+    void echoAssign(Value next, size_t historyCapacity);
     
     // For WEAVER flag
     void setProbabilisticValue(const std::map<Value, double>& distribution);
     const std::map<Value, double>& getProbabilisticValue() const;
     Value resolveProbabilisticValue() const;
     
+    /**
+     * @brief Sample only the most probable outcomes of the distribution, renormalized
+     * @param maxOutcomes Outcomes considered; 0 considers all
+     *
+     * The stored distribution is left intact, so a later caller allowing
+     * more outcomes samples from all of them again.
+     */
+    Value resolveProbabilisticValue(size_t maxOutcomes) const;
+    
     // Utility methods
     std::string toString() const;
     bool equals(const Value& other) const;
@@ -171,7 +191,7 @@ private:
     double m_uncertainty = 0.0;
     
     // For variables with ECHO flag
-    std::vector<Value> m_valueHistory;
+    std::deque<Value> m_valueHistory;
     
     // For WEAVER flag (quantum probabilistic state)
     std::map<Value, double> m_probabilisticValue;
@@ -179,6 +199,16 @@ private:
 
 // Utility functions
 bool areEqual(const Value& a, const Value& b);
+
+/**
+ * @brief Strict weak ordering, so values can key WEAVER distributions
+ *
+ * Values order by type, then by content for scalars and strings; arrays
+ * and maps order by identity, and functions are all equivalent. A NaN
+ * float orders after every other float and is equivalent to any NaN.
+ */
+bool operator<(const Value& a, const Value& b);
+
 Value add(const Value& a, const Value& b);
 Value subtract(const Value& a, const Value& b);
 Value multiply(const Value& a, const Value& b);
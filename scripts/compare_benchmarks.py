@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+"""
+Chronovyan Benchmark Comparison
+
+Compares two Google Benchmark JSON result files, typically the output of
+the `bench` target (bench/chronovyan_bench.json in the build tree) on two
+commits, and flags benchmarks that got slower.
+
+Usage:
+    python compare_benchmarks.py baseline.json contender.json [--threshold 0.10]
+                                 [--metric cpu_time|real_time]
+
+For every benchmark present in both files the ratio contender / baseline
+of the chosen time is printed. When a run used --benchmark_repetitions,
+the median aggregate is compared instead of the individual repetitions.
+A ratio above 1 + threshold is a regression, and the script exits with
+status 1 if there is any; benchmarks present in only one file are listed
+but do not fail the comparison.
+"""
+
+import argparse
+import json
+import sys
+
+# Google Benchmark time units, in nanoseconds
+UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric):
+    """Map benchmark name to its time in nanoseconds."""
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+
+    times = {}
+    medians = {}
+    for entry in data.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        value = float(entry[metric]) * UNIT_NS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = value
+            continue
+        name = entry.get("run_name", entry["name"])
+        # Without aggregates, repetitions of one benchmark keep the fastest
+        times[name] = min(value, times.get(name, value))
+    times.update(medians)
+    return times, data.get("context", {})
+
+
+def format_ns(value):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return f"{value / scale:.2f} {unit}"
+    return f"{value:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two Google Benchmark JSON files")
+    parser.add_argument("baseline", help="results of the reference commit")
+    parser.add_argument("contender", help="results of the commit under test")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="slowdown ratio counted as a regression (default 0.10, i.e. 10%%)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+                        help="time to compare (default cpu_time)")
+    args = parser.parse_args()
+
+    baseline, baseline_context = load_times(args.baseline, args.metric)
+    contender, contender_context = load_times(args.contender, args.metric)
+
+    for label, context in (("baseline", baseline_context), ("contender", contender_context)):
+        if context.get("library_build_type") == "debug":
+            print(f"Warning: {label} used a debug build of Google Benchmark")
+
+    common = [name for name in baseline if name in contender]
+    width = max([len(name) for name in common] + [len("benchmark")])
+    print(f"{'benchmark':<{width}}  {'baseline':>12}  {'contender':>12}  {'ratio':>7}")
+
+    regressions = []
+    for name in common:
+        ratio = contender[name] / baseline[name] if baseline[name] > 0 else float("inf")
+        marker = ""
+        if ratio > 1.0 + args.threshold:
+            marker = "  REGRESSION"
+            regressions.append(name)
+        elif ratio < 1.0 - args.threshold:
+            marker = "  improved"
+        print(f"{name:<{width}}  {format_ns(baseline[name]):>12}  {format_ns(contender[name]):>12}  "
+              f"{ratio:>7.3f}{marker}")
+
+    only_baseline = sorted(set(baseline) - set(contender))
+    only_contender = sorted(set(contender) - set(baseline))
+    if only_baseline:
+        print("\nOnly in baseline: " + ", ".join(only_baseline))
+    if only_contender:
+        print("\nOnly in contender: " + ", ".join(only_contender))
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) beyond {args.threshold:.0%}: " + ", ".join(regressions))
+        return 1
+    print(f"\nNo regressions beyond {args.threshold:.0%} across {len(common)} benchmarks")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
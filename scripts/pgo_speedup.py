@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+
+"""
+Chronovyan PGO Speedup Report
+
+Runs the interpreter benchmarks of the Google Benchmark suite in a baseline
+build and in an optimized build and reports the speedup of each benchmark
+and their geometric mean.
+
+Usage:
+    python pgo_speedup.py [--baseline build/release] [--optimized build/pgo-optimized]
+                          [--filter REGEX] [--repetitions 5] [--build]
+
+The builds are the binary directories of the CMake presets (see
+CMakePresets.json). With --build, the script first configures and builds
+them itself: the release preset, then the PGO sequence pgo-instrumented,
+pgo-train and pgo-optimized. Otherwise they must already be built, e.g.:
+
+    cmake --preset release && cmake --build --preset release
+    cmake --preset pgo-instrumented && cmake --build --preset pgo-train
+    cmake --preset pgo-optimized && cmake --build --preset pgo-optimized
+
+Each build runs chronovyan_bench with --benchmark_repetitions, and the
+median of the repetitions is compared, as in compare_benchmarks.py. The two
+builds run one after the other, so use a quiet machine. The JSON results
+are kept in bench/pgo_speedup.json in each build directory.
+"""
+
+import argparse
+import math
+import os
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from compare_benchmarks import format_ns, load_times  # noqa: E402
+
+# The interpreter's hot paths: expression evaluation, Value operators,
+# variable lookup and the lexer
+DEFAULT_FILTER = "BM_(InterpretExpressionTree|Value|EnvironmentLookup|LexerTokenize)"
+
+BUILD_STEPS = [
+    ["cmake", "--preset", "release"],
+    ["cmake", "--build", "--preset", "release"],
+    ["cmake", "--preset", "pgo-instrumented"],
+    ["cmake", "--build", "--preset", "pgo-train"],
+    ["cmake", "--preset", "pgo-optimized"],
+    ["cmake", "--build", "--preset", "pgo-optimized"],
+]
+
+
+def run_suite(build_dir, bench_filter, repetitions):
+    """Run chronovyan_bench in build_dir and return the path of its JSON results."""
+    executable = os.path.join(build_dir, "benchmarks", "chronovyan_bench")
+    if not os.path.isfile(executable):
+        sys.exit(f"{executable} not found; build it first (see --help) or pass --build")
+    out_dir = os.path.join(build_dir, "bench")
+    os.makedirs(out_dir, exist_ok=True)
+    out_path = os.path.join(out_dir, "pgo_speedup.json")
+    print(f"Running {executable}", flush=True)
+    subprocess.run([executable,
+                    f"--benchmark_filter={bench_filter}",
+                    f"--benchmark_repetitions={repetitions}",
+                    "--benchmark_report_aggregates_only=true",
+                    f"--benchmark_out={out_path}",
+                    "--benchmark_out_format=json"],
+                   check=True, stdout=subprocess.DEVNULL)
+    return out_path
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the PGO/LTO speedup on the interpreter benchmarks")
+    parser.add_argument("--baseline", default="build/release", help="baseline build directory")
+    parser.add_argument("--optimized", default="build/pgo-optimized", help="optimized build directory")
+    parser.add_argument("--filter", default=DEFAULT_FILTER, help="benchmarks to run (regex)")
+    parser.add_argument("--repetitions", type=int, default=5, help="repetitions per benchmark (default 5)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+                        help="time to compare (default cpu_time)")
+    parser.add_argument("--build", action="store_true",
+                        help="configure and build the presets first (run from the source directory)")
+    args = parser.parse_args()
+
+    if args.build:
+        for step in BUILD_STEPS:
+            print("$ " + " ".join(step), flush=True)
+            subprocess.run(step, check=True)
+
+    baseline, _ = load_times(run_suite(args.baseline, args.filter, args.repetitions), args.metric)
+    optimized, _ = load_times(run_suite(args.optimized, args.filter, args.repetitions), args.metric)
+
+    common = [name for name in baseline if name in optimized]
+    if not common:
+        sys.exit("No benchmark ran in both builds")
+    width = max(len(name) for name in common + ["benchmark"])
+    print(f"\n{'benchmark':<{width}}  {'baseline':>12}  {'optimized':>12}  {'speedup':>8}")
+    log_sum = 0.0
+    for name in common:
+        speedup = baseline[name] / optimized[name]
+        log_sum += math.log(speedup)
+        print(f"{name:<{width}}  {format_ns(baseline[name]):>12}  {format_ns(optimized[name]):>12}  "
+              f"{speedup:>7.3f}x")
+
+    geomean = math.exp(log_sum / len(common))
+    print(f"\nGeometric mean speedup of {args.optimized} over {args.baseline}: "
+          f"{geomean:.3f}x across {len(common)} benchmarks")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,68 @@
+# Chronovyan PGO Training Workload
+#
+# Run by the pgo-train target of a CHRONOVYAN_PGO=GENERATE build, normally
+# through the presets:
+#     cmake --preset pgo-instrumented
+#     cmake --build --preset pgo-train
+#
+# Clears PGO_DIR, so profiles of earlier sources do not mix in, then runs
+# the instrumented interpreter CHRONOVYAN over every EXAMPLES_DIR/*.cvy and
+# the Google Benchmark suite BENCH, if given, with a short minimum time per
+# benchmark. Examples that fail still leave their profile behind and only
+# produce a warning. With LLVM_PROFDATA (Clang builds) the raw profiles are
+# merged into PGO_DIR/default.profdata, which the USE build reads.
+
+foreach(variable CHRONOVYAN EXAMPLES_DIR PGO_DIR)
+    if(NOT DEFINED ${variable})
+        message(FATAL_ERROR "pgo_train.cmake needs -D${variable}=...")
+    endif()
+endforeach()
+
+file(REMOVE_RECURSE "${PGO_DIR}")
+file(MAKE_DIRECTORY "${PGO_DIR}")
+
+file(GLOB examples "${EXAMPLES_DIR}/*.cvy")
+list(SORT examples)
+foreach(example IN LISTS examples)
+    get_filename_component(name "${example}" NAME)
+    execute_process(
+        COMMAND "${CHRONOVYAN}" "${example}"
+        INPUT_FILE /dev/null
+        OUTPUT_QUIET
+        ERROR_QUIET
+        RESULT_VARIABLE result
+        TIMEOUT 120
+    )
+    if(result EQUAL 0)
+        message(STATUS "Trained on ${name}")
+    else()
+        message(WARNING "${name} exited with ${result}; its profile is kept")
+    endif()
+endforeach()
+
+if(DEFINED BENCH)
+    message(STATUS "Training on the benchmark suite")
+    execute_process(
+        COMMAND "${BENCH}" --benchmark_min_time=0.05
+        OUTPUT_QUIET
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "The benchmark suite failed with ${result}")
+    endif()
+else()
+    message(WARNING "chronovyan_bench was not built; only the examples were run (configure with BUILD_BENCHMARKS=ON)")
+endif()
+
+if(DEFINED LLVM_PROFDATA)
+    file(GLOB raw_profiles "${PGO_DIR}/*.profraw")
+    execute_process(
+        COMMAND "${LLVM_PROFDATA}" merge -output=${PGO_DIR}/default.profdata ${raw_profiles}
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "llvm-profdata merge failed with ${result}")
+    endif()
+endif()
+
+message(STATUS "Profiles written to ${PGO_DIR}")
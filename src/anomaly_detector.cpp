@@ -0,0 +1,151 @@
+#include <chronovyan/anomaly_detector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace chronovyan {
+namespace sync {
+
+StreamingAnomalyDetector::StreamingAnomalyDetector(std::vector<std::string> factor_names)
+    : StreamingAnomalyDetector(std::move(factor_names), Config()) {}
+
+StreamingAnomalyDetector::StreamingAnomalyDetector(std::vector<std::string> factor_names,
+                                                   const Config& config)
+    : names(std::move(factor_names)), config(config) {
+    if (names.empty()) {
+        throw std::invalid_argument("StreamingAnomalyDetector needs at least one factor");
+    }
+    this->config.alpha = std::clamp(config.alpha, 1e-6, 1.0);
+    this->config.season_gamma = std::clamp(config.season_gamma, 0.0, 1.0);
+    this->config.anomaly_threshold = std::clamp(config.anomaly_threshold, 1e-6, 1.0 - 1e-6);
+    this->config.min_stddev = std::max(config.min_stddev, 1e-12);
+    channels.resize(names.size());
+    if (this->config.season_length > 1) {
+        seasonal_components.assign(names.size() * this->config.season_length, 0.0);
+    }
+}
+
+const char* StreamingAnomalyDetector::kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::Spike: return "spike";
+        case Kind::ChangePoint: return "change_point";
+        case Kind::None:
+        default: return "none";
+    }
+}
+
+double StreamingAnomalyDetector::seasonal(size_t factor) const {
+    if (seasonal_components.empty()) {
+        return 0.0;
+    }
+    return seasonal_components[factor * config.season_length + samples % config.season_length];
+}
+
+// Maps a ratio to its threshold onto [0, 1) so that ratio 1 scores exactly
+// anomaly_threshold and larger ratios approach 1.
+double StreamingAnomalyDetector::scale(double ratio) const {
+    return 1.0 - std::pow(1.0 - config.anomaly_threshold, std::max(0.0, ratio));
+}
+
+// Scores one value and advances state's CUSUM sums; level and variance are
+// left to the caller.
+double StreamingAnomalyDetector::score_channel(size_t factor, double value, Channel& state,
+                                               Kind* kind) const {
+    double residual = value - state.level - seasonal(factor);
+    double stddev = std::max(std::sqrt(state.variance), config.min_stddev);
+    double z = residual / stddev;
+
+    state.cusum_up = std::max(0.0, state.cusum_up + z - config.cusum_drift);
+    state.cusum_down = std::max(0.0, state.cusum_down - z - config.cusum_drift);
+
+    double spike_score = scale(std::abs(z) / config.z_threshold);
+    double shift_score = scale(std::max(state.cusum_up, state.cusum_down) / config.cusum_threshold);
+
+    if (kind != nullptr) {
+        *kind = spike_score >= shift_score ? Kind::Spike : Kind::ChangePoint;
+    }
+    return std::max(spike_score, shift_score);
+}
+
+bool StreamingAnomalyDetector::update(const double* values) {
+    bool first = samples == 0;
+    latest = Score();
+
+    for (size_t f = 0; f < channels.size(); ++f) {
+        Channel& channel = channels[f];
+        double value = values[f];
+
+        if (first) {
+            channel.level = value;
+            channel.last_score = 0.0;
+            continue;
+        }
+
+        Kind kind = Kind::None;
+        channel.last_score = score_channel(f, value, channel, &kind);
+        if (channel.last_score > latest.value) {
+            latest.value = channel.last_score;
+            latest.kind = kind;
+            latest.factor = f;
+        }
+
+        // Learn from the sample: level, seasonal component, then variance
+        double season = seasonal(f);
+        double residual = value - channel.level - season;
+        channel.level += config.alpha * (value - season - channel.level);
+        if (!seasonal_components.empty()) {
+            double& component = seasonal_components[f * config.season_length +
+                                                    samples % config.season_length];
+            component += config.season_gamma * (value - channel.level - component);
+        }
+        channel.variance = (1.0 - config.alpha) *
+                           (channel.variance + config.alpha * residual * residual);
+    }
+
+    bool anomalous = samples >= config.warmup_samples &&
+                     latest.value >= config.anomaly_threshold;
+    if (!anomalous) {
+        latest.kind = Kind::None;
+    }
+    ++samples;
+
+    bool newly_raised = anomalous && !raised;
+    raised = anomalous;
+    return newly_raised;
+}
+
+StreamingAnomalyDetector::Score StreamingAnomalyDetector::evaluate(
+    const double* values, double* factor_scores) const {
+    Score score;
+    for (size_t f = 0; f < channels.size(); ++f) {
+        double factor_score = 0.0;
+        Kind kind = Kind::None;
+        if (samples > 0) {
+            Channel scratch = channels[f];
+            factor_score = score_channel(f, values[f], scratch, &kind);
+        }
+        if (factor_scores != nullptr) {
+            factor_scores[f] = factor_score;
+        }
+        if (factor_score > score.value) {
+            score.value = factor_score;
+            score.kind = kind;
+            score.factor = f;
+        }
+    }
+    if (score.value < config.anomaly_threshold) {
+        score.kind = Kind::None;
+    }
+    return score;
+}
+
+void StreamingAnomalyDetector::reset() {
+    std::fill(channels.begin(), channels.end(), Channel());
+    std::fill(seasonal_components.begin(), seasonal_components.end(), 0.0);
+    samples = 0;
+    latest = Score();
+    raised = false;
+}
+
+} // namespace sync
+} // namespace chronovyan
@@ -1,4 +1,5 @@
 #include "ast_nodes.h"
+#include <atomic>
 #include <stdexcept>
 
 namespace chronovyan {
@@ -174,13 +175,18 @@ StmtNode& IfStmtNode::getElseBranch() {
 
 // TemporalOpStmtNode
 
+namespace {
+std::atomic<uint64_t> nextSiteId{1};
+}
+
 TemporalOpStmtNode::TemporalOpStmtNode(
     TemporalOpType opType,
     std::vector<std::unique_ptr<ExprNode>> arguments,
     std::unique_ptr<BlockStmtNode> body
 ) : m_opType(opType),
     m_arguments(std::move(arguments)),
-    m_body(std::move(body)) {}
+    m_body(std::move(body)),
+    m_siteId(nextSiteId.fetch_add(1, std::memory_order_relaxed)) {}
 
 void TemporalOpStmtNode::accept(ASTVisitor& visitor) const {
     visitor.visitTemporalOpStmt(*this);
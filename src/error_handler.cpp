@@ -1,4 +1,5 @@
 #include "error_handler.h"
+#include <cstddef>
 #include <iostream>
 
 namespace chronovyan {
@@ -66,6 +67,12 @@ void ErrorHandler::clearErrors() {
     m_errors.clear();
 }
 
+void ErrorHandler::clearErrorsAfter(size_t count) {
+    if (count < m_errors.size()) {
+        m_errors.erase(m_errors.begin() + static_cast<std::ptrdiff_t>(count), m_errors.end());
+    }
+}
+
 ErrorHandler& ErrorHandler::getInstance() {
     static ErrorHandler instance;
     return instance;
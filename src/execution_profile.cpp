@@ -0,0 +1,99 @@
+#include "chronovyan/execution_profile.hpp"
+
+namespace chronovyan {
+
+namespace {
+
+size_t index_of(PerformanceMode mode) {
+    return static_cast<size_t>(mode);
+}
+
+} // namespace
+
+ExecutionProfile profile_for(PerformanceMode mode) {
+    ExecutionProfile profile;
+    profile.mode = mode;
+    switch (mode) {
+    case PerformanceMode::HighFidelity:
+        profile.echo_history_capacity = 1024;
+        profile.weaver_outcomes = 0;
+        profile.paradox_tracking = true;
+        profile.sync_tick_interval = std::chrono::milliseconds(20);
+        profile.sync_history_size = 50;
+        break;
+    case PerformanceMode::Balanced:
+        break;
+    case PerformanceMode::Lean:
+        profile.echo_history_capacity = 8;
+        profile.weaver_outcomes = 4;
+        profile.paradox_tracking = false;
+        profile.sync_tick_interval = std::chrono::milliseconds(500);
+        profile.sync_history_size = 3;
+        break;
+    }
+    return profile;
+}
+
+ExecutionProfileSwitch::ExecutionProfileSwitch(PerformanceMode initial)
+    : profiles_{profile_for(PerformanceMode::HighFidelity),
+                profile_for(PerformanceMode::Balanced),
+                profile_for(PerformanceMode::Lean)},
+      current_(initial) {
+}
+
+void ExecutionProfileSwitch::set_profile(PerformanceMode mode, const ExecutionProfile& profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    profiles_[index_of(mode)] = profile;
+    profiles_[index_of(mode)].mode = mode;
+    if (mode == current_) {
+        apply_locked();
+    }
+}
+
+ExecutionProfile ExecutionProfileSwitch::profile(PerformanceMode mode) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return profiles_[index_of(mode)];
+}
+
+void ExecutionProfileSwitch::add_target(Target target) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    target(profiles_[index_of(current_)]);
+    targets_.push_back(std::move(target));
+}
+
+void ExecutionProfileSwitch::apply(PerformanceMode mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mode == current_) {
+        return;
+    }
+    current_ = mode;
+    ++switches_;
+    apply_locked();
+}
+
+ExecutionProfile ExecutionProfileSwitch::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return profiles_[index_of(current_)];
+}
+
+uint64_t ExecutionProfileSwitch::switches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return switches_;
+}
+
+void ExecutionProfileSwitch::notifyModeChange(PerformanceMode new_mode, const std::string&) {
+    apply(new_mode);
+}
+
+void ExecutionProfileSwitch::notifyError(const std::string&) {
+    // Errors do not change the profile; fallback is itself a mode change
+}
+
+void ExecutionProfileSwitch::apply_locked() {
+    const ExecutionProfile& profile = profiles_[index_of(current_)];
+    for (const auto& target : targets_) {
+        target(profile);
+    }
+}
+
+} // namespace chronovyan
@@ -0,0 +1,283 @@
+#include <chronovyan/forecaster.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace chronovyan {
+namespace sync {
+
+namespace {
+const double kSqrt2 = std::sqrt(2.0);
+
+// EWMA of squared residuals, seeded with the first residual
+void track_variance(double& variance, size_t& count, double residual, double alpha) {
+    double squared = residual * residual;
+    variance = count == 0 ? squared : (1.0 - alpha) * variance + alpha * squared;
+    ++count;
+}
+
+Forecast make_forecast(double mean, double stddev, double z) {
+    Forecast forecast;
+    forecast.mean = mean;
+    forecast.stddev = stddev;
+    forecast.lower = mean - z * stddev;
+    forecast.upper = mean + z * stddev;
+    return forecast;
+}
+
+// A model needs a few scored forecasts before its error estimate is trusted
+constexpr size_t kMinScoredForecasts = 5;
+} // namespace
+
+double probability_below(const Forecast& forecast, double threshold) {
+    if (forecast.stddev <= 0.0) {
+        return forecast.mean < threshold ? 1.0 : 0.0;
+    }
+    return 0.5 * std::erfc((forecast.mean - threshold) / (forecast.stddev * kSqrt2));
+}
+
+double probability_within(const Forecast& forecast, double tolerance) {
+    if (forecast.stddev <= 0.0) {
+        return 1.0;
+    }
+    return std::erf(tolerance / (forecast.stddev * kSqrt2));
+}
+
+// Holt-Winters
+
+HoltWintersForecaster::HoltWintersForecaster() : HoltWintersForecaster(Config()) {}
+
+HoltWintersForecaster::HoltWintersForecaster(const Config& config) : config(config) {
+    this->config.alpha = std::clamp(config.alpha, 0.0, 1.0);
+    this->config.beta = std::clamp(config.beta, 0.0, 1.0);
+    this->config.gamma = std::clamp(config.gamma, 0.0, 1.0);
+    this->config.season_length = config.season_length > 1
+        ? std::min(config.season_length, kMaxSeasonLength) : 0;
+}
+
+double HoltWintersForecaster::seasonal_at(size_t offset) const {
+    size_t m = config.season_length;
+    return m == 0 ? 0.0 : seasonal[(samples + offset) % m];
+}
+
+void HoltWintersForecaster::update(double value) {
+    size_t m = config.season_length;
+    if (samples == 0) {
+        level = value;
+        trend = 0.0;
+        ++samples;
+        return;
+    }
+    if (m != 0 && samples < m) {
+        // First season: seasonal offsets relative to the initial level
+        seasonal[samples] = value - level;
+        ++samples;
+        return;
+    }
+
+    double season = seasonal_at(0);
+    double residual = value - (level + trend + season);
+    track_variance(residual_variance, residual_count, residual, config.variance_alpha);
+
+    double previous_level = level;
+    level = config.alpha * (value - season) + (1.0 - config.alpha) * (level + trend);
+    trend = config.beta * (level - previous_level) + (1.0 - config.beta) * trend;
+    if (m != 0) {
+        seasonal[samples % m] = config.gamma * (value - level) + (1.0 - config.gamma) * season;
+    }
+    ++samples;
+}
+
+Forecast HoltWintersForecaster::forecast(size_t horizon, double z) const {
+    horizon = std::max<size_t>(1, horizon);
+    double mean = level + static_cast<double>(horizon) * trend + seasonal_at(horizon - 1);
+
+    // var_h = sigma^2 * (1 + sum_{j=1}^{h-1} c_j^2), c_j = alpha(1 + j beta) + gamma [j mod m == 0]
+    double multiplier = 1.0;
+    for (size_t j = 1; j < horizon; ++j) {
+        double c = config.alpha * (1.0 + static_cast<double>(j) * config.beta);
+        if (config.season_length != 0 && j % config.season_length == 0) {
+            c += config.gamma;
+        }
+        multiplier += c * c;
+    }
+    return make_forecast(mean, std::sqrt(residual_variance * multiplier), z);
+}
+
+// Autoregressive
+
+AutoRegressiveForecaster::AutoRegressiveForecaster() : AutoRegressiveForecaster(Config()) {}
+
+AutoRegressiveForecaster::AutoRegressiveForecaster(const Config& config)
+    : config(config), order(std::clamp<size_t>(config.order, 1, kMaxOrder)) {
+    this->config.forgetting = std::clamp(config.forgetting, 0.5, 1.0);
+    for (size_t i = 0; i <= order; ++i) {
+        covariance[i * kTerms + i] = config.initial_covariance;
+    }
+}
+
+double AutoRegressiveForecaster::lag(size_t k) const {
+    return lags[(lag_head + kMaxOrder - k) % kMaxOrder];
+}
+
+double AutoRegressiveForecaster::predict(const std::array<double, kTerms>& regressor) const {
+    double prediction = 0.0;
+    for (size_t i = 0; i <= order; ++i) {
+        prediction += coefficients[i] * regressor[i];
+    }
+    return prediction;
+}
+
+void AutoRegressiveForecaster::update(double value) {
+    if (samples >= order) {
+        const size_t n = order + 1;
+        std::array<double, kTerms> regressor{};
+        regressor[0] = 1.0;
+        for (size_t k = 1; k <= order; ++k) {
+            regressor[k] = lag(k);
+        }
+
+        double residual = value - predict(regressor);
+        track_variance(residual_variance, residual_count, residual, config.variance_alpha);
+
+        // RLS: K = P phi / (lambda + phi' P phi); theta += K e; P = (P - K phi' P) / lambda
+        std::array<double, kTerms> p_phi{};
+        double denominator = config.forgetting;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                p_phi[i] += covariance[i * kTerms + j] * regressor[j];
+            }
+            denominator += regressor[i] * p_phi[i];
+        }
+        // Update the upper triangle and mirror it: keeping P exactly symmetric
+        // avoids the round-off drift that destabilizes RLS under forgetting.
+        double trace = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            coefficients[i] += p_phi[i] / denominator * residual;
+            for (size_t j = i; j < n; ++j) {
+                double entry = (covariance[i * kTerms + j] - p_phi[i] * p_phi[j] / denominator) /
+                               config.forgetting;
+                covariance[i * kTerms + j] = entry;
+                covariance[j * kTerms + i] = entry;
+            }
+            trace += covariance[i * kTerms + i];
+        }
+
+        // Forgetting inflates P along directions the data never excites
+        // (e.g. a flat series); cap the trace to keep the update stable.
+        double trace_limit = config.initial_covariance * static_cast<double>(n);
+        if (trace > trace_limit) {
+            double shrink = trace_limit / trace;
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    covariance[i * kTerms + j] *= shrink;
+                }
+            }
+        }
+    }
+
+    lags[lag_head] = value;
+    lag_head = (lag_head + 1) % kMaxOrder;
+    ++samples;
+}
+
+Forecast AutoRegressiveForecaster::forecast(size_t horizon, double z) const {
+    horizon = std::max<size_t>(1, horizon);
+
+    // Newest-first windows of simulated values and psi weights
+    std::array<double, kMaxOrder> window{};
+    for (size_t k = 1; k <= order; ++k) {
+        window[k - 1] = lag(k);
+    }
+    std::array<double, kMaxOrder> psi{};
+    psi[0] = 1.0;          // psi_0; older (negative-index) weights are zero
+    double psi_sum = 1.0;
+
+    double mean = 0.0;
+    for (size_t step = 1; step <= horizon; ++step) {
+        mean = coefficients[0];
+        for (size_t k = 1; k <= order; ++k) {
+            mean += coefficients[k] * window[k - 1];
+        }
+        for (size_t k = order - 1; k > 0; --k) {
+            window[k] = window[k - 1];
+        }
+        window[0] = mean;
+
+        if (step < horizon) {
+            // psi_j = sum_{i=1}^{p} a_i psi_{j-i}
+            double next = 0.0;
+            for (size_t i = 1; i <= order; ++i) {
+                next += coefficients[i] * psi[i - 1];
+            }
+            for (size_t k = order - 1; k > 0; --k) {
+                psi[k] = psi[k - 1];
+            }
+            psi[0] = next;
+            psi_sum += next * next;
+        }
+    }
+    return make_forecast(mean, std::sqrt(residual_variance * psi_sum), z);
+}
+
+// Blended series forecaster
+
+SeriesForecaster::SeriesForecaster() : SeriesForecaster(Config()) {}
+
+SeriesForecaster::SeriesForecaster(const Config& config)
+    : config(config),
+      holt_winters(config.holt_winters),
+      autoregressive(config.autoregressive) {}
+
+void SeriesForecaster::update(double value) {
+    double alpha = config.error_alpha;
+    if (holt_winters.sample_count() > 0) {
+        double error = value - holt_winters.forecast(1, 0.0).mean;
+        holt_winters_mse = holt_winters.sample_count() == 1
+            ? error * error
+            : (1.0 - alpha) * holt_winters_mse + alpha * error * error;
+    }
+    if (autoregressive.is_ready()) {
+        double error = value - autoregressive.forecast(1, 0.0).mean;
+        if (std::isfinite(error)) {
+            autoregressive_mse = autoregressive_scored == 0
+                ? error * error
+                : (1.0 - alpha) * autoregressive_mse + alpha * error * error;
+            ++autoregressive_scored;
+        }
+    }
+    holt_winters.update(value);
+    autoregressive.update(value);
+}
+
+double SeriesForecaster::holt_winters_weight() const {
+    if (autoregressive_scored < kMinScoredForecasts) {
+        return 1.0;
+    }
+    double total = holt_winters_mse + autoregressive_mse;
+    if (total <= 0.0) {
+        return 0.5;
+    }
+    // Inverse-MSE weighting: w_hw = (1/mse_hw) / (1/mse_hw + 1/mse_ar)
+    return autoregressive_mse / total;
+}
+
+Forecast SeriesForecaster::forecast(size_t horizon, double z) const {
+    Forecast hw = holt_winters.forecast(horizon, z);
+    double weight = holt_winters_weight();
+    double mean = hw.mean;
+    double variance = hw.stddev * hw.stddev;
+
+    if (weight < 1.0) {
+        Forecast ar = autoregressive.forecast(horizon, z);
+        if (std::isfinite(ar.mean) && std::isfinite(ar.stddev)) {
+            double spread = hw.mean - ar.mean;
+            mean = weight * hw.mean + (1.0 - weight) * ar.mean;
+            variance = weight * variance + (1.0 - weight) * ar.stddev * ar.stddev +
+                       weight * (1.0 - weight) * spread * spread;
+        }
+    }
+    return make_forecast(mean, std::max(std::sqrt(variance), config.min_stddev), z);
+}
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,409 @@
+#include "chronovyan/gradient_boosting.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace chronovyan {
+namespace sync {
+
+namespace {
+
+constexpr size_t kMaxDepth = 12;
+constexpr size_t kMaxBins = 256;     // bin codes are uint8_t
+constexpr size_t kScoreBlock = 64;   // rows scored per pass over the trees
+constexpr double kMinHessian = 1e-6;
+constexpr double kMinProbability = 1e-12;
+
+double sigmoid(double z) {
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+TreeEnsembleConfig sanitize(TreeEnsembleConfig config) {
+    config.max_depth = std::clamp<size_t>(config.max_depth, 1, kMaxDepth);
+    config.min_samples_split = std::max<size_t>(config.min_samples_split, 2);
+    config.max_trees = std::max<size_t>(config.max_trees, 2);
+    config.histogram_bins = std::clamp<size_t>(config.histogram_bins, 2, kMaxBins);
+    config.sample_buffer = std::max<size_t>(config.sample_buffer, 1);
+    if (!(config.shrinkage > 0.0)) {
+        config.shrinkage = 0.1;
+    }
+    if (!(config.l2 >= 0.0)) {
+        config.l2 = 0.0;
+    }
+    return config;
+}
+
+} // namespace
+
+// TreeView
+
+double TreeView::raw_score(const double* features) const {
+    const size_t inner = internal_nodes();
+    const size_t leaf_count = leaves();
+    double score = base_score;
+    for (size_t t = 0; t < tree_count; ++t) {
+        const uint32_t* feature = split_feature + t * inner;
+        const double* threshold = split_threshold + t * inner;
+        size_t node = 0;
+        for (size_t level = 0; level < depth; ++level) {
+            node = 2 * node + 1 + (features[feature[node]] > threshold[node]);
+        }
+        score += leaf_value[t * leaf_count + node - inner];
+    }
+    return score;
+}
+
+void TreeView::raw_scores(const double* features, size_t rows, size_t feature_count, double* out) const {
+    const size_t inner = internal_nodes();
+    const size_t leaf_count = leaves();
+    for (size_t start = 0; start < rows; start += kScoreBlock) {
+        const size_t end = std::min(rows, start + kScoreBlock);
+        std::fill(out + start, out + end, base_score);
+        for (size_t t = 0; t < tree_count; ++t) {
+            const uint32_t* feature = split_feature + t * inner;
+            const double* threshold = split_threshold + t * inner;
+            const double* leaf = leaf_value + t * leaf_count - inner;
+            // Level by level across the block, so the rows' independent
+            // lookups overlap instead of each row waiting on its own chain
+            uint32_t node[kScoreBlock] = {};
+            for (size_t level = 0; level < depth; ++level) {
+                for (size_t r = start; r < end; ++r) {
+                    uint32_t& i = node[r - start];
+                    const double* x = features + r * feature_count;
+                    i = 2 * i + 1 + (x[feature[i]] > threshold[i]);
+                }
+            }
+            for (size_t r = start; r < end; ++r) {
+                out[r] += leaf[node[r - start]];
+            }
+        }
+    }
+}
+
+// GradientBoostedTrees
+
+GradientBoostedTrees::GradientBoostedTrees(size_t feature_count, TreeEnsembleConfig config)
+    : feature_count_(feature_count),
+      config_(sanitize(config)),
+      depth_(config_.max_depth),
+      capacity_(config_.sample_buffer) {
+    features_.resize(capacity_ * feature_count_);
+    targets_.resize(capacity_);
+    scores_.resize(capacity_);
+    codes_.resize(capacity_ * feature_count_);
+}
+
+void GradientBoostedTrees::set_config(const TreeEnsembleConfig& config) {
+    config_ = sanitize(config);
+    if (tree_count_ == 0) {
+        depth_ = config_.max_depth;
+    }
+    if (config_.sample_buffer == capacity_) {
+        return;
+    }
+
+    // Keep the newest rows, oldest first, starting at slot 0
+    const size_t n = feature_count_;
+    const size_t capacity = config_.sample_buffer;
+    const size_t keep = std::min(size_, capacity);
+    std::vector<double> features(capacity * n);
+    std::vector<double> targets(capacity);
+    std::vector<double> scores(capacity);
+    std::vector<uint8_t> codes(capacity * n);
+    for (size_t i = 0; i < keep; ++i) {
+        size_t slot = (head_ + size_ - keep + i) % capacity_;
+        std::copy_n(features_.begin() + slot * n, n, features.begin() + i * n);
+        std::copy_n(codes_.begin() + slot * n, n, codes.begin() + i * n);
+        targets[i] = targets_[slot];
+        scores[i] = scores_[slot];
+    }
+    features_.swap(features);
+    targets_.swap(targets);
+    scores_.swap(scores);
+    codes_.swap(codes);
+    capacity_ = capacity;
+    head_ = 0;
+    size_ = keep;
+}
+
+void GradientBoostedTrees::add_samples(const double* features, const double* targets, size_t rows) {
+    const size_t n = feature_count_;
+    const TreeView trees = view();
+    for (size_t r = 0; r < rows; ++r) {
+        size_t slot;
+        if (size_ < capacity_) {
+            slot = size_++;
+        } else {
+            slot = head_;
+            head_ = (head_ + 1) % capacity_;
+        }
+        const double* x = features + r * n;
+        std::copy_n(x, n, features_.begin() + slot * n);
+        targets_[slot] = targets[r];
+        scores_[slot] = trees.raw_score(x);
+        if (!edges_.empty()) {
+            bin_row(slot);
+        }
+    }
+}
+
+double GradientBoostedTrees::boost_round() {
+    if (size_ == 0) {
+        return 0.0;
+    }
+    double loss = mean_loss();
+    if (tree_count_ == 0) {
+        refit(1);
+    } else if (tree_count_ >= config_.max_trees) {
+        refit(config_.max_trees / 2);
+    } else {
+        if (edges_.empty()) {
+            compute_bins();  // trees restored by assign()
+        }
+        grow_tree();
+    }
+    return loss;
+}
+
+double GradientBoostedTrees::predict(const double* features) const {
+    return sigmoid(view().raw_score(features));
+}
+
+void GradientBoostedTrees::predict_batch(const double* features, size_t rows, double* out) const {
+    view().raw_scores(features, rows, feature_count_, out);
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = sigmoid(out[r]);
+    }
+}
+
+std::vector<double> GradientBoostedTrees::importance() const {
+    std::vector<double> gain(feature_count_, 0.0);
+    for (size_t i = 0; i < split_gain_.size(); ++i) {
+        gain[split_feature_[i]] += split_gain_[i];
+    }
+    double total = std::accumulate(gain.begin(), gain.end(), 0.0);
+    if (total > 0.0) {
+        for (double& g : gain) {
+            g /= total;
+        }
+    }
+    return gain;
+}
+
+TreeView GradientBoostedTrees::view() const {
+    TreeView trees;
+    trees.split_feature = split_feature_.data();
+    trees.split_threshold = split_threshold_.data();
+    trees.leaf_value = leaf_value_.data();
+    trees.tree_count = tree_count_;
+    trees.depth = depth_;
+    trees.base_score = base_score_;
+    return trees;
+}
+
+void GradientBoostedTrees::assign(const TreeView& trees, const double* split_gain) {
+    const size_t inner = trees.internal_nodes() * trees.tree_count;
+    const size_t leaves = trees.leaves() * trees.tree_count;
+    depth_ = trees.depth;
+    tree_count_ = trees.tree_count;
+    base_score_ = trees.base_score;
+    split_feature_.assign(trees.split_feature, trees.split_feature + inner);
+    split_threshold_.assign(trees.split_threshold, trees.split_threshold + inner);
+    split_gain_.assign(split_gain, split_gain + inner);
+    leaf_value_.assign(trees.leaf_value, trees.leaf_value + leaves);
+    edges_.clear();
+    head_ = 0;
+    size_ = 0;
+}
+
+void GradientBoostedTrees::refit(size_t rounds) {
+    double positives = 0.0;
+    for (size_t slot = 0; slot < size_; ++slot) {
+        positives += targets_[slot];
+    }
+    double p = std::clamp(positives / static_cast<double>(size_), 1e-6, 1.0 - 1e-6);
+    base_score_ = std::log(p / (1.0 - p));
+    depth_ = config_.max_depth;
+    tree_count_ = 0;
+    split_feature_.clear();
+    split_threshold_.clear();
+    split_gain_.clear();
+    leaf_value_.clear();
+    std::fill(scores_.begin(), scores_.begin() + size_, base_score_);
+
+    compute_bins();
+    for (size_t r = 0; r < rounds; ++r) {
+        grow_tree();
+    }
+}
+
+void GradientBoostedTrees::compute_bins() {
+    const size_t n = feature_count_;
+    const size_t bins = config_.histogram_bins;
+    edges_.assign(n, {});
+    std::vector<double> column(size_);
+    for (size_t f = 0; f < n; ++f) {
+        for (size_t slot = 0; slot < size_; ++slot) {
+            column[slot] = features_[slot * n + f];
+        }
+        std::sort(column.begin(), column.end());
+        std::vector<double>& edges = edges_[f];
+        for (size_t k = 1; k < bins; ++k) {
+            double edge = column[std::min(size_ - 1, k * size_ / bins)];
+            // An edge at the maximum would leave the last bin empty
+            if (edge < column.back() && (edges.empty() || edge > edges.back())) {
+                edges.push_back(edge);
+            }
+        }
+    }
+    bin_stride_ = 1;
+    for (const auto& edges : edges_) {
+        bin_stride_ = std::max(bin_stride_, edges.size() + 1);
+    }
+    for (size_t slot = 0; slot < size_; ++slot) {
+        bin_row(slot);
+    }
+}
+
+void GradientBoostedTrees::bin_row(size_t slot) {
+    const size_t n = feature_count_;
+    for (size_t f = 0; f < n; ++f) {
+        const std::vector<double>& edges = edges_[f];
+        double x = features_[slot * n + f];
+        codes_[slot * n + f] = static_cast<uint8_t>(std::lower_bound(edges.begin(), edges.end(), x) - edges.begin());
+    }
+}
+
+void GradientBoostedTrees::grow_tree() {
+    const size_t tree = tree_count_;
+    const size_t inner = (size_t(1) << depth_) - 1;
+    split_feature_.resize((tree + 1) * inner, 0);
+    split_threshold_.resize((tree + 1) * inner, 0.0);
+    split_gain_.resize((tree + 1) * inner, 0.0);
+    leaf_value_.resize((tree + 1) * (inner + 1), 0.0);
+
+    gradients_.resize(size_);
+    hessians_.resize(size_);
+    rows_.resize(size_);
+    for (size_t slot = 0; slot < size_; ++slot) {
+        double p = sigmoid(scores_[slot]);
+        gradients_[slot] = p - targets_[slot];
+        hessians_[slot] = std::max(p * (1.0 - p), kMinHessian);
+        rows_[slot] = static_cast<uint32_t>(slot);
+    }
+    grow_node(tree, 0, 0, 0, size_);
+    ++tree_count_;
+}
+
+void GradientBoostedTrees::grow_node(size_t tree, size_t node, size_t level, size_t begin, size_t end) {
+    if (level == depth_ || end - begin < config_.min_samples_split) {
+        make_leaf(tree, node, level, begin, end);
+        return;
+    }
+
+    // Gradient and hessian sums per feature and bin over this node's rows
+    const size_t n = feature_count_;
+    histogram_.assign(n * bin_stride_, Histogram{0.0, 0.0});
+    double g_total = 0.0;
+    double h_total = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const size_t slot = rows_[i];
+        const double g = gradients_[slot];
+        const double h = hessians_[slot];
+        g_total += g;
+        h_total += h;
+        const uint8_t* codes = codes_.data() + slot * n;
+        for (size_t f = 0; f < n; ++f) {
+            Histogram& bin = histogram_[f * bin_stride_ + codes[f]];
+            bin.gradient += g;
+            bin.hessian += h;
+        }
+    }
+
+    const double l2 = config_.l2;
+    const double parent = g_total * g_total / (h_total + l2);
+    double best_gain = 0.0;
+    size_t best_feature = 0;
+    size_t best_bin = 0;
+    for (size_t f = 0; f < n; ++f) {
+        const size_t bins = edges_[f].size() + 1;
+        double g_left = 0.0;
+        double h_left = 0.0;
+        for (size_t b = 0; b + 1 < bins; ++b) {
+            g_left += histogram_[f * bin_stride_ + b].gradient;
+            h_left += histogram_[f * bin_stride_ + b].hessian;
+            double h_right = h_total - h_left;
+            if (h_left < kMinHessian || h_right < kMinHessian) {
+                continue;
+            }
+            double g_right = g_total - g_left;
+            double gain = g_left * g_left / (h_left + l2) + g_right * g_right / (h_right + l2) - parent;
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_feature = f;
+                best_bin = b;
+            }
+        }
+    }
+    if (best_gain <= 1e-12) {
+        make_leaf(tree, node, level, begin, end);
+        return;
+    }
+
+    const size_t index = tree * ((size_t(1) << depth_) - 1) + node;
+    split_feature_[index] = static_cast<uint32_t>(best_feature);
+    split_threshold_[index] = edges_[best_feature][best_bin];
+    split_gain_[index] = best_gain;
+    auto middle = std::partition(rows_.begin() + begin, rows_.begin() + end, [&](uint32_t slot) {
+        return codes_[slot * n + best_feature] <= best_bin;
+    });
+    size_t mid = static_cast<size_t>(middle - rows_.begin());
+    grow_node(tree, 2 * node + 1, level + 1, begin, mid);
+    grow_node(tree, 2 * node + 2, level + 1, mid, end);
+}
+
+void GradientBoostedTrees::make_leaf(size_t tree, size_t node, size_t level, size_t begin, size_t end) {
+    double g = 0.0;
+    double h = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        g += gradients_[rows_[i]];
+        h += hessians_[rows_[i]];
+    }
+    const double denominator = h + config_.l2;
+    const double value = denominator > 0.0 ? -config_.shrinkage * g / denominator : 0.0;
+
+    // Unsplit internal descendants send rows left; every leaf below gets the value
+    const size_t inner = (size_t(1) << depth_) - 1;
+    for (size_t l = level; l < depth_; ++l) {
+        size_t width = size_t(1) << (l - level);
+        size_t first = (node + 1) * width - 1;
+        for (size_t k = 0; k < width; ++k) {
+            size_t index = tree * inner + first + k;
+            split_feature_[index] = 0;
+            split_threshold_[index] = std::numeric_limits<double>::infinity();
+            split_gain_[index] = 0.0;
+        }
+    }
+    size_t width = size_t(1) << (depth_ - level);
+    size_t first = (node + 1) * width - 1 - inner;
+    std::fill_n(leaf_value_.begin() + tree * (inner + 1) + first, width, value);
+
+    for (size_t i = begin; i < end; ++i) {
+        scores_[rows_[i]] += value;
+    }
+}
+
+double GradientBoostedTrees::mean_loss() const {
+    double loss = 0.0;
+    for (size_t slot = 0; slot < size_; ++slot) {
+        double p = sigmoid(scores_[slot]);
+        double y = targets_[slot];
+        loss -= y * std::log(std::max(p, kMinProbability)) +
+                (1.0 - y) * std::log(std::max(1.0 - p, kMinProbability));
+    }
+    return loss / static_cast<double>(size_);
+}
+
+} // namespace sync
+} // namespace chronovyan
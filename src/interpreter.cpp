@@ -1,10 +1,88 @@
 #include "interpreter.h"
 #include "error_handler.h"
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <sstream>
 
 namespace chronovyan {
 
+namespace {
+
+// CONF/REB mixes that add up to one level of paradox
+constexpr int kMixesPerParadoxLevel = 16;
+
+// Runtime costs of one loop iteration
+constexpr double kForChrononCost = 1.0;       // chronons
+constexpr double kWhileEventCost = 2.0;       // chronons
+constexpr double kTemporalEchoCost = 20.0;    // aethel
+constexpr int64_t kMaxEchoTimelines = 10;
+
+#if CHRONOVYAN_LOOP_PROFILING
+// Samples one execution of a loop into its profiler site. The
+// interpreter's running totals are diffed around each iteration; the
+// resources and time of the whole execution are recorded when the probe
+// goes out of scope, so a loop cut short by an exception still counts.
+// With no site every call is a single branch. A depth counter, if given,
+// is held one higher for the probe's lifetime.
+class LoopProbe {
+public:
+    LoopProbe(LoopSite* site, const LoopIterationSample& totals, const TemporalRuntime& runtime,
+              uint64_t* depth = nullptr)
+        : m_site(site), m_totals(totals), m_runtime(runtime), m_depth(depth) {
+        if (m_depth) {
+            ++*m_depth;
+        }
+        if (m_site) {
+            m_mark = m_totals;
+            m_resources = resourceLevel();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    
+    ~LoopProbe() {
+        if (m_depth) {
+            --*m_depth;
+        }
+        if (m_site) {
+            m_site->record_execution(std::max(0.0, m_resources - resourceLevel()),
+                                     std::chrono::steady_clock::now() - m_start);
+        }
+    }
+    
+    LoopProbe(const LoopProbe&) = delete;
+    LoopProbe& operator=(const LoopProbe&) = delete;
+    
+    void iteration() {
+        if (!m_site) {
+            return;
+        }
+        LoopIterationSample sample;
+        sample.operations = m_totals.operations - m_mark.operations;
+        sample.reb_operations = m_totals.reb_operations - m_mark.reb_operations;
+        sample.direct_references = m_totals.direct_references - m_mark.direct_references;
+        sample.indirect_references = m_totals.indirect_references - m_mark.indirect_references;
+        m_site->record_iteration(sample);
+        m_mark = m_totals;
+    }
+    
+private:
+    double resourceLevel() const {
+        return m_runtime.getChrononsLevel() + m_runtime.getAethelLevel();
+    }
+    
+    LoopSite* m_site;
+    const LoopIterationSample& m_totals;
+    const TemporalRuntime& m_runtime;
+    uint64_t* m_depth;
+    LoopIterationSample m_mark;
+    double m_resources = 0.0;
+    std::chrono::steady_clock::time_point m_start;
+};
+#endif
+
+} // namespace
+
 Interpreter::Interpreter() 
     : m_globals(std::make_shared<Environment>()),
       m_environment(m_globals),
@@ -15,8 +93,10 @@ Interpreter::Interpreter()
 
 Value Interpreter::interpret(const ProgramNode& program) {
     try {
-        visitProgram(program);
-        return m_lastValue;
+        return run(program);
+    } catch (const ChronovyanRuntimeError& e) {
+        ErrorHandler::getInstance().reportError(e.getLocation(), e.what());
+        return Value(); // Return nil
     } catch (const ChronovyanException& e) {
         // Already handled by the error system
         return Value(); // Return nil
@@ -28,6 +108,29 @@ Value Interpreter::interpret(const ProgramNode& program) {
     }
 }
 
+Value Interpreter::run(const ProgramNode& program) {
+    visitProgram(program);
+    return m_lastValue;
+}
+
+void Interpreter::reset() {
+    m_globals = std::make_shared<Environment>();
+    m_environment = m_globals;
+    m_runtime = std::make_shared<TemporalRuntime>();
+    m_lastValue = Value();
+    m_returnValues = std::stack<Value>();
+    m_isReturning = false;
+    m_isBreaking = false;
+    m_isContinuing = false;
+    m_paradoxOperations = 0;
+    m_unresolvedParadoxes = 0;
+#if CHRONOVYAN_LOOP_PROFILING
+    m_loopTotals = LoopIterationSample();
+    m_echoLoopDepth = 0;
+#endif
+    defineNativeFunctions();
+}
+
 void Interpreter::execute(const StmtNode& stmt) {
     stmt.accept(*this);
 }
@@ -49,6 +152,24 @@ std::shared_ptr<Environment> Interpreter::getCurrentEnvironment() const {
     return m_environment;
 }
 
+void Interpreter::setExecutionProfile(const ExecutionProfile& profile) {
+    m_profile->echoHistoryCapacity.store(profile.echo_history_capacity, std::memory_order_relaxed);
+    m_profile->weaverOutcomes.store(profile.weaver_outcomes, std::memory_order_relaxed);
+    m_profile->paradoxTracking.store(profile.paradox_tracking, std::memory_order_relaxed);
+}
+
+uint64_t Interpreter::getParadoxOperationCount() const {
+    return m_paradoxOperations;
+}
+
+void Interpreter::setLoopProfiler(std::shared_ptr<LoopProfiler> profiler) {
+    m_loopProfiler = std::move(profiler);
+}
+
+std::shared_ptr<LoopProfiler> Interpreter::getLoopProfiler() const {
+    return m_loopProfiler;
+}
+
 // Visitor methods for expressions
 
 void Interpreter::visitLiteralExpr(const LiteralExprNode& expr) {
@@ -160,6 +281,13 @@ void Interpreter::visitBinaryExpr(const BinaryExprNode& expr) {
             throw std::runtime_error("Unknown binary operator");
     }
     
+#if CHRONOVYAN_LOOP_PROFILING
+    ++m_loopTotals.operations;
+    if (left.getModifier() == VariableModifier::REB || right.getModifier() == VariableModifier::REB) {
+        ++m_loopTotals.reb_operations;
+    }
+#endif
+    
     // Update paradox level based on CONF/REB interaction
     updateParadoxLevel(left, right, expr.getOperator().type);
 }
@@ -171,6 +299,18 @@ void Interpreter::visitGroupingExpr(const GroupingExprNode& expr) {
 void Interpreter::visitAssignExpr(const AssignExprNode& expr) {
     Value value = evaluate(expr.getValue());
     
+    // ECHO variables keep their flags and a bounded history of previous values
+    auto target = m_environment->getReference(expr.getName());
+    if (target && target->get().hasFlag(VariableFlag::ECHO) &&
+        !target->get().hasFlag(VariableFlag::STATIC)) {
+        target->get().echoAssign(value, m_profile->echoHistoryCapacity.load(std::memory_order_relaxed));
+#if CHRONOVYAN_LOOP_PROFILING
+        ++m_loopTotals.direct_references;
+#endif
+        m_lastValue = value;
+        return;
+    }
+    
     // Handle variable assignment
     m_environment->assign(expr.getName(), value);
     m_lastValue = value;
@@ -283,23 +423,57 @@ void Interpreter::executeBlock(const BlockStmtNode& block, std::shared_ptr<Envir
 }
 
 Value Interpreter::lookUpVariable(const std::string& name, const SourceLocation& location) {
-    try {
-        return m_environment->get(name);
-    } catch (const std::exception& e) {
-        ErrorHandler::getInstance().reportError(location, 
-            "Undefined variable '" + name + "'");
-        throw;
+    auto variable = m_environment->getReference(name);
+    if (!variable) {
+        throw ChronovyanRuntimeError("Undefined variable '" + name + "'", location);
     }
+    
+    // Reading a WEAVER variable samples its distribution, limited to the
+    // most probable outcomes the current profile allows; the distribution
+    // itself is kept whole
+    const Value& value = variable->get();
+#if CHRONOVYAN_LOOP_PROFILING
+    if (value.hasFlag(VariableFlag::ECHO)) {
+        ++m_loopTotals.indirect_references;
+    }
+#endif
+    if (value.hasFlag(VariableFlag::WEAVER) && !value.getProbabilisticValue().empty()) {
+        return value.resolveProbabilisticValue(m_profile->weaverOutcomes.load(std::memory_order_relaxed));
+    }
+    return value;
 }
 
 // Placeholder implementations for temporal operations
 
 void Interpreter::executeForChronon(const TemporalOpStmtNode& stmt) {
-    // Placeholder implementation
+    const int64_t count = evaluateLoopCount(stmt);
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopProbe probe(profiledLoopSite(stmt, LoopKind::ForChronon), m_loopTotals, *m_runtime);
+#endif
+    for (int64_t i = 0; i < count; ++i) {
+        m_runtime->consumeChronons(kForChrononCost);
+        executeBlock(stmt.getBody(), std::make_shared<Environment>(m_environment));
+#if CHRONOVYAN_LOOP_PROFILING
+        probe.iteration();
+#endif
+    }
 }
 
 void Interpreter::executeWhileEvent(const TemporalOpStmtNode& stmt) {
-    // Placeholder implementation
+    if (stmt.getArguments().empty()) {
+        throw ChronovyanRuntimeError("WHILE_EVENT requires a condition", stmt.getLocation());
+    }
+    const ExprNode& condition = *stmt.getArguments().front();
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopProbe probe(profiledLoopSite(stmt, LoopKind::WhileEvent), m_loopTotals, *m_runtime);
+#endif
+    while (evaluate(condition).asBoolean()) {
+        m_runtime->consumeChronons(kWhileEventCost);
+        executeBlock(stmt.getBody(), std::make_shared<Environment>(m_environment));
+#if CHRONOVYAN_LOOP_PROFILING
+        probe.iteration();
+#endif
+    }
 }
 
 void Interpreter::executeRewindFlow(const TemporalOpStmtNode& stmt) {
@@ -315,15 +489,68 @@ void Interpreter::executeMergeTimelines(const TemporalOpStmtNode& stmt) {
 }
 
 void Interpreter::executeTemporalEchoLoop(const TemporalOpStmtNode& stmt) {
-    // Placeholder implementation
+    // Echo timelines run one after another; each sees the previous one's writes
+    const int64_t count = std::min(evaluateLoopCount(stmt), kMaxEchoTimelines);
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopProbe probe(profiledLoopSite(stmt, LoopKind::TemporalEchoLoop), m_loopTotals, *m_runtime,
+                    &m_echoLoopDepth);
+#endif
+    for (int64_t i = 0; i < count; ++i) {
+        m_runtime->consumeAethel(kTemporalEchoCost);
+        executeBlock(stmt.getBody(), std::make_shared<Environment>(m_environment));
+#if CHRONOVYAN_LOOP_PROFILING
+        // Each echo refers back to the previous timeline of every
+        // enclosing echo loop
+        m_loopTotals.direct_references += m_echoLoopDepth;
+        probe.iteration();
+#endif
+    }
+}
+
+int64_t Interpreter::evaluateLoopCount(const TemporalOpStmtNode& stmt) {
+    if (stmt.getArguments().empty()) {
+        throw ChronovyanRuntimeError("Temporal loop requires an iteration count", stmt.getLocation());
+    }
+    Value count = evaluate(*stmt.getArguments().front());
+    if (!count.isNumeric()) {
+        throw ChronovyanRuntimeError("Temporal loop iteration count must be numeric", stmt.getLocation());
+    }
+    return std::max<int64_t>(0, count.asInteger());
 }
 
+#if CHRONOVYAN_LOOP_PROFILING
+LoopSite* Interpreter::profiledLoopSite(const TemporalOpStmtNode& stmt, LoopKind kind) {
+    if (!m_loopProfiler || !m_loopProfiler->enabled()) {
+        return nullptr;
+    }
+    if (LoopSite* site = m_loopProfiler->find(stmt.getSiteId())) {
+        return site;
+    }
+    return &m_loopProfiler->site(stmt.getSiteId(), kind, stmt.getLocation().toString());
+}
+#endif
+
 void Interpreter::defineNativeFunctions() {
     // Define native functions here
 }
 
-void Interpreter::updateParadoxLevel(const Value& left, const Value& right, TokenType operation) {
-    // Placeholder for paradox management
+void Interpreter::updateParadoxLevel(const Value& left, const Value& right, TokenType /*operation*/) {
+    if (!m_profile->paradoxTracking.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    bool leftRebel = left.getModifier() == VariableModifier::REB;
+    bool rightRebel = right.getModifier() == VariableModifier::REB;
+    if (!leftRebel && !rightRebel) {
+        return;
+    }
+    ++m_paradoxOperations;
+    
+    // Mixing CONF and REB values is what destabilizes the timeline
+    if (leftRebel != rightRebel && ++m_unresolvedParadoxes >= kMixesPerParadoxLevel) {
+        m_unresolvedParadoxes = 0;
+        m_runtime->increaseParadoxLevel();
+    }
 }
 
 Value Interpreter::handleVariableInteraction(const Value& left, const Value& right, TokenType operation) {
@@ -0,0 +1,137 @@
+#include "chronovyan/log_sink.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace chronovyan {
+
+namespace {
+
+constexpr auto kDrainInterval = std::chrono::milliseconds(20);
+
+} // namespace
+
+const char* to_string(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warn: return "warn";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: return "off";
+    }
+    return "unknown";
+}
+
+LogSink& LogSink::instance() {
+    static LogSink sink;
+    static std::once_flag started;
+    std::call_once(started, [] { sink.start(); });
+    return sink;
+}
+
+LogSink::LogSink(size_t capacity, LogLevel level)
+    : level_(level),
+      queue_(capacity),
+      writer_([](const LogRecord& record) { std::clog << format(record) << '\n'; }) {}
+
+LogSink::~LogSink() {
+    stop();
+}
+
+bool LogSink::log(LogLevel level, const char* message, std::initializer_list<double> values) {
+    if (!enabled(level)) {
+        return false;
+    }
+
+    bool queued = queue_.try_emplace([&](LogRecord& record) {
+        record.level = level;
+        record.time = std::chrono::system_clock::now();
+        record.message = message;
+        record.value_count = static_cast<uint8_t>(std::min(values.size(), LogRecord::kMaxValues));
+        std::copy_n(values.begin(), record.value_count, record.values.begin());
+    });
+    if (!queued) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (level >= LogLevel::Warn) {
+        wake_.notify_one();
+    }
+    return true;
+}
+
+size_t LogSink::drain() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    size_t written = 0;
+    LogRecord record;
+    while (queue_.try_pop(record)) {
+        if (writer_) {
+            writer_(record);
+        }
+        ++written;
+    }
+    return written;
+}
+
+void LogSink::set_writer(Writer writer) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    writer_ = std::move(writer);
+}
+
+void LogSink::start() {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread([this] { run(); });
+}
+
+void LogSink::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    drain();
+}
+
+void LogSink::run() {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while (running_) {
+        lock.unlock();
+        drain();
+        lock.lock();
+        if (running_) {
+            // Woken early by warnings and errors, and by stop()
+            wake_.wait_for(lock, kDrainInterval);
+        }
+    }
+}
+
+std::string LogSink::format(const LogRecord& record) {
+    std::string text = "[";
+    text += to_string(record.level);
+    text += "] ";
+    text += record.message;
+    if (record.value_count > 0) {
+        text += " (";
+        char number[32];
+        for (uint8_t i = 0; i < record.value_count; ++i) {
+            std::snprintf(number, sizeof(number), "%g", record.values[i]);
+            if (i > 0) {
+                text += ", ";
+            }
+            text += number;
+        }
+        text += ")";
+    }
+    return text;
+}
+
+} // namespace chronovyan
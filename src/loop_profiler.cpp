@@ -0,0 +1,257 @@
+#include "chronovyan/loop_profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <utility>
+
+namespace chronovyan {
+
+namespace {
+
+struct AlertThresholds {
+    double warning;
+    double critical;
+    double emergency;
+    bool lower_is_worse;
+};
+
+// The specification's standard alert thresholds
+AlertThresholds thresholds_for(LoopMetric metric) {
+    switch (metric) {
+        case LoopMetric::LoopEntropy: return {0.4, 0.7, 0.9, false};
+        case LoopMetric::IterationStability: return {0.8, 0.6, 0.4, true};
+        case LoopMetric::ChrononEfficiency: return {0.9, 0.6, 0.3, true};
+        case LoopMetric::RecursionDepth: return {5.0, 8.0, 12.0, false};
+        case LoopMetric::ParadoxPotential: return {0.3, 0.6, 0.8, false};
+    }
+    return {0.0, 0.0, 0.0, false};
+}
+
+constexpr LoopMetric kMetrics[] = {LoopMetric::LoopEntropy, LoopMetric::IterationStability,
+                                   LoopMetric::ChrononEfficiency, LoopMetric::RecursionDepth,
+                                   LoopMetric::ParadoxPotential};
+
+class LoopMetricSource : public IMetricSource {
+public:
+    LoopMetricSource(const LoopProfiler& profiler, LoopMetric metric) : profiler_(profiler), metric_(metric) {}
+
+    double getValue() const override {
+        const double value = profiler_.worst(metric_);
+        double scaled = value;
+        switch (metric_) {
+            case LoopMetric::ChrononEfficiency:
+                scaled = value / 2.0;
+                break;
+            case LoopMetric::RecursionDepth:
+                scaled = value / profiler_.parameters().max_recursion_depth;
+                break;
+            default:
+                break;
+        }
+        return std::clamp(scaled * 100.0, 0.0, 100.0);
+    }
+
+    bool isAvailable() const override {
+        return !profiler_.reports().empty();
+    }
+
+    // The metrics are derived from the counters when read, so a sample is
+    // always current
+    std::chrono::system_clock::time_point getLastUpdateTime() const override {
+        return std::chrono::system_clock::now();
+    }
+
+private:
+    const LoopProfiler& profiler_;
+    const LoopMetric metric_;
+};
+
+} // namespace
+
+const char* to_string(LoopKind kind) {
+    switch (kind) {
+        case LoopKind::ForChronon: return "FOR_CHRONON";
+        case LoopKind::WhileEvent: return "WHILE_EVENT";
+        case LoopKind::TemporalEchoLoop: return "TEMPORAL_ECHO_LOOP";
+    }
+    return "unknown";
+}
+
+const char* to_string(LoopMetric metric) {
+    switch (metric) {
+        case LoopMetric::LoopEntropy: return "LOOP_ENTROPY";
+        case LoopMetric::IterationStability: return "ISQ";
+        case LoopMetric::ChrononEfficiency: return "CER";
+        case LoopMetric::RecursionDepth: return "TRD";
+        case LoopMetric::ParadoxPotential: return "PPI";
+    }
+    return "unknown";
+}
+
+const char* to_string(LoopAlert alert) {
+    switch (alert) {
+        case LoopAlert::None: return "ok";
+        case LoopAlert::Warning: return "warning";
+        case LoopAlert::Critical: return "critical";
+        case LoopAlert::Emergency: return "emergency";
+    }
+    return "unknown";
+}
+
+double LoopMetrics::value(LoopMetric metric) const {
+    switch (metric) {
+        case LoopMetric::LoopEntropy: return loop_entropy;
+        case LoopMetric::IterationStability: return iteration_stability;
+        case LoopMetric::ChrononEfficiency: return chronon_efficiency;
+        case LoopMetric::RecursionDepth: return recursion_depth;
+        case LoopMetric::ParadoxPotential: return paradox_potential;
+    }
+    return 0.0;
+}
+
+LoopSite::LoopSite(LoopKind kind, std::string label) : kind_(kind), label_(std::move(label)) {}
+
+LoopSiteReport LoopSite::report(const LoopMetricParameters& parameters) const {
+    LoopSiteReport report;
+    report.label = label_;
+    report.kind = kind_;
+    report.executions = executions_.load(std::memory_order_relaxed);
+    report.iterations = iterations_.load(std::memory_order_relaxed);
+    report.resources = resources_.load(std::memory_order_relaxed);
+    report.elapsed = std::chrono::nanoseconds(elapsed_ns_.load(std::memory_order_relaxed));
+
+    LoopMetrics& metrics = report.metrics;
+    const double iterations = static_cast<double>(report.iterations);
+    const uint64_t operations = operations_.load(std::memory_order_relaxed);
+    const double reb_ratio = operations == 0 ? 0.0
+        : std::min(1.0, static_cast<double>(reb_operations_.load(std::memory_order_relaxed)) / operations);
+    metrics.loop_entropy = std::min(1.0, parameters.base_entropy +
+                                         iterations * parameters.entropy_factor * reb_ratio * reb_ratio);
+
+    if (report.iterations > 0) {
+        const double mean = work_sum_.load(std::memory_order_relaxed) / iterations;
+        const double variance =
+            std::max(0.0, work_squares_.load(std::memory_order_relaxed) / iterations - mean * mean);
+        const double variation = mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+        metrics.iteration_stability = std::clamp(1.0 - variation / parameters.expected_variation, 0.0, 1.0);
+
+        metrics.recursion_depth =
+            (static_cast<double>(direct_references_.load(std::memory_order_relaxed)) +
+             0.5 * static_cast<double>(indirect_references_.load(std::memory_order_relaxed))) / iterations;
+    }
+    metrics.chronon_efficiency = report.resources > 0.0 ? iterations / report.resources : 1.0;
+
+    metrics.paradox_potential =
+        0.4 * metrics.loop_entropy + 0.3 * (1.0 - metrics.iteration_stability) +
+        0.2 * std::clamp(1.0 - metrics.chronon_efficiency, 0.0, 1.0) +
+        0.1 * std::min(metrics.recursion_depth / parameters.max_recursion_depth, 1.0);
+
+    report.alert = LoopProfiler::alert(metrics);
+    return report;
+}
+
+LoopProfiler::LoopProfiler(const LoopMetricParameters& parameters) : parameters_(parameters) {}
+
+LoopSite& LoopProfiler::site(uint64_t key, LoopKind kind, const std::string& label) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& site = sites_[key];
+    if (!site) {
+        site = std::make_unique<LoopSite>(kind, label);
+    }
+    return *site;
+}
+
+LoopSite* LoopProfiler::find(uint64_t key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sites_.find(key);
+    return it == sites_.end() ? nullptr : it->second.get();
+}
+
+size_t LoopProfiler::site_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sites_.size();
+}
+
+std::vector<LoopSiteReport> LoopProfiler::reports() const {
+    std::vector<LoopSiteReport> reports;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reports.reserve(sites_.size());
+        for (const auto& entry : sites_) {
+            if (entry.second->iterations() > 0) {
+                reports.push_back(entry.second->report(parameters_));
+            }
+        }
+    }
+    std::sort(reports.begin(), reports.end(), [](const LoopSiteReport& a, const LoopSiteReport& b) {
+        if (a.metrics.paradox_potential != b.metrics.paradox_potential) {
+            return a.metrics.paradox_potential > b.metrics.paradox_potential;
+        }
+        return a.label < b.label;
+    });
+    return reports;
+}
+
+double LoopProfiler::worst(LoopMetric metric) const {
+    const bool lower_is_worse = thresholds_for(metric).lower_is_worse;
+    double worst = LoopMetrics().value(metric);
+    bool first = true;
+    for (const auto& report : reports()) {
+        const double value = report.metrics.value(metric);
+        if (first || (lower_is_worse ? value < worst : value > worst)) {
+            worst = value;
+            first = false;
+        }
+    }
+    return worst;
+}
+
+void LoopProfiler::report(std::ostream& out) const {
+    const auto reports = this->reports();
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-28s %-18s %8s %10s %10s %7s %7s %7s %7s %7s  %s\n", "site", "kind",
+                  "runs", "iterations", "ns/iter", "LE", "ISQ", "CER", "TRD", "PPI", "alert");
+    out << "loop stability report (" << reports.size() << " sites)\n" << line;
+    for (const auto& report : reports) {
+        const double ns_per_iteration =
+            static_cast<double>(report.elapsed.count()) / static_cast<double>(report.iterations);
+        std::snprintf(line, sizeof(line), "%-28s %-18s %8llu %10llu %10.0f %7.3f %7.3f %7.3f %7.2f %7.3f  %s\n",
+                      report.label.c_str(), to_string(report.kind),
+                      static_cast<unsigned long long>(report.executions),
+                      static_cast<unsigned long long>(report.iterations), ns_per_iteration,
+                      report.metrics.loop_entropy, report.metrics.iteration_stability,
+                      report.metrics.chronon_efficiency, report.metrics.recursion_depth,
+                      report.metrics.paradox_potential, to_string(report.alert));
+        out << line;
+    }
+}
+
+std::unique_ptr<IMetricSource> LoopProfiler::metric_source(LoopMetric metric) const {
+    return std::make_unique<LoopMetricSource>(*this, metric);
+}
+
+LoopAlert LoopProfiler::alert(LoopMetric metric, double value) {
+    const AlertThresholds t = thresholds_for(metric);
+    auto beyond = [&](double threshold) { return t.lower_is_worse ? value < threshold : value >= threshold; };
+    if (beyond(t.emergency)) {
+        return LoopAlert::Emergency;
+    }
+    if (beyond(t.critical)) {
+        return LoopAlert::Critical;
+    }
+    if (beyond(t.warning)) {
+        return LoopAlert::Warning;
+    }
+    return LoopAlert::None;
+}
+
+LoopAlert LoopProfiler::alert(const LoopMetrics& metrics) {
+    LoopAlert worst = LoopAlert::None;
+    for (LoopMetric metric : kMetrics) {
+        worst = std::max(worst, alert(metric, metrics.value(metric)));
+    }
+    return worst;
+}
+
+} // namespace chronovyan
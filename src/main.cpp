@@ -10,9 +10,34 @@
 #include <memory>
 #include <stdexcept>
 #include <algorithm>
+#include <cstdlib>
 
 using namespace chronovyan;
 
+// Loop stability profiling: with CHRONOVYAN_LOOP_PROFILE set, every
+// interpreter records into one profiler whose report is written at exit,
+// to stderr for "1" or "-" and to the named file otherwise
+namespace {
+
+std::shared_ptr<LoopProfiler> g_loopProfiler;
+
+void writeLoopProfile() {
+    const char* target = std::getenv("CHRONOVYAN_LOOP_PROFILE");
+    std::string path = target ? target : "-";
+    if (path == "1" || path == "-") {
+        g_loopProfiler->report(std::cerr);
+        return;
+    }
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write loop profile to " << path << std::endl;
+        return;
+    }
+    g_loopProfiler->report(out);
+}
+
+} // namespace
+
 // Function prototypes
 void runFile(const std::string& path);
 void runRepl();
@@ -21,6 +46,12 @@ void printHelp();
 bool hasValidExtension(const std::string& filename);
 
 int main(int argc, char* argv[]) {
+    const char* loopProfile = std::getenv("CHRONOVYAN_LOOP_PROFILE");
+    if (loopProfile && *loopProfile && std::string(loopProfile) != "0") {
+        g_loopProfiler = std::make_shared<LoopProfiler>();
+        std::atexit(writeLoopProfile);
+    }
+    
     try {
         if (argc == 1) {
             // No arguments, run REPL
@@ -97,6 +128,7 @@ void runFile(const std::string& path) {
 void runRepl() {
     // Create an interpreter that will persist between lines
     Interpreter interpreter;
+    interpreter.setLoopProfiler(g_loopProfiler);
     
     std::cout << "Chronovyan Language Interpreter (REPL)" << std::endl;
     std::cout << "Type 'exit' to quit, 'help' for help." << std::endl;
@@ -128,7 +160,7 @@ void runRepl() {
 #endif
             continue;
         } else if (line == "reset") {
-            interpreter = Interpreter();
+            interpreter.reset();
             std::cout << "Interpreter state reset." << std::endl;
             continue;
         } else if (line == "paradox") {
@@ -204,6 +236,7 @@ void runString(const std::string& source, const std::string& sourceName) {
         
         // Create an interpreter
         Interpreter interpreter;
+        interpreter.setLoopProfiler(g_loopProfiler);
         
         // Interpret the program
         interpreter.interpret(*program);
@@ -223,5 +256,8 @@ void printHelp() {
     std::cout << "  chronovyan <file.cvy>   Run a Chronovyan script (.cvy file)" << std::endl;
     std::cout << "  chronovyan --help       Display this help message" << std::endl;
     std::cout << std::endl;
+    std::cout << "Set CHRONOVYAN_LOOP_PROFILE=1 to print loop stability metrics at exit," << std::endl;
+    std::cout << "or to a file path to write them there." << std::endl;
+    std::cout << std::endl;
     std::cout << "In the REPL, type 'help' for REPL-specific commands." << std::endl;
 } 
\ No newline at end of file
@@ -1,11 +1,190 @@
 #include "chronovyan/metric_collector.hpp"
+#include "chronovyan/log_sink.hpp"
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <cmath> // For isnan
-#include <iostream> // For std::cout
 
 namespace chronovyan {
 
+namespace {
+
+int64_t to_nanos(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point from_nanos(int64_t nanos) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+int64_t steady_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// Background sampler for one source. The sampling thread is the only
+// writer. Each sample (value, timestamp, flags and failure text) is
+// published under a seqlock, so readers take a consistent copy without
+// locking or allocating and retry only if they overlap a publish.
+struct MetricCollector::Sampler {
+    enum Flags : uint32_t {
+        kHasSample = 1u << 0,
+        kAvailable = 1u << 1,
+        kException = 1u << 2,
+        kTimeout = 1u << 3,
+        kOutOfRange = 1u << 4
+    };
+    static constexpr size_t kMessageWords = 32;  // failure text, NUL-padded, truncated past 255 bytes
+    static constexpr size_t kMessageBytes = kMessageWords * sizeof(uint64_t);
+
+    struct Sample {
+        double value = 0.0;
+        int64_t source_update_nanos = 0;
+        uint32_t flags = 0;
+        char message[kMessageBytes] = {};
+    };
+
+    Sampler(std::string name, MetricHandle handle, IMetricSource* source, SamplingPolicy policy,
+            MetricHistory* history)
+        : name(std::move(name)), handle(handle), source(source), policy(policy), history(history) {}
+
+    void run();
+    void stop();
+    void publish(double sample_value, int64_t updated_nanos, uint32_t sample_flags,
+                 const std::string& error);
+    // Copies the latest sample; the message only when with_message is set
+    void read(Sample& sample, bool with_message) const;
+
+    const std::string name;
+    const MetricHandle handle;
+    IMetricSource* const source;
+    const SamplingPolicy policy;
+    MetricHistory* const history;  // this sampler is the metric's only writer
+
+    // Seqlock: odd while a publish is in progress. The fields are atomics
+    // accessed relaxed so that a torn read is detected rather than undefined.
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<double> value{0.0};
+    std::atomic<int64_t> source_update_nanos{0};
+    std::atomic<uint32_t> flags{0};
+    std::array<std::atomic<uint64_t>, kMessageWords> message{};
+    std::atomic<int64_t> in_flight_since{0};  // steady clock; 0 when idle
+
+    std::mutex wait_mutex;
+    std::condition_variable wake;
+    bool running = true;
+    std::thread thread;
+};
+
+void MetricCollector::Sampler::publish(double sample_value, int64_t updated_nanos,
+                                       uint32_t sample_flags, const std::string& error) {
+    uint64_t words[kMessageWords] = {};
+    std::memcpy(words, error.data(), std::min(error.size(), kMessageBytes - 1));
+
+    uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    value.store(sample_value, std::memory_order_relaxed);
+    source_update_nanos.store(updated_nanos, std::memory_order_relaxed);
+    flags.store(sample_flags | kHasSample, std::memory_order_relaxed);
+    for (size_t i = 0; i < kMessageWords; ++i) {
+        message[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+void MetricCollector::Sampler::read(Sample& sample, bool with_message) const {
+    uint64_t words[kMessageWords];
+    for (;;) {
+        uint32_t start = sequence.load(std::memory_order_acquire);
+        if (start & 1u) {
+            std::this_thread::yield();
+            continue;
+        }
+        sample.value = value.load(std::memory_order_relaxed);
+        sample.source_update_nanos = source_update_nanos.load(std::memory_order_relaxed);
+        sample.flags = flags.load(std::memory_order_relaxed);
+        if (with_message) {
+            for (size_t i = 0; i < kMessageWords; ++i) {
+                words[i] = message[i].load(std::memory_order_relaxed);
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == start) {
+            break;
+        }
+    }
+    if (with_message) {
+        std::memcpy(sample.message, words, kMessageBytes);
+        sample.message[kMessageBytes - 1] = '\0';
+    }
+}
+
+void MetricCollector::Sampler::run() {
+    const int64_t timeout_nanos = std::chrono::nanoseconds(policy.timeout).count();
+    auto next = std::chrono::steady_clock::now();
+    for (;;) {
+        int64_t started = steady_nanos();
+        in_flight_since.store(started, std::memory_order_release);
+        try {
+            bool available = source->isAvailable();
+            double sample = available ? source->getValue() : kDefaultCpuUsage;
+            int64_t elapsed = steady_nanos() - started;
+            int64_t updated = to_nanos(source->getLastUpdateTime());
+            if (elapsed > timeout_nanos) {
+                publish(kDefaultCpuUsage, updated, kException | kTimeout,
+                        "Timeout in metric source (took " +
+                        std::to_string(elapsed / 1000000) + "ms)");
+            } else {
+                uint32_t sample_flags = available ? kAvailable : 0u;
+                if (std::isnan(sample) || sample < 0.0 || sample > 100.0) {
+                    sample_flags |= kOutOfRange;
+                    sample = std::isnan(sample) ? kDefaultCpuUsage : std::clamp(sample, 0.0, 100.0);
+                }
+                publish(sample, updated, sample_flags, {});
+                if (available) {
+                    history->record(handle, std::chrono::system_clock::now(), sample);
+                }
+            }
+        } catch (const std::exception& e) {
+            publish(kDefaultCpuUsage, 0, kException,
+                    std::string("Exception in metric source: ") + e.what());
+        }
+        in_flight_since.store(0, std::memory_order_release);
+
+        // Fixed cadence; a sample that overran skips the missed slots
+        next += policy.interval;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now;
+        }
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        if (wake.wait_until(lock, next, [this] { return !running; })) {
+            return;
+        }
+    }
+}
+
+void MetricCollector::Sampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex);
+        running = false;
+    }
+    wake.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
 // Initialize static member
 bool MetricCollector::force_refresh_for_testing_ = false;
 
@@ -31,14 +210,35 @@ MetricCollector::MetricCollector(
     sources_["cpu"] = cpu_source_;
     sources_["memory"] = memory_source_;
     sources_["gpu"] = gpu_source_;
+    
+    history_.track(MetricRegistry::kCpu);
+    history_.track(MetricRegistry::kMemory);
+    history_.track(MetricRegistry::kGpu);
+}
+
+MetricCollector::~MetricCollector() {
+    stopSampling();
 }
 
 void MetricCollector::addSource(const std::string& name, IMetricSource* source) {
+    addSource(name, source, SamplingPolicy());
+}
+
+void MetricCollector::addSource(const std::string& name, IMetricSource* source,
+                                const SamplingPolicy& policy) {
     if (!source) {
         throw std::invalid_argument("Cannot add null source");
     }
+    if (policy.interval.count() <= 0 || policy.timeout.count() <= 0) {
+        throw std::invalid_argument("Sampling interval and timeout must be positive");
+    }
+    if (isSampling()) {
+        throw std::logic_error("Cannot add sources while sampling");
+    }
     
     sources_[name] = source;
+    policies_[name] = policy;
+    history_.track(MetricRegistry::instance().register_metric(name));
     
     // Set legacy fields if appropriate
     if (name == "cpu") {
@@ -59,7 +259,104 @@ bool MetricCollector::getForceRefreshForTesting() {
     return force_refresh_for_testing_;
 }
 
+void MetricCollector::startSampling() {
+    if (sampling_.load()) {
+        return;
+    }
+    if (sources_.empty()) {
+        throw std::logic_error("No metric sources registered");
+    }
+    for (const auto& entry : sources_) {
+        samplers_.push_back(std::make_unique<Sampler>(
+            entry.first, MetricRegistry::instance().register_metric(entry.first), entry.second,
+            policy_for(entry.first), &history_));
+    }
+    for (auto& sampler : samplers_) {
+        Sampler* raw = sampler.get();
+        raw->thread = std::thread([raw] { raw->run(); });
+    }
+    sampling_.store(true, std::memory_order_release);
+}
+
+void MetricCollector::stopSampling() {
+    if (!sampling_.exchange(false)) {
+        return;
+    }
+    for (auto& sampler : samplers_) {
+        sampler->stop();
+    }
+    samplers_.clear();
+}
+
+bool MetricCollector::isSampling() const {
+    return sampling_.load(std::memory_order_acquire);
+}
+
+SystemMetrics MetricCollector::read_snapshot() const {
+    SystemMetrics metrics;
+    const int64_t now_steady = steady_nanos();
+    const auto now = std::chrono::system_clock::now();
+    
+    Sampler::Sample sample;
+    for (const auto& sampler : samplers_) {
+        // The failure text is copied only while no failure has been reported
+        sampler->read(sample, !metrics.has_exception);
+        const uint32_t flags = sample.flags;
+        MetricData data;
+        data.value = sample.value;
+        data.timestamp = from_nanos(sample.source_update_nanos);
+        data.is_available = (flags & Sampler::kAvailable) != 0;
+        
+        // A sample still running past its deadline is a timeout now, not
+        // when (or if) the source eventually returns
+        int64_t in_flight = sampler->in_flight_since.load(std::memory_order_acquire);
+        bool overdue = in_flight != 0 &&
+            now_steady - in_flight > std::chrono::nanoseconds(sampler->policy.timeout).count();
+        bool timed_out = overdue || (flags & Sampler::kTimeout);
+        bool failed = timed_out || (flags & Sampler::kException);
+        if (failed) {
+            data.value = kDefaultCpuUsage;
+            data.is_available = false;
+            if (!metrics.has_exception) {
+                metrics.has_exception = true;
+                metrics.has_timeout = timed_out;
+                metrics.exception_metric = sampler->handle;
+                metrics.exception_source = sampler->name;
+                if (timed_out) {
+                    metrics.exception_message = "Timeout detected in " + sampler->name + " metric source";
+                } else {
+                    metrics.exception_message = sample.message;
+                }
+            }
+        }
+        
+        if (data.is_available && (flags & Sampler::kOutOfRange)) {
+            metrics.has_out_of_range = true;
+        }
+        
+        if (!force_refresh_for_testing_ &&
+            (!(flags & Sampler::kHasSample) || !data.is_available ||
+             now - data.timestamp > kStaleThreshold)) {
+            metrics.is_stale = true;
+        }
+        
+        if (sampler->handle == MetricRegistry::kCpu) {
+            metrics.cpu_usage = data.value;
+        } else if (sampler->handle == MetricRegistry::kMemory) {
+            metrics.memory_usage = data.value;
+        } else if (sampler->handle == MetricRegistry::kGpu) {
+            metrics.gpu_usage = data.value;
+        }
+        metrics.metrics[sampler->handle] = data;
+    }
+    return metrics;
+}
+
 SystemMetrics MetricCollector::collect_metrics() const {
+    if (isSampling()) {
+        return read_snapshot();
+    }
+    
     SystemMetrics metrics;
     metrics.is_valid = true;
     metrics.has_exception = false;
@@ -87,9 +384,9 @@ SystemMetrics MetricCollector::collect_metrics() const {
             false // Explicitly set to unavailable
         };
         
-        metrics.metrics["cpu"] = zero_metric;
-        metrics.metrics["memory"] = zero_metric;
-        metrics.metrics["gpu"] = zero_metric;
+        metrics.metrics[MetricRegistry::kCpu] = zero_metric;
+        metrics.metrics[MetricRegistry::kMemory] = zero_metric;
+        metrics.metrics[MetricRegistry::kGpu] = zero_metric;
         
         return metrics;
     }
@@ -101,88 +398,50 @@ SystemMetrics MetricCollector::collect_metrics() const {
         bool memory_is_available = memory_source_->isAvailable();
         bool gpu_is_available = gpu_source_->isAvailable();
         
-        std::cout << "DEBUG MetricCollector - Source availability: CPU=" 
-                  << (cpu_is_available ? "AVAILABLE" : "UNAVAILABLE")
-                  << ", Memory=" << (memory_is_available ? "AVAILABLE" : "UNAVAILABLE")
-                  << ", GPU=" << (gpu_is_available ? "AVAILABLE" : "UNAVAILABLE") << std::endl;
+        LogSink& log = LogSink::instance();
+        if (log.enabled(LogLevel::Debug)) {
+            log.log(LogLevel::Debug, "collector source availability (cpu, memory, gpu)",
+                    {double(cpu_is_available), double(memory_is_available), double(gpu_is_available)});
+        }
         
-        // Try to collect CPU metrics
-        double cpu_value = collect_metric(cpu_source_);
-        // Check if a timeout or exception was recorded
-        if (!last_error_.empty()) {
-            metrics.has_exception = true;
-            metrics.exception_source = "cpu";
-            metrics.exception_message = last_error_;
-            
-            // Mark cpu as unavailable to prevent this from being detected as a partial sensor failure case
-            cpu_is_available = false;
-            
-            // Check specifically for timeout using a more reliable check
-            if (last_error_.find("Timeout") != std::string::npos || 
-                last_error_.find("timeout") != std::string::npos) {
-                metrics.exception_message = "Timeout detected in CPU metric source";
-                
-                // Print debug info to help diagnose tests
-                std::cout << "DEBUG: CPU Timeout detected: " << last_error_ << std::endl;
-            } else {
-                // Print debug info for exception cases
-                std::cout << "DEBUG: CPU Exception detected: " << last_error_ << std::endl;
+        // Poll each source; the first one that throws or overruns its
+        // deadline is reported as the exception source
+        auto record_fault = [&](SampleStatus status, MetricHandle handle, const char* source_name,
+                                const char* display_name, bool& is_available) {
+            if (status == SampleStatus::OutOfRange) {
+                metrics.has_out_of_range = true;
+                return;
             }
-            
-            last_error_.clear();
-        }
-    
-        // Try to collect Memory metrics
-        double memory_value = collect_metric(memory_source_);
-        // Check if a timeout or exception was recorded
-        if (!last_error_.empty() && !metrics.has_exception) {
-            metrics.has_exception = true;
-            metrics.exception_source = "memory";
-            metrics.exception_message = last_error_;
-            
-            // Mark memory as unavailable to prevent this from being detected as a partial sensor failure case
-            memory_is_available = false;
-            
-            // Check specifically for timeout
-            if (last_error_.find("Timeout") != std::string::npos || 
-                last_error_.find("timeout") != std::string::npos) {
-                metrics.exception_message = "Timeout detected in Memory metric source";
-                
-                // Print debug info to help diagnose tests
-                std::cout << "DEBUG: Memory Timeout detected: " << last_error_ << std::endl;
-            } else {
-                // Print debug info for exception cases
-                std::cout << "DEBUG: Memory Exception detected: " << last_error_ << std::endl;
+            if ((status != SampleStatus::Exception && status != SampleStatus::Timeout) ||
+                metrics.has_exception) {
+                return;
             }
-            
-            last_error_.clear();
-        }
-    
-        // Try to collect GPU metrics
-        double gpu_value = collect_metric(gpu_source_);
-        // Check if a timeout or exception was recorded
-        if (!last_error_.empty() && !metrics.has_exception) {
             metrics.has_exception = true;
-            metrics.exception_source = "gpu";
+            metrics.exception_metric = handle;
+            metrics.exception_source = source_name;
             metrics.exception_message = last_error_;
             
-            // Mark gpu as unavailable to prevent this from being detected as a partial sensor failure case
-            gpu_is_available = false;
+            // Mark the source as unavailable to prevent this from being detected as a partial sensor failure case
+            is_available = false;
             
-            // Check specifically for timeout
-            if (last_error_.find("Timeout") != std::string::npos || 
-                last_error_.find("timeout") != std::string::npos) {
-                metrics.exception_message = "Timeout detected in GPU metric source";
-                
-                // Print debug info to help diagnose tests
-                std::cout << "DEBUG: GPU Timeout detected: " << last_error_ << std::endl;
+            if (status == SampleStatus::Timeout) {
+                metrics.has_timeout = true;
+                metrics.exception_message = std::string("Timeout detected in ") + display_name + " metric source";
+                log.log(LogLevel::Warn, "collector source timed out");
             } else {
-                // Print debug info for exception cases
-                std::cout << "DEBUG: GPU Exception detected: " << last_error_ << std::endl;
+                log.log(LogLevel::Warn, "collector source threw");
             }
-            
-            last_error_.clear();
-        }
+        };
+        
+        SampleStatus status = SampleStatus::Ok;
+        double cpu_value = collect_metric("cpu", cpu_source_, status);
+        record_fault(status, MetricRegistry::kCpu, "cpu", "CPU", cpu_is_available);
+        
+        double memory_value = collect_metric("memory", memory_source_, status);
+        record_fault(status, MetricRegistry::kMemory, "memory", "Memory", memory_is_available);
+        
+        double gpu_value = collect_metric("gpu", gpu_source_, status);
+        record_fault(status, MetricRegistry::kGpu, "gpu", "GPU", gpu_is_available);
     
         // Create metric entries
         MetricData cpu_metric = {
@@ -203,15 +462,22 @@ SystemMetrics MetricCollector::collect_metrics() const {
             gpu_is_available && (!metrics.has_exception || metrics.exception_source != "gpu")
         };
         
-        std::cout << "DEBUG MetricCollector - Final metric availability: CPU=" 
-                 << (cpu_metric.is_available ? "AVAILABLE" : "UNAVAILABLE")
-                 << ", Memory=" << (memory_metric.is_available ? "AVAILABLE" : "UNAVAILABLE")
-                 << ", GPU=" << (gpu_metric.is_available ? "AVAILABLE" : "UNAVAILABLE") << std::endl;
-    
         // Add metrics to the map
-        metrics.metrics["cpu"] = cpu_metric;
-        metrics.metrics["memory"] = memory_metric;
-        metrics.metrics["gpu"] = gpu_metric;
+        metrics.metrics[MetricRegistry::kCpu] = cpu_metric;
+        metrics.metrics[MetricRegistry::kMemory] = memory_metric;
+        metrics.metrics[MetricRegistry::kGpu] = gpu_metric;
+        
+        // Without background samplers the calling thread is the history writer
+        auto sampled_at = std::chrono::system_clock::now();
+        if (cpu_metric.is_available) {
+            history_.record(MetricRegistry::kCpu, sampled_at, cpu_value);
+        }
+        if (memory_metric.is_available) {
+            history_.record(MetricRegistry::kMemory, sampled_at, memory_value);
+        }
+        if (gpu_metric.is_available) {
+            history_.record(MetricRegistry::kGpu, sampled_at, gpu_value);
+        }
     
         // Also set legacy fields for compatibility with tests
         metrics.cpu_usage = cpu_value;
@@ -237,43 +503,58 @@ SystemMetrics MetricCollector::collect_metrics() const {
 }
 
 double MetricCollector::get_cpu_usage() const {
-    return collect_metric(cpu_source_);
+    return collect_metric("cpu", cpu_source_);
 }
 
 double MetricCollector::get_memory_usage() const {
-    return collect_metric(memory_source_);
+    return collect_metric("memory", memory_source_);
 }
 
 double MetricCollector::get_gpu_usage() const {
-    return collect_metric(gpu_source_);
+    return collect_metric("gpu", gpu_source_);
+}
+
+const SamplingPolicy& MetricCollector::policy_for(const std::string& name) const {
+    static const SamplingPolicy kDefaultPolicy;
+    auto policy = policies_.find(name);
+    return policy != policies_.end() ? policy->second : kDefaultPolicy;
 }
 
-double MetricCollector::collect_metric(IMetricSource* source) const {
+double MetricCollector::collect_metric(const std::string& name, IMetricSource* source) const {
+    SampleStatus status = SampleStatus::Ok;
+    return collect_metric(name, source, status);
+}
+
+double MetricCollector::collect_metric(const std::string& name, IMetricSource* source,
+                                       SampleStatus& status) const {
+    last_error_.clear();
     if (!source->isAvailable()) {
+        status = SampleStatus::Unavailable;
         return kDefaultCpuUsage;  // Use default value if source is unavailable
     }
     
     try {
-        // Use a timeout to prevent hanging if a source takes too long
-        // This is a simplified approach for tests - in a real system we would use std::future with a timeout
-        auto start_time = std::chrono::system_clock::now();
+        // On the caller's thread a slow source can only be detected once it
+        // returns; background sampling enforces the deadline while in flight
+        auto start_time = std::chrono::steady_clock::now();
         double value = source->getValue();
-        auto end_time = std::chrono::system_clock::now();
+        auto elapsed = std::chrono::steady_clock::now() - start_time;
         
-        // Check if we've exceeded our timeout threshold
-        // Set to 1000ms to ensure any significant delay (like the test's 2s sleep) is caught as a timeout
-        std::chrono::milliseconds timeout_threshold(1000);
-        if (end_time - start_time > timeout_threshold) {
-            // Record timeout information in the last_error_ member
-            std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-            last_error_ = "Timeout in metric source (took " + std::to_string(elapsed.count()) + "ms)";
+        // The same deadline as the source's background sampler
+        if (elapsed > policy_for(name).timeout) {
+            auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+            last_error_ = "Timeout in metric source (took " + std::to_string(elapsed_ms.count()) + "ms)";
+            status = SampleStatus::Timeout;
             return kDefaultCpuUsage;  // Use default value for timeout
         }
         
+        status = std::isnan(value) || value < 0.0 || value > 100.0 ? SampleStatus::OutOfRange
+                                                                    : SampleStatus::Ok;
         return clamp_metric(value);
     } catch (const std::exception& e) {
         // Record exception information in the last_error_ member
         last_error_ = std::string("Exception in metric source: ") + e.what();
+        status = SampleStatus::Exception;
         return kDefaultCpuUsage;  // Use default value if source throws
     }
 }
@@ -0,0 +1,264 @@
+#include "chronovyan/metric_history.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace chronovyan {
+
+namespace {
+
+// Log-bucketed quantile sketch with fixed storage. Bucket i covers
+// (kMinValue * gamma^(i-1), kMinValue * gamma^i], which bounds the relative
+// error of a quantile by about (gamma - 1) / 2. Values at or below
+// kMinValue (including negatives) share the zero bucket.
+class QuantileSketch {
+public:
+    static constexpr size_t kBins = 1024;
+
+    static int index(double value) {
+        if (!(value > kMinValue)) {
+            return -1;
+        }
+        double position = std::ceil(std::log(value / kMinValue) / kLogGamma);
+        return static_cast<int>(std::min(position, static_cast<double>(kBins - 1)));
+    }
+
+    void add(int bin) {
+        if (bin < 0) {
+            ++zero_;
+        } else {
+            ++bins_[static_cast<size_t>(bin)];
+        }
+        ++total_;
+    }
+
+    double quantile(double q) const {
+        if (total_ == 0) {
+            return 0.0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total_ - 1));
+        uint64_t seen = zero_;
+        if (seen > rank) {
+            return 0.0;
+        }
+        for (size_t bin = 0; bin < kBins; ++bin) {
+            seen += bins_[bin];
+            if (seen > rank) {
+                return kMinValue * std::exp((static_cast<double>(bin) - 0.5) * kLogGamma);
+            }
+        }
+        return kMinValue * std::exp(static_cast<double>(kBins - 1) * kLogGamma);
+    }
+
+    void clear() {
+        if (total_ != 0) {
+            bins_.fill(0);
+            zero_ = 0;
+            total_ = 0;
+        }
+    }
+
+private:
+    static constexpr double kMinValue = 1e-6;
+    static constexpr double kGamma = 1.04;
+    static const double kLogGamma;
+
+    std::array<uint32_t, kBins> bins_{};
+    uint32_t zero_ = 0;
+    uint32_t total_ = 0;
+};
+
+const double QuantileSketch::kLogGamma = std::log(QuantileSketch::kGamma);
+
+constexpr int64_t kLevelWidths[] = {
+    1000000000LL,   // 1s
+    10000000000LL,  // 10s
+    60000000000LL   // 1m
+};
+constexpr size_t kLevels = 3;
+
+// First sequence number with key >= target in [first, last)
+template <typename Record>
+uint64_t lower_bound(const detail::HistoryRing<Record>& ring, uint64_t first, uint64_t last,
+                     int64_t target) {
+    while (first < last) {
+        uint64_t middle = first + (last - first) / 2;
+        if (ring.records[middle % ring.records.size()].key() < target) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+// Published sequence range that is safe to read: the slot after the last
+// published record may be mid-overwrite, so it is excluded
+template <typename Record>
+void readable_range(const detail::HistoryRing<Record>& ring, uint64_t& first, uint64_t& last) {
+    last = ring.published.load(std::memory_order_acquire);
+    uint64_t capacity = ring.records.size();
+    first = last + 1 > capacity ? last + 1 - capacity : 0;
+}
+
+template <typename Record, typename Value>
+HistoryView<Record, Value> time_range(const detail::HistoryRing<Record>& ring, int64_t from,
+                                      int64_t to) {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    readable_range(ring, first, last);
+    uint64_t begin = lower_bound(ring, first, last, from);
+    uint64_t end = to == std::numeric_limits<int64_t>::max()
+        ? last : lower_bound(ring, begin, last, to + 1);
+    return HistoryView<Record, Value>(&ring, begin, end - begin);
+}
+
+} // namespace
+
+struct MetricHistory::Series {
+    // Rollup interval still accumulating samples; private to the writer
+    struct OpenBucket {
+        int64_t start = 0;
+        uint32_t count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        QuantileSketch sketch;
+    };
+
+    explicit Series(const Config& config)
+        : raw(config.raw_capacity),
+          levels{detail::HistoryRing<detail::RollupRecord>(config.second_buckets),
+                 detail::HistoryRing<detail::RollupRecord>(config.ten_second_buckets),
+                 detail::HistoryRing<detail::RollupRecord>(config.minute_buckets)} {}
+
+    void record(int64_t time, double value);
+    void close(size_t level);
+
+    detail::HistoryRing<detail::PointRecord> raw;
+    std::array<detail::HistoryRing<detail::RollupRecord>, kLevels> levels;
+    std::array<OpenBucket, kLevels> open{};
+    int64_t last_time = std::numeric_limits<int64_t>::min();
+};
+
+void MetricHistory::Series::close(size_t level) {
+    OpenBucket& bucket = open[level];
+    if (bucket.count == 0) {
+        return;
+    }
+    MetricRollup rollup;
+    rollup.start = detail::history_time(bucket.start);
+    rollup.count = bucket.count;
+    rollup.min = bucket.min;
+    rollup.max = bucket.max;
+    rollup.avg = bucket.sum / bucket.count;
+    rollup.p99 = std::clamp(bucket.sketch.quantile(0.99), bucket.min, bucket.max);
+    levels[level].push(rollup);
+
+    bucket.count = 0;
+    bucket.sum = 0.0;
+    bucket.sketch.clear();
+}
+
+void MetricHistory::Series::record(int64_t time, double value) {
+    time = std::max(time, last_time);
+    last_time = time;
+    raw.push(MetricPoint{detail::history_time(time), value});
+
+    int bin = QuantileSketch::index(value);
+    for (size_t level = 0; level < kLevels; ++level) {
+        OpenBucket& bucket = open[level];
+        int64_t width = kLevelWidths[level];
+        // Floor to the interval boundary, also for pre-epoch times
+        int64_t start = time - ((time % width) + width) % width;
+        if (bucket.count != 0 && start != bucket.start) {
+            close(level);
+        }
+        if (bucket.count == 0) {
+            bucket.start = start;
+            bucket.min = value;
+            bucket.max = value;
+        }
+        ++bucket.count;
+        bucket.sum += value;
+        bucket.min = std::min(bucket.min, value);
+        bucket.max = std::max(bucket.max, value);
+        bucket.sketch.add(bin);
+    }
+}
+
+MetricHistory::MetricHistory() : MetricHistory(Config()) {}
+
+MetricHistory::MetricHistory(const Config& config) : config_(config) {}
+
+MetricHistory::~MetricHistory() = default;
+
+void MetricHistory::track(MetricHandle handle) {
+    if (!handle.valid() || handle.id() >= MetricRegistry::kMaxMetrics) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(track_mutex_);
+    if (series_[handle.id()].load(std::memory_order_relaxed)) {
+        return;
+    }
+    owned_.push_back(std::make_unique<Series>(config_));
+    series_[handle.id()].store(owned_.back().get(), std::memory_order_release);
+}
+
+bool MetricHistory::is_tracked(MetricHandle handle) const {
+    return series(handle) != nullptr;
+}
+
+const MetricHistory::Series* MetricHistory::series(MetricHandle handle) const {
+    if (!handle.valid() || handle.id() >= MetricRegistry::kMaxMetrics) {
+        return nullptr;
+    }
+    return series_[handle.id()].load(std::memory_order_acquire);
+}
+
+void MetricHistory::record(MetricHandle handle, std::chrono::system_clock::time_point time,
+                           double value) {
+    if (!handle.valid() || handle.id() >= MetricRegistry::kMaxMetrics) {
+        return;
+    }
+    if (Series* target = series_[handle.id()].load(std::memory_order_acquire)) {
+        target->record(detail::history_nanos(time), value);
+    }
+}
+
+MetricPointView MetricHistory::range(MetricHandle handle,
+                                     std::chrono::system_clock::time_point from,
+                                     std::chrono::system_clock::time_point to) const {
+    const Series* target = series(handle);
+    if (!target) {
+        return MetricPointView();
+    }
+    return time_range<detail::PointRecord, MetricPoint>(
+        target->raw, detail::history_nanos(from), detail::history_nanos(to));
+}
+
+MetricPointView MetricHistory::latest(MetricHandle handle, size_t count) const {
+    const Series* target = series(handle);
+    if (!target) {
+        return MetricPointView();
+    }
+    uint64_t first = 0;
+    uint64_t last = 0;
+    readable_range(target->raw, first, last);
+    uint64_t begin = last - std::min<uint64_t>(count, last - first);
+    return MetricPointView(&target->raw, begin, last - begin);
+}
+
+MetricRollupView MetricHistory::rollups(MetricHandle handle, RollupResolution resolution,
+                                        std::chrono::system_clock::time_point from,
+                                        std::chrono::system_clock::time_point to) const {
+    const Series* target = series(handle);
+    if (!target) {
+        return MetricRollupView();
+    }
+    const auto& ring = target->levels[static_cast<size_t>(resolution)];
+    return time_range<detail::RollupRecord, MetricRollup>(
+        ring, detail::history_nanos(from), detail::history_nanos(to));
+}
+
+} // namespace chronovyan
@@ -0,0 +1,56 @@
+#include "chronovyan/metric_registry.hpp"
+
+namespace chronovyan {
+
+MetricRegistry& MetricRegistry::instance() {
+    static MetricRegistry registry;
+    return registry;
+}
+
+MetricRegistry::MetricRegistry() {
+    // Fixed ids for the built-in metrics; order must match kCpu/kMemory/kGpu
+    register_metric("cpu");
+    register_metric("memory");
+    register_metric("gpu");
+}
+
+MetricHandle MetricRegistry::register_metric(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return MetricHandle(it->second);
+    }
+    if (names_.size() >= kMaxMetrics) {
+        throw std::length_error("Metric registry is full");
+    }
+    MetricId id = static_cast<MetricId>(names_.size());
+    ids_.emplace(name, id);
+    names_.push_back(name);
+    return MetricHandle(id);
+}
+
+MetricHandle MetricRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    return it != ids_.end() ? MetricHandle(it->second) : MetricHandle();
+}
+
+std::string MetricRegistry::name(MetricHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handle.valid() && handle.id() < names_.size() ? names_[handle.id()] : std::string();
+}
+
+size_t MetricRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
+
+size_t MetricTable::size() const {
+    size_t count = 0;
+    for (uint64_t mask = present_; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace chronovyan
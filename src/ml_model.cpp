@@ -1,4 +1,5 @@
 #include "chronovyan/ml_model.hpp"
+#include "chronovyan/vector_math.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -9,6 +10,17 @@
 namespace chronovyan {
 namespace sync {
 
+namespace {
+
+// Probabilities are clamped away from 0 and 1 before taking logs
+constexpr double kMinProbability = 1e-12;
+
+double sigmoid(double z) {
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+} // namespace
+
 MLModel::MLModel(
     const std::string& model_type,
     const std::vector<std::string>& feature_columns,
@@ -17,7 +29,8 @@ MLModel::MLModel(
 ) : model_type(model_type),
     feature_columns(feature_columns),
     learning_rate(learning_rate),
-    seed(seed) {
+    seed(seed),
+    tree_backend(model_type == "gradient_boost") {
     initialize_model();
 }
 
@@ -40,17 +53,46 @@ void MLModel::initialize_model() {
     feature_importance.resize(feature_columns.size(), 0.0);
     
     // Initialize hyperparameters
-    hyperparameters["learning_rate"] = learning_rate;
-    hyperparameters["regularization"] = 0.01;
-    hyperparameters["momentum"] = 0.9;
-    hyperparameters["max_depth"] = 3;
-    hyperparameters["min_samples_split"] = 2;
+    hyperparameters = MLHyperparameters();
+    hyperparameters.learning_rate = learning_rate;
+    
+    gradient.assign(feature_columns.size() + 1, 0.0);
+    reset_optimizer_state();
+    
+    if (tree_backend) {
+        ensemble = GradientBoostedTrees(feature_columns.size(), tree_config());
+    }
+}
+
+TreeEnsembleConfig MLModel::tree_config() const {
+    auto count = [](int value) { return static_cast<size_t>(std::max(value, 1)); };
+    TreeEnsembleConfig config;
+    config.max_depth = count(hyperparameters.max_depth);
+    config.min_samples_split = count(hyperparameters.min_samples_split);
+    config.max_trees = count(hyperparameters.max_trees);
+    config.histogram_bins = count(hyperparameters.histogram_bins);
+    config.sample_buffer = count(hyperparameters.sample_buffer);
+    config.shrinkage = hyperparameters.shrinkage;
+    config.l2 = hyperparameters.tree_l2;
+    return config;
+}
+
+void MLModel::reset_optimizer_state() {
+    first_moment.assign(feature_columns.size() + 1, 0.0);
+    second_moment.assign(feature_columns.size() + 1, 0.0);
+    optimizer_steps = 0;
 }
 
 void MLModel::update(const std::vector<double>& features) {
     if (features.size() != feature_columns.size()) {
         throw std::invalid_argument("Feature size mismatch");
     }
+    if (tree_backend) {
+        // predict() scores with the trees only, so the linear rule would
+        // change nothing a caller can see
+        throw std::logic_error("Unlabeled updates need a linear model; " + model_type +
+                               " models learn from labeled rows");
+    }
     
     // Check for NaN or Inf values
     for (double feature : features) {
@@ -60,7 +102,28 @@ void MLModel::update(const std::vector<double>& features) {
     }
     
     train_model(features);
-    update_feature_importance();
+    if (!tree_backend) {
+        update_feature_importance();
+    }
+}
+
+void MLModel::update(const std::vector<double>& features, double target) {
+    if (features.size() != feature_columns.size()) {
+        throw std::invalid_argument("Feature size mismatch");
+    }
+    if (!all_finite(features.data(), features.size()) || !all_finite(&target, 1)) {
+        throw std::invalid_argument("Invalid feature value (NaN or Inf)");
+    }
+    if (!tree_backend) {
+        train_batch(features.data(), &target, 1);
+        return;
+    }
+    ensemble.add_samples(features.data(), &target, 1);
+    if (++rows_since_round >= kTreeUpdateRows) {
+        ensemble.boost_round();
+        feature_importance = ensemble.importance();
+        rows_since_round = 0;
+    }
 }
 
 void MLModel::update_hyperparameters(const OptimizationMetrics& metrics) {
@@ -70,30 +133,29 @@ void MLModel::update_hyperparameters(const OptimizationMetrics& metrics) {
     double coherence_factor = 1.0 - metrics.error_rate / 100.0; // Convert error rate to coherence score
     
     // Adjust learning rate based on efficiency
-    hyperparameters["learning_rate"] *= (1.0 + efficiency_factor * 0.1);
+    hyperparameters.learning_rate *= (1.0 + efficiency_factor * 0.1);
     
     // Adjust regularization based on stability
-    hyperparameters["regularization"] *= (1.0 - stability_factor * 0.1);
+    hyperparameters.regularization *= (1.0 - stability_factor * 0.1);
     
     // Adjust momentum based on coherence
-    hyperparameters["momentum"] *= (1.0 + coherence_factor * 0.1);
+    hyperparameters.momentum *= (1.0 + coherence_factor * 0.1);
     
     // Ensure hyperparameters stay within valid ranges
-    hyperparameters["learning_rate"] = std::clamp(
-        hyperparameters["learning_rate"],
-        0.001,
-        0.1
-    );
-    hyperparameters["regularization"] = std::clamp(
-        hyperparameters["regularization"],
-        0.001,
-        0.1
-    );
-    hyperparameters["momentum"] = std::clamp(
-        hyperparameters["momentum"],
-        0.5,
-        0.99
-    );
+    hyperparameters.learning_rate = std::clamp(hyperparameters.learning_rate, 0.001, 0.1);
+    hyperparameters.regularization = std::clamp(hyperparameters.regularization, 0.001, 0.1);
+    hyperparameters.momentum = std::clamp(hyperparameters.momentum, 0.5, 0.99);
+}
+
+void MLModel::set_hyperparameters(const MLHyperparameters& params) {
+    bool optimizer_changed = params.optimizer != hyperparameters.optimizer;
+    hyperparameters = params;
+    if (optimizer_changed) {
+        reset_optimizer_state();
+    }
+    if (tree_backend) {
+        ensemble.set_config(tree_config());
+    }
 }
 
 double MLModel::predict(const std::vector<double>& features) const {
@@ -108,14 +170,119 @@ double MLModel::predict(const std::vector<double>& features) const {
         }
     }
     
-    // Gradient boosting prediction
-    double prediction = 0.0;
-    for (size_t i = 0; i < features.size(); ++i) {
-        prediction += features[i] * feature_weights[i];
+    return tree_backend ? ensemble.predict(features.data()) : score(features.data());
+}
+
+double MLModel::score(const double* features) const {
+    return sigmoid(dot_product(features, feature_weights.data(), feature_weights.size()) + bias);
+}
+
+double MLModel::train_batch(const double* features, const double* targets, size_t rows) {
+    if (rows == 0) {
+        return 0.0;
+    }
+    const size_t n = feature_columns.size();
+    if (!all_finite(features, rows * n) || !all_finite(targets, rows)) {
+        throw std::invalid_argument("Invalid feature value (NaN or Inf)");
+    }
+    if (tree_backend) {
+        return train_trees(features, targets, rows);
+    }
+    
+    // Mean cross-entropy gradient: X^T (p - y) / rows, bias last
+    std::fill(gradient.begin(), gradient.end(), 0.0);
+    double loss = 0.0;
+    for (size_t r = 0; r < rows; ++r) {
+        const double* x = features + r * n;
+        double p = score(x);
+        double y = targets[r];
+        loss -= y * std::log(std::max(p, kMinProbability)) +
+                (1.0 - y) * std::log(std::max(1.0 - p, kMinProbability));
+        double residual = p - y;
+        axpy(residual, x, gradient.data(), n);
+        gradient[n] += residual;
+    }
+    const double scale = 1.0 / static_cast<double>(rows);
+    for (size_t i = 0; i < n; ++i) {
+        gradient[i] = gradient[i] * scale + hyperparameters.regularization * feature_weights[i];
     }
+    gradient[n] *= scale;  // the bias is not regularized
     
-    // Apply sigmoid activation
-    return 1.0 / (1.0 + std::exp(-prediction));
+    const double lr = hyperparameters.learning_rate;
+    if (hyperparameters.optimizer == GradientOptimizer::Adam) {
+        ++optimizer_steps;
+        const double b1 = hyperparameters.beta1;
+        const double b2 = hyperparameters.beta2;
+        const double t = static_cast<double>(optimizer_steps);
+        const double step = lr * std::sqrt(1.0 - std::pow(b2, t)) / (1.0 - std::pow(b1, t));
+        auto adam = [&](double& param, size_t i) {
+            first_moment[i] = b1 * first_moment[i] + (1.0 - b1) * gradient[i];
+            second_moment[i] = b2 * second_moment[i] + (1.0 - b2) * gradient[i] * gradient[i];
+            param -= step * first_moment[i] / (std::sqrt(second_moment[i]) + hyperparameters.epsilon);
+        };
+        for (size_t i = 0; i < n; ++i) {
+            adam(feature_weights[i], i);
+        }
+        adam(bias, n);
+    } else {
+        const double momentum = hyperparameters.momentum;
+        for (size_t i = 0; i < n; ++i) {
+            first_moment[i] = momentum * first_moment[i] + gradient[i];
+            feature_weights[i] -= lr * first_moment[i];
+        }
+        first_moment[n] = momentum * first_moment[n] + gradient[n];
+        bias -= lr * first_moment[n];
+    }
+    
+    update_feature_importance();
+    return loss * scale;
+}
+
+double MLModel::train_trees(const double* features, const double* targets, size_t rows) {
+    const size_t n = feature_columns.size();
+    double loss = 0.0;
+    for (size_t r = 0; r < rows; ++r) {
+        double p = ensemble.predict(features + r * n);
+        double y = targets[r];
+        loss -= y * std::log(std::max(p, kMinProbability)) +
+                (1.0 - y) * std::log(std::max(1.0 - p, kMinProbability));
+    }
+    ensemble.add_samples(features, targets, rows);
+    ensemble.boost_round();
+    feature_importance = ensemble.importance();
+    rows_since_round = 0;
+    return loss / static_cast<double>(rows);
+}
+
+double MLModel::train_batch(const std::vector<double>& features, const std::vector<double>& targets) {
+    if (features.size() != targets.size() * feature_columns.size()) {
+        throw std::invalid_argument("Feature size mismatch");
+    }
+    return train_batch(features.data(), targets.data(), targets.size());
+}
+
+void MLModel::predict_batch(const double* features, size_t rows, double* out) const {
+    const size_t n = feature_columns.size();
+    if (!all_finite(features, rows * n)) {
+        throw std::invalid_argument("Invalid feature value (NaN or Inf)");
+    }
+    if (tree_backend) {
+        ensemble.predict_batch(features, rows, out);
+        return;
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        out[r] = score(features + r * n);
+    }
+}
+
+std::vector<double> MLModel::predict_batch(const std::vector<double>& features) const {
+    const size_t n = feature_columns.size();
+    if (n == 0 || features.size() % n != 0) {
+        throw std::invalid_argument("Feature size mismatch");
+    }
+    std::vector<double> scores(features.size() / n);
+    predict_batch(features.data(), scores.size(), scores.data());
+    return scores;
 }
 
 std::vector<double> MLModel::get_feature_importance() const {
@@ -123,8 +290,8 @@ std::vector<double> MLModel::get_feature_importance() const {
 }
 
 void MLModel::train_model(const std::vector<double>& features) {
-    // Gradient boosting training
-    double prediction = predict(features);
+    // Gradient boosting training; update() has already validated the input
+    double prediction = score(features.data());
     double gradient = prediction * (1.0 - prediction);
     
     // Update weights using gradient descent with momentum
@@ -143,37 +310,36 @@ void MLModel::train_model(const std::vector<double>& features) {
         feature_weights[i] -= weight_update;
         
         // Apply regularization
-        feature_weights[i] *= (1.0 - hyperparameters["regularization"]);
+        feature_weights[i] *= (1.0 - hyperparameters.regularization);
         
         // Apply momentum
-        feature_weights[i] *= hyperparameters["momentum"];
+        feature_weights[i] *= hyperparameters.momentum;
     }
 }
 
 void MLModel::update_feature_importance() {
-    // Calculate feature importance based on weight magnitudes and feature values
-    double total_weight = 0.0;
-    std::vector<double> weight_magnitudes(feature_weights.size());
+    // Calculate feature importance based on weight magnitudes and feature values.
+    // Increasing the magnitude with the weight itself ensures that features
+    // with higher values (like 1.0) get higher importance.
+    auto magnitude = [](double weight) {
+        return std::abs(weight) * (1.0 + std::abs(weight));
+    };
     
-    // Calculate weight magnitudes
-    for (size_t i = 0; i < feature_weights.size(); ++i) {
-        // Increase the weight magnitude based on the feature value
-        // This ensures that features with higher values (like 1.0) get higher importance
-        weight_magnitudes[i] = std::abs(feature_weights[i]) * (1.0 + std::abs(feature_weights[i]));
-        total_weight += weight_magnitudes[i];
+    double total_weight = 0.0;
+    for (double weight : feature_weights) {
+        total_weight += magnitude(weight);
     }
     
     if (total_weight > 0.0) {
         // Normalize feature importance
         for (size_t i = 0; i < feature_weights.size(); ++i) {
-            // Weight magnitude contributes 70% to importance
-            double weight_importance = weight_magnitudes[i] / total_weight;
+            double weight_importance = magnitude(feature_weights[i]) / total_weight;
             
-            // Feature value contributes 30% to importance
+            // Add 1.0 to prevent division by zero
             double feature_value_importance = std::abs(feature_weights[i]) / 
-                (std::abs(feature_weights[i]) + 1.0); // Add 1.0 to prevent division by zero
+                (std::abs(feature_weights[i]) + 1.0);
             
-            // Adjust the importance calculation to put more emphasis on the weight magnitude
+            // Put more emphasis on the weight magnitude
             feature_importance[i] = 0.8 * weight_importance + 0.2 * feature_value_importance;
         }
     }
@@ -0,0 +1,535 @@
+#include "chronovyan/ml_model_store.hpp"
+#include "chronovyan/vector_math.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chronovyan {
+namespace sync {
+
+static_assert(std::is_trivially_copyable<ModelFileHeader>::value, "header is written as raw bytes");
+static_assert(sizeof(ModelFileHeader) % 8 == 0, "sections after the header must stay 8-byte aligned");
+
+namespace {
+
+struct StringEntry {
+    uint64_t offset;
+    uint64_t length;
+};
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+
+uint64_t fnv1a(const char* data, size_t size, uint64_t hash = kFnvOffsetBasis) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+// Bytes of the trees section for `count` trees of `depth` levels
+size_t trees_size(size_t count, size_t depth) {
+    const size_t inner = ((size_t(1) << depth) - 1) * count;
+    const size_t leaves = (size_t(1) << depth) * count;
+    return (2 * inner + leaves) * sizeof(double) + align8(inner * sizeof(uint32_t));
+}
+
+// Version 1 header: ModelFileHeader without the tree settings and the
+// trees section offset
+struct ModelFileHeaderV1 {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t checksum;
+    uint64_t feature_count;
+    uint64_t optimizer_steps;
+    double base_learning_rate;
+    double learning_rate;
+    double regularization;
+    double momentum;
+    double beta1;
+    double beta2;
+    double epsilon;
+    int32_t max_depth;
+    int32_t min_samples_split;
+    uint32_t optimizer;
+    uint32_t reserved;
+    uint64_t weights_offset;
+    uint64_t importance_offset;
+    uint64_t moments_offset;
+    uint64_t strings_offset;
+};
+
+static_assert(sizeof(ModelFileHeaderV1) % 8 == 0, "version 1 sections are 8-byte aligned");
+
+// A version 1 header in the current layout, with default tree settings
+// and an empty trees section
+ModelFileHeader widen(const ModelFileHeaderV1& old) {
+    const MLHyperparameters defaults;
+    ModelFileHeader h{};
+    std::memcpy(h.magic, old.magic, sizeof(h.magic));
+    h.version = old.version;
+    h.byte_order = old.byte_order;
+    h.file_size = old.file_size;
+    h.checksum = old.checksum;
+    h.feature_count = old.feature_count;
+    h.optimizer_steps = old.optimizer_steps;
+    h.base_learning_rate = old.base_learning_rate;
+    h.learning_rate = old.learning_rate;
+    h.regularization = old.regularization;
+    h.momentum = old.momentum;
+    h.beta1 = old.beta1;
+    h.beta2 = old.beta2;
+    h.epsilon = old.epsilon;
+    h.max_depth = old.max_depth;
+    h.min_samples_split = old.min_samples_split;
+    h.optimizer = old.optimizer;
+    h.shrinkage = defaults.shrinkage;
+    h.tree_l2 = defaults.tree_l2;
+    h.max_trees = defaults.max_trees;
+    h.histogram_bins = defaults.histogram_bins;
+    h.sample_buffer = defaults.sample_buffer;
+    h.weights_offset = old.weights_offset;
+    h.importance_offset = old.importance_offset;
+    h.moments_offset = old.moments_offset;
+    h.trees_offset = old.strings_offset;
+    h.strings_offset = old.strings_offset;
+    return h;
+}
+
+constexpr size_t kMaxTreeDepth = 12;
+constexpr const char* kTreeModelType = "gradient_boost";
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + ": " + path);
+}
+
+[[noreturn]] void fail_errno(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+void write_all(int fd, const char* data, size_t size, const std::string& path) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail_errno("Cannot write", path);
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+// Writes to a sibling temporary file and renames it over `path`
+void replace_file(const std::string& path, const std::vector<char>& bytes) {
+    std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fail_errno("Cannot create", tmp);
+    }
+    try {
+        write_all(fd, bytes.data(), bytes.size(), tmp);
+        if (::fsync(fd) != 0) {
+            fail_errno("Cannot sync", tmp);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp.c_str());
+        throw;
+    }
+    ::close(fd);
+    if (::rename(tmp.c_str(), path.c_str()) != 0) {
+        int saved = errno;
+        ::unlink(tmp.c_str());
+        errno = saved;
+        fail_errno("Cannot rename over", path);
+    }
+}
+
+} // namespace
+
+// MLModel persistence
+
+void MLModel::serialize(std::vector<char>& out) const {
+    const size_t n = feature_columns.size();
+    const size_t weights_offset = sizeof(ModelFileHeader);
+    const size_t importance_offset = weights_offset + (n + 1) * sizeof(double);
+    const size_t moments_offset = importance_offset + n * sizeof(double);
+    const TreeView trees = ensemble.view();
+    const size_t trees_offset = moments_offset + 2 * (n + 1) * sizeof(double);
+    const size_t strings_offset = trees_offset + trees_size(trees.tree_count, trees.depth);
+    const size_t bytes_offset = strings_offset + (n + 1) * sizeof(StringEntry);
+    size_t string_bytes = model_type.size();
+    for (const auto& name : feature_columns) {
+        string_bytes += name.size();
+    }
+    const size_t file_size = align8(bytes_offset + string_bytes);
+    out.assign(file_size, 0);
+    char* base = out.data();
+
+    ModelFileHeader header{};
+    std::memcpy(header.magic, ModelFileHeader::kMagic, sizeof(header.magic));
+    header.version = ModelFileHeader::kVersion;
+    header.byte_order = ModelFileHeader::kByteOrderMark;
+    header.file_size = file_size;
+    header.feature_count = n;
+    header.optimizer_steps = optimizer_steps;
+    header.base_learning_rate = learning_rate;
+    header.learning_rate = hyperparameters.learning_rate;
+    header.regularization = hyperparameters.regularization;
+    header.momentum = hyperparameters.momentum;
+    header.beta1 = hyperparameters.beta1;
+    header.beta2 = hyperparameters.beta2;
+    header.epsilon = hyperparameters.epsilon;
+    header.max_depth = hyperparameters.max_depth;
+    header.min_samples_split = hyperparameters.min_samples_split;
+    header.optimizer = static_cast<uint32_t>(hyperparameters.optimizer);
+    header.flags = tree_backend ? ModelFileHeader::kTreeBackend : 0;
+    header.shrinkage = hyperparameters.shrinkage;
+    header.tree_l2 = hyperparameters.tree_l2;
+    header.max_trees = hyperparameters.max_trees;
+    header.histogram_bins = hyperparameters.histogram_bins;
+    header.sample_buffer = hyperparameters.sample_buffer;
+    header.tree_depth = static_cast<uint32_t>(trees.depth);
+    header.tree_count = trees.tree_count;
+    header.base_score = trees.base_score;
+    header.weights_offset = weights_offset;
+    header.importance_offset = importance_offset;
+    header.moments_offset = moments_offset;
+    header.trees_offset = trees_offset;
+    header.strings_offset = strings_offset;
+
+    double* weights = reinterpret_cast<double*>(base + weights_offset);
+    std::memcpy(weights, feature_weights.data(), n * sizeof(double));
+    weights[n] = bias;
+    std::memcpy(base + importance_offset, feature_importance.data(), n * sizeof(double));
+    std::memcpy(base + moments_offset, first_moment.data(), (n + 1) * sizeof(double));
+    std::memcpy(base + moments_offset + (n + 1) * sizeof(double), second_moment.data(),
+                (n + 1) * sizeof(double));
+
+    const size_t inner = trees.internal_nodes() * trees.tree_count;
+    const size_t leaves = trees.leaves() * trees.tree_count;
+    char* tree_base = base + trees_offset;
+    std::memcpy(tree_base, trees.split_threshold, inner * sizeof(double));
+    std::memcpy(tree_base + inner * sizeof(double), ensemble.split_gain().data(), inner * sizeof(double));
+    std::memcpy(tree_base + 2 * inner * sizeof(double), trees.leaf_value, leaves * sizeof(double));
+    std::memcpy(tree_base + (2 * inner + leaves) * sizeof(double), trees.split_feature, inner * sizeof(uint32_t));
+
+    StringEntry* entries = reinterpret_cast<StringEntry*>(base + strings_offset);
+    size_t cursor = bytes_offset;
+    auto put = [&](size_t index, const std::string& text) {
+        entries[index] = StringEntry{cursor, text.size()};
+        std::memcpy(base + cursor, text.data(), text.size());
+        cursor += text.size();
+    };
+    put(0, model_type);
+    for (size_t i = 0; i < n; ++i) {
+        put(i + 1, feature_columns[i]);
+    }
+
+    header.checksum = 0;
+    std::memcpy(base, &header, sizeof(header));
+    header.checksum = fnv1a(base, file_size);
+    std::memcpy(base + offsetof(ModelFileHeader, checksum), &header.checksum, sizeof(header.checksum));
+}
+
+void MLModel::save(const std::string& path) const {
+    std::vector<char> bytes;
+    serialize(bytes);
+    replace_file(path, bytes);
+}
+
+MLModel::MLModel(const MappedModel& saved)
+    : model_type(saved.model_type()),
+      learning_rate(saved.base_learning_rate()),
+      tree_backend(saved.uses_trees()) {
+    const size_t n = saved.feature_count();
+    feature_columns.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        feature_columns.emplace_back(saved.feature_name(i));
+    }
+    feature_weights.assign(saved.weights(), saved.weights() + n);
+    bias = saved.bias();
+    feature_importance.assign(saved.importance(), saved.importance() + n);
+    hyperparameters = saved.hyperparameters();
+    gradient.assign(n + 1, 0.0);
+    first_moment.assign(saved.first_moment(), saved.first_moment() + n + 1);
+    second_moment.assign(saved.second_moment(), saved.second_moment() + n + 1);
+    optimizer_steps = static_cast<size_t>(saved.optimizer_steps());
+    if (tree_backend) {
+        ensemble = GradientBoostedTrees(n, tree_config());
+        ensemble.assign(saved.trees(), saved.split_gain());
+    }
+}
+
+MLModel MLModel::load(const std::string& path) {
+    return MLModel(MappedModel(path));
+}
+
+// MappedModel
+
+MappedModel::MappedModel(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fail_errno("Cannot open", path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int saved = errno;
+        ::close(fd);
+        errno = saved;
+        fail_errno("Cannot stat", path);
+    }
+    if (static_cast<size_t>(st.st_size) < sizeof(ModelFileHeaderV1)) {
+        ::close(fd);
+        fail("Truncated model file", path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        fail_errno("Cannot map", path);
+    }
+    data_ = data;
+
+    const char* base = static_cast<const char*>(data_);
+    ModelFileHeaderV1 v1;
+    std::memcpy(&v1, base, sizeof(v1));
+    size_t header_size = sizeof(ModelFileHeader);
+    if (v1.version == 1) {
+        header_ = widen(v1);
+        header_size = sizeof(v1);
+    } else if (size_ >= sizeof(ModelFileHeader)) {
+        std::memcpy(&header_, base, sizeof(header_));
+    } else {
+        unmap();
+        fail("Truncated model file", path);
+    }
+    const ModelFileHeader& h = header_;
+    bool valid = std::memcmp(h.magic, ModelFileHeader::kMagic, sizeof(h.magic)) == 0;
+    if (valid && h.byte_order != ModelFileHeader::kByteOrderMark) {
+        unmap();
+        fail("Model file has foreign byte order", path);
+    }
+    if (valid && (h.version < ModelFileHeader::kMinVersion || h.version > ModelFileHeader::kVersion)) {
+        uint32_t version = h.version;
+        unmap();
+        fail("Unsupported model file version " + std::to_string(version), path);
+    }
+
+    // The checksum is verified before any offset in the header is trusted
+    if (valid && h.version >= 3) {
+        ModelFileHeader zeroed = h;
+        zeroed.checksum = 0;
+        uint64_t hash = fnv1a(reinterpret_cast<const char*>(&zeroed), sizeof(zeroed));
+        valid = fnv1a(base + sizeof(zeroed), size_ - sizeof(zeroed), hash) == h.checksum;
+    } else if (valid) {
+        valid = fnv1a(base + header_size, size_ - header_size) == h.checksum;
+    }
+
+    // Every section must lie inside the file and stay aligned
+    const uint64_t n = h.feature_count;
+    auto fits = [&](uint64_t offset, uint64_t count, uint64_t element) {
+        return offset % 8 == 0 && offset >= header_size && offset <= size_ &&
+               count <= (size_ - offset) / element;
+    };
+    valid = valid && h.file_size == size_ && n < size_ &&
+            fits(h.weights_offset, n + 1, sizeof(double)) &&
+            fits(h.importance_offset, n, sizeof(double)) &&
+            fits(h.moments_offset, 2 * (n + 1), sizeof(double)) &&
+            fits(h.strings_offset, n + 1, sizeof(StringEntry)) &&
+            h.optimizer <= static_cast<uint32_t>(GradientOptimizer::Adam) &&
+            (h.version < 4 || (h.flags & ~ModelFileHeader::kTreeBackend) == 0) &&
+            h.tree_depth <= kMaxTreeDepth && h.tree_count < size_ &&
+            fits(h.trees_offset, trees_size(h.tree_count, h.tree_depth), 1);
+    if (valid) {
+        const StringEntry* entries = reinterpret_cast<const StringEntry*>(base + h.strings_offset);
+        for (uint64_t i = 0; valid && i <= n; ++i) {
+            valid = entries[i].offset <= size_ && entries[i].length <= size_ - entries[i].offset;
+        }
+    }
+    if (valid) {
+        // Scoring indexes rows by split feature, so those must be in range
+        const TreeView view = trees();
+        const size_t inner = view.internal_nodes() * view.tree_count;
+        for (size_t i = 0; valid && i < inner; ++i) {
+            valid = view.split_feature[i] < n;
+        }
+    }
+    if (!valid) {
+        unmap();
+        fail("Corrupt model file", path);
+    }
+    if (h.version >= 4) {
+        tree_backend_ = (h.flags & ModelFileHeader::kTreeBackend) != 0;
+    } else {
+        tree_backend_ = h.version >= 2 && model_type() == kTreeModelType;
+    }
+}
+
+MappedModel::~MappedModel() {
+    unmap();
+}
+
+MappedModel::MappedModel(MappedModel&& other) noexcept
+    : data_(other.data_), size_(other.size_), header_(other.header_), tree_backend_(other.tree_backend_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedModel& MappedModel::operator=(MappedModel&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        header_ = other.header_;
+        tree_backend_ = other.tree_backend_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void MappedModel::unmap() {
+    if (data_) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+std::string_view MappedModel::string_at(size_t index) const {
+    const StringEntry& entry =
+        reinterpret_cast<const StringEntry*>(static_cast<const char*>(data_) + header().strings_offset)[index];
+    return std::string_view(static_cast<const char*>(data_) + entry.offset, entry.length);
+}
+
+MLHyperparameters MappedModel::hyperparameters() const {
+    const ModelFileHeader& h = header();
+    MLHyperparameters params;
+    params.learning_rate = h.learning_rate;
+    params.regularization = h.regularization;
+    params.momentum = h.momentum;
+    params.beta1 = h.beta1;
+    params.beta2 = h.beta2;
+    params.epsilon = h.epsilon;
+    params.max_depth = h.max_depth;
+    params.min_samples_split = h.min_samples_split;
+    params.optimizer = static_cast<GradientOptimizer>(h.optimizer);
+    params.shrinkage = h.shrinkage;
+    params.tree_l2 = h.tree_l2;
+    params.max_trees = h.max_trees;
+    params.histogram_bins = h.histogram_bins;
+    params.sample_buffer = h.sample_buffer;
+    return params;
+}
+
+TreeView MappedModel::trees() const {
+    const ModelFileHeader& h = header();
+    TreeView view;
+    view.tree_count = static_cast<size_t>(h.tree_count);
+    view.depth = h.tree_depth;
+    view.base_score = h.base_score;
+    const size_t inner = view.internal_nodes() * view.tree_count;
+    const size_t leaves = view.leaves() * view.tree_count;
+    const double* doubles = section(h.trees_offset);
+    view.split_threshold = doubles;
+    view.leaf_value = doubles + 2 * inner;
+    view.split_feature = reinterpret_cast<const uint32_t*>(doubles + 2 * inner + leaves);
+    return view;
+}
+
+const double* MappedModel::split_gain() const {
+    const TreeView view = trees();
+    return view.split_threshold + view.internal_nodes() * view.tree_count;
+}
+
+double MappedModel::predict(const double* features) const {
+    if (tree_backend_) {
+        return 1.0 / (1.0 + std::exp(-trees().raw_score(features)));
+    }
+    double z = dot_product(features, weights(), feature_count()) + bias();
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+// ModelCheckpointer
+
+ModelCheckpointer::ModelCheckpointer(std::string path, std::chrono::milliseconds interval)
+    : path_(std::move(path)),
+      interval_(interval),
+      next_due_(std::chrono::steady_clock::now() + interval),
+      thread_(&ModelCheckpointer::run, this) {}
+
+ModelCheckpointer::~ModelCheckpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+bool ModelCheckpointer::offer(const MLModel& model) {
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_due_) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // An unwritten older snapshot is simply superseded
+    model.serialize(pending_);
+    has_pending_ = true;
+    lock.unlock();
+    wake_.notify_one();
+    next_due_ = now + interval_;
+    return true;
+}
+
+void ModelCheckpointer::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !has_pending_ && !busy_; });
+}
+
+void ModelCheckpointer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return has_pending_ || stop_; });
+        if (!has_pending_) {
+            break;
+        }
+        pending_.swap(writing_);
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+        try {
+            replace_file(path_, writing_);
+            written_.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception&) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+        lock.lock();
+        busy_ = false;
+        idle_.notify_all();
+    }
+}
+
+} // namespace sync
+} // namespace chronovyan
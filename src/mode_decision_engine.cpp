@@ -1,845 +1,267 @@
 #include "chronovyan/mode_decision_engine.hpp"
+#include "chronovyan/log_sink.hpp"
 #include "chronovyan/metric_collector.hpp"
-#include "chronovyan/state_controller.hpp"
 #include <algorithm>
 #include <cmath>
-#include <stdexcept>
 #include <chrono>
-#include <iostream>
-#include <sstream>
-
-// Enable debug mode for this file
-#define DEBUG_MODE
 
 namespace chronovyan {
 
+namespace {
+
+// Conditions derived from the decision inputs, one bit each
+enum Condition : uint32_t {
+    kInvalid = 1u << 0,
+    kTimeout = 1u << 1,
+    kException = 1u << 2,
+    kAllUnavailable = 1u << 3,
+    kPartialFailure = 1u << 4,
+    kStale = 1u << 5,
+    kRecovered = 1u << 6,
+    kOutOfRange = 1u << 7,
+    kHighLoad = 1u << 8,
+    kLowLoad = 1u << 9
+};
+
+enum RuleFlags : uint8_t {
+    kConservative = 1u << 0,
+    kErrorState = 1u << 1,
+    kFallbackMode = 1u << 2,
+    kRequiresFallback = 1u << 3
+};
+
+struct DecisionRule {
+    uint32_t when;  // all of these conditions must hold
+    PerformanceMode mode;
+    DecisionReason reason;
+    uint8_t flags;
+};
+
+// Evaluated top to bottom; the first matching rule decides. Faults come
+// before data quality, and data quality before load, so a decision is
+// never based on values the engine has reason to distrust.
+constexpr DecisionRule kRules[] = {
+    {kInvalid, PerformanceMode::Lean, DecisionReason::InvalidMetrics, kConservative},
+    {kTimeout, PerformanceMode::Balanced, DecisionReason::SourceTimeout, kConservative | kErrorState},
+    {kException, PerformanceMode::Balanced, DecisionReason::SourceException, kConservative | kErrorState},
+    {kAllUnavailable, PerformanceMode::Lean, DecisionReason::CompleteSensorFailure,
+     kConservative | kErrorState | kFallbackMode | kRequiresFallback},
+    {kPartialFailure, PerformanceMode::Lean, DecisionReason::PartialSensorFailure, kConservative},
+    {kStale, PerformanceMode::Lean, DecisionReason::StaleMetrics, kConservative},
+    {kRecovered, PerformanceMode::Balanced, DecisionReason::Recovered, 0},
+    {kOutOfRange, PerformanceMode::Lean, DecisionReason::OutOfRange, kConservative},
+    {kHighLoad, PerformanceMode::Lean, DecisionReason::HighLoad, 0},
+    {kLowLoad, PerformanceMode::HighFidelity, DecisionReason::LowLoad, 0},
+    {0, PerformanceMode::Balanced, DecisionReason::NormalLoad, 0}
+};
+
+uint32_t conditions(const DecisionInputs& inputs, uint8_t previously_unavailable) {
+    uint32_t present = 0;
+    if (!std::isfinite(inputs.cpu) || !std::isfinite(inputs.memory) || !std::isfinite(inputs.gpu)) {
+        present |= kInvalid;
+    }
+    if (inputs.has_exception) {
+        present |= inputs.has_timeout ? kTimeout : kException;
+    }
+    if (inputs.available == 0) {
+        present |= kAllUnavailable;
+    } else if (inputs.available != DecisionInputs::kAll) {
+        present |= kPartialFailure;
+    }
+    if (inputs.is_stale) {
+        present |= kStale;
+    }
+    if (previously_unavailable & inputs.available) {
+        present |= kRecovered;
+    }
+    if (inputs.has_out_of_range) {
+        present |= kOutOfRange;
+    }
+    if (inputs.cpu > ModeDecisionEngine::kHighLoadThreshold ||
+        inputs.memory > ModeDecisionEngine::kHighLoadThreshold ||
+        inputs.gpu > ModeDecisionEngine::kHighLoadThreshold) {
+        present |= kHighLoad;
+    } else if (inputs.cpu <= ModeDecisionEngine::kLowLoadThreshold &&
+               inputs.memory <= ModeDecisionEngine::kLowLoadThreshold &&
+               inputs.gpu <= ModeDecisionEngine::kLowLoadThreshold) {
+        present |= kLowLoad;
+    }
+    return present;
+}
+
+bool is_load_reason(DecisionReason reason) {
+    return reason == DecisionReason::HighLoad || reason == DecisionReason::LowLoad ||
+           reason == DecisionReason::NormalLoad || reason == DecisionReason::Hysteresis ||
+           reason == DecisionReason::RisingLoad;
+}
+
+// Higher is more conservative
+int conservatism(PerformanceMode mode) {
+    switch (mode) {
+        case PerformanceMode::HighFidelity: return 0;
+        case PerformanceMode::Balanced: return 1;
+        case PerformanceMode::Lean: return 2;
+    }
+    return 1;
+}
+
+} // namespace
+
+const char* to_string(DecisionReason reason) {
+    switch (reason) {
+        case DecisionReason::Custom: return "";
+        case DecisionReason::Forced: return "Mode forced for testing";
+        case DecisionReason::InvalidMetrics: return "invalid metrics: NaN or infinite values detected";
+        case DecisionReason::SourceTimeout: return "timeout detected";
+        case DecisionReason::SourceException: return "exception detected";
+        case DecisionReason::CompleteSensorFailure: return "critical: complete sensor failure";
+        case DecisionReason::PartialSensorFailure: return "partial sensor failure: defaults substituted";
+        case DecisionReason::StaleMetrics: return "stale metrics";
+        case DecisionReason::Recovered: return "recovered";
+        case DecisionReason::OutOfRange: return "metric out of range";
+        case DecisionReason::HighLoad: return "high_load";
+        case DecisionReason::LowLoad: return "low_load";
+        case DecisionReason::NormalLoad: return "normal_load";
+        case DecisionReason::Hysteresis: return "hysteresis";
+        case DecisionReason::RisingLoad: return "rising_load";
+    }
+    return "unknown";
+}
+
+std::string ModeDecision::reason_text() const {
+    if (!reason.empty()) {
+        return reason;
+    }
+    std::string text = to_string(code);
+    if (code == DecisionReason::SourceTimeout || code == DecisionReason::SourceException) {
+        std::string name = MetricRegistry::instance().name(source);
+        text += ": ";
+        text += name.empty() ? "unknown" : name;
+    }
+    return text;
+}
+
 // Initialize static members
 bool ModeDecisionEngine::force_stable_for_testing_ = false;
 
 // Static method to control forced stability for testing
 void ModeDecisionEngine::setForceStableForTesting(bool force_stable) {
-    force_stable_for_testing_ = force_stable; 
+    force_stable_for_testing_ = force_stable;
 }
 
 bool ModeDecisionEngine::getForceStableForTesting() {
     return force_stable_for_testing_;
 }
 
-ModeDecision ModeDecisionEngine::evaluate_metrics(const SystemMetrics& metrics) {
+DecisionInputs ModeDecisionEngine::inputs_from(const SystemMetrics& metrics) {
+    DecisionInputs inputs;
+    inputs.cpu = metrics.cpu_usage;
+    inputs.memory = metrics.memory_usage;
+    inputs.gpu = metrics.gpu_usage;
+    if (metrics.metrics.is_available(MetricRegistry::kCpu)) {
+        inputs.available |= DecisionInputs::kCpu;
+    }
+    if (metrics.metrics.is_available(MetricRegistry::kMemory)) {
+        inputs.available |= DecisionInputs::kMemory;
+    }
+    if (metrics.metrics.is_available(MetricRegistry::kGpu)) {
+        inputs.available |= DecisionInputs::kGpu;
+    }
+    inputs.is_stale = metrics.is_stale;
+    inputs.has_exception = metrics.has_exception;
+    inputs.has_timeout = metrics.has_timeout;
+    inputs.has_out_of_range = metrics.has_out_of_range;
+    inputs.failed_source = metrics.exception_metric;
+    return inputs;
+}
+
+void ModeDecisionEngine::enable_smoothing(const SmoothingConfig& config) {
+    smoother_ = ModeSmoother(config);
+    smoothing_enabled_ = true;
+}
+
+ModeDecision ModeDecisionEngine::decide(const DecisionInputs& inputs) {
+    return decide(inputs, std::chrono::steady_clock::now());
+}
+
+ModeDecision ModeDecisionEngine::decide(const DecisionInputs& inputs,
+                                        std::chrono::steady_clock::time_point now) {
     ModeDecision decision;
-    decision.mode = PerformanceMode::Balanced; // Default to balanced
-    
-    // If forced mode is set, always return it
-    if (force_mode_for_testing_) {
-        decision.mode = forced_mode_;
-        decision.reason = forced_reason_;
-        return decision;
-    }
-    
-    // Debug output for metrics
-    #ifdef DEBUG_MODE
-    std::cout << "***** DEBUG SystemMetrics *****" << std::endl;
-    std::cout << "CPU: " << metrics.cpu_usage << std::endl;
-    std::cout << "Memory: " << metrics.memory_usage << std::endl;
-    std::cout << "GPU: " << metrics.gpu_usage << std::endl;
-    std::cout << "Is Stale: " << (metrics.is_stale ? "true" : "false") << std::endl;
-    std::cout << "Is Valid: " << (metrics.is_valid ? "true" : "false") << std::endl;
-    #endif
-    
-    // Check source availability
-    bool cpu_available = metrics.metrics.count("cpu") && metrics.metrics.at("cpu").is_available;
-    bool memory_available = metrics.metrics.count("memory") && metrics.metrics.at("memory").is_available;
-    bool gpu_available = metrics.metrics.count("gpu") && metrics.metrics.at("gpu").is_available;
-    
-    // Check if any source was previously unavailable but is now available
-    bool cpu_recovered = cpu_was_unavailable_ && cpu_available;
-    bool memory_recovered = memory_was_unavailable_ && memory_available;
-    bool gpu_recovered = gpu_was_unavailable_ && gpu_available;
-    bool any_recovered = cpu_recovered || memory_recovered || gpu_recovered;
-    
-    // Debug output
-    #ifdef DEBUG_MODE
-    std::cout << "Recovery check - CPU: " << (cpu_recovered ? "RECOVERED" : "no change")
-              << " (was unavailable: " << cpu_was_unavailable_ << ", now: " << cpu_available << ")"
-              << ", Memory: " << (memory_recovered ? "RECOVERED" : "no change")
-              << " (was unavailable: " << memory_was_unavailable_ << ", now: " << memory_available << ")"
-              << ", GPU: " << (gpu_recovered ? "RECOVERED" : "no change")
-              << " (was unavailable: " << gpu_was_unavailable_ << ", now: " << gpu_available << ")"
-              << std::endl;
-    #endif
-    
-    // Special case for recovery after failure - ALWAYS check this first
-    if (any_recovered) {
-        #ifdef DEBUG_MODE
-        std::cout << "SOURCE RECOVERY DETECTED! Setting mode to Balanced with reason 'recovered'" << std::endl;
-        #endif
-        
-        // Basic recovery case - override other decisions if any source has recovered
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "recovered";
-        decision.details = "Sensor recovery detected";
-        
-        // Update tracking state after recovery
-        had_previous_source_failure_ = false;
-        cpu_was_unavailable_ = false;
-        memory_was_unavailable_ = false;
-        gpu_was_unavailable_ = false;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Special case for RecoversFromTemporaryFailure_AndRestoresAppropriateMode test
-    // When the CPU is unavailable, we should set specific flags and return Lean mode with "default" reason
-    if (!cpu_available && memory_available && gpu_available &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        
-        #ifdef DEBUG_MODE
-        std::cout << "RecoversFromTemporaryFailure test case detected - CPU unavailable with Memory=60, GPU=75" << std::endl;
-        #endif
-        
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "default";
-        decision.details = "partial sensor failure";
-        decision.is_conservative = true;
-        
-        // Update tracking state for next time
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = true;  // Explicitly set this flag 
-        memory_was_unavailable_ = !memory_available;
-        gpu_was_unavailable_ = !gpu_available;
-        
-        #ifdef DEBUG_MODE
-        std::cout << "Setting tracking state: cpu_was_unavailable_=" << cpu_was_unavailable_
-                  << ", had_previous_source_failure_=" << had_previous_source_failure_ << std::endl;
-        #endif
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
 
-    // Update tracking variables for next time - this is important!
-    // We update these even if we don't detect a special case above
-    had_previous_source_failure_ = !cpu_available || !memory_available || !gpu_available;
-    cpu_was_unavailable_ = !cpu_available;
-    memory_was_unavailable_ = !memory_available;
-    gpu_was_unavailable_ = !gpu_available;
-    
-    // Test #1: SwitchesToPerformance
-    // ... existing code ...
-    
-    decision.mode = PerformanceMode::Balanced; // Default to balanced
-    decision.details = "";
-    decision.is_error_state = false;
-    decision.is_conservative = false;
-    
-    // Debug output to console to understand the metrics values
-    #ifdef DEBUG_MODE
-    std::cout << "***** DEBUG SystemMetrics *****" << std::endl;
-    std::cout << "CPU: " << metrics.cpu_usage << std::endl;
-    std::cout << "Memory: " << metrics.memory_usage << std::endl;
-    std::cout << "GPU: " << metrics.gpu_usage << std::endl;
-    std::cout << "Is Stale: " << (metrics.is_stale ? "true" : "false") << std::endl;
-    std::cout << "Is Valid: " << (metrics.is_valid ? "true" : "false") << std::endl;
-    #endif
-    
-    // Exception handling moved to makeDecision method
-    
-    // Special case for HandlesPartialSensorFailures test
-    if (!cpu_available && memory_available && gpu_available &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        // This is the specific pattern for HandlesPartialSensorFailures test
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "partial sensor failure";
-        decision.details = "CPU sensor unavailable";
-        decision.is_error_state = true;
-        
-        // Update tracking state for next time
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = !cpu_available;
-        memory_was_unavailable_ = !memory_available;
-        gpu_was_unavailable_ = !gpu_available;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Special case for RecoversFromTemporaryFailure_AndRestoresAppropriateMode test
-    // CPU is 0 (unavailable) but memory and GPU have specific values
-    if (metrics.cpu_usage == 0.0 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        // This is the original case for RecoversFromTemporaryFailure test
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "default";
-        decision.details = "partial sensor failure";
-        decision.is_conservative = true;
-        
-        // Update tracking state for next time
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = !cpu_available;
-        memory_was_unavailable_ = !memory_available;
-        gpu_was_unavailable_ = !gpu_available;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Handle forced mode for testing
+    // A forced mode bypasses the rule table and leaves the source
+    // tracking untouched
     if (force_mode_for_testing_) {
         decision.mode = forced_mode_;
-        
-        // Special case for HandlesMetricSourceDrift - use specific reason text
-        // Check if any metric value matches a drift value
-        double drift_values[] = {45.5, 47.0, 48.5, 50.0, 51.5};
-        for (double value : drift_values) {
-            if (std::abs(metrics.cpu_usage - value) < 0.1 && 
-                std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-                std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-                decision.reason = "metric drift detected";
-                return decision;
-            }
-        }
-        
-        // Special case for StateController_PreventsModeOscillation test
-        // Check for specific metric patterns used in the test
-        if (std::abs(metrics.cpu_usage - 20.0) < 0.1 && 
-            std::abs(metrics.memory_usage - 30.0) < 0.1 && 
-            std::abs(metrics.gpu_usage - 40.0) < 0.1) {
-            decision.reason = "High performance mode activated due to high CPU usage";
-            decision.mode = PerformanceMode::HighFidelity;
-            return decision;
-        }
-        
-        if (std::abs(metrics.cpu_usage - 45.0) < 0.1 && 
-            std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-            std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-            decision.reason = "normal";
-            decision.details = "CPU=45, Memory=60, GPU=75";
-            return decision;
-        }
-        
-        if (std::abs(metrics.cpu_usage - 95.0) < 0.1 && 
-            std::abs(metrics.memory_usage - 90.0) < 0.1 && 
-            std::abs(metrics.gpu_usage - 85.0) < 0.1) {
-            decision.reason = "High performance mode activated due to high CPU usage";
-            decision.details = "CPU=95, Memory=90, GPU=85";
-            return decision;
-        }
-        
-        // Default reason
-        decision.reason = "Mode forced for testing";
-        return decision;
-    }
-    
-    // Handle force stable for HandlesRapidMetricFluctuations test
-    if (force_stable_for_testing_) {
-        #ifdef DEBUG_MODE
-        std::cout << "ModeDecisionEngine::makeDecision - Force stable for testing detected, enforcing Balanced mode"
-                 << " for all metric values" << std::endl;
-        #endif
-        
-        // When force_stable_for_testing_ is true, always return Balanced mode
-        // This is required for HandlesRapidMetricFluctuations test to pass
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "hysteresis";
-        decision.details = "force stable mode active - stabilizing all metrics";
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Test #4: HandlesFallbackToLean_WhenDecisionEngineIndicatesCriticalFailure / StateController_InitiatesSystemFallback_WhenDecisionEngineSignalsCriticalError
-    if (metrics.cpu_usage == 0.0 && 
-        metrics.memory_usage == 0.0 && 
-        metrics.gpu_usage == 0.0) {
-        decision.mode = PerformanceMode::Lean;
-        
-        // Handle the specific test differently
-        // Special case specifically for StateController_InitiatesSystemFallback_WhenDecisionEngineSignalsCriticalError
-        if (!cpu_available && !memory_available && !gpu_available) {
-            // Check if the no sensors are available AND we're in the specific StateController test
-            std::string test_specific_error = "Critical error detected: all sensors unavailable";
-            if (!metrics.metrics.count("cpu") || !metrics.metrics.count("memory") || !metrics.metrics.count("gpu")) {
-                decision.reason = test_specific_error;
-            } else {
-                // Default for HandlesFallbackToLean_WhenDecisionEngineIndicatesCriticalFailure
-                decision.reason = "critical: complete sensor failure";
-            }
-        } else {
-            // Default to the critical failure case for backward compatibility
-            decision.reason = "critical: complete sensor failure";
-        }
-        
-        decision.details = "All sensor values are zero";
-        decision.is_conservative = true;
-        decision.requires_fallback = true;
-        decision.is_fallback_mode = true;
-        decision.is_error_state = true;
+        decision.code = DecisionReason::Forced;
+        decision.reason = forced_reason_;
         last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
         return decision;
     }
 
-    // Test #5: HandlesOutOfRangeMetrics - cpu=100, memory=0, gpu=75
-    if (metrics.cpu_usage == 100.0 && 
-        metrics.memory_usage == 0.0 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "range";
-        decision.details = "out of range";
-        decision.is_conservative = true;
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Test #6: HandlesNaNMetrics - check for NaN values in any of the metrics
-    if (std::isnan(metrics.cpu_usage) || std::isnan(metrics.memory_usage) || std::isnan(metrics.gpu_usage) ||
-        std::isinf(metrics.cpu_usage) || std::isinf(metrics.memory_usage) || std::isinf(metrics.gpu_usage)) {
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "invalid";
-        decision.details = "invalid metrics: NaN or infinite values detected";
-        decision.is_conservative = true;
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // For stale metrics, apply a conservative policy
-    if (metrics.is_stale) {
-        // Special case for HandlesStaleMetrics_WithModeSwitching test
-        // CPU value is 45.5, memory is 60.0, gpu is 75.0, but CPU timestamp is stale
-        if (std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-            std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-            std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-            decision.mode = PerformanceMode::Lean;
-            decision.reason = "stale metrics detected";
-            decision.details = "Using last known good value";
-            decision.is_conservative = true;
-            
-            #ifdef DEBUG_MODE
-            std::cout << "Detected stale metrics matching HandlesStaleMetrics_WithModeSwitching test pattern" << std::endl;
-            #endif
-            
-            last_decision_ = decision;
-            last_decision_time_ = std::chrono::system_clock::now();
-            return decision;
-        }
-        
-        // Default handling for stale metrics
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "stale";
-        decision.details = "stale metrics";
-        decision.is_conservative = true;
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Test #7: HandlesRapidMetricChanges - handled by hysteresis logic
-    // Check if we need to apply hysteresis to avoid frequent mode switches
-    auto time_diff = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now() - last_decision_time_).count();
-            
-    // Don't apply hysteresis if we're in the specific recovery test scenario
-    if (!any_recovered && !last_decision_.reason.empty() && time_diff < 5) {
-        decision.mode = last_decision_.mode;
-        decision.reason = "hysteresis";
-        decision.details = "hysteresis applied";
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
+    const uint32_t present = conditions(inputs, unavailable_);
+    const DecisionRule* rule = kRules;
+    while ((present & rule->when) != rule->when) {
+        ++rule;
     }
-    
-    // Check if this is a calibration scenario by inspecting the metrics
-    // Calibrating: CPU=0.0, Memory=60.0, GPU=75.0 with all sources available
-    bool all_available = metrics.metrics.count("cpu") && metrics.metrics.at("cpu").is_available &&
-                         metrics.metrics.count("memory") && metrics.metrics.at("memory").is_available &&
-                         metrics.metrics.count("gpu") && metrics.metrics.at("gpu").is_available;
 
-    // Special case for partial sensor failures - check this before calibration
-    // CPU is explicitly reported as unavailable but other sources are working
-    // Variables cpu_available, memory_available, and gpu_available are already defined earlier in this method
-    
-    #ifdef DEBUG_MODE
-    std::cout << "Sensor availability check - CPU: " << (cpu_available ? "AVAILABLE" : "UNAVAILABLE")
-              << ", Memory: " << (memory_available ? "AVAILABLE" : "UNAVAILABLE")
-              << ", GPU: " << (gpu_available ? "AVAILABLE" : "UNAVAILABLE")
-              << ", All available: " << (all_available ? "TRUE" : "FALSE") << std::endl;
-    #endif
-
-    if (!cpu_available && memory_available && gpu_available &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        // This is the specific pattern for HandlesPartialSensorFailures test
-        #ifdef DEBUG_MODE
-        std::cout << "PARTIAL SENSOR FAILURE DETECTED - CPU is unavailable but others are working" << std::endl;
-        #endif
-        
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "partial sensor failure";
-        decision.details = "CPU sensor unavailable";
-        decision.is_error_state = true;
-
-        // Update tracking state for next time
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = !cpu_available;
-        memory_was_unavailable_ = !memory_available;
-        gpu_was_unavailable_ = !gpu_available;
-
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
+    decision.mode = rule->mode;
+    decision.code = rule->reason;
+    decision.is_conservative = (rule->flags & kConservative) != 0;
+    decision.is_error_state = (rule->flags & kErrorState) != 0;
+    decision.is_fallback_mode = (rule->flags & kFallbackMode) != 0;
+    decision.requires_fallback = (rule->flags & kRequiresFallback) != 0;
+    if (rule->when & (kTimeout | kException)) {
+        decision.source = inputs.failed_source;
     }
 
-    // Only consider calibration if CPU is actually available but reporting 0.0
-    if (all_available && metrics.cpu_usage == 0.0 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 &&
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        #ifdef DEBUG_MODE
-        std::cout << "CALIBRATION DETECTED - CPU is available but reading 0.0" << std::endl;
-        #endif
-        
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "calibrating CPU sensor";
-        return decision;
-    }
-    
-    // Calibrated: CPU=45.5, Memory=60.0, GPU=75.0 with all sources available
-    if (all_available && std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        ModeDecision decision;
+    // Load-driven steps to a more conservative mode take effect at once;
+    // steps back are held until the previous mode has lasted
+    // kHysteresisHold, so load hovering at a threshold cannot flap. Forced
+    // stability pins every load decision to Balanced; faults still apply.
+    // The smoother, when enabled, only sees samples the table trusted.
+    if (is_load_reason(decision.code) && force_stable_for_testing_) {
         decision.mode = PerformanceMode::Balanced;
-        decision.reason = "calibrated CPU sensor";
-        return decision;
-    }
-    
-    // Default logic - evaluate metrics normally
-    double cpu_load = metrics.cpu_usage;
-    double memory_load = metrics.memory_usage;
-    double gpu_load = metrics.gpu_usage;
-    
-    // Calculate rate of change (simplified)
-    double rate_of_change = 0.0;  // Not used in basic implementation
-    
-    // Determine performance mode based on metrics
-    if (cpu_load > kHighLoadThreshold || 
-        memory_load > kHighLoadThreshold || 
-        gpu_load > kHighLoadThreshold) {
-        // High load on any resource -> Lean mode
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "high_load";
-        decision.details = "High load detected on system resources";
-    } 
-    else if (cpu_load < kLowLoadThreshold && 
-             memory_load < kLowLoadThreshold && 
-             gpu_load < kLowLoadThreshold) {
-        // Low load on all resources -> High Fidelity mode
-        decision.mode = PerformanceMode::HighFidelity;
-        
-        // Special case for StateController_CorrectlyAppliesModeSwitch_FromDecisionEngine test
-        // Check if values match the specific test values
-        if (std::abs(cpu_load - 20.0) < 0.1 &&
-            std::abs(memory_load - 30.0) < 0.1 &&
-            std::abs(gpu_load - 40.0) < 0.1) {
-            decision.reason = "High performance mode activated due to high CPU usage";
+        decision.code = DecisionReason::Hysteresis;
+    } else if (is_load_reason(decision.code) && smoothing_enabled_) {
+        SmoothedMode smoothed = smoother_.update(now, std::max({inputs.cpu, inputs.memory, inputs.gpu}));
+        decision.mode = smoothed.mode;
+        if (smoothed.held) {
+            decision.code = DecisionReason::Hysteresis;
+        } else if (smoothed.rate_triggered) {
+            decision.code = DecisionReason::RisingLoad;
         } else {
-            decision.reason = "low_load";
+            decision.code = smoothed.mode == PerformanceMode::Lean ? DecisionReason::HighLoad
+                          : smoothed.mode == PerformanceMode::HighFidelity ? DecisionReason::LowLoad
+                          : DecisionReason::NormalLoad;
         }
-        
-        decision.details = "Low load detected on all system resources";
+    } else if (is_load_reason(decision.code) && is_load_reason(last_decision_.code) &&
+               conservatism(decision.mode) < conservatism(last_decision_.mode) &&
+               now - last_mode_change_ < kHysteresisHold) {
+        decision.mode = last_decision_.mode;
+        decision.code = DecisionReason::Hysteresis;
     }
-    else {
-        // Moderate load -> Balanced mode
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "moderate_load";
-        decision.details = "Moderate load detected on system resources";
+    if (decision.mode != last_decision_.mode) {
+        last_mode_change_ = now;
     }
-    
-    // Include the metrics in the details for debugging
-    std::stringstream metrics_details;
-    metrics_details << "CPU=" << metrics.cpu_usage
-                   << ", Memory=" << metrics.memory_usage
-                   << ", GPU=" << metrics.gpu_usage;
-    decision.details = metrics_details.str();
-    
-    // After all decisions are made, update tracking state for next time
-    had_previous_source_failure_ = !cpu_available || !memory_available || !gpu_available;
-    cpu_was_unavailable_ = !cpu_available;
-    memory_was_unavailable_ = !memory_available;
-    gpu_was_unavailable_ = !gpu_available;
-    
-    last_decision_ = decision;
-    last_decision_time_ = std::chrono::system_clock::now();
-    return decision;
-}
-
-bool ModeDecisionEngine::is_metric_stale(const std::chrono::system_clock::time_point& timestamp) const {
-    auto now = std::chrono::system_clock::now();
-    auto age = std::chrono::duration_cast<std::chrono::seconds>(now - timestamp).count();
-    return age > kStaleMetricThreshold;
-}
 
-bool ModeDecisionEngine::should_apply_hysteresis(const ModeDecision& new_decision) const {
-    // Only apply hysteresis if we're switching to the same mode
-    return new_decision.mode == last_decision_.mode;
-}
+    unavailable_ = static_cast<uint8_t>(~inputs.available & DecisionInputs::kAll);
+    last_decision_ = decision;
 
-ModeDecision ModeDecisionEngine::make_conservative_decision(const std::string& reason, const std::string& details) const {
-    ModeDecision decision;
-    decision.mode = PerformanceMode::Lean;
-    decision.reason = reason;
-    decision.details = details;
-    decision.is_conservative = true;
+    LogSink& log = LogSink::instance();
+    if (log.enabled(LogLevel::Debug)) {
+        log.log(LogLevel::Debug, to_string(decision.code), {inputs.cpu, inputs.memory, inputs.gpu});
+    }
     return decision;
 }
 
-bool ModeDecisionEngine::is_metric_valid(double value) const {
-    // Check for NaN, infinity, or negative values
-    if (std::isnan(value) || std::isinf(value) || value < 0.0) {
-        return false;
-    }
-    
-    // Check for unreasonable values (above 100%)
-    if (value > 100.0) {
-        return false;
-    }
-    
-    return true;
+ModeDecision ModeDecisionEngine::evaluate_metrics(const SystemMetrics& metrics) {
+    return decide(inputs_from(metrics));
 }
 
 ModeDecision ModeDecisionEngine::makeDecision(const SystemMetrics& metrics) {
     // Store the metrics for later retrieval
     last_processed_metrics_ = metrics;
-    
-    // Check for NaN or infinity in the metrics
-    if (std::isnan(metrics.cpu_usage) || std::isnan(metrics.memory_usage) || std::isnan(metrics.gpu_usage) ||
-        std::isinf(metrics.cpu_usage) || std::isinf(metrics.memory_usage) || std::isinf(metrics.gpu_usage)) {
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "invalid";
-        decision.details = "invalid metrics: NaN or infinite values detected";
-        decision.is_conservative = true;
-        return decision;
-    }
-
-    // Check for exceptions first - this should be the highest priority
-    if (metrics.has_exception) {
-        // Special case for timeouts
-        if (metrics.exception_message.find("Timeout") != std::string::npos || 
-            metrics.exception_message.find("timeout") != std::string::npos) {
-            ModeDecision decision;
-            decision.mode = PerformanceMode::Balanced;
-            decision.reason = "timeout detected: " + metrics.exception_source;
-            decision.details = metrics.exception_message;
-            decision.is_error_state = true;
-            decision.is_conservative = true;
-            
-            // Debug output to help track timeout cases
-            #ifdef DEBUG_MODE
-            std::cout << "Handling timeout case: " << metrics.exception_message << std::endl;
-            #endif
-            
-            last_decision_ = decision;
-            last_decision_time_ = std::chrono::system_clock::now();
-            return decision;
-        }
-        
-        // Handle other exceptions
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced; // Stay in balanced mode for exceptions
-        decision.reason = "exception detected: " + metrics.exception_source;
-        decision.details = metrics.exception_message;
-        decision.is_error_state = true;
-        decision.is_conservative = true; // Explicitly mark as conservative
-        
-        // Debug output to help track this case
-        #ifdef DEBUG_MODE
-        std::cout << "Handling exception case from " << metrics.exception_source 
-                  << ": " << metrics.exception_message << std::endl;
-        #endif
-                  
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Check for stale metrics before recovery checks - needed for HandlesStaleMetrics_WithModeSwitching
-    if (metrics.is_stale) {
-        // Special case for HandlesStaleMetrics_WithModeSwitching test
-        if (std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-            std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-            std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-            
-            #ifdef DEBUG_MODE
-            std::cout << "STALE METRICS DETECTED in makeDecision: CPU=" << metrics.cpu_usage 
-                     << ", Memory=" << metrics.memory_usage 
-                     << ", GPU=" << metrics.gpu_usage << std::endl;
-            #endif
-            
-            ModeDecision decision;
-            decision.mode = PerformanceMode::Lean;
-            decision.reason = "stale metrics detected";
-            decision.details = "Using last known good value";
-            decision.is_conservative = true;
-            last_decision_ = decision;
-            last_decision_time_ = std::chrono::system_clock::now();
-            return decision;
-        }
-    }
-    
-    // Check for recovery - after exceptions and stale metrics
-    bool cpu_available = metrics.metrics.count("cpu") && metrics.metrics.at("cpu").is_available;
-    bool memory_available = metrics.metrics.count("memory") && metrics.metrics.at("memory").is_available;
-    bool gpu_available = metrics.metrics.count("gpu") && metrics.metrics.at("gpu").is_available;
-    
-    // Check if any source was previously unavailable but is now available
-    bool cpu_recovered = cpu_was_unavailable_ && cpu_available;
-    bool memory_recovered = memory_was_unavailable_ && memory_available;
-    bool gpu_recovered = gpu_was_unavailable_ && gpu_available;
-    bool any_recovered = cpu_recovered || memory_recovered || gpu_recovered;
-    
-    // Debug output
-    #ifdef DEBUG_MODE
-    std::cout << "Recovery check in makeDecision - CPU: " 
-              << (cpu_recovered ? "RECOVERED" : "no change") 
-              << " (was unavailable: " << cpu_was_unavailable_ << ", now: " << cpu_available << ")"
-              << ", Memory: " << (memory_recovered ? "RECOVERED" : "no change")
-              << " (was unavailable: " << memory_was_unavailable_ << ", now: " << memory_available << ")"
-              << ", GPU: " << (gpu_recovered ? "RECOVERED" : "no change")
-              << " (was unavailable: " << gpu_was_unavailable_ << ", now: " << gpu_available << ")"
-              << std::endl;
-    #endif
-    
-    // Special case for recovery after failure - ALWAYS check this first
-    if (any_recovered) {
-        #ifdef DEBUG_MODE
-        std::cout << "SOURCE RECOVERY DETECTED in makeDecision! Setting mode to Balanced with reason 'recovered'" << std::endl;
-        #endif
-        
-        // Basic recovery case - override other decisions if any source has recovered
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "recovered";
-        decision.details = "Sensor recovery detected";
-        
-        // Update tracking state after recovery
-        had_previous_source_failure_ = false;
-        cpu_was_unavailable_ = false;
-        memory_was_unavailable_ = false;
-        gpu_was_unavailable_ = false;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // SPECIAL CASE FOR RecoversFromTemporaryFailure_AndRestoresAppropriateMode test
-    // When CPU is recovering with specific metrics, ALSO mark as recovered
-    if (cpu_was_unavailable_ && cpu_available && 
-        std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        
-        #ifdef DEBUG_MODE
-        std::cout << "RecoversFromTemporaryFailure test RECOVERY detected! CPU was unavailable but now available with metrics 45.5/60/75" << std::endl;
-        #endif
-        
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "recovered";
-        decision.details = "CPU sensor recovered";
-        
-        // Update tracking state
-        had_previous_source_failure_ = false;
-        cpu_was_unavailable_ = false;
-        memory_was_unavailable_ = false;
-        gpu_was_unavailable_ = false;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // Special case for RecoversFromTemporaryFailure_AndRestoresAppropriateMode test
-    // When the CPU is unavailable, we should set specific flags and return Lean mode with "default" reason
-    if (!cpu_available && memory_available && gpu_available &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        
-        #ifdef DEBUG_MODE
-        std::cout << "RecoversFromTemporaryFailure test case detected in makeDecision - CPU unavailable with Memory=60, GPU=75" << std::endl;
-        std::cout << "Setting tracking state: cpu_was_unavailable_=1, had_previous_source_failure_=1" << std::endl;
-        #endif
-        
-        // Explicitly create a decision for the RecoversFromTemporaryFailure test
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "default";
-        decision.details = "partial sensor failure";
-        decision.is_conservative = true;
-        
-        // Update tracking state for recovery detection later
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = true;
-        memory_was_unavailable_ = false;
-        gpu_was_unavailable_ = false;
-        
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-    
-    // If we're forcing a mode for testing, return that directly with the forced reason
-    if (force_mode_for_testing_) {
-        ModeDecision decision;
-        decision.mode = forced_mode_;
-        decision.reason = forced_reason_;
-        return decision;
-    }
-    
-    // Special case for SwitchesModeCorrectly_OnDecisionEngineOutput test
-    // The test is looking for a reason with the word "normal" in it
-    if (std::abs(metrics.cpu_usage - 45.5) < 0.1 &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 &&
-        std::abs(metrics.gpu_usage - 75.0) < 0.1 &&
-        !metrics.is_stale &&
-        !had_previous_source_failure_) {  // Add check to avoid conflict with recovery
-
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Lean;
-        decision.reason = "normal operation mode";
-        decision.details = "CPU=45.5, Memory=60.0, GPU=75.0";
-        decision.is_error_state = false;
-        decision.is_fallback_mode = false;
-        decision.is_conservative = false;
-
-        #ifdef DEBUG_MODE
-        std::cout << "ModeDecisionEngine::makeDecision - Special case for SwitchesModeCorrectly_OnDecisionEngineOutput test detected" << std::endl;
-        #endif
-        return decision;
-    }
-    
-    // Special case for StateController_CorrectlyAppliesModeSwitch_FromDecisionEngine test
-    // The key values we're checking for are CPU=20.0, Memory=30.0, GPU=40.0
-    if (std::abs(metrics.cpu_usage - 20.0) < 0.1 && 
-        std::abs(metrics.memory_usage - 30.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 40.0) < 0.1 && 
-        !metrics.is_stale) {
-        ModeDecision decision;
-        decision.mode = PerformanceMode::HighFidelity;
-        decision.reason = "High performance mode activated due to high CPU usage";
-        decision.details = "CPU=20, Memory=30, GPU=40";
-        decision.is_error_state = false;
-        decision.is_fallback_mode = false;
-        decision.is_conservative = false;
-        
-        #ifdef DEBUG_MODE
-        std::cout << "ModeDecisionEngine::makeDecision - Special case for test detected, returning HighFidelity mode" << std::endl;
-        #endif
-        return decision;
-    }
-    
-    // Special case for EnforcesCooldown_AfterModeSwitch test
-    // This test specifically needs a "normal" reason for the setupNormalMetrics() metrics
-    // and must return PerformanceMode::Balanced
-    if (std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        
-        // Check if SwitchesModeCorrectly_OnDecisionEngineOutput test is calling this
-        // That test sets direct mode set to true before calling
-        if (StateController::is_direct_mode_set_) {
-            // For SwitchesModeCorrectly_OnDecisionEngineOutput we need Lean mode
-            ModeDecision decision;
-            decision.mode = PerformanceMode::Lean;
-            decision.reason = "normal operation mode";
-            decision.details = "CPU=45.5, Memory=60.0, GPU=75.0";
-            
-            #ifdef DEBUG_MODE
-            std::cout << "ModeDecisionEngine::makeDecision - Special case for SwitchesModeCorrectly_OnDecisionEngineOutput detected" << std::endl;
-            #endif
-            
-            return decision;
-        } else {
-            // For EnforcesCooldown_AfterModeSwitch we need Balanced mode
-            ModeDecision decision;
-            decision.mode = PerformanceMode::Balanced;
-            decision.reason = "normal operation";
-            decision.details = "CPU=45.5, Memory=60.0, GPU=75.0";
-            
-            #ifdef DEBUG_MODE
-            std::cout << "ModeDecisionEngine::makeDecision - Special case for EnforcesCooldown_AfterModeSwitch test detected" << std::endl;
-            #endif
-            
-            return decision;
-        }
-    }
-    
-    // Check if this is a calibration scenario by inspecting the metrics
-    // Calibrating: CPU=0.0, Memory=60.0, GPU=75.0 with all sources available
-    bool all_available = metrics.metrics.count("cpu") && metrics.metrics.at("cpu").is_available &&
-                         metrics.metrics.count("memory") && metrics.metrics.at("memory").is_available &&
-                         metrics.metrics.count("gpu") && metrics.metrics.at("gpu").is_available;
-                         
-    // Special case for partial sensor failures - check this before calibration
-    // CPU is explicitly reported as unavailable but other sources are working
-    if (!cpu_available && memory_available && gpu_available &&
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        // This is the specific pattern for HandlesPartialSensorFailures test
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "partial sensor failure";
-        decision.details = "CPU sensor unavailable";
-        decision.is_error_state = true;
-
-        // Update tracking state for next time
-        had_previous_source_failure_ = true;
-        cpu_was_unavailable_ = !cpu_available;
-        memory_was_unavailable_ = !memory_available;
-        gpu_was_unavailable_ = !gpu_available;
-
-        last_decision_ = decision;
-        last_decision_time_ = std::chrono::system_clock::now();
-        return decision;
-    }
-                         
-    // Only consider calibration if CPU is actually available but reporting 0.0
-    if (all_available && metrics.cpu_usage == 0.0 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "calibrating CPU sensor";
-        return decision;
-    }
-    
-    // Calibrated: CPU=45.5, Memory=60.0, GPU=75.0 with all sources available
-    if (all_available && std::abs(metrics.cpu_usage - 45.5) < 0.1 && 
-        std::abs(metrics.memory_usage - 60.0) < 0.1 && 
-        std::abs(metrics.gpu_usage - 75.0) < 0.1) {
-        ModeDecision decision;
-        decision.mode = PerformanceMode::Balanced;
-        decision.reason = "calibrated CPU sensor";
-        return decision;
-    }
-    
-    // For all other cases, use the standard evaluation logic
-    return evaluate_metrics(metrics);
+    return decide(inputs_from(metrics));
 }
 
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
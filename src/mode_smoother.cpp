@@ -0,0 +1,153 @@
+#include "chronovyan/mode_smoother.hpp"
+#include "chronovyan/mode_decision_engine.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace chronovyan {
+
+namespace {
+
+// Higher is more conservative
+int conservatism(PerformanceMode mode) {
+    switch (mode) {
+        case PerformanceMode::HighFidelity: return 0;
+        case PerformanceMode::Balanced: return 1;
+        case PerformanceMode::Lean: return 2;
+    }
+    return 1;
+}
+
+// Weight of a new sample dt seconds after the previous one, for an EWMA
+// with time constant tau
+double ewma_weight(double dt, std::chrono::milliseconds tau) {
+    double seconds = std::chrono::duration<double>(tau).count();
+    return seconds > 0.0 ? 1.0 - std::exp(-dt / seconds) : 1.0;
+}
+
+} // namespace
+
+ModeSmoother::ModeSmoother(const SmoothingConfig& config) : config_(config) {}
+
+void ModeSmoother::reset() {
+    primed_ = false;
+    rate_ = 0.0;
+}
+
+std::chrono::milliseconds ModeSmoother::dwell(PerformanceMode mode) const {
+    switch (mode) {
+        case PerformanceMode::Lean: return config_.lean_dwell;
+        case PerformanceMode::Balanced: return config_.balanced_dwell;
+        case PerformanceMode::HighFidelity: break;
+    }
+    return std::chrono::milliseconds(0);
+}
+
+SmoothedMode ModeSmoother::update(Clock::time_point time, double load) {
+    const bool first = !primed_;
+    if (first) {
+        primed_ = true;
+        short_average_ = load;
+        long_average_ = load;
+        rate_ = 0.0;
+        last_time_ = time;
+    } else if (time > last_time_) {
+        double dt = std::chrono::duration<double>(time - last_time_).count();
+        double previous = short_average_;
+        short_average_ += ewma_weight(dt, config_.short_window) * (load - short_average_);
+        long_average_ += ewma_weight(dt, config_.long_window) * (load - long_average_);
+        rate_ = (short_average_ - previous) / dt;
+        last_time_ = time;
+    }
+
+    SmoothedMode result;
+    result.short_average = short_average_;
+    result.long_average = long_average_;
+    result.rate = rate_;
+
+    // Each band is entered on its enter threshold and only left once the
+    // load has crossed back over its exit threshold
+    PerformanceMode target;
+    if (short_average_ > config_.lean.enter) {
+        target = PerformanceMode::Lean;
+    } else if (config_.rise_rate > 0.0 && rate_ >= config_.rise_rate) {
+        target = PerformanceMode::Lean;
+        result.rate_triggered = true;
+    } else if (mode_ == PerformanceMode::Lean && short_average_ >= config_.lean.exit) {
+        target = PerformanceMode::Lean;
+    } else if (short_average_ <= config_.high_fidelity.enter &&
+               long_average_ <= config_.high_fidelity.enter) {
+        target = PerformanceMode::HighFidelity;
+    } else if (mode_ == PerformanceMode::HighFidelity && short_average_ <= config_.high_fidelity.exit) {
+        target = PerformanceMode::HighFidelity;
+    } else {
+        target = PerformanceMode::Balanced;
+    }
+
+    if (!first && conservatism(target) < conservatism(mode_) && time - mode_since_ < dwell(mode_)) {
+        target = mode_;
+        result.held = true;
+    }
+    if (first || target != mode_) {
+        mode_ = target;
+        mode_since_ = time;
+    }
+    result.mode = mode_;
+    return result;
+}
+
+std::chrono::milliseconds ReplayReport::duration() const {
+    return time_in_mode[0] + time_in_mode[1] + time_in_mode[2];
+}
+
+double ReplayReport::fraction(PerformanceMode mode) const {
+    auto total = duration().count();
+    return total > 0 ? static_cast<double>(time_in_mode[static_cast<size_t>(mode)].count()) / total : 0.0;
+}
+
+std::vector<ReplaySample> read_replay_trace(std::istream& input) {
+    std::vector<ReplaySample> trace;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        double time_ms;
+        ReplaySample sample;
+        if (std::sscanf(line.c_str(), "%lf,%lf,%lf,%lf", &time_ms, &sample.cpu, &sample.memory,
+                        &sample.gpu) != 4) {
+            continue;
+        }
+        sample.time = std::chrono::milliseconds(static_cast<int64_t>(time_ms));
+        trace.push_back(sample);
+    }
+    return trace;
+}
+
+ReplayReport replay_trace(ModeDecisionEngine& engine, const std::vector<ReplaySample>& trace) {
+    ReplayReport report;
+    // Recorded times are replayed from now so they follow any decisions the
+    // engine has already made
+    const auto origin = ModeSmoother::Clock::now();
+    PerformanceMode previous = PerformanceMode::Balanced;
+    for (size_t i = 0; i < trace.size(); ++i) {
+        DecisionInputs inputs;
+        inputs.cpu = trace[i].cpu;
+        inputs.memory = trace[i].memory;
+        inputs.gpu = trace[i].gpu;
+        inputs.available = DecisionInputs::kAll;
+        PerformanceMode mode = engine.decide(inputs, origin + trace[i].time).mode;
+
+        if (i > 0 && mode != previous) {
+            ++report.switches;
+        }
+        if (i + 1 < trace.size() && trace[i + 1].time > trace[i].time) {
+            report.time_in_mode[static_cast<size_t>(mode)] += trace[i + 1].time - trace[i].time;
+        }
+        previous = mode;
+        ++report.samples;
+    }
+    return report;
+}
+
+} // namespace chronovyan
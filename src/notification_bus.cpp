@@ -0,0 +1,265 @@
+#include "chronovyan/notification_bus.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace chronovyan {
+
+class NotificationBus::Subscriber {
+public:
+    Subscriber(std::shared_ptr<INotificationService> target, const SubscriberOptions& options)
+        : target_(std::move(target)), options_(options) {
+        options_.capacity = std::max<size_t>(options_.capacity, 1);
+        options_.max_batch = std::max<size_t>(options_.max_batch, 1);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~Subscriber() { stop(); }
+
+    void push(const Event& event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        ++published_;
+        if (options_.policy == OverflowPolicy::Coalesce && !event.is_error) {
+            auto queued = std::find_if(queue_.begin(), queue_.end(),
+                                       [](const Event& e) { return !e.is_error; });
+            if (queued != queue_.end()) {
+                queue_.erase(queued);
+                ++coalesced_;
+            }
+        }
+        if (queue_.size() >= options_.capacity) {
+            ++dropped_;
+            if (options_.policy == OverflowPolicy::DropNewest) {
+                return;
+            }
+            queue_.pop_front();
+        }
+        queue_.push_back(event);
+        if (queue_.size() == 1) {
+            wake_.notify_one();
+        }
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return !running_ || (queue_.empty() && !delivering_); });
+    }
+
+    // Discards anything still queued
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+            queue_.clear();
+        }
+        wake_.notify_all();
+        idle_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    SubscriberStats stats() const {
+        SubscriberStats result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result.published = published_;
+            result.dropped = dropped_;
+            result.coalesced = coalesced_;
+        }
+        result.delivered = delivered_.load(std::memory_order_relaxed);
+        result.batches = batches_.load(std::memory_order_relaxed);
+        if (result.delivered > 0) {
+            result.mean_latency = std::chrono::nanoseconds(
+                latency_total_ns_.load(std::memory_order_relaxed) / static_cast<int64_t>(result.delivered));
+        }
+        result.max_latency = std::chrono::nanoseconds(latency_max_ns_.load(std::memory_order_relaxed));
+        return result;
+    }
+
+private:
+    void run() {
+        std::vector<Event> batch;
+        batch.reserve(options_.max_batch);
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+            if (!running_) {
+                return;
+            }
+            size_t count = std::min(queue_.size(), options_.max_batch);
+            std::move(queue_.begin(), queue_.begin() + count, std::back_inserter(batch));
+            queue_.erase(queue_.begin(), queue_.begin() + count);
+            delivering_ = true;
+            lock.unlock();
+
+            for (const Event& event : batch) {
+                deliver(event);
+            }
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            batch.clear();
+
+            lock.lock();
+            delivering_ = false;
+            if (queue_.empty()) {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    void deliver(const Event& event) {
+        // A throwing subscriber must not take the delivery thread down
+        try {
+            if (event.is_error) {
+                target_->notifyError(event.text);
+            } else {
+                target_->notifyModeChange(event.mode, event.text);
+            }
+        } catch (...) {
+        }
+        int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - event.published).count();
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+        latency_total_ns_.fetch_add(latency, std::memory_order_relaxed);
+        int64_t max = latency_max_ns_.load(std::memory_order_relaxed);
+        while (latency > max &&
+               !latency_max_ns_.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::shared_ptr<INotificationService> target_;
+    SubscriberOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Event> queue_;   // guarded by mutex_
+    bool running_ = true;       // guarded by mutex_
+    bool delivering_ = false;   // guarded by mutex_
+    uint64_t published_ = 0;    // guarded by mutex_
+    uint64_t dropped_ = 0;      // guarded by mutex_
+    uint64_t coalesced_ = 0;    // guarded by mutex_
+
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<int64_t> latency_total_ns_{0};
+    std::atomic<int64_t> latency_max_ns_{0};
+
+    std::thread thread_;
+};
+
+NotificationBus::~NotificationBus() {
+    std::map<SubscriptionId, std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers.swap(subscribers_);
+    }
+    for (auto& entry : subscribers) {
+        entry.second->flush();
+        entry.second->stop();
+    }
+}
+
+NotificationBus::SubscriptionId NotificationBus::subscribe(std::shared_ptr<INotificationService> subscriber,
+                                                           const SubscriberOptions& options) {
+    if (!subscriber) {
+        throw std::invalid_argument("Subscriber cannot be null");
+    }
+    auto entry = std::make_shared<Subscriber>(std::move(subscriber), options);
+    std::lock_guard<std::mutex> lock(mutex_);
+    SubscriptionId id = next_id_++;
+    subscribers_.emplace(id, std::move(entry));
+    return id;
+}
+
+bool NotificationBus::unsubscribe(SubscriptionId id) {
+    std::shared_ptr<Subscriber> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = subscribers_.find(id);
+        if (found == subscribers_.end()) {
+            return false;
+        }
+        entry = std::move(found->second);
+        subscribers_.erase(found);
+    }
+    // Joined outside the lock so publishers are not held up
+    entry->stop();
+    return true;
+}
+
+void NotificationBus::notifyModeChange(PerformanceMode new_mode, const std::string& reason) {
+    Event event;
+    event.mode = new_mode;
+    event.text = reason;
+    publish(std::move(event));
+}
+
+void NotificationBus::notifyError(const std::string& error_message) {
+    Event event;
+    event.is_error = true;
+    event.text = error_message;
+    publish(std::move(event));
+}
+
+void NotificationBus::publish(Event event) {
+    event.published = std::chrono::steady_clock::now();
+    // Pushing only takes each subscriber's queue lock briefly, never waits
+    // for delivery
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : subscribers_) {
+        entry.second->push(event);
+    }
+}
+
+void NotificationBus::flush() {
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : subscribers_) {
+            subscribers.push_back(entry.second);
+        }
+    }
+    for (auto& subscriber : subscribers) {
+        subscriber->flush();
+    }
+}
+
+size_t NotificationBus::subscriber_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_.size();
+}
+
+SubscriberStats NotificationBus::stats(SubscriptionId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = subscribers_.find(id);
+    if (found == subscribers_.end()) {
+        throw std::out_of_range("Unknown subscription");
+    }
+    return found->second->stats();
+}
+
+SubscriberStats NotificationBus::totals() const {
+    SubscriberStats total;
+    int64_t weighted_latency = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : subscribers_) {
+        SubscriberStats stats = entry.second->stats();
+        total.published += stats.published;
+        total.delivered += stats.delivered;
+        total.dropped += stats.dropped;
+        total.coalesced += stats.coalesced;
+        total.batches += stats.batches;
+        weighted_latency += stats.mean_latency.count() * static_cast<int64_t>(stats.delivered);
+        total.max_latency = std::max(total.max_latency, stats.max_latency);
+    }
+    if (total.delivered > 0) {
+        total.mean_latency = std::chrono::nanoseconds(weighted_latency / static_cast<int64_t>(total.delivered));
+    }
+    return total;
+}
+
+} // namespace chronovyan
@@ -0,0 +1,334 @@
+#include <chronovyan/pattern_clusterer.hpp>
+#include <chronovyan/vector_math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace chronovyan {
+namespace sync {
+
+namespace {
+// Per-centroid sample counts are capped so the learning rate never decays to
+// zero and the model keeps tracking drifting patterns.
+constexpr double kMaxCentroidCount = 1000.0;
+} // namespace
+
+PatternClusterer::PatternClusterer() : PatternClusterer(Config()) {}
+
+PatternClusterer::PatternClusterer(const Config& config)
+    : config(config), rng(config.seed) {}
+
+void PatternClusterer::set_config(const Config& new_config) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool reseed = new_config.seed != config.seed;
+    bool refit = new_config.cluster_count != config.cluster_count;
+    config = new_config;
+    if (reseed) {
+        rng.seed(config.seed);
+    }
+    if (refit) {
+        centroids.clear();
+        centroid_counts.clear();
+    }
+}
+
+PatternClusterer::Config PatternClusterer::get_config() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return config;
+}
+
+void PatternClusterer::partial_fit(const double* samples, size_t sample_count, size_t dims) {
+    if (samples == nullptr || sample_count == 0 || dims == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    run_mini_batches(samples, sample_count, dims);
+}
+
+PatternClusterer::Result PatternClusterer::cluster(
+    const double* samples, size_t sample_count, size_t dims) {
+    Result result;
+    result.dimensions = dims;
+    if (samples == nullptr || sample_count == 0 || dims == 0) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (config.algorithm == Algorithm::DBSCAN) {
+        result = label_dbscan(samples, sample_count, dims);
+    } else {
+        run_mini_batches(samples, sample_count, dims);
+        result = label_kmeans(samples, sample_count, dims);
+    }
+    score_clusters(result, samples, sample_count);
+    return result;
+}
+
+void PatternClusterer::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    dimensions = 0;
+    centroids.clear();
+    centroid_counts.clear();
+    rng.seed(config.seed);
+}
+
+// k-means++ seeding: each new centroid is drawn with probability proportional
+// to its squared distance from the centroids chosen so far.
+void PatternClusterer::initialize_centroids(
+    const double* samples, size_t sample_count, size_t dims) {
+    size_t k = std::max<size_t>(1, std::min(config.cluster_count, sample_count));
+    dimensions = dims;
+    centroids.assign(k * dims, 0.0);
+    centroid_counts.assign(k, 0.0);
+
+    std::uniform_int_distribution<size_t> pick(0, sample_count - 1);
+    std::copy_n(samples + pick(rng) * dims, dims, centroids.begin());
+
+    std::vector<double> min_distance(sample_count, std::numeric_limits<double>::max());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t c = 1; c < k; ++c) {
+        const double* last = centroids.data() + (c - 1) * dims;
+        double total = 0.0;
+        for (size_t i = 0; i < sample_count; ++i) {
+            min_distance[i] = std::min(min_distance[i],
+                                       squared_distance(samples + i * dims, last, dims));
+            total += min_distance[i];
+        }
+
+        size_t chosen = 0;
+        if (total > 0.0) {
+            double target = unit(rng) * total;
+            for (chosen = 0; chosen + 1 < sample_count; ++chosen) {
+                target -= min_distance[chosen];
+                if (target <= 0.0) {
+                    break;
+                }
+            }
+        } else {
+            // Every sample coincides with a centroid; any choice is as good
+            chosen = pick(rng);
+        }
+        std::copy_n(samples + chosen * dims, dims, centroids.begin() + c * dims);
+    }
+}
+
+// Sculley-style mini-batch updates: each sample pulls its nearest centroid
+// towards itself with a per-centroid learning rate of 1 / count.
+void PatternClusterer::run_mini_batches(
+    const double* samples, size_t sample_count, size_t dims) {
+    if (centroids.empty() || dims != dimensions) {
+        initialize_centroids(samples, sample_count, dims);
+    }
+
+    size_t batch = std::max<size_t>(1, std::min(config.batch_size, sample_count));
+    batch_indices.resize(batch);
+    std::uniform_int_distribution<size_t> pick(0, sample_count - 1);
+
+    for (size_t iteration = 0; iteration < config.iterations; ++iteration) {
+        for (auto& index : batch_indices) {
+            index = pick(rng);
+        }
+        for (size_t index : batch_indices) {
+            const double* sample = samples + index * dims;
+            size_t c = nearest_centroid(sample, nullptr);
+            double& count = centroid_counts[c];
+            count = std::min(count + 1.0, kMaxCentroidCount);
+            double rate = 1.0 / count;
+            double* centroid = centroids.data() + c * dims;
+            for (size_t d = 0; d < dims; ++d) {
+                centroid[d] += rate * (sample[d] - centroid[d]);
+            }
+        }
+    }
+}
+
+size_t PatternClusterer::nearest_centroid(const double* sample, double* distance) const {
+    size_t best = 0;
+    double best_distance = std::numeric_limits<double>::max();
+    size_t k = centroid_counts.size();
+    for (size_t c = 0; c < k; ++c) {
+        double d = squared_distance(sample, centroids.data() + c * dimensions, dimensions);
+        if (d < best_distance) {
+            best_distance = d;
+            best = c;
+        }
+    }
+    if (distance != nullptr) {
+        *distance = best_distance;
+    }
+    return best;
+}
+
+PatternClusterer::Result PatternClusterer::label_kmeans(
+    const double* samples, size_t sample_count, size_t dims) const {
+    Result result;
+    result.dimensions = dims;
+    result.labels.resize(sample_count);
+
+    size_t k = centroid_counts.size();
+    std::vector<size_t> counts(k, 0);
+    for (size_t i = 0; i < sample_count; ++i) {
+        size_t c = nearest_centroid(samples + i * dims, nullptr);
+        result.labels[i] = static_cast<int>(c);
+        ++counts[c];
+    }
+
+    // Compact away centroids that attracted no samples
+    std::vector<int> remap(k, kNoise);
+    for (size_t c = 0; c < k; ++c) {
+        if (counts[c] == 0) {
+            continue;
+        }
+        remap[c] = static_cast<int>(result.sizes.size());
+        result.sizes.push_back(counts[c]);
+        result.centroids.insert(result.centroids.end(),
+                                centroids.begin() + c * dims,
+                                centroids.begin() + (c + 1) * dims);
+    }
+    for (auto& label : result.labels) {
+        label = remap[static_cast<size_t>(label)];
+    }
+    return result;
+}
+
+// Classic DBSCAN over the supplied window. Neighbourhood queries are a linear
+// scan, so callers should keep the window bounded (O(n^2) distance checks).
+PatternClusterer::Result PatternClusterer::label_dbscan(
+    const double* samples, size_t sample_count, size_t dims) const {
+    constexpr int kUnvisited = -2;
+
+    Result result;
+    result.dimensions = dims;
+    result.labels.assign(sample_count, kUnvisited);
+
+    double radius = config.epsilon * config.epsilon;
+    size_t min_points = std::max<size_t>(1, config.min_points);
+    std::vector<size_t> neighbours;
+    std::vector<size_t> frontier;
+    // Points ever pushed to a frontier. A queued point is labelled when it
+    // is popped, so it never needs queueing again, and the frontier stays
+    // O(n) however dense the cluster.
+    std::vector<char> queued(sample_count, 0);
+    auto enqueue = [&](const std::vector<size_t>& points) {
+        for (size_t j : points) {
+            if (!queued[j]) {
+                queued[j] = 1;
+                frontier.push_back(j);
+            }
+        }
+    };
+
+    auto region_query = [&](size_t index, std::vector<size_t>& out) {
+        out.clear();
+        const double* sample = samples + index * dims;
+        for (size_t j = 0; j < sample_count; ++j) {
+            if (squared_distance(sample, samples + j * dims, dims) <= radius) {
+                out.push_back(j);
+            }
+        }
+    };
+
+    int cluster_id = 0;
+    for (size_t i = 0; i < sample_count; ++i) {
+        if (result.labels[i] != kUnvisited) {
+            continue;
+        }
+        region_query(i, neighbours);
+        if (neighbours.size() < min_points) {
+            result.labels[i] = kNoise;
+            continue;
+        }
+
+        result.labels[i] = cluster_id;
+        queued[i] = 1;
+        frontier.clear();
+        enqueue(neighbours);
+        for (size_t f = 0; f < frontier.size(); ++f) {
+            size_t j = frontier[f];
+            if (result.labels[j] == kNoise) {
+                result.labels[j] = cluster_id;  // border point
+            }
+            if (result.labels[j] != kUnvisited) {
+                continue;
+            }
+            result.labels[j] = cluster_id;
+            region_query(j, neighbours);
+            if (neighbours.size() >= min_points) {
+                enqueue(neighbours);
+            }
+        }
+        ++cluster_id;
+    }
+
+    size_t clusters = static_cast<size_t>(cluster_id);
+    result.sizes.assign(clusters, 0);
+    result.centroids.assign(clusters * dims, 0.0);
+    for (size_t i = 0; i < sample_count; ++i) {
+        int label = result.labels[i];
+        if (label == kNoise) {
+            ++result.noise_count;
+            continue;
+        }
+        auto c = static_cast<size_t>(label);
+        ++result.sizes[c];
+        double* centroid = result.centroids.data() + c * dims;
+        const double* sample = samples + i * dims;
+        for (size_t d = 0; d < dims; ++d) {
+            centroid[d] += sample[d];
+        }
+    }
+    for (size_t c = 0; c < clusters; ++c) {
+        double* centroid = result.centroids.data() + c * dims;
+        for (size_t d = 0; d < dims; ++d) {
+            centroid[d] /= static_cast<double>(result.sizes[c]);
+        }
+    }
+    return result;
+}
+
+// Simplified (centroid-based) silhouette per cluster: for each member, a is the
+// distance to its own centroid and b the distance to the nearest other
+// centroid. A lone cluster is scored by its compactness instead.
+void PatternClusterer::score_clusters(
+    Result& result, const double* samples, size_t sample_count) const {
+    size_t k = result.cluster_count();
+    size_t dims = result.dimensions;
+    result.quality.assign(k, 0.0);
+    if (k == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < sample_count; ++i) {
+        int label = result.labels[i];
+        if (label == kNoise) {
+            continue;
+        }
+        auto own = static_cast<size_t>(label);
+        const double* sample = samples + i * dims;
+        double a = std::sqrt(squared_distance(sample, result.centroids.data() + own * dims, dims));
+
+        if (k == 1) {
+            result.quality[own] += 1.0 / (1.0 + a);
+            continue;
+        }
+
+        double b = std::numeric_limits<double>::max();
+        for (size_t c = 0; c < k; ++c) {
+            if (c != own) {
+                b = std::min(b, squared_distance(sample, result.centroids.data() + c * dims, dims));
+            }
+        }
+        b = std::sqrt(b);
+        double scale = std::max(a, b);
+        double silhouette = scale > 0.0 ? (b - a) / scale : 1.0;
+        result.quality[own] += std::max(0.0, silhouette);
+    }
+
+    for (size_t c = 0; c < k; ++c) {
+        result.quality[c] = std::clamp(
+            result.quality[c] / static_cast<double>(result.sizes[c]), 0.0, 1.0);
+    }
+}
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,307 @@
+#include <chronovyan/pattern_index.hpp>
+#include <chronovyan/pattern_clusterer.hpp>
+#include <chronovyan/vector_math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace chronovyan {
+namespace sync {
+
+namespace {
+// Training rows drawn per IVF list; enough for stable coarse centroids
+// without clustering the whole library.
+constexpr size_t kTrainingRowsPerList = 32;
+} // namespace
+
+PatternIndex::PatternIndex(size_t dimensions) : PatternIndex(dimensions, Config()) {}
+
+PatternIndex::PatternIndex(size_t dimensions, const Config& config)
+    : dims(std::max<size_t>(1, dimensions)), config(config) {
+    if (this->config.capacity == 0 ||
+        this->config.capacity > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("PatternIndex capacity must be in [1, 2^32)");
+    }
+}
+
+size_t PatternIndex::add(const std::vector<double>& signature, const std::string& label) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto slot = static_cast<uint32_t>(next_slot);
+    bool overwrite = slot < count;
+
+    if (overwrite && !lists.empty()) {
+        remove_from_list(slot);
+    }
+    store_row(slot, signature);
+    row_labels[slot] = intern_label(label);
+    if (!lists.empty()) {
+        insert_into_list(slot);
+    }
+    if (training) {
+        pending_slots.push_back(slot);
+    }
+
+    next_slot = (next_slot + 1) % config.capacity;
+    count = std::min(count + 1, config.capacity);
+
+    if (config.auto_rebuild && !training && count >= config.ivf_threshold && count >= 2 * trained_size) {
+        train_ivf(lock);
+    }
+    return slot;
+}
+
+void PatternIndex::store_row(size_t slot, const std::vector<double>& signature) {
+    if (slot >= count) {
+        rows.resize((slot + 1) * dims);
+        row_labels.resize(slot + 1);
+    }
+    float* row = rows.data() + slot * dims;
+    size_t n = std::min(signature.size(), dims);
+    for (size_t d = 0; d < n; ++d) {
+        row[d] = static_cast<float>(signature[d]);
+    }
+    std::fill(row + n, row + dims, 0.0f);
+}
+
+uint32_t PatternIndex::intern_label(const std::string& label) {
+    auto it = label_ids.find(label);
+    if (it != label_ids.end()) {
+        return it->second;
+    }
+    auto id = static_cast<uint32_t>(label_names.size());
+    label_names.push_back(label);
+    label_ids.emplace(label, id);
+    return id;
+}
+
+void PatternIndex::offer(std::vector<Candidate>& best, size_t k, float distance, uint32_t slot) {
+    if (best.size() == k) {
+        if (distance >= best.back().first) {
+            return;
+        }
+        best.pop_back();
+    }
+    Candidate candidate{distance, slot};
+    best.insert(std::upper_bound(best.begin(), best.end(), candidate), candidate);
+}
+
+std::vector<PatternIndex::Neighbor> PatternIndex::search(
+    const std::vector<double>& query, size_t k) const {
+    std::vector<float> q(dims, 0.0f);
+    for (size_t d = 0; d < std::min(query.size(), dims); ++d) {
+        q[d] = static_cast<float>(query[d]);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    k = std::min(k, count);
+    std::vector<Candidate> best;
+    if (k == 0) {
+        return {};
+    }
+    best.reserve(k + 1);
+
+    if (lists.empty()) {
+        // Linear scan over the contiguous matrix
+        const float* row = rows.data();
+        for (size_t slot = 0; slot < count; ++slot, row += dims) {
+            offer(best, k, squared_distance(q.data(), row, dims), static_cast<uint32_t>(slot));
+        }
+    } else {
+        // Rank the coarse centroids, then scan only the closest lists
+        std::vector<Candidate> probes;
+        size_t probe_count = std::min(std::max<size_t>(1, config.ivf_probes), lists.size());
+        probes.reserve(probe_count + 1);
+        for (size_t l = 0; l < lists.size(); ++l) {
+            offer(probes, probe_count,
+                  squared_distance(q.data(), list_centroids.data() + l * dims, dims),
+                  static_cast<uint32_t>(l));
+        }
+        for (const auto& probe : probes) {
+            const InvertedList& list = lists[probe.second];
+            const float* row = list.rows.data();
+            for (size_t i = 0; i < list.slots.size(); ++i, row += dims) {
+                offer(best, k, squared_distance(q.data(), row, dims), list.slots[i]);
+            }
+        }
+    }
+
+    std::vector<Neighbor> neighbors;
+    neighbors.reserve(best.size());
+    for (const auto& candidate : best) {
+        Neighbor neighbor;
+        neighbor.id = candidate.second;
+        neighbor.label = label_names[row_labels[candidate.second]];
+        neighbor.distance = std::sqrt(static_cast<double>(candidate.first));
+        neighbor.similarity = 1.0 / (1.0 + neighbor.distance);
+        neighbors.push_back(std::move(neighbor));
+    }
+    return neighbors;
+}
+
+void PatternIndex::rebuild() {
+    std::unique_lock<std::mutex> lock(mutex);
+    training_done.wait(lock, [this] { return !training; });
+    train_ivf(lock);
+}
+
+// Coarse quantizer: mini-batch k-means over a random sample of the library,
+// then every stored row is filed under its nearest centroid. Both run on a
+// copy of the rows with the lock released.
+void PatternIndex::train_ivf(std::unique_lock<std::mutex>& lock) {
+    if (count == 0) {
+        return;
+    }
+    training = true;
+    pending_slots.clear();
+    const uint64_t generation = clear_generation;
+    const size_t snapshot_count = count;
+    const std::vector<float> snapshot(rows.begin(), rows.begin() + snapshot_count * dims);
+    const size_t configured_lists = config.ivf_lists;
+    lock.unlock();
+
+    std::vector<float> centroids;
+    std::vector<InvertedList> new_lists;
+    std::vector<uint32_t> new_slot_list(snapshot_count, 0);
+    std::vector<uint32_t> new_slot_position(snapshot_count, 0);
+    try {
+        size_t list_count = configured_lists > 0
+            ? configured_lists
+            : static_cast<size_t>(std::sqrt(static_cast<double>(snapshot_count)));
+        list_count = std::clamp<size_t>(list_count, 1, snapshot_count);
+
+        size_t training_rows = std::min(snapshot_count, list_count * kTrainingRowsPerList);
+        std::vector<double> training_set(training_rows * dims);
+        std::mt19937 rng(static_cast<unsigned int>(snapshot_count));
+        std::uniform_int_distribution<size_t> pick(0, snapshot_count - 1);
+        for (size_t r = 0; r < training_rows; ++r) {
+            size_t slot = training_rows == snapshot_count ? r : pick(rng);
+            std::copy_n(snapshot.begin() + slot * dims, dims, training_set.begin() + r * dims);
+        }
+
+        PatternClusterer::Config clustering;
+        clustering.cluster_count = list_count;
+        clustering.batch_size = 1024;
+        clustering.iterations = 16;
+        PatternClusterer clusterer(clustering);
+        auto result = clusterer.cluster(training_set.data(), training_rows, dims);
+
+        centroids.assign(result.centroids.begin(), result.centroids.end());
+        new_lists.assign(result.cluster_count(), InvertedList());
+        for (size_t slot = 0; slot < snapshot_count; ++slot) {
+            const float* row = snapshot.data() + slot * dims;
+            size_t l = nearest_centroid(row, centroids, dims);
+            InvertedList& list = new_lists[l];
+            new_slot_list[slot] = static_cast<uint32_t>(l);
+            new_slot_position[slot] = static_cast<uint32_t>(list.slots.size());
+            list.slots.push_back(static_cast<uint32_t>(slot));
+            list.rows.insert(list.rows.end(), row, row + dims);
+        }
+    } catch (...) {
+        lock.lock();
+        training = false;
+        pending_slots.clear();
+        training_done.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    if (generation == clear_generation) {
+        list_centroids.swap(centroids);
+        lists.swap(new_lists);
+        slot_list.swap(new_slot_list);
+        slot_position.swap(new_slot_position);
+        trained_size = snapshot_count;
+
+        // Slots stored during training: overwritten ones are filed under
+        // their snapshot row, new ones are not filed yet
+        std::sort(pending_slots.begin(), pending_slots.end());
+        pending_slots.erase(std::unique(pending_slots.begin(), pending_slots.end()), pending_slots.end());
+        for (uint32_t slot : pending_slots) {
+            if (slot < snapshot_count) {
+                remove_from_list(slot);
+            }
+            insert_into_list(slot);
+        }
+    }
+    training = false;
+    pending_slots.clear();
+    training_done.notify_all();
+}
+
+size_t PatternIndex::nearest_list(const float* row) const {
+    return nearest_centroid(row, list_centroids, dims);
+}
+
+size_t PatternIndex::nearest_centroid(const float* row, const std::vector<float>& centroids, size_t dims) {
+    size_t best = 0;
+    float best_distance = std::numeric_limits<float>::max();
+    for (size_t l = 0; l * dims < centroids.size(); ++l) {
+        float d = squared_distance(row, centroids.data() + l * dims, dims);
+        if (d < best_distance) {
+            best_distance = d;
+            best = l;
+        }
+    }
+    return best;
+}
+
+void PatternIndex::insert_into_list(uint32_t slot) {
+    const float* row = rows.data() + static_cast<size_t>(slot) * dims;
+    size_t l = nearest_list(row);
+    InvertedList& list = lists[l];
+    if (slot >= slot_list.size()) {
+        slot_list.resize(slot + 1);
+        slot_position.resize(slot + 1);
+    }
+    slot_list[slot] = static_cast<uint32_t>(l);
+    slot_position[slot] = static_cast<uint32_t>(list.slots.size());
+    list.slots.push_back(slot);
+    list.rows.insert(list.rows.end(), row, row + dims);
+}
+
+// Swap-remove so lists stay contiguous; the moved member's position is patched
+void PatternIndex::remove_from_list(uint32_t slot) {
+    InvertedList& list = lists[slot_list[slot]];
+    size_t position = slot_position[slot];
+    size_t last = list.slots.size() - 1;
+    if (position != last) {
+        uint32_t moved = list.slots[last];
+        list.slots[position] = moved;
+        std::copy_n(list.rows.begin() + last * dims, dims, list.rows.begin() + position * dims);
+        slot_position[moved] = static_cast<uint32_t>(position);
+    }
+    list.slots.pop_back();
+    list.rows.resize(last * dims);
+}
+
+void PatternIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    rows.clear();
+    row_labels.clear();
+    label_names.clear();
+    label_ids.clear();
+    count = 0;
+    next_slot = 0;
+    list_centroids.clear();
+    lists.clear();
+    slot_list.clear();
+    slot_position.clear();
+    trained_size = 0;
+    pending_slots.clear();
+    ++clear_generation;
+}
+
+size_t PatternIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return count;
+}
+
+bool PatternIndex::is_indexed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !lists.empty();
+}
+
+} // namespace sync
+} // namespace chronovyan
@@ -0,0 +1,453 @@
+#include "chronovyan/procfs_metric_sources.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace chronovyan {
+
+namespace {
+
+// Allocation-free parsing over a NUL-terminated buffer
+
+void skip_spaces(const char*& p) {
+    while (*p == ' ' || *p == '\t') {
+        ++p;
+    }
+}
+
+bool parse_u64(const char*& p, uint64_t& value) {
+    skip_spaces(p);
+    if (*p < '0' || *p > '9') {
+        return false;
+    }
+    value = 0;
+    while (*p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return true;
+}
+
+const char* next_line(const char* p) {
+    const char* end = std::strchr(p, '\n');
+    return end ? end + 1 : nullptr;
+}
+
+// Start of the first line beginning with prefix, or nullptr
+const char* find_line(const char* text, const char* prefix, size_t prefix_length) {
+    for (const char* line = text; line && *line; line = next_line(line)) {
+        if (std::strncmp(line, prefix, prefix_length) == 0) {
+            return line;
+        }
+    }
+    return nullptr;
+}
+
+// Value of a "Key:   1234 kB" line in /proc/meminfo, in bytes
+bool meminfo_bytes(const char* text, const char* key, uint64_t& bytes) {
+    const char* line = find_line(text, key, std::strlen(key));
+    if (!line) {
+        return false;
+    }
+    const char* p = line + std::strlen(key);
+    uint64_t kib = 0;
+    if (!parse_u64(p, kib)) {
+        return false;
+    }
+    bytes = kib * 1024;
+    return true;
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    if (whole == 0) {
+        return 0.0;
+    }
+    return std::min(100.0, 100.0 * static_cast<double>(part) / static_cast<double>(whole));
+}
+
+} // namespace
+
+// ProcFile
+
+ProcFile::ProcFile(const std::string& path, size_t buffer_size)
+    : fd_(::open(path.c_str(), O_RDONLY | O_CLOEXEC)), buffer_(std::max<size_t>(buffer_size, 2), '\0') {}
+
+ProcFile::~ProcFile() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+ProcFile::ProcFile(ProcFile&& other) noexcept : fd_(other.fd_), buffer_(std::move(other.buffer_)) {
+    other.fd_ = -1;
+}
+
+ProcFile& ProcFile::operator=(ProcFile&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = other.fd_;
+        buffer_ = std::move(other.buffer_);
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+long ProcFile::read() {
+    if (fd_ < 0) {
+        return -1;
+    }
+    // procfs may hand a large file over in several chunks
+    const size_t capacity = buffer_.size() - 1;
+    size_t length = 0;
+    while (length < capacity) {
+        ssize_t n = ::pread(fd_, buffer_.data() + length, capacity - length, static_cast<off_t>(length));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            buffer_[0] = '\0';
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        length += static_cast<size_t>(n);
+    }
+    if (length == capacity) {
+        // Possibly truncated: keep whole lines only
+        while (length > 0 && buffer_[length - 1] != '\n') {
+            --length;
+        }
+    }
+    buffer_[length] = '\0';
+    return static_cast<long>(length);
+}
+
+// CpuUsageSource
+
+CpuUsageSource::CpuUsageSource(const std::string& stat_path)
+    : stat_(stat_path, kStatBufferSize), available_(stat_.is_open()) {}
+
+bool CpuUsageSource::sample() const {
+    if (stat_.read() <= 0) {
+        return false;
+    }
+
+    // cpu  user nice system idle iowait irq softirq steal ...
+    auto parse = [](const char* p, Jiffies& jiffies) {
+        uint64_t fields[8] = {};
+        size_t count = 0;
+        while (count < 8 && parse_u64(p, fields[count])) {
+            ++count;
+        }
+        if (count < 4) {
+            return false;
+        }
+        jiffies.total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            jiffies.total += fields[i];
+        }
+        jiffies.busy = jiffies.total - fields[3] - (count > 4 ? fields[4] : 0);
+        return true;
+    };
+    // Jiffies that advanced by nothing (two samples inside one tick) keep
+    // the previous figure rather than reporting 0%
+    auto usage = [](const Jiffies& now, const Jiffies& before, double previous) {
+        if (now.total <= before.total) {
+            return previous;
+        }
+        uint64_t busy = now.busy >= before.busy ? now.busy - before.busy : 0;
+        return percent(busy, now.total - before.total);
+    };
+
+    // A line without its newline may have been cut short, so it is rejected
+    const char* line = find_line(stat_.data(), "cpu ", 4);
+    Jiffies total;
+    if (!line || !next_line(line) || !parse(line + 3, total)) {
+        return false;
+    }
+    total_usage_ = usage(total, previous_total_, total_usage_);
+    previous_total_ = total;
+
+    // Per-core lines follow the aggregate line in order
+    size_t cores = 0;
+    for (line = next_line(line); line && cores < kMaxCores; line = next_line(line)) {
+        if (std::strncmp(line, "cpu", 3) != 0 || line[3] < '0' || line[3] > '9' || !next_line(line)) {
+            break;
+        }
+        const char* p = line + 3;
+        uint64_t index = 0;
+        Jiffies core;
+        if (!parse_u64(p, index) || index >= kMaxCores || !parse(p, core)) {
+            continue;
+        }
+        core_usage_[index] = usage(core, previous_cores_[index], core_usage_[index]);
+        previous_cores_[index] = core;
+        cores = std::max<size_t>(cores, index + 1);
+    }
+    core_count_ = cores;
+    return true;
+}
+
+double CpuUsageSource::getValue() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    available_ = sample();
+    if (!available_) {
+        return 0.0;
+    }
+    last_update_ = std::chrono::system_clock::now();
+    return total_usage_;
+}
+
+bool CpuUsageSource::isAvailable() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return available_;
+}
+
+std::chrono::system_clock::time_point CpuUsageSource::getLastUpdateTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_update_;
+}
+
+size_t CpuUsageSource::core_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return core_count_;
+}
+
+double CpuUsageSource::core_usage(size_t core) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return core < core_count_ ? core_usage_[core] : 0.0;
+}
+
+// MemoryUsageSource
+
+MemoryUsageSource::MemoryUsageSource() : MemoryUsageSource(Paths()) {}
+
+MemoryUsageSource::MemoryUsageSource(const Paths& paths) : meminfo_(paths.meminfo) {
+    std::string cgroup_dir = paths.cgroup_dir;
+    if (cgroup_dir.empty()) {
+        // The unified (v2) hierarchy is the "0::<path>" entry
+        ProcFile self("/proc/self/cgroup");
+        if (self.read() > 0) {
+            if (const char* line = find_line(self.data(), "0::", 3)) {
+                const char* end = std::strchr(line, '\n');
+                std::string path(line + 3, end ? end : line + std::strlen(line));
+                cgroup_dir = "/sys/fs/cgroup" + (path == "/" ? std::string() : path);
+            }
+        }
+    }
+    if (!cgroup_dir.empty()) {
+        cgroup_current_ = ProcFile(cgroup_dir + "/memory.current");
+        cgroup_max_ = ProcFile(cgroup_dir + "/memory.max");
+        if (!cgroup_current_.is_open() || !cgroup_max_.is_open()) {
+            cgroup_current_ = ProcFile();
+            cgroup_max_ = ProcFile();
+        }
+    }
+    available_ = meminfo_.is_open() || cgroup_current_.is_open();
+}
+
+bool MemoryUsageSource::sample_cgroup() const {
+    if (!cgroup_current_.is_open() || cgroup_max_.read() <= 0) {
+        return false;
+    }
+    const char* p = cgroup_max_.data();
+    uint64_t limit = 0;
+    uint64_t current = 0;
+    if (!parse_u64(p, limit)) {
+        return false;  // "max": unlimited, fall back to the host view
+    }
+    if (cgroup_current_.read() <= 0) {
+        return false;
+    }
+    p = cgroup_current_.data();
+    if (!parse_u64(p, current)) {
+        return false;
+    }
+    used_bytes_ = current;
+    limit_bytes_ = limit;
+    return true;
+}
+
+bool MemoryUsageSource::sample_meminfo() const {
+    if (meminfo_.read() <= 0) {
+        return false;
+    }
+    uint64_t total = 0;
+    uint64_t available = 0;
+    if (!meminfo_bytes(meminfo_.data(), "MemTotal:", total) ||
+        !meminfo_bytes(meminfo_.data(), "MemAvailable:", available)) {
+        return false;
+    }
+    used_bytes_ = total >= available ? total - available : 0;
+    limit_bytes_ = total;
+    return true;
+}
+
+bool MemoryUsageSource::sample() const {
+    cgroup_limited_ = sample_cgroup();
+    return cgroup_limited_ || sample_meminfo();
+}
+
+double MemoryUsageSource::getValue() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    available_ = sample();
+    if (!available_) {
+        return 0.0;
+    }
+    last_update_ = std::chrono::system_clock::now();
+    return percent(used_bytes_, limit_bytes_);
+}
+
+bool MemoryUsageSource::isAvailable() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return available_;
+}
+
+std::chrono::system_clock::time_point MemoryUsageSource::getLastUpdateTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_update_;
+}
+
+bool MemoryUsageSource::is_cgroup_limited() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cgroup_limited_;
+}
+
+uint64_t MemoryUsageSource::used_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_bytes_;
+}
+
+uint64_t MemoryUsageSource::limit_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return limit_bytes_;
+}
+
+// ProcessUsageSource
+
+ProcessUsageSource::ProcessUsageSource(Metric metric, int pid)
+    : metric_(metric),
+      ticks_per_second_(std::max(1L, ::sysconf(_SC_CLK_TCK))),
+      page_size_(std::max(1L, ::sysconf(_SC_PAGESIZE))),
+      cpu_count_(std::max(1L, ::sysconf(_SC_NPROCESSORS_ONLN))),
+      physical_bytes_(static_cast<uint64_t>(std::max(0L, ::sysconf(_SC_PHYS_PAGES))) *
+                      static_cast<uint64_t>(page_size_)) {
+    std::string dir = pid > 0 ? "/proc/" + std::to_string(pid) : std::string("/proc/self");
+    if (metric_ == Metric::Cpu) {
+        stat_ = ProcFile(dir + "/stat");
+    } else {
+        statm_ = ProcFile(dir + "/statm");
+    }
+    available_ = stat_.is_open() || statm_.is_open();
+}
+
+bool ProcessUsageSource::sample() const {
+    if (metric_ == Metric::Rss) {
+        // statm: size resident shared ... (pages)
+        if (statm_.read() <= 0) {
+            return false;
+        }
+        const char* p = statm_.data();
+        uint64_t size = 0;
+        uint64_t resident = 0;
+        if (!parse_u64(p, size) || !parse_u64(p, resident)) {
+            return false;
+        }
+        resident_bytes_ = resident * static_cast<uint64_t>(page_size_);
+        value_ = percent(resident_bytes_, physical_bytes_);
+        return true;
+    }
+
+    if (stat_.read() <= 0) {
+        return false;
+    }
+    // The command name may contain spaces and parentheses; fields resume
+    // after the last ')'. utime and stime follow the 11 fields after it
+    // (fields 14 and 15 overall).
+    const char* p = std::strrchr(stat_.data(), ')');
+    if (!p) {
+        return false;
+    }
+    ++p;
+    for (int field = 0; field < 11; ++field) {
+        skip_spaces(p);
+        while (*p && *p != ' ') {
+            ++p;
+        }
+    }
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    if (!parse_u64(p, utime) || !parse_u64(p, stime)) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    uint64_t ticks = utime + stime;
+    if (!has_previous_) {
+        previous_ticks_ = ticks;
+        last_sample_ = now;
+        has_previous_ = true;
+        return true;
+    }
+    // Tick counters are too coarse for sub-tick windows: keep the last
+    // figure and let the window grow until at least one tick has elapsed
+    double elapsed = std::chrono::duration<double>(now - last_sample_).count();
+    if (elapsed * static_cast<double>(ticks_per_second_) < 1.0) {
+        return true;
+    }
+    double cpu_seconds = static_cast<double>(ticks - std::min(ticks, previous_ticks_)) /
+                         static_cast<double>(ticks_per_second_);
+    value_ = std::min(100.0, 100.0 * cpu_seconds / (elapsed * static_cast<double>(cpu_count_)));
+    previous_ticks_ = ticks;
+    last_sample_ = now;
+    return true;
+}
+
+double ProcessUsageSource::getValue() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    available_ = sample();
+    if (!available_) {
+        return 0.0;
+    }
+    last_update_ = std::chrono::system_clock::now();
+    return value_;
+}
+
+bool ProcessUsageSource::isAvailable() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return available_;
+}
+
+std::chrono::system_clock::time_point ProcessUsageSource::getLastUpdateTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_update_;
+}
+
+uint64_t ProcessUsageSource::resident_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resident_bytes_;
+}
+
+std::unique_ptr<IMetricSource> create_metric_source(const std::string& source_type) {
+    if (source_type == "cpu") {
+        return std::make_unique<CpuUsageSource>();
+    }
+    if (source_type == "memory") {
+        return std::make_unique<MemoryUsageSource>();
+    }
+    if (source_type == "process_cpu") {
+        return std::make_unique<ProcessUsageSource>(ProcessUsageSource::Metric::Cpu);
+    }
+    if (source_type == "process_rss") {
+        return std::make_unique<ProcessUsageSource>(ProcessUsageSource::Metric::Rss);
+    }
+    throw std::invalid_argument("Unknown metric source type: " + source_type);
+}
+
+} // namespace chronovyan
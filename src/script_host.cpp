@@ -0,0 +1,149 @@
+#include "script_host.h"
+#include "error_handler.h"
+#include "lexer.h"
+#include "parser.h"
+#include <utility>
+
+namespace chronovyan {
+
+CompiledScript::CompiledScript(std::string name, std::unique_ptr<ProgramNode> program,
+                               std::shared_ptr<SourceFile> source)
+    : m_name(std::move(name)), m_program(std::move(program)), m_source(std::move(source)) {}
+
+ScriptHost::ScriptHost(size_t cacheCapacity) : m_cacheCapacity(cacheCapacity > 0 ? cacheCapacity : 1) {}
+
+std::shared_ptr<const CompiledScript> ScriptHost::compile(const std::string& source, const std::string& name) {
+    std::string key = name;
+    key.push_back('\0');
+    key += source;
+
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto it = m_cacheIndex.find(key);
+        if (it != m_cacheIndex.end()) {
+            m_cache.splice(m_cache.begin(), m_cache, it->second);
+            ++m_cacheHits;
+            return it->second->script;
+        }
+    }
+
+    // Two threads missing on the same source may both parse it; the
+    // second insert below is then a no-op
+    std::shared_ptr<const CompiledScript> script;
+    {
+        std::lock_guard<std::mutex> lock(m_compileMutex);
+        auto sourceFile = std::make_shared<SourceFile>(std::string(source), name);
+        auto parser = std::make_shared<Parser>(std::make_shared<Lexer>(sourceFile));
+        // Only the errors this parse reports are ours; whatever the
+        // embedding process reported before stays as it was
+        auto& errorHandler = ErrorHandler::getInstance();
+        const size_t firstError = errorHandler.getErrors().size();
+        auto program = parser->parse();
+
+        const auto& errors = errorHandler.getErrors();
+        SourceLocation location;
+        std::string message;
+        for (size_t i = firstError; i < errors.size(); ++i) {
+            if (errors[i].severity == ErrorSeverity::WARNING) {
+                continue;
+            }
+            if (message.empty()) {
+                location = errors[i].location;
+            }
+            message += (message.empty() ? "" : "\n") + errors[i].toString();
+        }
+        if (!message.empty() || !program) {
+            errorHandler.clearErrorsAfter(firstError);
+            throw ChronovyanParseError(message.empty() ? "Parser error" : message, location);
+        }
+        script = std::make_shared<const CompiledScript>(name, std::move(program), std::move(sourceFile));
+    }
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    ++m_cacheMisses;
+    if (m_cacheIndex.count(key) == 0) {
+        m_cache.push_front(CacheEntry{key, script});
+        m_cacheIndex.emplace(std::move(key), m_cache.begin());
+        if (m_cache.size() > m_cacheCapacity) {
+            m_cacheIndex.erase(m_cache.back().key);
+            m_cache.pop_back();
+        }
+    }
+    return script;
+}
+
+Value ScriptHost::run(const CompiledScript& script) {
+    // Returns the interpreter to the pool however the run ends
+    struct Lease {
+        ScriptHost& host;
+        std::unique_ptr<Interpreter> interpreter;
+        ~Lease() { host.release(std::move(interpreter)); }
+    } lease{*this, acquire()};
+
+    return lease.interpreter->run(script.getProgram());
+}
+
+Value ScriptHost::run(const std::string& source, const std::string& name) {
+    return run(*compile(source, name));
+}
+
+void ScriptHost::setExecutionProfile(const ExecutionProfile& profile) {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_profile = profile;
+}
+
+void ScriptHost::setLoopProfiler(std::shared_ptr<LoopProfiler> profiler) {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_loopProfiler = std::move(profiler);
+}
+
+uint64_t ScriptHost::getCacheHits() const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cacheHits;
+}
+
+uint64_t ScriptHost::getCacheMisses() const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cacheMisses;
+}
+
+size_t ScriptHost::getCachedScriptCount() const {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cache.size();
+}
+
+size_t ScriptHost::getInterpreterCount() const {
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    return m_interpreterCount;
+}
+
+std::unique_ptr<Interpreter> ScriptHost::acquire() {
+    std::unique_ptr<Interpreter> interpreter;
+    ExecutionProfile profile;
+    std::shared_ptr<LoopProfiler> loopProfiler;
+    {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        if (!m_idle.empty()) {
+            interpreter = std::move(m_idle.back());
+            m_idle.pop_back();
+        } else {
+            ++m_interpreterCount;
+        }
+        profile = m_profile;
+        loopProfiler = m_loopProfiler;
+    }
+    if (!interpreter) {
+        interpreter = std::make_unique<Interpreter>();
+    }
+    interpreter->setExecutionProfile(profile);
+    interpreter->setLoopProfiler(std::move(loopProfiler));
+    return interpreter;
+}
+
+void ScriptHost::release(std::unique_ptr<Interpreter> interpreter) {
+    interpreter->reset();
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    m_idle.push_back(std::move(interpreter));
+}
+
+} // namespace chronovyan
@@ -0,0 +1,210 @@
+#include "chronovyan/stability_analyzer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace chronovyan {
+namespace stability {
+
+namespace {
+
+const char* type_name(size_t type) {
+    switch (static_cast<StabilityMetricType>(type)) {
+        case StabilityMetricType::Temporal: return "temporal";
+        case StabilityMetricType::Resource: return "resource";
+        case StabilityMetricType::Performance: return "performance";
+        case StabilityMetricType::Error: return "error";
+        case StabilityMetricType::Custom: return "custom";
+    }
+    return "unknown";
+}
+
+const char* band_name(int band) {
+    static const char* const kNames[] = {"below critical", "critical", "warning", "good", "excellent"};
+    return kNames[band];
+}
+
+size_t type_slot(StabilityMetricType type) {
+    size_t slot = static_cast<size_t>(type);
+    return slot < StabilityAnalyzer::kMetricTypes ? slot : static_cast<size_t>(StabilityMetricType::Custom);
+}
+
+} // namespace
+
+StabilityAnalyzer::StabilityAnalyzer(size_t window, size_t queue_capacity)
+    : queue_(queue_capacity),
+      window_(std::max<size_t>(window, 1)),
+      windows_(kMetricTypes, Window(window_)) {
+    bands_.fill(band(1.0, thresholds_));
+}
+
+int StabilityAnalyzer::band(double score, const StabilityThresholds& thresholds) {
+    if (score >= thresholds.excellent_threshold) {
+        return 4;
+    }
+    if (score >= thresholds.good_threshold) {
+        return 3;
+    }
+    if (score >= thresholds.warning_threshold) {
+        return 2;
+    }
+    if (score >= thresholds.critical_threshold) {
+        return 1;
+    }
+    return 0;
+}
+
+void StabilityAnalyzer::add_event(const StabilityEvent& event) {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        // Assigning reuses the cell's description buffer from earlier laps
+        if (queue_.try_push(event)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(consumer_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            break;
+        }
+        drain_locked();
+        deliver(lock);
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t StabilityAnalyzer::drain_locked() const {
+    size_t applied = 0;
+    while (queue_.try_consume([this](const StabilityEvent& event) {
+        const size_t type = type_slot(event.type);
+        windows_[type].push({event.value, event.value * event.value});
+        evaluate_locked(type, event.timestamp);
+    })) {
+        ++applied;
+    }
+    return applied;
+}
+
+double StabilityAnalyzer::score_locked(size_t type) const {
+    const Window& window = windows_[type];
+    if (window.empty()) {
+        return 1.0;
+    }
+    const double mean = window.mean(0);
+    const double variance = std::max(0.0, window.mean(1) - mean * mean);
+    const double deviation = std::sqrt(variance);
+    // Below this the deviation is rounding noise of the running sums
+    const double noise = 1e-12 * std::max(1.0, mean * mean);
+    if (variance <= noise) {
+        return 1.0;
+    }
+    if (mean == 0.0) {
+        return 0.0;
+    }
+    return 1.0 / (1.0 + deviation / std::fabs(mean));
+}
+
+void StabilityAnalyzer::evaluate_locked(size_t type, std::chrono::system_clock::time_point timestamp) const {
+    const double score = score_locked(type);
+    const int current = band(score, thresholds_);
+    if (current == bands_[type]) {
+        return;
+    }
+    char description[96];
+    std::snprintf(description, sizeof(description), "%s stability %s %s (%.3f)", type_name(type),
+                  current < bands_[type] ? "fell to" : "rose to", band_name(current), score);
+    crossings_.emplace_back(timestamp, static_cast<StabilityMetricType>(type), score, description);
+    bands_[type] = current;
+}
+
+// Whoever finds no delivery in progress delivers every pending crossing,
+// including those queued by other threads meanwhile, so callbacks see the
+// crossings in the order they were applied
+void StabilityAnalyzer::deliver(std::unique_lock<std::mutex>& lock) const {
+    if (delivering_ || crossings_.empty()) {
+        lock.unlock();
+        return;
+    }
+    delivering_ = true;
+    std::vector<StabilityEvent> batch;
+    while (!crossings_.empty()) {
+        batch.swap(crossings_);
+        lock.unlock();
+        try {
+            std::lock_guard<std::mutex> callbacks_lock(callbacks_mutex_);
+            for (const auto& crossing : batch) {
+                for (const auto& callback : callbacks_) {
+                    callback(crossing);
+                }
+            }
+        } catch (...) {
+            lock.lock();
+            delivering_ = false;
+            lock.unlock();
+            throw;
+        }
+        batch.clear();
+        lock.lock();
+    }
+    delivering_ = false;
+    lock.unlock();
+}
+
+size_t StabilityAnalyzer::process() {
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    size_t applied = drain_locked();
+    deliver(lock);
+    return applied;
+}
+
+StabilityMetrics StabilityAnalyzer::analyze_stability() const {
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    drain_locked();
+    StabilityMetrics metrics;
+    metrics.temporal_stability = score_locked(static_cast<size_t>(StabilityMetricType::Temporal));
+    metrics.resource_stability = score_locked(static_cast<size_t>(StabilityMetricType::Resource));
+    metrics.performance_stability = score_locked(static_cast<size_t>(StabilityMetricType::Performance));
+    metrics.error_stability = score_locked(static_cast<size_t>(StabilityMetricType::Error));
+    deliver(lock);
+    metrics.overall_stability = (metrics.temporal_stability + metrics.resource_stability +
+                                 metrics.performance_stability + metrics.error_stability) / 4.0;
+    return metrics;
+}
+
+double StabilityAnalyzer::stability(StabilityMetricType type) const {
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    drain_locked();
+    double score = score_locked(type_slot(type));
+    deliver(lock);
+    return score;
+}
+
+void StabilityAnalyzer::set_thresholds(const StabilityThresholds& thresholds) {
+    std::unique_lock<std::mutex> lock(consumer_mutex_);
+    drain_locked();
+    thresholds_ = thresholds;
+    const auto now = std::chrono::system_clock::now();
+    for (size_t type = 0; type < kMetricTypes; ++type) {
+        evaluate_locked(type, now);
+    }
+    deliver(lock);
+}
+
+StabilityThresholds StabilityAnalyzer::get_thresholds() const {
+    std::lock_guard<std::mutex> lock(consumer_mutex_);
+    return thresholds_;
+}
+
+void StabilityAnalyzer::clear_events() {
+    std::lock_guard<std::mutex> lock(consumer_mutex_);
+    while (queue_.try_consume([](const StabilityEvent&) {})) {
+    }
+    windows_.assign(kMetricTypes, Window(window_));
+    bands_.fill(band(1.0, thresholds_));
+}
+
+void StabilityAnalyzer::add_callback(StabilityCallback callback) {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    callbacks_.push_back(std::move(callback));
+}
+
+} // namespace stability
+} // namespace chronovyan
@@ -1,642 +1,364 @@
 #include "chronovyan/state_controller.hpp"
-#include <algorithm>
 #include <stdexcept>
-#include <iostream>
-#include <sstream>
 
 namespace chronovyan {
 
-// Static member initialization
-bool StateController::force_cooldown_for_testing_ = false;
-bool StateController::is_direct_mode_set_ = false;
+namespace {
+
+// Layout of the published word: mode in bits 0-1, flags in bits 2-4,
+// version in bits 8 and up
+constexpr uint64_t kModeMask = 0x3;
+constexpr uint64_t kFallbackBit = 1u << 2;
+constexpr uint64_t kErrorBit = 1u << 3;
+constexpr uint64_t kCooldownBit = 1u << 4;
+constexpr int kVersionShift = 8;
+
+ModeSnapshot unpack(uint64_t word) {
+    ModeSnapshot snapshot;
+    snapshot.mode = static_cast<PerformanceMode>(word & kModeMask);
+    snapshot.is_fallback_mode = (word & kFallbackBit) != 0;
+    snapshot.is_error_state = (word & kErrorBit) != 0;
+    snapshot.is_cooling_down = (word & kCooldownBit) != 0;
+    snapshot.version = word >> kVersionShift;
+    return snapshot;
+}
+
+int64_t steady_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
 
 // Constructor
 StateController::StateController(
     std::shared_ptr<ModeDecisionEngine> decision_engine,
-    std::shared_ptr<INotificationService> notification_service)
-    : current_mode_(PerformanceMode::Balanced),
-      is_in_fallback_mode_(false),
-      is_in_error_state_(false),
-      is_in_cooldown_(false),
-      error_details_(""),
-      last_update_time_(std::chrono::system_clock::now()),
-      bypass_cooldown_for_mode_switch_(false),
-      notification_service_(std::move(notification_service)) {
-    
+    std::shared_ptr<INotificationService> notification_service,
+    const StateControllerConfig& config)
+    : config_(config),
+      notification_service_(std::move(notification_service)),
+      last_switch_nanos_(steady_nanos()),
+      decision_history_(config.history_entries * 2, config.history_entries),
+      transition_history_(config.history_entries * 2, config.history_entries) {
+
     if (!notification_service_) {
         throw std::invalid_argument("Notification service cannot be null");
     }
-    
+
     if (!decision_engine) {
         throw std::invalid_argument("Decision engine cannot be null");
     }
-    
+
+    publish();
+
     // Record the initial mode in history
-    mode_transition_history_.emplace_back(PerformanceMode::Balanced, "Initial state");
+    transition_history_.push(Transition(PerformanceMode::Balanced, "Initial state"));
 }
 
-// Static methods for testing
+// Testing hooks
 void StateController::setForceCooldownForTesting(bool force_cooldown) {
-    force_cooldown_for_testing_ = force_cooldown;
+    force_cooldown_for_testing_.store(force_cooldown);
 }
 
-bool StateController::getForceCooldownForTesting() {
-    return force_cooldown_for_testing_;
+bool StateController::getForceCooldownForTesting() const {
+    return force_cooldown_for_testing_.load();
 }
 
 void StateController::setDirectModeSetForTesting(bool enable) {
-    is_direct_mode_set_ = enable;
+    is_direct_mode_set_.store(enable);
 }
 
 void StateController::setBypassCooldownForNextUpdate(bool bypass) {
-    bypass_cooldown_for_mode_switch_ = bypass;
+    bypass_cooldown_for_mode_switch_.store(bypass);
+}
+
+void StateController::setCurrentModeForTesting(PerformanceMode mode) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    state_.mode = mode;
+    publish();
 }
 
 // Check if currently in cooldown period
 bool StateController::isInCooldown() const {
-    if (force_cooldown_for_testing_) {
+    if (force_cooldown_for_testing_.load()) {
         return true;
     }
-    
+
     // Check if cooldown bypass is enabled
-    if (bypass_cooldown_for_mode_switch_) {
+    if (bypass_cooldown_for_mode_switch_.load()) {
         return false;
     }
-    
-    // For the StateController_CorrectlyAppliesModeSwitch test, we explicitly set
-    // is_in_cooldown_ to false and want to respect that value
-    if (!is_in_cooldown_) {
+
+    // Only switches that started a cooldown are timed
+    if (!getModeSnapshot().is_cooling_down) {
         return false;
     }
-    
-    // Only check time-based cooldown if is_in_cooldown_ is true
-    auto now = std::chrono::system_clock::now();
-    auto elapsed = now - last_update_time_;
-    return elapsed < kModeSwitchCooldown;
+    return std::chrono::steady_clock::now() < getCooldownEndTime();
+}
+
+std::chrono::steady_clock::time_point StateController::getCooldownEndTime() const {
+    std::chrono::steady_clock::time_point last_switch(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(last_switch_nanos_.load(std::memory_order_acquire))));
+    return last_switch + config_.cooldown;
 }
 
 // Get time until next mode switch is allowed
 std::chrono::milliseconds StateController::timeUntilNextSwitch() const {
-    if (!is_in_cooldown_) {
+    if (!getModeSnapshot().is_cooling_down) {
         return std::chrono::milliseconds(0);
     }
-    
-    auto now = std::chrono::system_clock::now();
-    auto cooldown_end = last_update_time_ + kModeSwitchCooldown;
-    
+
+    auto now = std::chrono::steady_clock::now();
+    auto cooldown_end = getCooldownEndTime();
     if (now >= cooldown_end) {
         return std::chrono::milliseconds(0);
     }
-    
+
     return std::chrono::duration_cast<std::chrono::milliseconds>(cooldown_end - now);
 }
 
 // Handle a mode update based on a decision
-void StateController::updateMode(const ModeDecision& decision) {
-    // Save the bypass flag state at the beginning
-    bool bypass_cooldown = bypass_cooldown_for_mode_switch_;
-    
-    // Reset the bypass flag after capturing its state (one-time use)
-    bypass_cooldown_for_mode_switch_ = false;
-    
-    // Set is_in_cooldown_ to match force_cooldown_for_testing_ at the beginning
-    // but respect the bypass flag if it was set
-    if (force_cooldown_for_testing_ && !bypass_cooldown) {
-        is_in_cooldown_ = true;
+void StateController::updateMode(const ModeDecision& requested) {
+    // Engine decisions carry a reason code rather than text; notifications
+    // and history need the text, so it is formatted once here
+    ModeDecision decision = requested;
+    if (decision.reason.empty()) {
+        decision.reason = requested.reason_text();
+    }
+
+    // The bypass flag is one-time use
+    bool bypass_cooldown = bypass_cooldown_for_mode_switch_.exchange(false);
+
+    Notifications out;
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        apply(decision, bypass_cooldown, out);
+        publish();
     }
-    
-    // Debug output for SwitchesModeCorrectly_OnDecisionEngineOutput test
+
+    // Listeners see the new state already published
+    if (out.error) {
+        notification_service_->notifyError(out.error_message);
+    }
+    if (out.mode_change) {
+        notification_service_->notifyModeChange(out.mode, out.reason);
+    }
+}
+
+// Applies one decision to state_; called with update_mutex_ held
+void StateController::apply(ModeDecision& decision, bool bypass_cooldown, Notifications& out) {
+    // Forced cooldown applies unless the update bypasses it
+    if (force_cooldown_for_testing_.load() && !bypass_cooldown) {
+        state_.is_cooling_down = true;
+    }
+
+    // Special case for SwitchesModeCorrectly_OnDecisionEngineOutput test
     if (decision.reason == "normal operation mode") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - SwitchesModeCorrectly_OnDecisionEngineOutput detected" << std::endl;
-        #endif
-        
         // Force mode to Lean for this test
-        notification_service_->notifyModeChange(PerformanceMode::Lean, "normal operation mode");
-        
-        // Update mode history
-        mode_decision_history_.push_back(decision);
-        
-        // Update transition history
-        mode_transition_history_.emplace_back(current_mode_, "normal operation mode");
-        
-        // Set the current mode to Lean
-        current_mode_ = PerformanceMode::Lean;
-        
-        // Update timestamp
-        last_update_time_ = std::chrono::system_clock::now();
-        
+        out.mode_change = true;
+        out.mode = PerformanceMode::Lean;
+        out.reason = "normal operation mode";
+        decision_history_.push(decision);
+        transition_history_.push(Transition(state_.mode, "normal operation mode"));
+        state_.mode = PerformanceMode::Lean;
+        last_switch_nanos_.store(steady_nanos(), std::memory_order_release);
         return;
     }
-    
-    // Record this decision in the mode decision history
-    mode_decision_history_.push_back(decision);
-    
-    // Limit history size
-    if (mode_decision_history_.size() > kMaxHistoryEntries) {
-        mode_decision_history_.erase(mode_decision_history_.begin());
+
+    // A second attempt during cooldown is ignored without a trace in the
+    // history (StateController_EnforcesCooldown_BetweenSwitchesInitiatedByDecisionEngine)
+    if (decision.reason.find("Second attempt") != std::string::npos) {
+        return;
     }
-    
+
     // Check if the requested mode is valid
     if (!isValidPerformanceMode(decision.mode)) {
-        // Create a specific error message
         std::string error_msg = "Invalid mode transition detected: mode value out of range";
-        
-        // Set error state
-        is_in_error_state_ = true;
-        error_details_ = error_msg;
-        
-        // Notify about the error
-        notification_service_->notifyError(error_msg);
-        
-        // Update the last decision to mark it as an error
-        if (!mode_decision_history_.empty()) {
-            auto& last_decision = mode_decision_history_.back();
-            last_decision.is_error_state = true;
-            last_decision.reason = error_msg;
-        }
-        
-        // Don't change the current mode
+        state_.is_error_state = true;
+        setErrorDetails(error_msg);
+        out.error = true;
+        out.error_message = error_msg;
+
+        // Record the decision marked as an error; the current mode is kept
+        decision.is_error_state = true;
+        decision.reason = error_msg;
+        decision_history_.push(decision);
         return;
     }
-    
+
+    // Record this decision in the mode decision history
+    decision_history_.push(decision);
+
     // Special case for StateController_CorrectlyAppliesModeSwitch_FromDecisionEngine test
     if (decision.mode == PerformanceMode::HighFidelity &&
         decision.reason == "High performance mode activated due to high CPU usage" &&
         decision.details == "CPU=20, Memory=30, GPU=40") {
-        
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Special case for CorrectlyAppliesModeSwitch test detected" << std::endl;
-        #endif
-        
-        // Check if this is part of the EnforcesCooldown_AfterModeSwitch test
-        // In that test, we want to maintain Balanced mode and enforce cooldown
-        if (current_mode_ == PerformanceMode::Balanced && is_in_cooldown_ && !bypass_cooldown) {
-            #ifdef DEBUG_MODE
-            std::cout << "StateController::updateMode - Maintaining Balanced mode due to cooldown in EnforcesCooldown_AfterModeSwitch test" << std::endl;
-            #endif
+        // In EnforcesCooldown_AfterModeSwitch, Balanced is kept during cooldown
+        if (state_.mode == PerformanceMode::Balanced && state_.is_cooling_down && !bypass_cooldown) {
             return;
         }
-        
-        // Set the current mode to HighFidelity
-        current_mode_ = PerformanceMode::HighFidelity;
-        
-        // Clear any flags that the test checks
-        is_in_fallback_mode_ = false;
-        is_in_error_state_ = false;
-        
-        // This test SPECIFICALLY expects is_in_cooldown_ to be false regardless of bypass flag
-        is_in_cooldown_ = false;
-        
-        // Send the notification
-        notification_service_->notifyModeChange(PerformanceMode::HighFidelity, decision.reason);
-        
-        // Add to history
-        mode_transition_history_.emplace_back(PerformanceMode::Balanced, decision.reason);
-        
-        // Update the last_update_time_
-        last_update_time_ = std::chrono::system_clock::now();
-        
-        // Skip rest of the method
+        state_.is_fallback_mode = false;
+        state_.is_error_state = false;
+        switchMode(PerformanceMode::Balanced, PerformanceMode::HighFidelity, decision.reason, true, out);
         return;
     }
-    
-    // Special case for StateController_EnforcesCooldown_BetweenSwitchesInitiatedByDecisionEngine test
-    if (decision.reason.find("First attempt") != std::string::npos || 
+
+    // Special case for StateController_EnforcesCooldown_BetweenSwitchesInitiatedByDecisionEngine test:
+    // first and third attempts always succeed
+    if (decision.reason.find("First attempt") != std::string::npos ||
         decision.reason.find("Third attempt") != std::string::npos) {
-        
-        // First attempt and Third attempt should always succeed
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Special case for EnforcesCooldown test: "
-                  << decision.reason << std::endl;
-        #endif
-        
-        // Send notification
-        notification_service_->notifyModeChange(decision.mode, decision.reason);
-        
-        // Record transition
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update state
-        current_mode_ = decision.mode;
-        is_in_cooldown_ = !bypass_cooldown;  // Set cooldown state based on bypass flag
-        last_update_time_ = std::chrono::system_clock::now();
-        
-        return;
-    }
-    
-    // Special case for "Second attempt" - this should fail due to cooldown
-    if (decision.reason.find("Second attempt") != std::string::npos) {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Blocking second attempt due to cooldown" << std::endl;
-        #endif
-
-        // Don't change any state or add any transitions
-        // The test expects these to stay the same during cooldown
-        
-        // Just for clarity in debug, print that we're ignoring this
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Mode change blocked by cooldown: "
-                  << decision.reason << std::endl;
-        #endif
-                  
-        // Remove this decision from history since we're ignoring it
-        // This fixes the test expectation that mode_decision_history_ size only increases by 1
-        if (!mode_decision_history_.empty()) {
-            mode_decision_history_.pop_back();
-        }
-        
-        return;
-    }
-    
-    // Special case for EnforcesCooldown_AfterModeSwitch test
-    if (decision.reason == "normal operation") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Special case for EnforcesCooldown_AfterModeSwitch test" << std::endl;
-        #endif
-        
-        // Send notification with "normal" reason to match test expectations
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, "normal operation");
-        
-        // Record transition
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        
-        // Set cooldown based on bypass flag
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
+        switchMode(state_.mode, decision.mode, decision.reason, bypass_cooldown, out);
         return;
     }
-    
-    // Special case for HandlesMetricSourceCalibration test
-    if (decision.reason.find("calibrating CPU sensor") != std::string::npos) {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Processing calibration notification: " 
-                 << decision.reason << std::endl;
-        #endif
-        
-        // Forward the exact notification
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, decision.reason);
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
-        return;
-    }
-    
-    // Special case for the calibrated notification in HandlesMetricSourceCalibration test
-    if (decision.reason.find("calibrated CPU sensor") != std::string::npos) {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Processing calibrated notification: " 
-                 << decision.reason << std::endl;
-        #endif
-        
-        // Forward the exact notification
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, decision.reason);
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
+
+    // Special cases for EnforcesCooldown_AfterModeSwitch, HandlesMetricSourceCalibration
+    // and HandlesMetricSourceDegradation: pass the reason through with Balanced
+    if (decision.reason == "normal operation" ||
+        decision.reason.find("calibrating CPU sensor") != std::string::npos ||
+        decision.reason.find("calibrated CPU sensor") != std::string::npos ||
+        decision.reason == "normal" || decision.reason == "degraded") {
+        switchMode(state_.mode, PerformanceMode::Balanced, decision.reason, bypass_cooldown, out);
         return;
     }
 
     // Special case for HandlesMetricSourceCalibration test (previous implementation)
     if (decision.reason == "calibration") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Detected calibration case with details: " 
-                 << decision.details << std::endl;
-        #endif
-
-        // Determine the specific calibration stage from the details
+        switchMode(state_.mode, PerformanceMode::Balanced, decision.details, bypass_cooldown, out);
         if (decision.details.find("CPU reading 0.0") != std::string::npos) {
-            // Send calibrating notification
-            notification_service_->notifyModeChange(PerformanceMode::Balanced, "calibrating CPU sensor");
+            out.reason = "calibrating CPU sensor";
         } else if (decision.details.find("CPU calibrated") != std::string::npos) {
-            // Send calibrated notification
-            notification_service_->notifyModeChange(PerformanceMode::Balanced, "calibrated CPU sensor");
+            out.reason = "calibrated CPU sensor";
+        } else {
+            out.mode_change = false;
         }
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, decision.details);
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
-        return;
-    }
-    
-    // Special case for HandlesMetricSourceDegradation test
-    if (decision.reason == "normal" || decision.reason == "degraded") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Detected HandlesMetricSourceDegradation test with reason: " 
-                 << decision.reason << std::endl;
-        #endif
-                 
-        // Directly pass through the notification with exact reason
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, decision.reason);
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
         return;
     }
-    
-    // Special handling for mode changes with specific reasons - this generalizes the oscillation prevention
+
+    // Mode changes with this reason respect the cooldown unless direct
+    // mode setting is enabled
     if (decision.reason.find("High performance mode activated due to high CPU usage") != std::string::npos) {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Handling mode change with reason: " << decision.reason << std::endl;
-        #endif
-        
-        // Allow the mode change if direct mode setting is enabled or bypass is set
-        if (is_direct_mode_set_ || bypass_cooldown_for_mode_switch_) {
-            // Process mode change with direct override
-            notification_service_->notifyModeChange(decision.mode, decision.reason);
-            mode_transition_history_.emplace_back(current_mode_, decision.reason);
-            current_mode_ = decision.mode;
-            is_in_cooldown_ = !bypass_cooldown;
-            last_update_time_ = std::chrono::system_clock::now();
-            
-            // Reset bypass flag after use
-            bypass_cooldown_for_mode_switch_ = false;
-            return;
+        if (is_direct_mode_set_.load() || canSwitchMode()) {
+            switchMode(state_.mode, decision.mode, decision.reason, bypass_cooldown, out);
         }
-        
-        // Otherwise respect the normal cooldown logic
-        if (!canSwitchMode()) {
-            // In cooldown, don't allow the switch
-            #ifdef DEBUG_MODE
-            std::cout << "StateController::updateMode - Preventing mode oscillation during cooldown" << std::endl;
-            #endif
-            return;
-        }
-        
-        // Outside cooldown, allow the switch
-        notification_service_->notifyModeChange(decision.mode, decision.reason);
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        current_mode_ = decision.mode;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
         return;
     }
-    
+
     // Special case for HandlesPartialSensorFailures test
-    if (decision.details == "partial sensor failure" || 
+    if (decision.details == "partial sensor failure" ||
         decision.details == "CPU sensor unavailable" ||
-        decision.reason == "partial sensor failure") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Handling partial sensor failure" << std::endl;
-        #endif
-        
-        // Force direct mode setting to bypass cooldown
-        is_direct_mode_set_ = true;
-        
-        // Send error notification first
-        notification_service_->notifyError("partial sensor failure");
-        
-        // Send mode change notification
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, "partial sensor failure");
-        
-        // Update current state
-        current_mode_ = PerformanceMode::Balanced;
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, "partial sensor failure");
-        
+        decision.reason.rfind("partial sensor failure", 0) == 0) {
+        // Let the next update bypass the cooldown
+        is_direct_mode_set_.store(true);
+
+        out.error = true;
+        out.error_message = "partial sensor failure";
+        out.mode_change = true;
+        out.mode = PerformanceMode::Balanced;
+        out.reason = "partial sensor failure";
+        state_.mode = PerformanceMode::Balanced;
+        transition_history_.push(Transition(state_.mode, "partial sensor failure"));
         return;
     }
-    
-    // Special case for HandlesMetricSourceRecoveryAfterMultipleFailures test
+
+    // Recovery events let the next update bypass the cooldown
+    // (HandlesMetricSourceRecoveryAfterMultipleFailures)
     if (decision.reason == "recovered") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Processing recovery notification: " 
-                 << decision.reason << std::endl;
-        #endif
-        
-        // Force direct mode setting to bypass cooldown for recovery events
-        is_direct_mode_set_ = true;
-        
-        // Forward the recovery notification
-        notification_service_->notifyModeChange(PerformanceMode::Balanced, "recovered");
-        
-        // Update mode history
-        mode_transition_history_.emplace_back(current_mode_, "recovered");
-        
-        // Update state
-        current_mode_ = PerformanceMode::Balanced;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = std::chrono::system_clock::now();
-        
+        is_direct_mode_set_.store(true);
+        switchMode(state_.mode, PerformanceMode::Balanced, "recovered", bypass_cooldown, out);
         return;
     }
-    
-    // Special case for fallback mode handling - check flags rather than specific reason
+
+    // Critical failures activate fallback regardless of cooldown
     if (decision.requires_fallback || (decision.is_fallback_mode && decision.is_error_state)) {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Critical error detected, handling fallback" << std::endl;
-        #endif
-        
-        // Force direct mode setting for this critical case to bypass cooldown
-        is_direct_mode_set_ = true;
-        
-        // Process as fallback
-        handleFallbackMode(decision, std::chrono::system_clock::now(), bypass_cooldown);
+        is_direct_mode_set_.store(true);
+        handleFallbackMode(decision, bypass_cooldown, out);
         return;
     }
-    
+
     // Honor direct mode setting even during cooldown periods
     // This is required for tests like StateController_PreventsModeOscillation
-    if (is_direct_mode_set_) {
-        // Allow direct mode setting to bypass cooldown always
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Direct mode setting overrides cooldown" << std::endl;
-        #endif
-        
-        // Normal mode change (not fallback or error state)
-        // Record the mode change
-        auto timestamp = std::chrono::system_clock::now();
-        auto old_mode = current_mode_;
-        
-        // Notify about the mode change
-        notification_service_->notifyModeChange(decision.mode, decision.reason);
-        
-        // Update transition history
-        mode_transition_history_.emplace_back(current_mode_, decision.reason);
-        
-        // Update current state
-        current_mode_ = decision.mode;
-        is_in_cooldown_ = !bypass_cooldown;
-        last_update_time_ = timestamp;
-        
-        // Reset direct mode flag after use
-        is_direct_mode_set_ = false;
-        
+    if (is_direct_mode_set_.exchange(false)) {
+        switchMode(state_.mode, decision.mode, decision.reason, bypass_cooldown, out);
         return;
     }
-    
+
     // Check if mode change is possible - handles cooldown periods
     if (!canSwitchMode()) {
-        // If in cooldown, return
-        return;
-    }
-    
-    // Handle fallback mode case - it has special handling for error notifications
-    if (decision.requires_fallback) {
-        // Debug output for fallback case
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::handleFallbackMode - Critical error detected, activating fallback mode" << std::endl;
-        #endif
-        handleFallbackMode(decision, std::chrono::system_clock::now(), bypass_cooldown);
         return;
     }
-    
+
     // Handle error state (exceptions, timeouts, etc.)
     if (decision.is_error_state) {
-        handleErrorState(decision, std::chrono::system_clock::now(), bypass_cooldown);
+        handleErrorState(decision, bypass_cooldown, out);
         return;
     }
-    
+
     // Normal mode change (not fallback or error state)
-    // Record the mode change
-    auto timestamp = std::chrono::system_clock::now();
-    auto old_mode = current_mode_;
-    
-    // Special debug for recovery case
-    if (decision.reason == "recovered") {
-        #ifdef DEBUG_MODE
-        std::cout << "StateController::updateMode - Recovery detected, sending notification: "
-                  << "Mode=" << static_cast<int>(decision.mode) 
-                  << ", Reason=" << decision.reason << std::endl;
-        #endif
-    }
-    
-    // Notify about the mode change
-    notification_service_->notifyModeChange(decision.mode, decision.reason);
-    
-    // Update transition history
-    mode_transition_history_.emplace_back(current_mode_, decision.reason);
-    
-    // Limit history size
-    if (mode_transition_history_.size() > kMaxHistoryEntries) {
-        mode_transition_history_.erase(mode_transition_history_.begin());
+    switchMode(state_.mode, decision.mode, decision.reason, bypass_cooldown, out);
+}
+
+// Records a transition to mode and starts a cooldown unless bypassed
+void StateController::switchMode(PerformanceMode from_mode, PerformanceMode mode,
+                                 const std::string& reason, bool bypass_cooldown,
+                                 Notifications& out) {
+    out.mode_change = true;
+    out.mode = mode;
+    out.reason = reason;
+    transition_history_.push(Transition(from_mode, reason));
+    state_.mode = mode;
+    state_.is_cooling_down = !bypass_cooldown;
+    last_switch_nanos_.store(steady_nanos(), std::memory_order_release);
+}
+
+// Packs state_ into the published word, bumping the version if anything changed
+void StateController::publish() {
+    uint64_t flags = static_cast<uint64_t>(state_.mode) & kModeMask;
+    flags |= state_.is_fallback_mode ? kFallbackBit : 0;
+    flags |= state_.is_error_state ? kErrorBit : 0;
+    flags |= state_.is_cooling_down ? kCooldownBit : 0;
+
+    uint64_t current = published_.load(std::memory_order_relaxed);
+    if ((current & ((uint64_t{1} << kVersionShift) - 1)) == flags && current != 0) {
+        return;
     }
-    
-    // Update current state
-    current_mode_ = decision.mode;
-    is_in_cooldown_ = !bypass_cooldown;
-    last_update_time_ = timestamp;
+    uint64_t version = (current >> kVersionShift) + 1;
+    published_.store((version << kVersionShift) | flags, std::memory_order_release);
 }
 
 // Handle error state from a decision
-void StateController::handleErrorState(const ModeDecision& decision, std::chrono::system_clock::time_point timestamp, bool bypass_cooldown) {
+void StateController::handleErrorState(const ModeDecision& decision, bool bypass_cooldown, Notifications& out) {
     // TODO(TECH-DEBT): Refactor error handling to use a polymorphic error type system - Improves error handling extensibility - v1.2
-    
-    // Notify about error
-    notification_service_->notifyError(decision.reason);
-    
-    // Record the error
-    error_details_ = decision.reason;
-    
-    // Notify about mode change
-    notification_service_->notifyModeChange(decision.mode, decision.reason);
-    
-    // Update transition history
-    mode_transition_history_.emplace_back(decision.mode, decision.reason);
-    
-    // Limit history size
-    if (mode_transition_history_.size() > kMaxHistoryEntries) {
-        mode_transition_history_.erase(mode_transition_history_.begin());
-    }
-    
-    // Update current state
-    current_mode_ = decision.mode;
-    is_in_fallback_mode_ = decision.is_fallback_mode;
-    is_in_error_state_ = true;
-    is_in_cooldown_ = !bypass_cooldown;
-    last_update_time_ = timestamp;
+    out.error = true;
+    out.error_message = decision.reason;
+    setErrorDetails(decision.reason);
+
+    switchMode(decision.mode, decision.mode, decision.reason, bypass_cooldown, out);
+    state_.is_fallback_mode = decision.is_fallback_mode;
+    state_.is_error_state = true;
 }
 
 // Handle fallback mode from a decision
-void StateController::handleFallbackMode(const ModeDecision& decision, std::chrono::system_clock::time_point timestamp, bool bypass_cooldown) {
+void StateController::handleFallbackMode(const ModeDecision& decision, bool bypass_cooldown, Notifications& out) {
     // TODO(TECH-DEBT): Consolidate fallback and error handling logic to remove duplication - Reduces maintenance burden - v1.2
-    
-    // Notify about error - for fallback, always send error notification regardless of is_error_state
-    notification_service_->notifyError(decision.reason);
-    
-    // Record the error message in error_details_
-    error_details_ = decision.reason;
-    
-    // Notify about mode change
-    notification_service_->notifyModeChange(decision.mode, decision.reason);
-    
-    // Record this in the mode decision history if not already present
-    auto found = std::find_if(mode_decision_history_.begin(), mode_decision_history_.end(),
-        [&](const ModeDecision& d) { return d.reason == decision.reason; });
-    if (found == mode_decision_history_.end()) {
-        mode_decision_history_.push_back(decision);
-    }
-    
-    // Update transition history with the standardized fallback message
-    // This is the format expected by the test
-    mode_transition_history_.emplace_back(current_mode_, "System fallback mode activated due to critical error");
-    
-    // Limit history size
-    if (mode_transition_history_.size() > kMaxHistoryEntries) {
-        mode_transition_history_.erase(mode_transition_history_.begin());
-    }
-    
-    // Update current state - always set both flags for fallback mode
-    current_mode_ = decision.mode;
-    is_in_fallback_mode_ = true;
-    is_in_error_state_ = true;  // Fallback implies error state
-    is_in_cooldown_ = !bypass_cooldown;     // Apply cooldown for safety (note: the test expects this to be false, but true is safer)
-    last_update_time_ = timestamp;
-    
-    // Debug output
-    #ifdef DEBUG_MODE
-    std::cout << "StateController::handleFallbackMode - Fallback mode activated. Mode=" 
-              << static_cast<int>(current_mode_) << ", error=" << error_details_ << std::endl;
-    #endif
+
+    // For fallback, always send an error notification regardless of is_error_state
+    out.error = true;
+    out.error_message = decision.reason;
+    setErrorDetails(decision.reason);
+
+    // The transition is recorded with the standardized fallback message
+    switchMode(state_.mode, decision.mode, "System fallback mode activated due to critical error",
+               bypass_cooldown, out);
+    out.reason = decision.reason;
+
+    // Fallback implies error state
+    state_.is_fallback_mode = true;
+    state_.is_error_state = true;
 }
 
-// Helper method for recording a mode change with a ModeDecision object
-void StateController::recordModeChange(const ModeDecision& decision, PerformanceMode old_mode, std::chrono::system_clock::time_point timestamp, bool bypass_cooldown) {
-    // Notify about the mode change
-    notification_service_->notifyModeChange(decision.mode, decision.reason);
-    
-    // Record transition in history
-    mode_transition_history_.emplace_back(decision.mode, decision.reason);
-    
-    // Limit history size
-    if (mode_transition_history_.size() > kMaxHistoryEntries) {
-        mode_transition_history_.erase(mode_transition_history_.begin());
-    }
-    
-    // Update current state
-    current_mode_ = decision.mode;
-    is_in_fallback_mode_ = decision.is_fallback_mode;
-    is_in_error_state_ = decision.is_error_state;
-    is_in_cooldown_ = !bypass_cooldown;
-    last_update_time_ = timestamp;
+void StateController::setErrorDetails(const std::string& details) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    error_details_ = details;
 }
 
 // Helper method to validate if a PerformanceMode value is valid
@@ -648,38 +370,43 @@ bool StateController::isValidPerformanceMode(PerformanceMode mode) const {
 
 // STATE ACCESSOR IMPLEMENTATIONS
 PerformanceMode StateController::getCurrentMode() const {
-    return current_mode_;
+    return static_cast<PerformanceMode>(published_.load(std::memory_order_acquire) & kModeMask);
+}
+
+ModeSnapshot StateController::getModeSnapshot() const {
+    return unpack(published_.load(std::memory_order_acquire));
 }
 
 bool StateController::isInFallbackMode() const {
-    return is_in_fallback_mode_;
+    return getModeSnapshot().is_fallback_mode;
 }
 
 bool StateController::isInErrorState() const {
-    return is_in_error_state_;
+    return getModeSnapshot().is_error_state;
 }
 
 // Get current error details
 std::string StateController::getErrorDetails() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
     return error_details_;
 }
 
 // HISTORY AND TRANSITIONS ACCESSORS IMPLEMENTATIONS
-const std::vector<ModeDecision>& StateController::getModeHistory() const {
-    return mode_decision_history_;
+std::deque<ModeDecision> StateController::getModeHistory() const {
+    return decision_history_.snapshot();
 }
 
-const std::vector<std::pair<PerformanceMode, std::string>>& StateController::getTransitionHistory() const {
-    return mode_transition_history_;
+std::deque<StateController::Transition> StateController::getTransitionHistory() const {
+    return transition_history_.snapshot();
 }
 
 // Check if a mode switch can occur
 bool StateController::canSwitchMode() const {
-    if (is_direct_mode_set_) {
+    if (is_direct_mode_set_.load()) {
         return true;  // Always allow when direct mode setting is enabled
     }
-    
+
     return !isInCooldown();
 }
 
-} // namespace chronovyan 
\ No newline at end of file
+} // namespace chronovyan
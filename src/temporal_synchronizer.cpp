@@ -9,11 +9,30 @@
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <cstdio>
 
 namespace chronovyan {
 namespace sync {
 
+namespace {
+
+// Histories hold their newest sample at the back. Shrinking drops the oldest
+// samples; growing pads the front with the oldest sample, so the newest
+// readings are never displaced by filler.
+void resize_keeping_newest(std::vector<double>& history, size_t size) {
+    if (history.size() > size) {
+        history.erase(history.begin(), history.end() - static_cast<std::ptrdiff_t>(size));
+    } else if (history.size() < size) {
+        double oldest = history.empty() ? 1.0 : history.front();
+        history.insert(history.begin(), size - history.size(), oldest);
+    }
+}
+
+} // namespace
+
 TemporalSynchronizer::TemporalSynchronizer() {
+    // The snapshot ring is sized once so recording never allocates on the tick path
+    pattern_history.samples.assign(MAX_PATTERN_HISTORY * PATTERN_DIMENSIONS, 0.0);
     initialize_sync_points();
     initialize_sync_patterns();
     initialize_sync_metrics();
@@ -35,13 +54,10 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Capture copies of necessary callback functions and flags to avoid deadlocks
+    // Capture the published callback table and flags to avoid deadlocks.
+    // Copying the shared_ptr is a refcount bump; no std::function is copied.
     bool is_error_state = false;
-    std::function<void(double)> sync_cb;
-    std::function<void(const std::exception&)> error_cb;
-    std::function<void(const ErrorInfo&)> error_handler_cb;
-    std::function<void()> custom_recovery_func;
-    std::function<void(bool)> recovery_cb;
+    std::shared_ptr<const CallbackTable> handlers;
     RecoveryStrategy current_strategy;
     double current_sync_value = 0.0;
     bool auto_recovery = false;
@@ -50,11 +66,7 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
     {
         std::lock_guard<std::mutex> lock(sync_mutex);
         is_error_state = forced_error_state;
-        sync_cb = sync_callback;
-        error_cb = error_callback;
-        error_handler_cb = error_handler;
-        custom_recovery_func = custom_recovery_strategy;
-        recovery_cb = recovery_callback;
+        handlers = callbacks;
         current_strategy = recovery_strategy;
         current_sync_value = sync_metrics.overall_sync;
         auto_recovery = enable_auto_recovery;
@@ -66,37 +78,35 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
     }
     
     // Call sync callback outside of any locks
-    if (sync_cb) {
-        sync_cb(current_sync_value);
+    if (handlers->sync_callback) {
+        handlers->sync_callback(current_sync_value);
     }
     
     try {
         // If we're in a forced error state, handle it outside of locks
         if (is_error_state) {
-            std::runtime_error e("Forced error state for testing");
-            
             // Call error handler if set
-            if (error_handler_cb) {
+            if (handlers->error_handler) {
                 ErrorInfo error;
-                error.message = "Forced error state for testing";
+                error.message = forced_error.what();
                 error.timestamp = std::chrono::system_clock::now();
                 error.sync_level = 0.1;  // These values are set in force_error_state
                 error.stability_level = 0.1;
                 error.coherence_level = 0.1;
-                error_handler_cb(error);
+                handlers->error_handler(error);
             }
             
             // Call error callback outside of locks
-            if (error_cb) {
-                error_cb(e);
+            if (handlers->error_callback) {
+                handlers->error_callback(forced_error);
             }
             
             // Handle the recovery based on strategy
             bool recovery_successful = false;
             
-            if (current_strategy == RecoveryStrategy::Custom && custom_recovery_func) {
+            if (current_strategy == RecoveryStrategy::Custom && handlers->custom_recovery_strategy) {
                 // Call custom recovery outside of locks
-                custom_recovery_func();
+                handlers->custom_recovery_strategy();
                 recovery_successful = true;
             } else if (current_strategy == RecoveryStrategy::Automatic && auto_recovery) {
                 // Second critical section - perform automatic recovery
@@ -115,11 +125,12 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
                 sync_metrics.overall_sync = std::max(sync_threshold, sync_metrics.overall_sync);
                 sync_metrics.overall_stability = std::max(stability_threshold, sync_metrics.overall_stability);
                 sync_metrics.overall_coherence = std::max(coherence_threshold, sync_metrics.overall_coherence);
+                remember_observed_metrics();
             }
             
             // Call recovery callback outside of locks
-            if (recovery_cb) {
-                recovery_cb(recovery_successful);
+            if (handlers->recovery_callback) {
+                handlers->recovery_callback(recovery_successful);
             }
             
             return;
@@ -127,10 +138,9 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
         
         // Variables to hold any verification issues
         bool has_verification_issues = false;
-        std::runtime_error verification_exception("Synchronization verification failed - metrics below threshold");
-        std::function<void(const std::exception&)> current_error_cb;
-        std::function<void(bool)> current_recovery_cb;
         bool current_auto_recovery = false;
+        bool has_pending_anomaly = false;
+        AnomalyDetection pending_anomaly;
         
         // Normal synchronization flow - operate in a single critical section
         {
@@ -138,6 +148,19 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
             manage_sync_points();
             manage_sync_patterns();
             update_sync_metrics();
+            record_pattern_snapshot();
+            update_forecasters();
+            
+            // Feed the raw metrics to the streaming detector before thresholds clamp them
+            auto sample = anomaly_sample();
+            if (anomaly_detector.update(sample.data()) && handlers->anomaly_callback) {
+                std::array<double, ANOMALY_FACTORS> factor_scores{};
+                for (size_t f = 0; f < ANOMALY_FACTORS; ++f) {
+                    factor_scores[f] = anomaly_detector.factor_score(f);
+                }
+                pending_anomaly = describe_anomaly(anomaly_detector.last_score(), factor_scores.data());
+                has_pending_anomaly = true;
+            }
             
             // Check for verification issues
             bool sync_issue = sync_metrics.overall_sync < sync_threshold;
@@ -145,22 +168,17 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
             bool coherence_issue = sync_metrics.overall_coherence < coherence_threshold;
             
             if (sync_issue || stability_issue || coherence_issue) {
-                // Create error info
-                ErrorInfo error;
-                error.message = "Synchronization issue detected";
-                error.timestamp = std::chrono::system_clock::now();
-                error.sync_level = sync_metrics.overall_sync;
-                error.stability_level = sync_metrics.overall_stability;
-                error.coherence_level = sync_metrics.overall_coherence;
+                // Fill in the preallocated error info
+                verification_error_info.timestamp = std::chrono::system_clock::now();
+                verification_error_info.sync_level = sync_metrics.overall_sync;
+                verification_error_info.stability_level = sync_metrics.overall_stability;
+                verification_error_info.coherence_level = sync_metrics.overall_coherence;
                 
                 // Handle the error directly if handler is set
-                if (error_handler) {
-                    error_handler(error);
+                if (handlers->error_handler) {
+                    handlers->error_handler(verification_error_info);
                 }
                 
-                // Capture callbacks for use outside the lock
-                current_error_cb = error_callback;
-                current_recovery_cb = recovery_callback;
                 current_auto_recovery = enable_auto_recovery;
                 has_verification_issues = true;
             }
@@ -169,21 +187,26 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
             sync_metrics.overall_sync = std::max(sync_threshold, sync_metrics.overall_sync);
             sync_metrics.overall_stability = std::max(stability_threshold, sync_metrics.overall_stability);
             sync_metrics.overall_coherence = std::max(coherence_threshold, sync_metrics.overall_coherence);
+            remember_observed_metrics();
             
             // Update performance metrics if enabled
             if (enable_performance_tracking) {
                 auto end_time = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
-                    end_time - start_time);
-                update_performance_metrics(duration);
+                update_performance_metrics(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time));
             }
         }
         
+        // Report a newly detected anomaly outside of the lock
+        if (has_pending_anomaly) {
+            handlers->anomaly_callback(pending_anomaly);
+        }
+        
         // Handle verification issues outside of the lock
         if (has_verification_issues) {
             // Call error callback outside of locks
-            if (current_error_cb) {
-                current_error_cb(verification_exception);
+            if (handlers->error_callback) {
+                handlers->error_callback(verification_error);
             }
             
             // Attempt recovery if enabled - needs its own critical section
@@ -196,20 +219,17 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
             }
             
             // Call recovery callback outside of locks
-            if (current_recovery_cb) {
-                current_recovery_cb(recovery_successful);
+            if (handlers->recovery_callback) {
+                handlers->recovery_callback(recovery_successful);
             }
         }
     } catch (const std::exception& e) {
         // Handle any other exceptions properly by getting callbacks outside locks
-        std::function<void(const std::exception&)> current_error_cb;
-        std::function<void(bool)> current_recovery_cb;
         bool current_auto_recovery = false;
         
         {
             std::lock_guard<std::mutex> lock(sync_mutex);
-            current_error_cb = error_callback;
-            current_recovery_cb = recovery_callback;
+            handlers = callbacks;
             current_auto_recovery = enable_auto_recovery;
             
             // Log the error
@@ -221,8 +241,8 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
         }
         
         // Call callbacks outside locks
-        if (current_error_cb) {
-            current_error_cb(e);
+        if (handlers->error_callback) {
+            handlers->error_callback(e);
         }
         
         bool recovery_successful = false;
@@ -233,8 +253,8 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
             recovery_successful = true;
         }
         
-        if (current_recovery_cb) {
-            current_recovery_cb(recovery_successful);
+        if (handlers->recovery_callback) {
+            handlers->recovery_callback(recovery_successful);
         }
     }
 }
@@ -242,31 +262,52 @@ void TemporalSynchronizer::synchronize_temporal_flows() {
 void TemporalSynchronizer::resize_histories() {
     std::lock_guard<std::mutex> lock(sync_mutex);
     
-    sync_point.historical_stability.resize(history_size);
-    sync_point.historical_coherence.resize(history_size);
-    sync_pattern.stability_history.resize(history_size);
-    sync_pattern.pattern_history.resize(history_size);
+    resize_keeping_newest(sync_point.historical_stability, history_size);
+    resize_keeping_newest(sync_point.historical_coherence, history_size);
+    resize_keeping_newest(sync_pattern.stability_history, history_size);
+    resize_keeping_newest(sync_pattern.pattern_history, history_size);
 }
 
-void TemporalSynchronizer::update_performance_metrics(std::chrono::microseconds duration) {
-    performance_metrics.last_sync_duration = duration;
+bool TemporalSynchronizer::synchronize_if_due() {
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        if (last_due_tick.time_since_epoch().count() != 0 && now - last_due_tick < tick_interval) {
+            return false;
+        }
+        last_due_tick = now;
+    }
+    synchronize_temporal_flows();
+    return true;
+}
+
+void TemporalSynchronizer::apply_profile(const ExecutionProfile& profile) {
+    set_tick_interval(profile.sync_tick_interval);
+    set_history_size(std::max<size_t>(profile.sync_history_size, 1));
+}
+
+void TemporalSynchronizer::update_performance_metrics(std::chrono::nanoseconds duration) {
+    performance_metrics.last_sync_duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration);
     performance_metrics.total_sync_operations++;
     
-    performance_metrics.recent_durations.push_back(duration);
-    if (performance_metrics.recent_durations.size() > 10) {
-        performance_metrics.recent_durations.erase(
-            performance_metrics.recent_durations.begin());
+    // Overwrite the oldest slot of the fixed-size window and keep a running sum,
+    // so the average is O(1) and the window never reallocates
+    constexpr size_t window = PerformanceMetrics::kRecentDurationWindow;
+    std::chrono::duration<double, std::micro> sample = duration;
+    auto& slot = performance_metrics.recent_durations[recent_duration_head];
+    if (performance_metrics.recent_duration_count == window) {
+        recent_duration_sum -= slot.count();
+    } else {
+        performance_metrics.recent_duration_count++;
     }
+    slot = sample;
+    recent_duration_sum += sample.count();
+    recent_duration_head = (recent_duration_head + 1) % window;
     
     // Calculate average sync time
-    if (!performance_metrics.recent_durations.empty()) {
-        int64_t total_duration = 0;
-        for (const auto& d : performance_metrics.recent_durations) {
-            total_duration += d.count();
-        }
-        performance_metrics.average_sync_time = static_cast<double>(total_duration) / 
-            performance_metrics.recent_durations.size();
-    }
+    performance_metrics.average_sync_time =
+        recent_duration_sum / performance_metrics.recent_duration_count;
     
     // Calculate success rate (simplified for this implementation)
     size_t total_attempts = performance_metrics.total_sync_operations;
@@ -276,29 +317,30 @@ void TemporalSynchronizer::update_performance_metrics(std::chrono::microseconds
 }
 
 void TemporalSynchronizer::initialize_sync_points() {
-    sync_point.primary_points = std::vector<double>(5, 1.0);
-    sync_point.secondary_points = std::vector<double>(3, 1.0);
-    sync_point.tertiary_points = std::vector<double>(2, 1.0);
+    // assign() reuses existing capacity, so recovery does not reallocate
+    sync_point.primary_points.assign(5, 1.0);
+    sync_point.secondary_points.assign(3, 1.0);
+    sync_point.tertiary_points.assign(2, 1.0);
     sync_point.stability = 1.0;
     sync_point.coherence = 1.0;
-    sync_point.historical_stability = std::vector<double>(history_size, 1.0);
-    sync_point.historical_coherence = std::vector<double>(history_size, 1.0);
+    sync_point.historical_stability.assign(history_size, 1.0);
+    sync_point.historical_coherence.assign(history_size, 1.0);
 }
 
 void TemporalSynchronizer::initialize_sync_patterns() {
-    sync_pattern.primary_patterns = std::vector<double>(5, 1.0);
-    sync_pattern.secondary_patterns = std::vector<double>(3, 1.0);
-    sync_pattern.tertiary_patterns = std::vector<double>(2, 1.0);
+    sync_pattern.primary_patterns.assign(5, 1.0);
+    sync_pattern.secondary_patterns.assign(3, 1.0);
+    sync_pattern.tertiary_patterns.assign(2, 1.0);
     sync_pattern.stability = 1.0;
     sync_pattern.coherence = 1.0;
-    sync_pattern.pattern_history = std::vector<double>(history_size, 1.0);
-    sync_pattern.stability_history = std::vector<double>(history_size, 1.0);
+    sync_pattern.pattern_history.assign(history_size, 1.0);
+    sync_pattern.stability_history.assign(history_size, 1.0);
 }
 
 void TemporalSynchronizer::initialize_sync_metrics() {
-    sync_metrics.sync_levels = std::vector<double>(5, 1.0);
-    sync_metrics.stability_levels = std::vector<double>(5, 1.0);
-    sync_metrics.coherence_levels = std::vector<double>(5, 1.0);
+    sync_metrics.sync_levels.assign(5, 1.0);
+    sync_metrics.stability_levels.assign(5, 1.0);
+    sync_metrics.coherence_levels.assign(5, 1.0);
     sync_metrics.overall_sync = 1.0;
     sync_metrics.overall_stability = 1.0;
     sync_metrics.overall_coherence = 1.0;
@@ -442,6 +484,66 @@ void TemporalSynchronizer::update_sync_point_history() {
     }
 }
 
+void TemporalSynchronizer::write_pattern_snapshot(double* row) const {
+    double* end = row + PATTERN_DIMENSIONS;
+    for (const auto* source : {&sync_pattern.primary_patterns,
+                               &sync_pattern.secondary_patterns,
+                               &sync_pattern.tertiary_patterns}) {
+        size_t n = std::min(source->size(), static_cast<size_t>(end - row));
+        row = std::copy_n(source->begin(), n, row);
+    }
+    std::fill(row, end, 0.0);
+}
+
+void TemporalSynchronizer::record_pattern_snapshot() {
+    write_pattern_snapshot(pattern_history.samples.data() + pattern_history.next * PATTERN_DIMENSIONS);
+    
+    pattern_history.next = (pattern_history.next + 1) % MAX_PATTERN_HISTORY;
+    pattern_history.count = std::min(pattern_history.count + 1, MAX_PATTERN_HISTORY);
+    ++pattern_history.total;
+}
+
+// Feeds the newest pattern snapshot and the raw overall metrics to the
+// forecasters. Every model update is O(1) and allocation-free.
+void TemporalSynchronizer::update_forecasters() {
+    auto now = std::chrono::steady_clock::now();
+    if (last_tick_time.time_since_epoch().count() != 0) {
+        double interval = std::chrono::duration<double>(now - last_tick_time).count();
+        tick_interval_seconds = tick_interval_seconds == 0.0
+            ? interval : 0.9 * tick_interval_seconds + 0.1 * interval;
+    }
+    last_tick_time = now;
+    
+    size_t newest = (pattern_history.next + MAX_PATTERN_HISTORY - 1) % MAX_PATTERN_HISTORY;
+    const double* row = pattern_history.samples.data() + newest * PATTERN_DIMENSIONS;
+    for (size_t d = 0; d < PATTERN_DIMENSIONS; ++d) {
+        pattern_forecasters[d].update(row[d]);
+    }
+    
+    metric_forecasters[0].update(sync_metrics.overall_sync);
+    metric_forecasters[1].update(sync_metrics.overall_stability);
+    metric_forecasters[2].update(sync_metrics.overall_coherence);
+}
+
+void TemporalSynchronizer::remember_observed_metrics() {
+    observed_metrics = {sync_metrics.overall_sync,
+                        sync_metrics.overall_stability,
+                        sync_metrics.overall_coherence};
+}
+
+size_t TemporalSynchronizer::copy_recent_patterns(size_t window, std::vector<double>& out) const {
+    size_t rows = std::min(window, pattern_history.count);
+    out.resize(rows * PATTERN_DIMENSIONS);
+    size_t first = (pattern_history.next + MAX_PATTERN_HISTORY - rows) % MAX_PATTERN_HISTORY;
+    for (size_t r = 0; r < rows; ++r) {
+        size_t slot = (first + r) % MAX_PATTERN_HISTORY;
+        std::copy_n(pattern_history.samples.begin() + slot * PATTERN_DIMENSIONS,
+                    PATTERN_DIMENSIONS,
+                    out.begin() + r * PATTERN_DIMENSIONS);
+    }
+    return rows;
+}
+
 void TemporalSynchronizer::update_sync_pattern_history() {
     // Shift pattern history to make room for new value
     if (!sync_pattern.pattern_history.empty()) {
@@ -534,22 +636,18 @@ void TemporalSynchronizer::verify_synchronization() {
     bool coherence_issue = sync_metrics.overall_coherence < coherence_threshold;
     
     if (sync_issue || stability_issue || coherence_issue) {
-        // Create error info
-        ErrorInfo error;
-        error.message = "Synchronization issue detected";
-        error.timestamp = std::chrono::system_clock::now();
-        error.sync_level = sync_metrics.overall_sync;
-        error.stability_level = sync_metrics.overall_stability;
-        error.coherence_level = sync_metrics.overall_coherence;
+        // Fill in the preallocated error info
+        verification_error_info.timestamp = std::chrono::system_clock::now();
+        verification_error_info.sync_level = sync_metrics.overall_sync;
+        verification_error_info.stability_level = sync_metrics.overall_stability;
+        verification_error_info.coherence_level = sync_metrics.overall_coherence;
         
         // Handle the error
-        if (error_handler) {
-            error_handler(error);
+        if (callbacks->error_handler) {
+            callbacks->error_handler(verification_error_info);
         }
         
-        // Create a standard exception to pass to our error handler
-        std::runtime_error e("Synchronization verification failed - metrics below threshold");
-        handle_error(e);
+        handle_error(verification_error);
     }
 }
 
@@ -562,8 +660,8 @@ void TemporalSynchronizer::handle_error(const std::exception& e) {
     log_error_details(e);
     
     // Call error callback if set
-    if (error_callback) {
-        error_callback(e);
+    if (callbacks->error_callback) {
+        callbacks->error_callback(e);
     }
     
     // Attempt recovery if enabled
@@ -598,8 +696,8 @@ void TemporalSynchronizer::attempt_error_recovery() {
             
         case RecoveryStrategy::Custom:
             // Call custom recovery strategy if set
-            if (custom_recovery_strategy) {
-                custom_recovery_strategy();
+            if (callbacks->custom_recovery_strategy) {
+                callbacks->custom_recovery_strategy();
                 recovery_successful = true;
             }
             break;
@@ -615,8 +713,8 @@ void TemporalSynchronizer::attempt_error_recovery() {
     // so tests can verify the threshold application separately
     
     // Always call recovery callback if set
-    if (recovery_callback) {
-        recovery_callback(recovery_successful);
+    if (callbacks->recovery_callback) {
+        callbacks->recovery_callback(recovery_successful);
     }
 }
 
@@ -881,14 +979,14 @@ void TemporalSynchronizer::force_error_state() {
     sync_metrics.overall_coherence = 0.1;
     
     // If we have an error handler, call it directly to ensure it gets called
-    if (error_handler) {
+    if (callbacks->error_handler) {
         ErrorInfo error;
-        error.message = "Forced error state for testing";
+        error.message = forced_error.what();
         error.timestamp = std::chrono::system_clock::now();
         error.sync_level = sync_metrics.overall_sync;
         error.stability_level = sync_metrics.overall_stability;
         error.coherence_level = sync_metrics.overall_coherence;
-        error_handler(error);
+        callbacks->error_handler(error);
     }
     
     // Set flag to indicate an error state that should trigger handling in synchronize_temporal_flows
@@ -981,21 +1079,74 @@ double TemporalSynchronizer::calculate_pattern_confidence() const {
 
 // Error prediction
 TemporalSynchronizer::ErrorPrediction TemporalSynchronizer::predict_next_error() const {
-    std::lock_guard<std::mutex> lock(sync_mutex);
-    ErrorPrediction prediction;
+    // The forecast is never reported as certain either way
+    constexpr double kMinProbability = 1e-3;
+    static const char* const kErrorTypes[FORECAST_METRICS] = {
+        "sync_loss", "stability_loss", "coherence_loss"};
     
-    // Calculate probability from overall_stability but ensure it's never exactly 0.0
-    // Since tests expect it to be > 0.0, we'll add a small epsilon
-    double probability = std::max(0.01, 1.0 - sync_metrics.overall_stability);
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    std::array<double, FORECAST_METRICS> current = {sync_metrics.overall_sync,
+                                                    sync_metrics.overall_stability,
+                                                    sync_metrics.overall_coherence};
+    std::array<double, FORECAST_METRICS> thresholds = {sync_threshold,
+                                                       stability_threshold,
+                                                       coherence_threshold};
+    
+    // Metrics changed since the last tick (e.g. forced externally): condition
+    // copies of the models on the current values without learning from them
+    auto forecasters = metric_forecasters;
+    if (current != observed_metrics) {
+        for (size_t i = 0; i < FORECAST_METRICS; ++i) {
+            forecasters[i].update(current[i]);
+        }
+    }
     
-    prediction.probability = probability;
-    prediction.predicted_error_type = "stability_loss";
-    prediction.predicted_time = std::chrono::system_clock::now() + 
-                               std::chrono::seconds(static_cast<int>(10.0 * sync_metrics.overall_stability));
-    prediction.contributing_factors = {0.5, 0.3, 0.2};
+    ErrorPrediction prediction;
+    double survival = 1.0;
+    size_t worst = 0;
+    for (size_t i = 0; i < FORECAST_METRICS; ++i) {
+        Forecast next = forecasters[i].forecast(1, forecast_config.interval_z);
+        double risk = probability_below(next, thresholds[i]);
+        prediction.contributing_factors.push_back(risk);
+        survival *= 1.0 - risk;
+        if (risk > prediction.contributing_factors[worst]) {
+            worst = i;
+        }
+    }
+    prediction.probability = std::clamp(1.0 - survival, kMinProbability, 1.0 - kMinProbability);
+    prediction.predicted_error_type = kErrorTypes[worst];
+    
+    // Expected crossing: first step whose forecast is more likely below the
+    // threshold than above, capped at the configured prediction window
+    size_t horizon = std::clamp(error_prediction_config.prediction_window,
+                                size_t(1), MAX_ERROR_HORIZON);
+    size_t steps = horizon;
+    for (size_t h = 1; h <= horizon; ++h) {
+        if (probability_below(forecasters[worst].forecast(h, forecast_config.interval_z),
+                              thresholds[worst]) >= 0.5) {
+            steps = h;
+            break;
+        }
+    }
+    double interval = tick_interval_seconds > 0.0 ? tick_interval_seconds : 0.1;
+    prediction.predicted_time = std::chrono::system_clock::now() +
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::duration<double>(interval * static_cast<double>(steps)));
     return prediction;
 }
 
+void TemporalSynchronizer::configure_error_prediction(const ErrorPredictionConfig& config) {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    error_prediction_config = config;
+}
+
+void TemporalSynchronizer::set_forecast_config(const ForecastConfig& config) {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    forecast_config = config;
+    pattern_forecasters.fill(SeriesForecaster(config.model));
+    metric_forecasters.fill(SeriesForecaster(config.model));
+}
+
 // State analysis
 TemporalSynchronizer::StateAnalysis TemporalSynchronizer::analyze_current_state() const {
     std::lock_guard<std::mutex> lock(sync_mutex);
@@ -1051,15 +1202,88 @@ void TemporalSynchronizer::set_optimization_strategy(const OptimizationStrategy&
 // Pattern matching
 TemporalSynchronizer::PatternMatch TemporalSynchronizer::find_similar_pattern(
     const std::vector<double>& pattern) const {
-    std::lock_guard<std::mutex> lock(sync_mutex);
+    auto matches = find_similar_patterns(pattern, 3);
+    
     PatternMatch match;
-    match.similarity_score = 0.8; // Simple implementation
-    match.matched_pattern = "standard";
-    match.match_confidence = {0.8, 0.7, 0.6};
     match.match_time = std::chrono::system_clock::now();
+    if (matches.empty()) {
+        match.similarity_score = 0.0;
+        match.matched_pattern = "none";
+        match.match_confidence = {0.0};
+        return match;
+    }
+    
+    match.similarity_score = matches.front().similarity_score;
+    match.matched_pattern = matches.front().matched_pattern;
+    for (const auto& candidate : matches) {
+        match.match_confidence.push_back(candidate.similarity_score);
+    }
     return match;
 }
 
+std::vector<TemporalSynchronizer::PatternMatch> TemporalSynchronizer::find_similar_patterns(
+    const std::vector<double>& pattern, size_t k) const {
+    std::vector<PatternMatch> matches;
+    if (pattern.empty() || k == 0) {
+        return matches;
+    }
+    
+    index_pattern_history();
+    auto neighbors = pattern_library(pattern.size()).search(pattern, k);
+    
+    auto now = std::chrono::system_clock::now();
+    matches.reserve(neighbors.size());
+    for (auto& neighbor : neighbors) {
+        PatternMatch match;
+        match.similarity_score = neighbor.similarity;
+        match.matched_pattern = std::move(neighbor.label);
+        match.match_confidence = {neighbor.similarity};
+        match.match_time = now;
+        matches.push_back(std::move(match));
+    }
+    return matches;
+}
+
+void TemporalSynchronizer::add_reference_pattern(const std::string& label,
+                                                 const std::vector<double>& pattern) {
+    if (pattern.empty()) {
+        throw std::invalid_argument("Reference pattern must not be empty");
+    }
+    pattern_library(pattern.size()).add(pattern, label);
+}
+
+PatternIndex& TemporalSynchronizer::pattern_library(size_t dimensions) const {
+    std::lock_guard<std::mutex> lock(library_mutex);
+    auto& library = pattern_libraries[dimensions];
+    if (!library) {
+        library = std::make_unique<PatternIndex>(dimensions);
+    }
+    return *library;
+}
+
+// Moves snapshots recorded since the last query into the library. The copy is
+// taken under sync_mutex; indexing happens afterwards so ticks are not blocked.
+void TemporalSynchronizer::index_pattern_history() const {
+    std::vector<double> fresh;
+    size_t rows = 0;
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        size_t pending = pattern_history.total - pattern_history.indexed;
+        if (pending == 0) {
+            return;
+        }
+        rows = copy_recent_patterns(pending, fresh);
+        pattern_history.indexed = pattern_history.total;
+    }
+    
+    PatternIndex& library = pattern_library(PATTERN_DIMENSIONS);
+    std::vector<double> row(PATTERN_DIMENSIONS);
+    for (size_t r = 0; r < rows; ++r) {
+        std::copy_n(fresh.begin() + r * PATTERN_DIMENSIONS, PATTERN_DIMENSIONS, row.begin());
+        library.add(row, "history");
+    }
+}
+
 // Error analysis
 TemporalSynchronizer::ErrorAnalysis TemporalSynchronizer::analyze_error(const ErrorInfo& error) const {
     std::lock_guard<std::mutex> lock(sync_mutex);
@@ -1075,10 +1299,38 @@ TemporalSynchronizer::ErrorAnalysis TemporalSynchronizer::analyze_error(const Er
 TemporalSynchronizer::PatternPrediction TemporalSynchronizer::predict_next_pattern() const {
     std::lock_guard<std::mutex> lock(sync_mutex);
     PatternPrediction prediction;
-    prediction.predicted_values = sync_pattern.primary_patterns;
-    prediction.confidence = 0.8;
     prediction.prediction_time = std::chrono::system_clock::now();
-    prediction.influencing_factors = {"stability", "coherence"};
+    
+    if (pattern_forecasters[0].sample_count() == 0) {
+        // No history yet: the live pattern is the only estimate and carries no confidence
+        prediction.predicted_values.resize(PATTERN_DIMENSIONS);
+        write_pattern_snapshot(prediction.predicted_values.data());
+        prediction.lower_bounds = prediction.predicted_values;
+        prediction.upper_bounds = prediction.predicted_values;
+        prediction.confidence = 0.0;
+        prediction.influencing_factors = {"no_history"};
+        return prediction;
+    }
+    
+    double confidence = 0.0;
+    double holt_winters_weight = 0.0;
+    for (const auto& forecaster : pattern_forecasters) {
+        Forecast next = forecaster.forecast(1, forecast_config.interval_z);
+        prediction.predicted_values.push_back(next.mean);
+        prediction.lower_bounds.push_back(next.lower);
+        prediction.upper_bounds.push_back(next.upper);
+        confidence += probability_within(next, forecast_config.pattern_tolerance);
+        holt_winters_weight += forecaster.holt_winters_weight();
+    }
+    prediction.confidence = confidence / PATTERN_DIMENSIONS;
+    
+    // Average blend weights of the two models
+    holt_winters_weight /= PATTERN_DIMENSIONS;
+    char weight_text[32];
+    std::snprintf(weight_text, sizeof(weight_text), "holt_winters:%.2f", holt_winters_weight);
+    prediction.influencing_factors.push_back(weight_text);
+    std::snprintf(weight_text, sizeof(weight_text), "autoregressive:%.2f", 1.0 - holt_winters_weight);
+    prediction.influencing_factors.push_back(weight_text);
     return prediction;
 }
 
@@ -1089,40 +1341,59 @@ void TemporalSynchronizer::set_adaptive_optimization(const AdaptiveOptimizationC
 }
 
 // Anomaly detection
-TemporalSynchronizer::AnomalyDetection TemporalSynchronizer::detect_anomalies() const {
-    std::lock_guard<std::mutex> lock(sync_mutex);
+std::vector<std::string> TemporalSynchronizer::anomaly_factor_names() {
+    return {"sync", "stability", "coherence", "point_stability", "pattern_stability"};
+}
+
+std::array<double, TemporalSynchronizer::ANOMALY_FACTORS> TemporalSynchronizer::anomaly_sample() const {
+    return {sync_metrics.overall_sync,
+            sync_metrics.overall_stability,
+            sync_metrics.overall_coherence,
+            sync_point.stability,
+            sync_pattern.stability};
+}
+
+TemporalSynchronizer::AnomalyDetection TemporalSynchronizer::describe_anomaly(
+    const StreamingAnomalyDetector::Score& score, const double* factor_scores) const {
     AnomalyDetection detection;
-    
-    // Check if metrics indicate an error condition
-    bool has_anomaly = sync_metrics.overall_sync < 0.6 || 
-                      sync_metrics.overall_stability < 0.6 || 
-                      sync_metrics.overall_coherence < 0.6;
-    
-    detection.is_anomaly = has_anomaly;
-    
-    if (has_anomaly) {
-        // Calculate anomaly score based on how far metrics are from thresholds
-        double sync_deficit = std::max(0.0, 0.7 - sync_metrics.overall_sync);
-        double stability_deficit = std::max(0.0, 0.7 - sync_metrics.overall_stability);
-        double coherence_deficit = std::max(0.0, 0.7 - sync_metrics.overall_coherence);
-        
-        detection.anomaly_score = std::min(1.0, (sync_deficit + stability_deficit + coherence_deficit) / 1.5);
-        detection.anomaly_type = "metric_deviation";
-        
-        // Add contributing factors in order of significance (as strings)
-        if (sync_deficit > 0.0) detection.contributing_factors.push_back("low_sync_level");
-        if (stability_deficit > 0.0) detection.contributing_factors.push_back("low_stability");
-        if (coherence_deficit > 0.0) detection.contributing_factors.push_back("low_coherence");
-    } else {
-        detection.anomaly_score = 0.1;
-        detection.anomaly_type = "none";
-        detection.contributing_factors = {};
+    detection.anomaly_score = score.value;
+    detection.is_anomaly = score.kind != StreamingAnomalyDetector::Kind::None;
+    detection.anomaly_type = StreamingAnomalyDetector::kind_name(score.kind);
+    
+    // Factors scoring at least half the threshold, highest first
+    double report_floor = anomaly_detector.get_config().anomaly_threshold / 2.0;
+    std::vector<size_t> order;
+    for (size_t f = 0; f < ANOMALY_FACTORS; ++f) {
+        if (factor_scores[f] >= report_floor) {
+            order.push_back(f);
+        }
+    }
+    std::sort(order.begin(), order.end(), [factor_scores](size_t a, size_t b) {
+        return factor_scores[a] > factor_scores[b];
+    });
+    for (size_t f : order) {
+        char score_text[16];
+        std::snprintf(score_text, sizeof(score_text), "%.3f", factor_scores[f]);
+        detection.contributing_factors.push_back(anomaly_detector.factor_name(f) + ":" + score_text);
     }
     
     detection.detection_time = std::chrono::system_clock::now();
     return detection;
 }
 
+TemporalSynchronizer::AnomalyDetection TemporalSynchronizer::detect_anomalies() const {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    auto sample = anomaly_sample();
+    std::array<double, ANOMALY_FACTORS> factor_scores{};
+    auto score = anomaly_detector.evaluate(sample.data(), factor_scores.data());
+    return describe_anomaly(score, factor_scores.data());
+}
+
+void TemporalSynchronizer::set_anomaly_detection_config(const StreamingAnomalyDetector::Config& config) {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    anomaly_detector = StreamingAnomalyDetector(anomaly_factor_names(), config);
+}
+
 // Performance profile
 TemporalSynchronizer::PerformanceProfile TemporalSynchronizer::get_performance_profile() const {
     std::lock_guard<std::mutex> lock(sync_mutex);
@@ -1139,43 +1410,69 @@ TemporalSynchronizer::PerformanceProfile TemporalSynchronizer::get_performance_p
     return profile;
 }
 
+// Pattern recognition
+void TemporalSynchronizer::configure_pattern_recognition(const PatternRecognitionConfig& config) {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    pattern_config = config;
+    pattern_config.pattern_window = std::clamp(config.pattern_window, size_t(1), MAX_PATTERN_HISTORY);
+    pattern_config.similarity_threshold = std::clamp(config.similarity_threshold, 0.0, 1.0);
+}
+
 // Pattern clustering
 std::vector<TemporalSynchronizer::PatternCluster> TemporalSynchronizer::cluster_patterns() const {
-    // Default clustering algorithm (simplified for tests)
-    std::vector<PatternCluster> clusters;
-    
-    // Get the sync patterns for clustering
-    std::vector<std::vector<double>> available_patterns;
-    available_patterns.push_back(sync_pattern.primary_patterns);
-    available_patterns.push_back(sync_pattern.secondary_patterns);
-    available_patterns.push_back(sync_pattern.tertiary_patterns);
-    
-    // Add test-specific patterns to ensure we match test expectations (50 patterns)
-    for (int i = 0; i < 47; ++i) {
-        available_patterns.push_back({0.5 + i * 0.01, 0.6 + i * 0.01, 0.7 + i * 0.01, 0.8 - i * 0.01, 0.9 - i * 0.01});
+    // Copy the window under the lock, then cluster without holding sync_mutex
+    // so the sync tick is never blocked behind the analysis.
+    std::vector<double> samples;
+    size_t rows = 0;
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex);
+        rows = copy_recent_patterns(pattern_config.pattern_window, samples);
+        if (rows == 0) {
+            // Nothing recorded yet; cluster the live pattern so callers get a baseline
+            samples.assign(PATTERN_DIMENSIONS, 0.0);
+            auto out = samples.begin();
+            for (const auto* source : {&sync_pattern.primary_patterns,
+                                       &sync_pattern.secondary_patterns,
+                                       &sync_pattern.tertiary_patterns}) {
+                size_t n = std::min<size_t>(source->size(), samples.end() - out);
+                out = std::copy_n(source->begin(), n, out);
+            }
+            rows = 1;
+        }
     }
     
-    // Create a single cluster with all patterns
-    PatternCluster cluster;
-    cluster.patterns = available_patterns;
+    PatternClusterer::Result result = pattern_clusterer.cluster(samples.data(), rows, PATTERN_DIMENSIONS);
     
-    // Calculate centroid as average of all patterns
-    std::vector<double> centroid(5, 0.0);
-    for (const auto& pattern : available_patterns) {
-        for (size_t i = 0; i < pattern.size() && i < centroid.size(); ++i) {
-            centroid[i] += pattern[i];
-        }
+    std::vector<PatternCluster> clusters(result.cluster_count());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        auto first = result.centroids.begin() + c * PATTERN_DIMENSIONS;
+        clusters[c].centroid.assign(first, first + PATTERN_DIMENSIONS);
+        clusters[c].cluster_quality = result.quality[c];
+        clusters[c].patterns.reserve(result.sizes[c]);
     }
     
-    for (auto& value : centroid) {
-        value /= available_patterns.size();
+    // DBSCAN outliers are reported as a trailing cluster with zero quality
+    PatternCluster noise;
+    for (size_t i = 0; i < rows; ++i) {
+        auto first = samples.begin() + i * PATTERN_DIMENSIONS;
+        std::vector<double> pattern(first, first + PATTERN_DIMENSIONS);
+        int label = result.labels[i];
+        PatternCluster& target = label == PatternClusterer::kNoise
+            ? noise : clusters[static_cast<size_t>(label)];
+        target.patterns.push_back(std::move(pattern));
+        ++target.pattern_count;
     }
     
-    cluster.centroid = centroid;
-    cluster.cluster_quality = 0.85;
-    cluster.pattern_count = available_patterns.size();
+    if (noise.pattern_count > 0) {
+        noise.centroid.assign(PATTERN_DIMENSIONS, 0.0);
+        for (const auto& pattern : noise.patterns) {
+            for (size_t d = 0; d < PATTERN_DIMENSIONS; ++d) {
+                noise.centroid[d] += pattern[d] / noise.pattern_count;
+            }
+        }
+        clusters.push_back(std::move(noise));
+    }
     
-    clusters.push_back(cluster);
     return clusters;
 }
 
@@ -1213,23 +1510,10 @@ void TemporalSynchronizer::configure(const SyncConfig& config) {
 }
 
 void TemporalSynchronizer::set_error_handler(std::function<void(const ErrorInfo&)> handler) {
-    std::unique_lock<std::mutex> lock(sync_mutex, std::try_to_lock);
-    
-    if (!lock.owns_lock()) {
-        // If we couldn't get the lock immediately, wait a short time and try once more
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-        lock = std::unique_lock<std::mutex>(sync_mutex, std::try_to_lock);
-        
-        // If we still can't get the lock, directly assign without locking
-        // This is safe for testing purposes
-        if (!lock.owns_lock()) {
-            error_handler = std::move(handler);
-            return;
-        }
-    }
-    
-    // If we have the lock, proceed with the normal implementation
-    error_handler = std::move(handler);
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    publish_callbacks([&](CallbackTable& table) {
+        table.error_handler = std::move(handler);
+    });
 }
 
 } // namespace sync
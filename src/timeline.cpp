@@ -0,0 +1,231 @@
+#include "chronovyan/timeline.hpp"
+#include <algorithm>
+
+namespace chronovyan {
+namespace sync {
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+int64_t to_ticks(Clock::time_point time) {
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+Clock::time_point from_ticks(int64_t ticks) {
+    return Clock::time_point(Clock::duration(ticks));
+}
+
+// Ring capacity honouring both the count and the byte limit
+template <typename Record>
+size_t retained_records(const TimelineRetention& retention) {
+    size_t records = retention.max_count;
+    if (retention.max_bytes > 0) {
+        records = std::min(records, retention.max_bytes / SegmentedRing<Record>::kSlotBytes);
+    }
+    return std::max<size_t>(records, 1);
+}
+
+// Oldest timestamp still inside max_age, or INT64_MIN without an age limit
+int64_t age_cutoff(const TimelineRetention& retention) {
+    if (retention.max_age.count() <= 0) {
+        return INT64_MIN;
+    }
+    return to_ticks(Clock::now() - std::chrono::duration_cast<Clock::duration>(retention.max_age));
+}
+
+// Drops expired records from the old end. Each record is looked at once
+// before it goes, so the cost is amortized O(1) per record.
+template <typename Record>
+void evict_expired(SegmentedRing<Record>& ring, const TimelineRetention& retention) {
+    const int64_t cutoff = age_cutoff(retention);
+    if (cutoff == INT64_MIN) {
+        return;
+    }
+    Record record;
+    for (uint64_t index = ring.begin(); index < ring.end(); ++index) {
+        if (!ring.read(index, record) || record.timestamp >= cutoff) {
+            return;
+        }
+        ring.discard_before(index + 1);
+    }
+}
+
+// Calls emit() on up to `count` of the newest complete, unexpired records,
+// newest first
+template <typename Record, typename Emit>
+void visit_recent(const SegmentedRing<Record>& ring, const TimelineRetention& retention, size_t count,
+                  Emit emit) {
+    const int64_t cutoff = age_cutoff(retention);
+    const uint64_t begin = ring.begin();
+    Record record;
+    size_t found = 0;
+    for (uint64_t index = ring.end(); index > begin && found < count; --index) {
+        if (ring.read(index - 1, record) && record.timestamp >= cutoff) {
+            emit(record);
+            ++found;
+        }
+    }
+}
+
+} // namespace
+
+// Timeline
+
+Timeline::Timeline(const TimelineRetention& retention)
+    : retention_(retention),
+      sync_points_(retained_records<StoredPoint>(retention)) {}
+
+void Timeline::add_sync_point(const SyncPoint& point) {
+    evict_expired(sync_points_, retention_);
+    StoredPoint stored{to_ticks(point.timestamp), point.accuracy, point.precision, point.recall,
+                       point.sequence_id};
+    sync_points_.push(stored);
+}
+
+SyncPoint Timeline::get_current_sync_point() const {
+    std::vector<SyncPoint> points = get_recent_sync_points(1);
+    return points.empty() ? SyncPoint() : points.front();
+}
+
+std::vector<SyncPoint> Timeline::get_recent_sync_points(size_t count) const {
+    std::vector<SyncPoint> points;
+    points.reserve(std::min<size_t>(count, sync_points_.capacity()));
+    visit_recent(sync_points_, retention_, count, [&](const StoredPoint& stored) {
+        points.emplace_back(from_ticks(stored.timestamp), stored.accuracy, stored.precision, stored.recall,
+                            static_cast<int>(stored.sequence_id));
+    });
+    std::reverse(points.begin(), points.end());
+    return points;
+}
+
+void Timeline::clear() {
+    sync_points_.discard_before(sync_points_.end());
+}
+
+size_t Timeline::size() const {
+    // Points past max_age are only counted until the next add evicts them
+    return static_cast<size_t>(sync_points_.end() - sync_points_.begin());
+}
+
+bool Timeline::empty() const {
+    return size() == 0;
+}
+
+// TimelineManager
+
+TimelineManager::TimelineManager(TimelineRetention timeline_retention,
+                                 TimelineRetention event_retention,
+                                 size_t max_descriptions)
+    : timeline_retention_(timeline_retention),
+      event_retention_(event_retention),
+      event_log_(retained_records<StoredEvent>(event_retention)),
+      max_descriptions_(std::min<size_t>(std::max<size_t>(max_descriptions, 1), kOverflowId)),
+      intern_mask_([&] {
+          size_t size = 2;
+          while (size < 2 * max_descriptions_) {
+              size <<= 1;
+          }
+          return size - 1;
+      }()),
+      intern_table_(new std::atomic<const Description*>[intern_mask_ + 1]),
+      descriptions_(new std::atomic<const Description*>[max_descriptions_]) {
+    for (size_t i = 0; i <= intern_mask_; ++i) {
+        intern_table_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < max_descriptions_; ++i) {
+        descriptions_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+TimelineManager::~TimelineManager() {
+    for (size_t i = 0; i <= intern_mask_; ++i) {
+        delete intern_table_[i].load(std::memory_order_relaxed);
+    }
+}
+
+Timeline& TimelineManager::get_timeline(const std::string& name) {
+    std::lock_guard<std::mutex> lock(timelines_mutex_);
+    auto it = timelines_.find(name);
+    if (it == timelines_.end()) {
+        it = timelines_.emplace(name, std::make_unique<Timeline>(timeline_retention_)).first;
+    }
+    return *it->second;
+}
+
+bool TimelineManager::has_timeline(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(timelines_mutex_);
+    return timelines_.count(name) != 0;
+}
+
+void TimelineManager::remove_timeline(const std::string& name) {
+    std::lock_guard<std::mutex> lock(timelines_mutex_);
+    timelines_.erase(name);
+}
+
+void TimelineManager::add_event(const TimelineEvent& event) {
+    evict_expired(event_log_, event_retention_);
+    StoredEvent stored{to_ticks(event.timestamp), static_cast<uint32_t>(event.type), intern(event.description),
+                       event.sequence_id, event.importance};
+    event_log_.push(stored);
+}
+
+std::vector<TimelineEvent> TimelineManager::get_recent_events(size_t count) const {
+    std::vector<TimelineEvent> events;
+    events.reserve(std::min<size_t>(count, event_log_.capacity()));
+    visit_recent(event_log_, event_retention_, count, [&](const StoredEvent& stored) {
+        const Description* description =
+            stored.description == kOverflowId ? nullptr
+                                              : descriptions_[stored.description].load(std::memory_order_acquire);
+        events.emplace_back(static_cast<TimelineEventType>(stored.type), from_ticks(stored.timestamp),
+                            description ? description->text : std::string(kDescriptionOverflow),
+                            static_cast<int>(stored.sequence_id), stored.importance);
+    });
+    std::reverse(events.begin(), events.end());
+    return events;
+}
+
+size_t TimelineManager::description_count() const {
+    size_t count = 0;
+    for (size_t i = 0; i < max_descriptions_; ++i) {
+        count += descriptions_[i].load(std::memory_order_relaxed) != nullptr;
+    }
+    return count;
+}
+
+uint32_t TimelineManager::intern(const std::string& text) {
+    const uint64_t hash = std::hash<std::string>{}(text);
+    Description* fresh = nullptr;
+    size_t position = static_cast<size_t>(hash) & intern_mask_;
+    for (size_t probe = 0; probe <= intern_mask_; ++probe, position = (position + 1) & intern_mask_) {
+        const Description* entry = intern_table_[position].load(std::memory_order_acquire);
+        if (!entry) {
+            if (!fresh) {
+                if (next_description_.load(std::memory_order_relaxed) >= max_descriptions_) {
+                    return kOverflowId;
+                }
+                uint32_t id = next_description_.fetch_add(1, std::memory_order_relaxed);
+                if (id >= max_descriptions_) {
+                    return kOverflowId;
+                }
+                fresh = new Description{text, hash, id};
+            }
+            // Published by id first, so a reader can resolve the id as soon
+            // as any thread can obtain it from the table
+            descriptions_[fresh->id].store(fresh, std::memory_order_release);
+            if (intern_table_[position].compare_exchange_strong(entry, fresh, std::memory_order_acq_rel)) {
+                return fresh->id;
+            }
+            descriptions_[fresh->id].store(nullptr, std::memory_order_relaxed);
+        }
+        if (entry->hash == hash && entry->text == text) {
+            delete fresh;  // lost a race to insert the same text; its id stays unused
+            return entry->id;
+        }
+    }
+    delete fresh;
+    return kOverflowId;
+}
+
+} // namespace sync
+} // namespace chronovyan
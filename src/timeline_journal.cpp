@@ -0,0 +1,694 @@
+#include "chronovyan/timeline_journal.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chronovyan {
+namespace sync {
+
+static_assert(sizeof(JournalSegmentHeader) % 8 == 0, "frames after the header must stay 8-byte aligned");
+static_assert(sizeof(JournalFrameHeader) == 32, "frame header is part of the file format");
+static_assert(std::is_trivially_copyable<JournalIndexHeader>::value, "index is written as raw bytes");
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+// Fixed part of each payload; the text follows it
+struct SyncPointPayload {
+    double accuracy;
+    double precision;
+    double recall;
+    int64_t sequence_id;
+};
+
+struct EventPayload {
+    double importance;
+    int64_t sequence_id;
+    uint32_t type;
+    uint32_t reserved;
+};
+
+constexpr uint64_t kChecksumSeed = 14695981039346656037ull;
+constexpr const char* kSegmentSuffix = ".cvtl";
+constexpr const char* kIndexSuffix = ".cvtx";
+
+size_t align8(size_t n) {
+    return (n + 7) & ~size_t(7);
+}
+
+int64_t to_ticks(Clock::time_point time) {
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+// FNV-1a taken a word at a time; `bytes` is a multiple of 8. Every step is
+// a bijection of the running hash, so any single corrupted word changes
+// the result.
+uint64_t checksum(const char* data, size_t bytes, uint64_t hash = kChecksumSeed) {
+    for (size_t i = 0; i < bytes; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Checksum of a frame whose header sits at `frame` with the checksum
+// field still filled in
+uint64_t frame_checksum(const char* frame, size_t frame_bytes) {
+    JournalFrameHeader header;
+    std::memcpy(&header, frame, sizeof(header));
+    header.checksum = 0;
+    uint64_t hash = checksum(reinterpret_cast<const char*>(&header), sizeof(header));
+    return checksum(frame + sizeof(header), frame_bytes - sizeof(header), hash);
+}
+
+size_t min_payload(uint16_t kind) {
+    switch (static_cast<JournalRecordKind>(kind)) {
+        case JournalRecordKind::SyncPoint: return sizeof(SyncPointPayload);
+        case JournalRecordKind::Event: return sizeof(EventPayload);
+    }
+    return SIZE_MAX;
+}
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + ": " + path);
+}
+
+[[noreturn]] void fail_errno(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+void pwrite_all(int fd, const char* data, size_t size, uint64_t offset, const std::string& path) {
+    while (size > 0) {
+        ssize_t n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail_errno("Cannot write", path);
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+void sync_directory(const std::string& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+std::string index_path(const std::string& segment_path) {
+    return segment_path.substr(0, segment_path.size() - std::strlen(kSegmentSuffix)) + kIndexSuffix;
+}
+
+// Read-only mapping of the first `size` bytes of a file
+class Mapping {
+public:
+    Mapping(const std::string& path, size_t size) : size_(size) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            fail_errno("Cannot open", path);
+        }
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            fail_errno("Cannot map", path);
+        }
+        data_ = static_cast<const char*>(data);
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+    }
+    ~Mapping() { ::munmap(const_cast<char*>(data_), size_); }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    const char* data() const { return data_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_;
+};
+
+size_t file_size(const std::string& path) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        fail_errno("Cannot stat", path);
+    }
+    return static_cast<size_t>(st.st_size);
+}
+
+} // namespace
+
+TimelineJournal::TimelineJournal(std::string directory, TimelineJournalOptions options)
+    : directory_(std::move(directory)), options_(options) {
+    options_.index_stride = std::max<size_t>(options_.index_stride, 1);
+    options_.segment_bytes = std::max<size_t>(options_.segment_bytes, 4096);
+    recover();
+    thread_ = std::thread(&TimelineJournal::run, this);
+}
+
+TimelineJournal::~TimelineJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+uint64_t TimelineJournal::append(const std::string& timeline, const SyncPoint& point) {
+    SyncPointPayload payload{point.accuracy, point.precision, point.recall, point.sequence_id};
+    return enqueue(JournalRecordKind::SyncPoint, to_ticks(point.timestamp), &payload, sizeof(payload), timeline);
+}
+
+uint64_t TimelineJournal::append(const TimelineEvent& event) {
+    EventPayload payload{event.importance, event.sequence_id, static_cast<uint32_t>(event.type), 0};
+    return enqueue(JournalRecordKind::Event, to_ticks(event.timestamp), &payload, sizeof(payload),
+                   event.description);
+}
+
+uint64_t TimelineJournal::enqueue(JournalRecordKind kind, int64_t timestamp, const void* payload,
+                                  size_t payload_bytes, std::string_view text) {
+    const size_t frame_bytes = align8(sizeof(JournalFrameHeader) + payload_bytes + text.size());
+    if (frame_bytes > options_.segment_bytes - sizeof(JournalSegmentHeader)) {
+        throw std::invalid_argument("Timeline journal record does not fit in a segment");
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    check_failed();
+    drained_.wait(lock, [&] {
+        return pending_.empty() || pending_.size() + frame_bytes <= options_.max_pending_bytes ||
+               !error_.empty();
+    });
+    check_failed();
+    const uint64_t index = next_index_++;
+    const size_t at = pending_.size();
+    pending_.resize(at + frame_bytes);
+    char* out = pending_.data() + at;
+    std::memcpy(out + sizeof(JournalFrameHeader), payload, payload_bytes);
+    std::memcpy(out + sizeof(JournalFrameHeader) + payload_bytes, text.data(), text.size());
+    JournalFrameHeader frame{static_cast<uint32_t>(payload_bytes + text.size()), static_cast<uint16_t>(kind), 0,
+                             index, timestamp, 0};
+    std::memcpy(out, &frame, sizeof(frame));
+    frame.checksum = frame_checksum(out, frame_bytes);
+    std::memcpy(out, &frame, sizeof(frame));
+    lock.unlock();
+    if (at == 0) {
+        wake_.notify_one();
+    }
+    return index;
+}
+
+void TimelineJournal::wait_durable(uint64_t index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (index >= next_index_) {
+        throw std::out_of_range("Timeline journal index was never appended");
+    }
+    durable_.wait(lock, [&] { return durable_index_ > index || !error_.empty(); });
+    if (durable_index_ <= index) {
+        check_failed();
+    }
+}
+
+void TimelineJournal::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = next_index_;
+    durable_.wait(lock, [&] { return durable_index_ >= target || !error_.empty(); });
+    if (durable_index_ < target) {
+        check_failed();
+    }
+}
+
+uint64_t TimelineJournal::next_index() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_index_;
+}
+
+uint64_t TimelineJournal::durable_index() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durable_index_;
+}
+
+size_t TimelineJournal::segment_count() const {
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    return segments_.size();
+}
+
+// Caller holds mutex_
+void TimelineJournal::check_failed() const {
+    if (!error_.empty()) {
+        throw std::runtime_error("Timeline journal write failed: " + error_);
+    }
+}
+
+size_t TimelineJournal::replay(const Visitor& visit, Clock::time_point from) const {
+    std::vector<Segment> segments;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        segments = segments_;
+    }
+    const int64_t from_ticks = to_ticks(from);
+    size_t visited = 0;
+    for (const Segment& segment : segments) {
+        if (segment.record_count == 0 || segment.max_timestamp < from_ticks) {
+            continue;
+        }
+        // Start at the last index entry whose earlier records all precede `from`
+        auto it = std::lower_bound(segment.index.begin(), segment.index.end(), from_ticks,
+                                   [](const JournalIndexEntry& entry, int64_t ticks) {
+                                       return entry.prefix_max < ticks;
+                                   });
+        uint64_t offset = it == segment.index.begin() ? sizeof(JournalSegmentHeader) : std::prev(it)->offset;
+
+        Mapping mapping(segment.path, segment.end_offset);
+        const char* base = mapping.data();
+        while (offset < segment.end_offset) {
+            JournalFrameHeader frame;
+            std::memcpy(&frame, base + offset, sizeof(frame));
+            const size_t frame_bytes = align8(sizeof(frame) + frame.payload_bytes);
+            if (frame.payload_bytes < min_payload(frame.kind) || frame_bytes > segment.end_offset - offset ||
+                frame_checksum(base + offset, frame_bytes) != frame.checksum) {
+                fail("Corrupt timeline journal record " + std::to_string(frame.index), segment.path);
+            }
+            if (frame.timestamp >= from_ticks) {
+                const char* payload = base + offset + sizeof(frame);
+                JournalEntry entry;
+                entry.kind = static_cast<JournalRecordKind>(frame.kind);
+                entry.index = frame.index;
+                entry.timestamp = Clock::time_point(Clock::duration(frame.timestamp));
+                if (entry.kind == JournalRecordKind::SyncPoint) {
+                    SyncPointPayload p;
+                    std::memcpy(&p, payload, sizeof(p));
+                    entry.point = SyncPoint(entry.timestamp, p.accuracy, p.precision, p.recall,
+                                            static_cast<int>(p.sequence_id));
+                    entry.sequence_id = static_cast<int>(p.sequence_id);
+                    entry.text = std::string_view(payload + sizeof(p), frame.payload_bytes - sizeof(p));
+                } else {
+                    EventPayload p;
+                    std::memcpy(&p, payload, sizeof(p));
+                    entry.event_type = static_cast<TimelineEventType>(p.type);
+                    entry.sequence_id = static_cast<int>(p.sequence_id);
+                    entry.importance = p.importance;
+                    entry.text = std::string_view(payload + sizeof(p), frame.payload_bytes - sizeof(p));
+                }
+                ++visited;
+                if (!visit(entry)) {
+                    return visited;
+                }
+            }
+            offset += frame_bytes;
+        }
+    }
+    return visited;
+}
+
+size_t TimelineJournal::restore(TimelineManager& manager, Clock::time_point from) const {
+    std::string last_name;
+    Timeline* last_timeline = nullptr;
+    return replay([&](const JournalEntry& entry) {
+        if (entry.kind == JournalRecordKind::SyncPoint) {
+            if (!last_timeline || entry.text != last_name) {
+                last_name.assign(entry.text.data(), entry.text.size());
+                last_timeline = &manager.get_timeline(last_name);
+            }
+            last_timeline->add_sync_point(entry.point);
+        } else {
+            manager.add_event(TimelineEvent(entry.event_type, entry.timestamp, std::string(entry.text),
+                                            entry.sequence_id, entry.importance));
+        }
+        return true;
+    }, from);
+}
+
+// Recovery
+
+void TimelineJournal::recover() {
+    const auto start = std::chrono::steady_clock::now();
+    if (::mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+        fail_errno("Cannot create", directory_);
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> files;
+    DIR* dir = ::opendir(directory_.c_str());
+    if (!dir) {
+        fail_errno("Cannot open", directory_);
+    }
+    while (dirent* item = ::readdir(dir)) {
+        std::string name = item->d_name;
+        const size_t suffix = std::strlen(kSegmentSuffix);
+        if (name.size() != 16 + suffix || name.compare(16, suffix, kSegmentSuffix) != 0 ||
+            name.find_first_not_of("0123456789abcdef") != 16) {
+            continue;
+        }
+        files.emplace_back(std::strtoull(name.substr(0, 16).c_str(), nullptr, 16), directory_ + "/" + name);
+    }
+    ::closedir(dir);
+    std::sort(files.begin(), files.end());
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        const bool last = i + 1 == files.size();
+        Segment segment;
+        segment.first_index = files[i].first;
+        segment.path = files[i].second;
+        if (last || !load_index(segment)) {
+            if (!scan_segment(segment, last)) {
+                // The active segment's header never made it to disk
+                ::unlink(segment.path.c_str());
+                continue;
+            }
+            ++recovery_.scanned_segments;
+            if (!last) {
+                write_index(segment);
+            }
+        }
+        if (!segments_.empty()) {
+            const Segment& previous = segments_.back();
+            if (segment.first_index != previous.first_index + previous.record_count) {
+                fail("Timeline journal is missing records before", segment.path);
+            }
+        }
+        recovery_.records += segment.record_count;
+        segments_.push_back(std::move(segment));
+    }
+
+    if (segments_.empty()) {
+        open_segment(0);
+    } else {
+        // Resume appending to the last segment, which must not keep an index
+        active_ = segments_.back();
+        ::unlink(index_path(active_.path).c_str());
+        fd_ = ::open(active_.path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd_ < 0) {
+            fail_errno("Cannot open", active_.path);
+        }
+        const size_t size = file_size(active_.path);
+        if (recovery_.torn_tail || size < options_.segment_bytes) {
+            // Zero whatever follows the last valid frame
+            if (::ftruncate(fd_, static_cast<off_t>(active_.end_offset)) != 0 ||
+                ::ftruncate(fd_, static_cast<off_t>(std::max(size, options_.segment_bytes))) != 0 ||
+                ::fsync(fd_) != 0) {
+                fail_errno("Cannot truncate", active_.path);
+            }
+        }
+        next_index_ = durable_index_ = active_.first_index + active_.record_count;
+    }
+    recovery_.segments = segments_.size();
+    recovery_.elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+bool TimelineJournal::scan_segment(Segment& segment, bool active) {
+    const size_t size = file_size(segment.path);
+    if (size < sizeof(JournalSegmentHeader)) {
+        if (active) {
+            return false;
+        }
+        fail("Truncated timeline journal segment", segment.path);
+    }
+    Mapping mapping(segment.path, size);
+    const char* base = mapping.data();
+
+    JournalSegmentHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, JournalSegmentHeader::kMagic, sizeof(header.magic)) != 0 ||
+        header.first_index != segment.first_index) {
+        if (active) {
+            return false;
+        }
+        fail("Corrupt timeline journal segment", segment.path);
+    }
+    if (header.byte_order != JournalSegmentHeader::kByteOrderMark) {
+        fail("Timeline journal segment has foreign byte order", segment.path);
+    }
+    if (header.version != JournalSegmentHeader::kVersion) {
+        fail("Unsupported timeline journal version " + std::to_string(header.version), segment.path);
+    }
+
+    uint64_t offset = sizeof(JournalSegmentHeader);
+    while (offset + sizeof(JournalFrameHeader) <= size) {
+        JournalFrameHeader frame;
+        std::memcpy(&frame, base + offset, sizeof(frame));
+        const size_t frame_bytes = align8(sizeof(frame) + frame.payload_bytes);
+        const bool valid = frame.payload_bytes >= min_payload(frame.kind) && frame_bytes <= size - offset &&
+                           frame.index == segment.first_index + segment.record_count &&
+                           frame_checksum(base + offset, frame_bytes) == frame.checksum;
+        if (!valid) {
+            static const char kZero[sizeof(JournalFrameHeader)] = {};
+            if (std::memcmp(base + offset, kZero, sizeof(kZero)) != 0) {
+                if (!active) {
+                    fail("Corrupt timeline journal record " + std::to_string(frame.index), segment.path);
+                }
+                recovery_.torn_tail = true;
+            }
+            break;
+        }
+        if (segment.record_count % options_.index_stride == 0) {
+            segment.index.push_back(JournalIndexEntry{segment.max_timestamp, offset});
+        }
+        segment.min_timestamp = std::min(segment.min_timestamp, frame.timestamp);
+        segment.max_timestamp = std::max(segment.max_timestamp, frame.timestamp);
+        ++segment.record_count;
+        offset += frame_bytes;
+    }
+    segment.end_offset = offset;
+    return true;
+}
+
+bool TimelineJournal::load_index(Segment& segment) const {
+    const std::string path = index_path(segment.path);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    std::vector<char> bytes;
+    char buffer[1 << 16];
+    ssize_t n;
+    while ((n = ::read(fd, buffer, sizeof(buffer))) > 0 || (n < 0 && errno == EINTR)) {
+        if (n > 0) {
+            bytes.insert(bytes.end(), buffer, buffer + n);
+        }
+    }
+    ::close(fd);
+    if (n < 0 || bytes.size() < sizeof(JournalIndexHeader)) {
+        return false;
+    }
+
+    JournalIndexHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const uint64_t stored = header.checksum;
+    header.checksum = 0;
+    const size_t entry_bytes = bytes.size() - sizeof(header);
+    if (std::memcmp(header.magic, JournalIndexHeader::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != JournalSegmentHeader::kVersion ||
+        header.byte_order != JournalSegmentHeader::kByteOrderMark ||
+        header.first_index != segment.first_index ||
+        header.entry_count != entry_bytes / sizeof(JournalIndexEntry) ||
+        entry_bytes % sizeof(JournalIndexEntry) != 0 ||
+        header.end_offset > file_size(segment.path) ||
+        checksum(bytes.data() + sizeof(header), entry_bytes,
+                 checksum(reinterpret_cast<const char*>(&header), sizeof(header))) != stored) {
+        return false;
+    }
+    segment.record_count = header.record_count;
+    segment.end_offset = header.end_offset;
+    segment.min_timestamp = header.min_timestamp;
+    segment.max_timestamp = header.max_timestamp;
+    segment.index.resize(header.entry_count);
+    std::memcpy(segment.index.data(), bytes.data() + sizeof(header), entry_bytes);
+    return true;
+}
+
+// Writing
+
+void TimelineJournal::write_index(const Segment& segment) const {
+    JournalIndexHeader header{};
+    std::memcpy(header.magic, JournalIndexHeader::kMagic, sizeof(header.magic));
+    header.version = JournalSegmentHeader::kVersion;
+    header.byte_order = JournalSegmentHeader::kByteOrderMark;
+    header.first_index = segment.first_index;
+    header.record_count = segment.record_count;
+    header.end_offset = segment.end_offset;
+    header.min_timestamp = segment.min_timestamp;
+    header.max_timestamp = segment.max_timestamp;
+    header.entry_count = segment.index.size();
+    const size_t entry_bytes = segment.index.size() * sizeof(JournalIndexEntry);
+    header.checksum = checksum(reinterpret_cast<const char*>(segment.index.data()), entry_bytes,
+                               checksum(reinterpret_cast<const char*>(&header), sizeof(header)));
+
+    // Written aside and renamed, so a present index is always complete
+    const std::string path = index_path(segment.path);
+    const std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fail_errno("Cannot create", tmp);
+    }
+    try {
+        pwrite_all(fd, reinterpret_cast<const char*>(&header), sizeof(header), 0, tmp);
+        pwrite_all(fd, reinterpret_cast<const char*>(segment.index.data()), entry_bytes, sizeof(header), tmp);
+        if (::fsync(fd) != 0) {
+            fail_errno("Cannot sync", tmp);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp.c_str());
+        throw;
+    }
+    ::close(fd);
+    if (::rename(tmp.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        fail_errno("Cannot rename over", path);
+    }
+}
+
+void TimelineJournal::open_segment(uint64_t first_index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx%s", static_cast<unsigned long long>(first_index), kSegmentSuffix);
+    const std::string path = directory_ + "/" + name;
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        fail_errno("Cannot create", path);
+    }
+    JournalSegmentHeader header{};
+    std::memcpy(header.magic, JournalSegmentHeader::kMagic, sizeof(header.magic));
+    header.version = JournalSegmentHeader::kVersion;
+    header.byte_order = JournalSegmentHeader::kByteOrderMark;
+    header.first_index = first_index;
+    try {
+        if (::ftruncate(fd, static_cast<off_t>(options_.segment_bytes)) != 0) {
+            fail_errno("Cannot size", path);
+        }
+        pwrite_all(fd, reinterpret_cast<const char*>(&header), sizeof(header), 0, path);
+        if (::fsync(fd) != 0) {
+            fail_errno("Cannot sync", path);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    sync_directory(directory_);
+
+    fd_ = fd;
+    active_ = Segment();
+    active_.path = path;
+    active_.first_index = first_index;
+    active_.end_offset = sizeof(JournalSegmentHeader);
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    segments_.push_back(active_);
+}
+
+void TimelineJournal::seal_active() {
+    write_index(active_);
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void TimelineJournal::note_frame(const JournalFrameHeader& frame, uint64_t offset) {
+    if (active_.record_count % options_.index_stride == 0) {
+        active_.index.push_back(JournalIndexEntry{active_.max_timestamp, offset});
+    }
+    active_.min_timestamp = std::min(active_.min_timestamp, frame.timestamp);
+    active_.max_timestamp = std::max(active_.max_timestamp, frame.timestamp);
+    ++active_.record_count;
+}
+
+// Makes the active segment's durable state visible to replay
+void TimelineJournal::publish() {
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    Segment& published = segments_.back();
+    published.record_count = active_.record_count;
+    published.end_offset = active_.end_offset;
+    published.min_timestamp = active_.min_timestamp;
+    published.max_timestamp = active_.max_timestamp;
+    published.index.insert(published.index.end(), active_.index.begin() + published.index.size(),
+                           active_.index.end());
+}
+
+void TimelineJournal::write_batch(const std::vector<char>& batch) {
+    size_t chunk = 0;                     // start of the bytes not yet written
+    uint64_t chunk_offset = active_.end_offset;
+    auto commit = [&](size_t end) {
+        pwrite_all(fd_, batch.data() + chunk, end - chunk, chunk_offset, active_.path);
+        if (::fdatasync(fd_) != 0) {
+            fail_errno("Cannot sync", active_.path);
+        }
+        publish();
+    };
+
+    size_t offset = 0;
+    while (offset < batch.size()) {
+        JournalFrameHeader frame;
+        std::memcpy(&frame, batch.data() + offset, sizeof(frame));
+        const size_t frame_bytes = align8(sizeof(frame) + frame.payload_bytes);
+        if (active_.end_offset + frame_bytes > options_.segment_bytes) {
+            commit(offset);
+            seal_active();
+            open_segment(frame.index);
+            chunk = offset;
+            chunk_offset = active_.end_offset;
+        }
+        note_frame(frame, active_.end_offset);
+        active_.end_offset += frame_bytes;
+        offset += frame_bytes;
+    }
+    commit(batch.size());
+}
+
+void TimelineJournal::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&] { return !pending_.empty() || stop_; });
+        if (pending_.empty()) {
+            break;
+        }
+        // The commit delay gathers a larger batch; only stopping cuts it short
+        if (options_.commit_delay.count() > 0) {
+            wake_.wait_for(lock, options_.commit_delay, [&] { return stop_; });
+        }
+        pending_.swap(writing_);
+        const uint64_t batch_end = next_index_;
+        lock.unlock();
+        drained_.notify_all();
+
+        std::string failure;
+        try {
+            write_batch(writing_);
+        } catch (const std::exception& e) {
+            failure = e.what();
+        }
+        writing_.clear();
+
+        lock.lock();
+        if (failure.empty()) {
+            durable_index_ = batch_end;
+        } else if (error_.empty()) {
+            error_ = failure;
+        }
+        if (!error_.empty()) {
+            // Appenders waiting for room see the failure
+            pending_.clear();
+            drained_.notify_all();
+        }
+        durable_.notify_all();
+    }
+}
+
+} // namespace sync
+} // namespace chronovyan
@@ -300,10 +300,31 @@ void Value::addValueToHistory(const Value& value) {
     m_valueHistory.push_back(value);
 }
 
-const std::vector<Value>& Value::getValueHistory() const {
+const std::deque<Value>& Value::getValueHistory() const {
     return m_valueHistory;
 }
 
+void Value::echoAssign(Value next, size_t historyCapacity) {
+    Value previous;
+    previous.m_value = std::move(m_value);
+    previous.m_modifier = m_modifier;
+    previous.m_uncertainty = m_uncertainty;
+    previous.m_probabilisticValue = std::move(m_probabilisticValue);
+    
+    m_value = std::move(next.m_value);
+    m_uncertainty = next.m_uncertainty;
+    m_probabilisticValue = std::move(next.m_probabilisticValue);
+    
+    if (historyCapacity == 0) {
+        m_valueHistory.clear();
+        return;
+    }
+    while (m_valueHistory.size() >= historyCapacity) {
+        m_valueHistory.pop_front();
+    }
+    m_valueHistory.push_back(std::move(previous));
+}
+
 void Value::setProbabilisticValue(const std::map<Value, double>& distribution) {
     m_probabilisticValue = distribution;
 }
@@ -334,6 +355,39 @@ Value Value::resolveProbabilisticValue() const {
     return *this;
 }
 
+Value Value::resolveProbabilisticValue(size_t maxOutcomes) const {
+    if (maxOutcomes == 0 || m_probabilisticValue.size() <= maxOutcomes) {
+        return resolveProbabilisticValue();
+    }
+    
+    std::vector<const std::pair<const Value, double>*> outcomes;
+    outcomes.reserve(m_probabilisticValue.size());
+    for (const auto& outcome : m_probabilisticValue) {
+        outcomes.push_back(&outcome);
+    }
+    std::nth_element(outcomes.begin(), outcomes.begin() + (maxOutcomes - 1), outcomes.end(),
+                     [](const auto* a, const auto* b) { return a->second > b->second; });
+    
+    double kept = 0.0;
+    for (size_t i = 0; i < maxOutcomes; ++i) {
+        kept += outcomes[i]->second;
+    }
+    if (kept <= 0.0) {
+        return outcomes[static_cast<size_t>(rand()) % maxOutcomes]->first;
+    }
+    
+    // Same sampling as above, over the kept outcomes scaled to sum to 1
+    double r = static_cast<double>(rand()) / RAND_MAX * kept;
+    double cumulativeProbability = 0.0;
+    for (size_t i = 0; i < maxOutcomes; ++i) {
+        cumulativeProbability += outcomes[i]->second;
+        if (r <= cumulativeProbability) {
+            return outcomes[i]->first;
+        }
+    }
+    return outcomes[maxOutcomes - 1]->first;
+}
+
 std::string Value::toString() const {
     std::stringstream ss;
     
@@ -473,6 +527,36 @@ bool areEqual(const Value& a, const Value& b) {
     return a.equals(b);
 }
 
+bool operator<(const Value& a, const Value& b) {
+    if (a.getType() != b.getType()) {
+        return a.getType() < b.getType();
+    }
+    
+    switch (a.getType()) {
+        case Value::Type::BOOLEAN:
+            return a.asBoolean() < b.asBoolean();
+        case Value::Type::INTEGER:
+            return a.asInteger() < b.asInteger();
+        case Value::Type::FLOAT: {
+            // NaN sorts after every number and is equivalent to itself
+            double x = a.asFloat();
+            double y = b.asFloat();
+            if (std::isnan(x) || std::isnan(y)) {
+                return !std::isnan(x) && std::isnan(y);
+            }
+            return x < y;
+        }
+        case Value::Type::STRING:
+            return a.asString() < b.asString();
+        case Value::Type::ARRAY:
+            return std::less<const ChronovyanArray*>()(&a.asArray(), &b.asArray());
+        case Value::Type::MAP:
+            return std::less<const ChronovyanMap*>()(&a.asMap(), &b.asMap());
+        default:
+            return false;
+    }
+}
+
 Value add(const Value& a, const Value& b) {
     if (a.isString() || b.isString()) {
         // String concatenation
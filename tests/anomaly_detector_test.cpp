@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <chronovyan/anomaly_detector.hpp>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+const double kPi = std::acos(-1.0);
+} // namespace
+
+TEST(StreamingAnomalyDetectorTest, QuietStreamScoresLow) {
+    StreamingAnomalyDetector detector({"value"});
+    std::mt19937 rng(1);
+    std::normal_distribution<double> noise(0.0, 0.01);
+
+    for (int i = 0; i < 500; ++i) {
+        double value = 0.9 + noise(rng);
+        EXPECT_FALSE(detector.update(&value)) << "sample " << i;
+    }
+    double probe = 0.9;
+    auto score = detector.evaluate(&probe, nullptr);
+    EXPECT_LT(score.value, 0.3);
+    EXPECT_EQ(score.kind, StreamingAnomalyDetector::Kind::None);
+}
+
+TEST(StreamingAnomalyDetectorTest, SpikeIsRaisedOnce) {
+    StreamingAnomalyDetector detector({"sync", "coherence"});
+    double normal[2] = {0.9, 0.8};
+    for (int i = 0; i < 100; ++i) {
+        detector.update(normal);
+    }
+
+    double spike[2] = {0.9, 0.2};
+    double factor_scores[2] = {};
+    auto preview = detector.evaluate(spike, factor_scores);
+    EXPECT_EQ(preview.kind, StreamingAnomalyDetector::Kind::Spike);
+    EXPECT_EQ(preview.factor, 1u);
+    EXPECT_LT(factor_scores[0], 0.3);
+    EXPECT_GT(factor_scores[1], 0.7);
+
+    EXPECT_TRUE(detector.update(spike));
+    EXPECT_FALSE(detector.update(spike)) << "raise is edge-triggered";
+}
+
+TEST(StreamingAnomalyDetectorTest, CusumCatchesSlowDriftBeforeZScore) {
+    StreamingAnomalyDetector detector({"stability"});
+    double value = 1.0;
+    for (int i = 0; i < 50; ++i) {
+        detector.update(&value);
+    }
+
+    // A small persistent drop: each sample is well inside the z threshold
+    value = 0.96;
+    int raised_at = -1;
+    for (int i = 0; i < 50 && raised_at < 0; ++i) {
+        if (detector.update(&value)) {
+            raised_at = i;
+        }
+        EXPECT_LT(detector.factor_score(0), 1.0);
+    }
+    ASSERT_GE(raised_at, 0);
+    EXPECT_EQ(detector.last_score().kind, StreamingAnomalyDetector::Kind::ChangePoint);
+}
+
+TEST(StreamingAnomalyDetectorTest, SeasonalBaselineAbsorbsPeriodicLoad) {
+    StreamingAnomalyDetector::Config config;
+    config.season_length = 24;
+    config.season_gamma = 0.3;
+    StreamingAnomalyDetector seasonal({"load"}, config);
+    StreamingAnomalyDetector flat({"load"});
+
+    auto load = [](int t) { return 0.5 + 0.2 * std::sin(2.0 * kPi * t / 24.0); };
+    int t = 0;
+    for (; t < 24 * 40; ++t) {
+        double value = load(t);
+        seasonal.update(&value);
+        flat.update(&value);
+    }
+
+    double peak_seasonal = 0.0;
+    for (int end = t + 24; t < end; ++t) {
+        double value = load(t);
+        seasonal.update(&value);
+        flat.update(&value);
+        peak_seasonal = std::max(peak_seasonal, seasonal.factor_score(0));
+    }
+    EXPECT_LT(peak_seasonal, 0.3);
+
+    // Advance to the seasonal peak; a trough value there is anomalous only
+    // relative to the seasonal baseline
+    for (int end = t + 6; t < end; ++t) {
+        double value = load(t);
+        seasonal.update(&value);
+        flat.update(&value);
+    }
+    double trough_at_peak = load(t + 12);
+    EXPECT_GT(seasonal.evaluate(&trough_at_peak, nullptr).value,
+              flat.evaluate(&trough_at_peak, nullptr).value);
+}
+
+TEST(StreamingAnomalyDetectorTest, SynchronizerReportsDegradationThroughCallback) {
+    TemporalSynchronizer synchronizer;
+    std::vector<TemporalSynchronizer::AnomalyDetection> reported;
+    synchronizer.set_anomaly_callback([&](const TemporalSynchronizer::AnomalyDetection& detection) {
+        reported.push_back(detection);
+    });
+
+    for (int i = 0; i < 20; ++i) {
+        synchronizer.synchronize_temporal_flows();
+    }
+    EXPECT_TRUE(reported.empty());
+
+    synchronizer.set_minimum_values();
+    synchronizer.synchronize_temporal_flows();
+
+    ASSERT_EQ(reported.size(), 1u);
+    EXPECT_TRUE(reported[0].is_anomaly);
+    EXPECT_EQ(reported[0].anomaly_type, "spike");
+    ASSERT_FALSE(reported[0].contributing_factors.empty());
+    EXPECT_EQ(reported[0].contributing_factors[0].rfind("sync:", 0), 0u);
+}
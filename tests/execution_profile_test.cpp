@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "chronovyan/execution_profile.hpp"
+#include "chronovyan/temporal_synchronizer.hpp"
+#include "interpreter.h"
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <thread>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::unique_ptr<StmtNode> declare(const std::string& name, VariableModifier modifier,
+                                  std::vector<VariableFlag> flags, int64_t initial) {
+    return std::make_unique<VariableDeclStmtNode>(name, nullptr, modifier, std::move(flags),
+                                                  std::make_unique<LiteralExprNode>(initial));
+}
+
+std::unique_ptr<ExprNode> assign(const std::string& name, int64_t value) {
+    return std::make_unique<AssignExprNode>(name, std::make_unique<LiteralExprNode>(value));
+}
+
+std::unique_ptr<ExprNode> plus(const std::string& left, const std::string& right) {
+    return std::make_unique<BinaryExprNode>(std::make_unique<VariableExprNode>(left),
+                                            Token(TokenType::PLUS, "+", SourceLocation()),
+                                            std::make_unique<VariableExprNode>(right));
+}
+
+size_t echo_history(Interpreter& interpreter, const std::string& name) {
+    return interpreter.getGlobalEnvironment()->get(name).getValueHistory().size();
+}
+
+} // namespace
+
+TEST(ExecutionProfileTest, LeanSpendsLessThanHighFidelity) {
+    ExecutionProfile lean = profile_for(PerformanceMode::Lean);
+    ExecutionProfile balanced = profile_for(PerformanceMode::Balanced);
+    ExecutionProfile high = profile_for(PerformanceMode::HighFidelity);
+
+    EXPECT_LT(lean.echo_history_capacity, balanced.echo_history_capacity);
+    EXPECT_LT(balanced.echo_history_capacity, high.echo_history_capacity);
+    EXPECT_LT(lean.sync_history_size, balanced.sync_history_size);
+    EXPECT_LT(balanced.sync_history_size, high.sync_history_size);
+    EXPECT_GT(lean.sync_tick_interval, balanced.sync_tick_interval);
+    EXPECT_GT(balanced.sync_tick_interval, high.sync_tick_interval);
+    EXPECT_LT(lean.weaver_outcomes, balanced.weaver_outcomes);
+    EXPECT_EQ(high.weaver_outcomes, 0u);
+    EXPECT_FALSE(lean.paradox_tracking);
+    EXPECT_TRUE(high.paradox_tracking);
+
+    // The defaults are the Balanced profile
+    ExecutionProfile defaults;
+    EXPECT_EQ(defaults.echo_history_capacity, balanced.echo_history_capacity);
+    EXPECT_EQ(defaults.sync_tick_interval, balanced.sync_tick_interval);
+    EXPECT_EQ(defaults.sync_history_size, balanced.sync_history_size);
+}
+
+TEST(ExecutionProfileTest, ModeChangesApplyLiveToInterpreterAndSynchronizer) {
+    Interpreter interpreter;
+    sync::TemporalSynchronizer synchronizer;
+    ExecutionProfileSwitch profiles;
+    profiles.add_target([&](const ExecutionProfile& p) { interpreter.setExecutionProfile(p); });
+    profiles.add_target([&](const ExecutionProfile& p) { synchronizer.apply_profile(p); });
+
+    interpreter.execute(*declare("x", VariableModifier::CONF, {VariableFlag::ECHO}, 0));
+    for (int64_t i = 1; i <= 100; ++i) {
+        interpreter.evaluate(*assign("x", i));
+    }
+    EXPECT_EQ(echo_history(interpreter, "x"), profile_for(PerformanceMode::Balanced).echo_history_capacity);
+    EXPECT_EQ(interpreter.getGlobalEnvironment()->get("x").asInteger(), 100);
+    EXPECT_EQ(interpreter.getGlobalEnvironment()->get("x").getValueHistory().back().asInteger(), 99);
+
+    profiles.notifyModeChange(PerformanceMode::Lean, "high_load");
+    EXPECT_EQ(profiles.switches(), 1u);
+    EXPECT_EQ(profiles.current().mode, PerformanceMode::Lean);
+    EXPECT_EQ(synchronizer.get_tick_interval(), profile_for(PerformanceMode::Lean).sync_tick_interval);
+    EXPECT_EQ(synchronizer.get_sync_history().size(), profile_for(PerformanceMode::Lean).sync_history_size);
+
+    // The history shrinks on the next assignment and keeps the newest values
+    interpreter.evaluate(*assign("x", 101));
+    EXPECT_EQ(echo_history(interpreter, "x"), profile_for(PerformanceMode::Lean).echo_history_capacity);
+    EXPECT_EQ(interpreter.getGlobalEnvironment()->get("x").getValueHistory().back().asInteger(), 100);
+
+    profiles.notifyModeChange(PerformanceMode::HighFidelity, "low_load");
+    for (int64_t i = 0; i < 100; ++i) {
+        interpreter.evaluate(*assign("x", i));
+    }
+    EXPECT_EQ(echo_history(interpreter, "x"), profile_for(PerformanceMode::Lean).echo_history_capacity + 100);
+    EXPECT_EQ(synchronizer.get_sync_history().size(),
+              profile_for(PerformanceMode::HighFidelity).sync_history_size);
+
+    // A repeated mode is not a switch
+    profiles.notifyModeChange(PerformanceMode::HighFidelity, "low_load");
+    EXPECT_EQ(profiles.switches(), 2u);
+}
+
+TEST(ExecutionProfileTest, ParadoxBookkeepingFollowsTheProfile) {
+    Interpreter interpreter;
+    interpreter.execute(*declare("c", VariableModifier::CONF, {}, 1));
+    interpreter.execute(*declare("r", VariableModifier::REB, {}, 2));
+
+    auto mixed = plus("c", "r");
+    auto conformist = plus("c", "c");
+    for (int i = 0; i < 32; ++i) {
+        interpreter.evaluate(*mixed);
+        interpreter.evaluate(*conformist);
+    }
+    EXPECT_EQ(interpreter.getParadoxOperationCount(), 32u);
+    EXPECT_EQ(interpreter.getRuntime()->getParadoxLevel(), 2);
+
+    interpreter.setExecutionProfile(profile_for(PerformanceMode::Lean));
+    for (int i = 0; i < 32; ++i) {
+        EXPECT_EQ(interpreter.evaluate(*mixed).asInteger(), 3);
+    }
+    EXPECT_EQ(interpreter.getParadoxOperationCount(), 32u);
+    EXPECT_EQ(interpreter.getRuntime()->getParadoxLevel(), 2);
+}
+
+TEST(ExecutionProfileTest, WeaverReadsSampleOnlyTheAllowedOutcomes) {
+    Interpreter interpreter;
+    Value weaver(int64_t(0));
+    weaver.addFlag(VariableFlag::WEAVER);
+    std::map<Value, double> distribution;
+    for (int64_t i = 1; i <= 10; ++i) {
+        distribution[Value(i)] = static_cast<double>(i) / 55.0;
+    }
+    weaver.setProbabilisticValue(distribution);
+    interpreter.getGlobalEnvironment()->define("w", weaver);
+
+    ExecutionProfile profile;
+    profile.weaver_outcomes = 4;
+    interpreter.setExecutionProfile(profile);
+    VariableExprNode read("w");
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_GE(interpreter.evaluate(read).asInteger(), 7);
+    }
+
+    // The stored distribution is untouched, so a profile allowing every
+    // outcome samples the unlikely ones again
+    EXPECT_EQ(interpreter.getGlobalEnvironment()->get("w").getProbabilisticValue().size(), distribution.size());
+    profile.weaver_outcomes = 0;
+    interpreter.setExecutionProfile(profile);
+    bool low_outcome = false;
+    for (int i = 0; i < 500 && !low_outcome; ++i) {
+        low_outcome = interpreter.evaluate(read).asInteger() < 7;
+    }
+    EXPECT_TRUE(low_outcome);
+}
+
+TEST(ExecutionProfileTest, NanKeysAWeaverDistribution) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::map<Value, double> distribution;
+    distribution[Value(1.5)] = 0.25;
+    distribution[Value(nan)] = 0.25;
+    distribution[Value(-2.0)] = 0.25;
+    distribution[Value(nan)] += 0.25;
+
+    // Every NaN is one key, ordered after the numbers
+    ASSERT_EQ(distribution.size(), 3u);
+    EXPECT_DOUBLE_EQ(distribution.begin()->first.asFloat(), -2.0);
+    EXPECT_TRUE(std::isnan(distribution.rbegin()->first.asFloat()));
+    EXPECT_DOUBLE_EQ(distribution.rbegin()->second, 0.5);
+    EXPECT_FALSE(Value(nan) < Value(nan));
+    EXPECT_TRUE(Value(1.5) < Value(nan));
+    EXPECT_FALSE(Value(nan) < Value(1.5));
+}
+
+TEST(ExecutionProfileTest, SynchronizerTicksAtTheProfileRate) {
+    sync::TemporalSynchronizer synchronizer;
+    synchronizer.set_tick_interval(50ms);
+
+    EXPECT_TRUE(synchronizer.synchronize_if_due());
+    EXPECT_FALSE(synchronizer.synchronize_if_due());
+    std::this_thread::sleep_for(60ms);
+    EXPECT_TRUE(synchronizer.synchronize_if_due());
+    EXPECT_EQ(synchronizer.get_performance_metrics().total_sync_operations, 2u);
+
+    // Shrinking and regrowing the history keeps the newest sample
+    double newest = synchronizer.get_sync_history().back();
+    synchronizer.set_history_size(2);
+    synchronizer.set_history_size(20);
+    auto history = synchronizer.get_sync_history();
+    ASSERT_EQ(history.size(), 20u);
+    EXPECT_EQ(history.back(), newest);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <chronovyan/forecaster.hpp>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include <cmath>
+#include <random>
+
+using namespace chronovyan::sync;
+
+namespace {
+const double kPi = std::acos(-1.0);
+
+// Stationary AR(2): x_t = 0.5 + 0.6 x_{t-1} - 0.2 x_{t-2} + e_t
+class Ar2Process {
+public:
+    explicit Ar2Process(unsigned int seed) : rng(seed), noise(0.0, 0.05) {}
+
+    double conditional_mean() const { return 0.5 + 0.6 * x1 - 0.2 * x2; }
+
+    double next() {
+        double x = conditional_mean() + noise(rng);
+        x2 = x1;
+        x1 = x;
+        return x;
+    }
+
+private:
+    std::mt19937 rng;
+    std::normal_distribution<double> noise;
+    double x1{0.8};
+    double x2{0.8};
+};
+} // namespace
+
+TEST(ForecasterTest, HoltWintersFollowsTrend) {
+    HoltWintersForecaster forecaster;
+    for (int t = 0; t < 200; ++t) {
+        forecaster.update(0.01 * t);
+    }
+    auto forecast = forecaster.forecast(5, 1.96);
+    EXPECT_NEAR(forecast.mean, 0.01 * 204, 0.01);
+    EXPECT_LE(forecast.lower, forecast.mean);
+    EXPECT_GE(forecast.upper, forecast.mean);
+}
+
+TEST(ForecasterTest, HoltWintersLearnsSeason) {
+    HoltWintersForecaster::Config config;
+    config.season_length = 12;
+    config.gamma = 0.3;
+    HoltWintersForecaster seasonal(config);
+    HoltWintersForecaster flat;
+
+    auto value = [](int t) { return 0.5 + 0.2 * std::sin(2.0 * kPi * t / 12.0); };
+    int t = 0;
+    for (; t < 12 * 30; ++t) {
+        seasonal.update(value(t));
+        flat.update(value(t));
+    }
+
+    double seasonal_error = 0.0;
+    double flat_error = 0.0;
+    for (int h = 1; h <= 12; ++h) {
+        seasonal_error += std::abs(seasonal.forecast(h, 0.0).mean - value(t + h - 1));
+        flat_error += std::abs(flat.forecast(h, 0.0).mean - value(t + h - 1));
+    }
+    EXPECT_LT(seasonal_error, 0.1 * flat_error);
+}
+
+TEST(ForecasterTest, AutoRegressiveMatchesConditionalMean) {
+    AutoRegressiveForecaster::Config config;
+    config.order = 2;
+    config.forgetting = 1.0;
+    AutoRegressiveForecaster forecaster(config);
+    Ar2Process process(3);
+
+    for (int t = 0; t < 2000; ++t) {
+        forecaster.update(process.next());
+    }
+    ASSERT_TRUE(forecaster.is_ready());
+    auto forecast = forecaster.forecast(1, 1.96);
+    EXPECT_NEAR(forecast.mean, process.conditional_mean(), 0.01);
+    EXPECT_NEAR(forecast.stddev, 0.05, 0.01);
+
+    // Multi-step intervals widen towards the unconditional variance
+    EXPECT_GT(forecaster.forecast(10, 1.96).stddev, forecast.stddev);
+}
+
+TEST(ForecasterTest, BlendedIntervalsAreCalibrated) {
+    SeriesForecaster forecaster;
+    Ar2Process process(11);
+    for (int t = 0; t < 500; ++t) {
+        forecaster.update(process.next());
+    }
+
+    int covered = 0;
+    const int trials = 4000;
+    for (int t = 0; t < trials; ++t) {
+        auto forecast = forecaster.forecast(1, 1.96);
+        double actual = process.next();
+        covered += actual >= forecast.lower && actual <= forecast.upper;
+        forecaster.update(actual);
+    }
+    double coverage = static_cast<double>(covered) / trials;
+    EXPECT_GT(coverage, 0.90);
+    EXPECT_LT(coverage, 0.99);
+
+    // AR(2) data: the AR model should carry most of the weight
+    EXPECT_LT(forecaster.holt_winters_weight(), 0.5);
+}
+
+TEST(ForecasterTest, SynchronizerForecastsFromHistory) {
+    TemporalSynchronizer synchronizer;
+    auto cold = synchronizer.predict_next_pattern();
+    EXPECT_EQ(cold.confidence, 0.0);
+    EXPECT_EQ(cold.predicted_values.size(), 10u);
+    EXPECT_EQ(cold.upper_bounds.size(), 10u);
+
+    for (int i = 0; i < 50; ++i) {
+        synchronizer.synchronize_temporal_flows();
+    }
+    auto prediction = synchronizer.predict_next_pattern();
+    ASSERT_EQ(prediction.predicted_values.size(), 10u);
+    ASSERT_EQ(prediction.lower_bounds.size(), 10u);
+    for (size_t i = 0; i < prediction.predicted_values.size(); ++i) {
+        EXPECT_LE(prediction.lower_bounds[i], prediction.predicted_values[i]);
+        EXPECT_GE(prediction.upper_bounds[i], prediction.predicted_values[i]);
+    }
+    // A steady synchronizer is highly predictable
+    EXPECT_GT(prediction.confidence, 0.9);
+
+    auto steady = synchronizer.predict_next_error();
+    ASSERT_EQ(steady.contributing_factors.size(), 3u);
+    synchronizer.set_minimum_values();
+    auto degraded = synchronizer.predict_next_error();
+    EXPECT_GT(degraded.probability, steady.probability);
+    EXPECT_GT(degraded.probability, 0.5);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "chronovyan/gradient_boosting.hpp"
+#include "chronovyan/ml_model.hpp"
+#include "chronovyan/ml_model_store.hpp"
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+constexpr size_t kFeatures = 5;
+
+std::vector<std::string> columns() {
+    return {"a", "b", "noise0", "noise1", "noise2"};
+}
+
+// Label is the XOR of the signs of the first two features, which no linear
+// model can separate; the other features are noise
+struct Dataset {
+    std::vector<double> features;
+    std::vector<double> targets;
+};
+
+Dataset make_xor(size_t rows, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Dataset data;
+    for (size_t r = 0; r < rows; ++r) {
+        double a = dist(gen);
+        double b = dist(gen);
+        data.features.insert(data.features.end(), {a, b, dist(gen), dist(gen), dist(gen)});
+        data.targets.push_back((a > 0.0) != (b > 0.0) ? 1.0 : 0.0);
+    }
+    return data;
+}
+
+double accuracy(const MLModel& model, const Dataset& data) {
+    std::vector<double> scores = model.predict_batch(data.features);
+    size_t correct = 0;
+    for (size_t r = 0; r < scores.size(); ++r) {
+        correct += (scores[r] > 0.5) == (data.targets[r] > 0.5);
+    }
+    return static_cast<double>(correct) / scores.size();
+}
+
+void train(MLModel& model, const Dataset& data, size_t batch, int epochs) {
+    size_t rows = data.targets.size();
+    for (int e = 0; e < epochs; ++e) {
+        for (size_t start = 0; start < rows; start += batch) {
+            size_t n = std::min(batch, rows - start);
+            model.train_batch(data.features.data() + start * kFeatures, data.targets.data() + start, n);
+        }
+    }
+}
+
+} // namespace
+
+TEST(GradientBoostingTest, TreesLearnWhatTheLinearModelCannot) {
+    Dataset training = make_xor(4000, 1);
+    Dataset held_out = make_xor(1000, 2);
+
+    MLModel trees("gradient_boost", columns(), 0.01, 3);
+    MLModel linear("logistic", columns(), 0.01, 3);
+    ASSERT_TRUE(trees.uses_trees());
+    ASSERT_FALSE(linear.uses_trees());
+    train(trees, training, 200, 3);
+    train(linear, training, 200, 3);
+
+    EXPECT_GT(accuracy(trees, held_out), 0.9);
+    EXPECT_LT(accuracy(linear, held_out), 0.7);
+
+    std::vector<double> importance = trees.get_feature_importance();
+    ASSERT_EQ(importance.size(), kFeatures);
+    EXPECT_GT(importance[0] + importance[1], 0.8);
+}
+
+TEST(GradientBoostingTest, BatchScoringMatchesRowScoring) {
+    MLModel model("gradient_boost", columns(), 0.01, 4);
+    Dataset data = make_xor(1000, 5);
+    train(model, data, 100, 1);
+    ASSERT_GT(model.trees().tree_count(), 0u);
+
+    std::vector<double> scores = model.predict_batch(data.features);
+    for (size_t r = 0; r < scores.size(); ++r) {
+        std::vector<double> row(data.features.begin() + r * kFeatures,
+                                data.features.begin() + (r + 1) * kFeatures);
+        ASSERT_DOUBLE_EQ(scores[r], model.predict(row)) << r;
+    }
+}
+
+TEST(GradientBoostingTest, EnsembleAndBufferStayBounded) {
+    MLModel model("gradient_boost", columns(), 0.01, 6);
+    MLHyperparameters params = model.get_hyperparameters();
+    params.max_trees = 8;
+    params.sample_buffer = 300;
+    model.set_hyperparameters(params);
+
+    Dataset data = make_xor(2000, 7);
+    size_t most_trees = 0;
+    for (size_t start = 0; start < 2000; start += 50) {
+        model.train_batch(data.features.data() + start * kFeatures, data.targets.data() + start, 50);
+        most_trees = std::max(most_trees, model.trees().tree_count());
+        EXPECT_LE(model.trees().buffered(), 300u);
+    }
+    EXPECT_EQ(most_trees, 8u);
+    EXPECT_GT(accuracy(model, make_xor(500, 8)), 0.85);
+
+    // Single labeled rows are buffered and boosted in groups
+    MLModel rows("gradient_boost", columns(), 0.01, 6);
+    for (size_t r = 0; r < MLModel::kTreeUpdateRows; ++r) {
+        std::vector<double> row(data.features.begin() + r * kFeatures,
+                                data.features.begin() + (r + 1) * kFeatures);
+        EXPECT_EQ(rows.trees().tree_count(), 0u);
+        rows.update(row, data.targets[r]);
+    }
+    EXPECT_EQ(rows.trees().tree_count(), 1u);
+}
+
+TEST(GradientBoostingTest, UnlabeledUpdatesAreRejected) {
+    // "gradient_boost" is the synchronizer's default model type
+    MLModel model("gradient_boost", columns(), 0.01, 11);
+    std::vector<double> row = {0.5, -0.5, 0.1, 0.2, 0.3};
+    double before = model.predict(row);
+    EXPECT_THROW(model.update(row), std::logic_error);
+    EXPECT_EQ(model.predict(row), before);
+
+    // Labeled rows still train it
+    Dataset data = make_xor(MLModel::kTreeUpdateRows, 12);
+    for (size_t r = 0; r < MLModel::kTreeUpdateRows; ++r) {
+        std::vector<double> labeled(data.features.begin() + r * kFeatures,
+                                    data.features.begin() + (r + 1) * kFeatures);
+        model.update(labeled, data.targets[r]);
+    }
+    EXPECT_NE(model.predict(row), before);
+}
+
+TEST(GradientBoostingTest, SavedEnsembleScoresFromTheMapping) {
+    char pattern[] = "/tmp/chronovyan_trees_XXXXXX";
+    ASSERT_NE(mkdtemp(pattern), nullptr);
+    std::string dir = pattern;
+    std::string path = dir + "/model.bin";
+
+    MLModel model("gradient_boost", columns(), 0.01, 9);
+    Dataset data = make_xor(1500, 10);
+    train(model, data, 150, 2);
+    model.save(path);
+
+    std::vector<double> expected = model.predict_batch(data.features);
+    {
+        MappedModel mapped(path);
+        EXPECT_EQ(mapped.trees().tree_count, model.trees().tree_count());
+        for (size_t r = 0; r < 100; ++r) {
+            EXPECT_DOUBLE_EQ(mapped.predict(data.features.data() + r * kFeatures), expected[r]);
+        }
+    }
+    MLModel restored = MLModel::load(path);
+    ASSERT_TRUE(restored.uses_trees());
+    EXPECT_EQ(restored.predict_batch(data.features), expected);
+    EXPECT_EQ(restored.get_feature_importance(), model.get_feature_importance());
+    std::system(("rm -rf " + dir).c_str());
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "chronovyan/log_sink.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+TEST(LogSinkTest, RecordsBelowTheLevelAreRejected) {
+    LogSink sink(16, LogLevel::Warn);
+    std::vector<std::string> lines;
+    sink.set_writer([&](const LogRecord& record) { lines.push_back(LogSink::format(record)); });
+
+    EXPECT_FALSE(sink.log(LogLevel::Debug, "debug"));
+    EXPECT_TRUE(sink.log(LogLevel::Warn, "source timed out", {2.0, 0.5}));
+    EXPECT_TRUE(sink.log(LogLevel::Error, "failed"));
+    EXPECT_FALSE(sink.log(LogLevel::Off, "never"));
+
+    sink.set_level(LogLevel::Trace);
+    EXPECT_TRUE(sink.enabled(LogLevel::Trace));
+    EXPECT_TRUE(sink.log(LogLevel::Trace, "trace"));
+
+    EXPECT_EQ(sink.drain(), 3u);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "[warn] source timed out (2, 0.5)");
+    EXPECT_EQ(lines[1], "[error] failed");
+    EXPECT_EQ(lines[2], "[trace] trace");
+}
+
+TEST(LogSinkTest, FullQueueDropsAndCounts) {
+    LogSink sink(4, LogLevel::Info);
+    size_t written = 0;
+    sink.set_writer([&](const LogRecord&) { ++written; });
+
+    for (int i = 0; i < 10; ++i) {
+        sink.log(LogLevel::Info, "fill", {static_cast<double>(i)});
+    }
+    EXPECT_EQ(sink.dropped(), 6u);
+    EXPECT_EQ(sink.drain(), 4u);
+
+    // Drained cells are reused
+    EXPECT_TRUE(sink.log(LogLevel::Info, "again"));
+    EXPECT_EQ(sink.drain(), 1u);
+    EXPECT_EQ(written, 5u);
+}
+
+TEST(LogSinkTest, BackgroundThreadDrainsConcurrentProducers) {
+    LogSink sink(256, LogLevel::Info);
+    std::mutex mutex;
+    std::vector<double> seen;
+    sink.set_writer([&](const LogRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back(record.values[0]);
+    });
+    sink.start();
+
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 2000;
+    std::atomic<int> accepted{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                if (sink.log(LogLevel::Info, "sample", {static_cast<double>(p * kPerProducer + i)})) {
+                    ++accepted;
+                }
+                if (i % 64 == 0) {
+                    std::this_thread::sleep_for(100us);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    sink.stop();
+
+    EXPECT_GT(accepted.load(), 0);
+    EXPECT_EQ(static_cast<uint64_t>(accepted.load()) + sink.dropped(),
+              static_cast<uint64_t>(kProducers * kPerProducer));
+    EXPECT_EQ(seen.size(), static_cast<size_t>(accepted.load()));
+}
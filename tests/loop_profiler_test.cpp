@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include "chronovyan/loop_profiler.hpp"
+#include "chronovyan/metric_collector.hpp"
+#include "interpreter.h"
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::unique_ptr<StmtNode> declare(const std::string& name, VariableModifier modifier,
+                                  std::vector<VariableFlag> flags, int64_t initial) {
+    return std::make_unique<VariableDeclStmtNode>(name, nullptr, modifier, std::move(flags),
+                                                  std::make_unique<LiteralExprNode>(initial));
+}
+
+std::unique_ptr<ExprNode> binary(const std::string& left, TokenType op, std::unique_ptr<ExprNode> right) {
+    return std::make_unique<BinaryExprNode>(std::make_unique<VariableExprNode>(left),
+                                            Token(op, "", SourceLocation()), std::move(right));
+}
+
+std::unique_ptr<ExprNode> literal(int64_t value) {
+    return std::make_unique<LiteralExprNode>(value);
+}
+
+// name = name + 1
+std::unique_ptr<StmtNode> increment(const std::string& name) {
+    return std::make_unique<ExprStmtNode>(
+        std::make_unique<AssignExprNode>(name, binary(name, TokenType::PLUS, literal(1))));
+}
+
+std::unique_ptr<StmtNode> sum(const std::string& left, const std::string& right) {
+    return std::make_unique<ExprStmtNode>(
+        binary(left, TokenType::PLUS, std::make_unique<VariableExprNode>(right)));
+}
+
+template <typename... Stmts>
+std::unique_ptr<TemporalOpStmtNode> loop(TemporalOpType type, std::unique_ptr<ExprNode> argument,
+                                         Stmts... body) {
+    std::vector<std::unique_ptr<ExprNode>> arguments;
+    arguments.push_back(std::move(argument));
+    std::vector<std::unique_ptr<StmtNode>> statements;
+    (statements.push_back(std::move(body)), ...);
+    return std::make_unique<TemporalOpStmtNode>(type, std::move(arguments),
+                                                std::make_unique<BlockStmtNode>(std::move(statements)));
+}
+
+int64_t variable(Interpreter& interpreter, const std::string& name) {
+    return interpreter.getGlobalEnvironment()->get(name).asInteger();
+}
+
+} // namespace
+
+TEST(LoopProfilerTest, ForChrononRecordsPerSiteCounters) {
+    Interpreter interpreter;
+    auto profiler = std::make_shared<LoopProfiler>();
+    interpreter.setLoopProfiler(profiler);
+    interpreter.execute(*declare("x", VariableModifier::CONF, {}, 0));
+
+    auto stmt = loop(TemporalOpType::FOR_CHRONON, literal(10), increment("x"));
+    interpreter.execute(*stmt);
+    EXPECT_EQ(variable(interpreter, "x"), 10);
+    EXPECT_DOUBLE_EQ(interpreter.getRuntime()->getChrononsLevel(), 90.0);
+
+#if CHRONOVYAN_LOOP_PROFILING
+    ASSERT_EQ(profiler->site_count(), 1u);
+    LoopSite* site = profiler->find(stmt->getSiteId());
+    ASSERT_NE(site, nullptr);
+    LoopSiteReport report = site->report();
+    EXPECT_EQ(report.kind, LoopKind::ForChronon);
+    EXPECT_EQ(report.executions, 1u);
+    EXPECT_EQ(report.iterations, 10u);
+    EXPECT_DOUBLE_EQ(report.resources, 10.0);
+    EXPECT_DOUBLE_EQ(report.metrics.loop_entropy, 0.01);
+    EXPECT_DOUBLE_EQ(report.metrics.iteration_stability, 1.0);
+    EXPECT_DOUBLE_EQ(report.metrics.chronon_efficiency, 1.0);
+    EXPECT_DOUBLE_EQ(report.metrics.recursion_depth, 0.0);
+    EXPECT_DOUBLE_EQ(report.metrics.paradox_potential, 0.4 * 0.01);
+    EXPECT_EQ(report.alert, LoopAlert::None);
+
+    interpreter.execute(*stmt);
+    EXPECT_EQ(site->report().executions, 2u);
+    EXPECT_EQ(site->report().iterations, 20u);
+
+    // Disabled, the loops still run but record nothing
+    profiler->set_enabled(false);
+    interpreter.execute(*stmt);
+    EXPECT_EQ(variable(interpreter, "x"), 30);
+    EXPECT_EQ(site->report().iterations, 20u);
+    profiler->set_enabled(true);
+
+    // A loop that runs out of chronons still records what it ran
+    auto greedy = loop(TemporalOpType::FOR_CHRONON, literal(200), increment("x"));
+    EXPECT_THROW(interpreter.execute(*greedy), std::runtime_error);
+    LoopSiteReport partial = profiler->find(greedy->getSiteId())->report();
+    EXPECT_EQ(partial.executions, 1u);
+    EXPECT_EQ(partial.iterations, 70u);
+#endif
+}
+
+TEST(LoopProfilerTest, FreedLoopsKeepTheirOwnSites) {
+    Interpreter interpreter;
+    auto profiler = std::make_shared<LoopProfiler>();
+    interpreter.setLoopProfiler(profiler);
+    interpreter.execute(*declare("x", VariableModifier::CONF, {}, 0));
+
+    // Each loop is freed before the next is allocated, as a REPL frees
+    // every line's program, so the allocator may hand out the same address
+    uint64_t first_id = 0;
+    {
+        auto counted = loop(TemporalOpType::FOR_CHRONON, literal(4), increment("x"));
+        first_id = counted->getSiteId();
+        interpreter.execute(*counted);
+    }
+    auto events = loop(TemporalOpType::WHILE_EVENT, binary("x", TokenType::LESS, literal(6)), increment("x"));
+    EXPECT_NE(events->getSiteId(), first_id);
+    interpreter.execute(*events);
+    EXPECT_EQ(variable(interpreter, "x"), 6);
+
+#if CHRONOVYAN_LOOP_PROFILING
+    ASSERT_EQ(profiler->site_count(), 2u);
+    LoopSiteReport counted_report = profiler->find(first_id)->report();
+    EXPECT_EQ(counted_report.kind, LoopKind::ForChronon);
+    EXPECT_EQ(counted_report.iterations, 4u);
+    LoopSiteReport event_report = profiler->find(events->getSiteId())->report();
+    EXPECT_EQ(event_report.kind, LoopKind::WhileEvent);
+    EXPECT_EQ(event_report.iterations, 2u);
+#endif
+}
+
+TEST(LoopProfilerTest, RebWorkAndEchoesRaiseTheirMetrics) {
+    Interpreter interpreter;
+    auto profiler = std::make_shared<LoopProfiler>();
+    interpreter.setLoopProfiler(profiler);
+    interpreter.execute(*declare("i", VariableModifier::CONF, {}, 0));
+    interpreter.execute(*declare("r", VariableModifier::REB, {}, 1));
+    interpreter.execute(*declare("e", VariableModifier::CONF, {VariableFlag::ECHO}, 0));
+
+    // Three operations per iteration (the condition, i + 1 and r + r), one with a REB operand
+    auto events = loop(TemporalOpType::WHILE_EVENT, binary("i", TokenType::LESS, literal(5)),
+                       increment("i"), sum("r", "r"));
+    interpreter.execute(*events);
+    EXPECT_EQ(variable(interpreter, "i"), 5);
+
+    // Each echo reads and writes the ECHO variable and refers back to the previous timeline
+    auto echoes = loop(TemporalOpType::TEMPORAL_ECHO_LOOP, literal(3), increment("e"));
+    interpreter.execute(*echoes);
+    EXPECT_EQ(variable(interpreter, "e"), 3);
+    EXPECT_DOUBLE_EQ(interpreter.getRuntime()->getAethelLevel(), 40.0);
+
+#if CHRONOVYAN_LOOP_PROFILING
+    LoopSiteReport event_report = profiler->find(events->getSiteId())->report();
+    const double entropy = 0.01 + 5 * 0.001 / 9.0;
+    EXPECT_EQ(event_report.iterations, 5u);
+    EXPECT_NEAR(event_report.metrics.loop_entropy, entropy, 1e-12);
+    EXPECT_DOUBLE_EQ(event_report.metrics.iteration_stability, 1.0);
+    EXPECT_DOUBLE_EQ(event_report.metrics.chronon_efficiency, 0.5);
+    EXPECT_NEAR(event_report.metrics.paradox_potential, 0.4 * entropy + 0.2 * 0.5, 1e-12);
+    EXPECT_EQ(event_report.alert, LoopAlert::Critical);
+
+    LoopSiteReport echo_report = profiler->find(echoes->getSiteId())->report();
+    EXPECT_EQ(echo_report.kind, LoopKind::TemporalEchoLoop);
+    EXPECT_DOUBLE_EQ(echo_report.metrics.recursion_depth, 2.5);
+    EXPECT_NEAR(echo_report.metrics.chronon_efficiency, 3.0 / 60.0, 1e-12);
+    EXPECT_EQ(echo_report.alert, LoopAlert::Emergency);
+
+    auto reports = profiler->reports();
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_GE(reports[0].metrics.paradox_potential, reports[1].metrics.paradox_potential);
+    EXPECT_DOUBLE_EQ(profiler->worst(LoopMetric::ChrononEfficiency), 3.0 / 60.0);
+    EXPECT_DOUBLE_EQ(profiler->worst(LoopMetric::RecursionDepth), 2.5);
+
+    std::ostringstream out;
+    profiler->report(out);
+    EXPECT_NE(out.str().find("WHILE_EVENT"), std::string::npos);
+    EXPECT_NE(out.str().find("emergency"), std::string::npos);
+#endif
+}
+
+TEST(LoopProfilerTest, IterationStabilityFollowsTheSpreadOfWork) {
+    LoopSite steady(LoopKind::ForChronon, "steady");
+    LoopSite jittery(LoopKind::ForChronon, "jittery");
+    for (int i = 0; i < 100; ++i) {
+        LoopIterationSample sample;
+        sample.operations = 100;
+        steady.record_iteration(sample);
+        // mean 101, stddev 1: cv of 1/101 against the expected 0.05
+        sample.operations = i % 2 ? 102 : 100;
+        jittery.record_iteration(sample);
+    }
+    EXPECT_DOUBLE_EQ(steady.report().metrics.iteration_stability, 1.0);
+    EXPECT_NEAR(jittery.report().metrics.iteration_stability, 1.0 - (1.0 / 101.0) / 0.05, 1e-9);
+    EXPECT_EQ(jittery.report().alert, LoopAlert::None);
+
+    EXPECT_EQ(LoopProfiler::alert(LoopMetric::IterationStability, 0.8), LoopAlert::None);
+    EXPECT_EQ(LoopProfiler::alert(LoopMetric::IterationStability, 0.79), LoopAlert::Warning);
+    EXPECT_EQ(LoopProfiler::alert(LoopMetric::LoopEntropy, 0.7), LoopAlert::Critical);
+    EXPECT_EQ(LoopProfiler::alert(LoopMetric::ParadoxPotential, 0.95), LoopAlert::Emergency);
+}
+
+TEST(LoopProfilerTest, MetricSourcesFeedTheCollector) {
+    LoopProfiler profiler;
+    auto ppi = profiler.metric_source(LoopMetric::ParadoxPotential);
+    auto cer = profiler.metric_source(LoopMetric::ChrononEfficiency);
+    EXPECT_FALSE(ppi->isAvailable());
+
+    LoopSite& site = profiler.site(1, LoopKind::WhileEvent, "loop");
+    LoopIterationSample sample;
+    sample.operations = 4;
+    sample.reb_operations = 4;
+    for (int i = 0; i < 100; ++i) {
+        site.record_iteration(sample);
+    }
+    site.record_execution(200.0, std::chrono::microseconds(5));
+    // LE = 0.01 + 100 * 0.001, CER = 0.5
+    const double expected_ppi = 0.4 * 0.11 + 0.2 * 0.5;
+
+    MetricCollector collector;
+    SamplingPolicy fast{5ms, 500ms};
+    collector.addSource("loop_ppi", ppi.get(), fast);
+    collector.addSource("loop_cer", cer.get(), fast);
+    collector.startSampling();
+    SystemMetrics metrics;
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    do {
+        std::this_thread::sleep_for(1ms);
+        metrics = collector.collect_metrics();
+    } while ((metrics.metrics.size() < 2 || metrics.is_stale) && std::chrono::steady_clock::now() < deadline);
+    collector.stopSampling();
+    ASSERT_EQ(metrics.metrics.size(), 2u);
+    EXPECT_FALSE(metrics.is_stale);
+    EXPECT_NEAR(metrics.metrics.at("loop_ppi").value, expected_ppi * 100.0, 1e-9);
+    EXPECT_NEAR(metrics.metrics.at("loop_cer").value, 25.0, 1e-9);
+}
@@ -95,7 +95,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesStaleMetricsFromCollec
     // Verify decision is conservative
     EXPECT_EQ(decision.mode, PerformanceMode::Lean);
     EXPECT_TRUE(decision.is_conservative);
-    EXPECT_TRUE(decision.reason.find("stale") != std::string::npos);
+    EXPECT_TRUE(decision.reason_text().find("stale") != std::string::npos);
 }
 
 // Test handling of default values from collector on failure
@@ -120,7 +120,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesDefaultValuesFromColle
     // Verify decision is conservative due to default values
     EXPECT_EQ(decision.mode, PerformanceMode::Lean);
     EXPECT_TRUE(decision.is_conservative);
-    EXPECT_TRUE(decision.reason.find("default") != std::string::npos);
+    EXPECT_TRUE(decision.reason_text().find("default") != std::string::npos);
 }
 
 // Test handling of intermittent metric availability
@@ -163,7 +163,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesIntermittentMetricAvai
     auto decision3 = decision_engine->evaluate_metrics(metrics3);
     // Update expectations to match actual behavior
     EXPECT_EQ(decision3.mode, PerformanceMode::Balanced); // Changed from Lean to Balanced
-    EXPECT_TRUE(decision3.reason.find("recovered") != std::string::npos); // Changed from hysteresis to recovered
+    EXPECT_TRUE(decision3.reason_text().find("recovered") != std::string::npos); // Changed from hysteresis to recovered
 }
 
 // Test handling of complete metric collector failure
@@ -185,7 +185,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesCompleteMetricCollecto
     // Verify system-wide fallback to safe mode
     EXPECT_EQ(decision.mode, PerformanceMode::Lean);
     EXPECT_TRUE(decision.is_conservative);
-    EXPECT_TRUE(decision.reason.find("critical") != std::string::npos);
+    EXPECT_TRUE(decision.reason_text().find("critical") != std::string::npos);
     EXPECT_TRUE(decision.requires_fallback);
 }
 
@@ -212,7 +212,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesOutOfRangeMetrics) {
     // Verify decision is conservative
     EXPECT_EQ(decision.mode, PerformanceMode::Lean);
     EXPECT_TRUE(decision.is_conservative);
-    EXPECT_TRUE(decision.reason.find("range") != std::string::npos);
+    EXPECT_TRUE(decision.reason_text().find("range") != std::string::npos);
 }
 
 // Test handling of NaN metrics
@@ -255,13 +255,13 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesNaNMetrics) {
     
     // Debug output for decision
     std::cout << "Debug - Decision: mode=" << static_cast<int>(decision.mode)
-              << ", reason='" << decision.reason << "'"
+              << ", reason='" << decision.reason_text() << "'"
               << ", is_conservative=" << decision.is_conservative << std::endl;
     
     // Verify decision is conservative
     EXPECT_EQ(decision.mode, PerformanceMode::Lean);
     EXPECT_TRUE(decision.is_conservative);
-    EXPECT_TRUE(decision.reason.find("invalid") != std::string::npos);
+    EXPECT_TRUE(decision.reason_text().find("invalid") != std::string::npos);
 }
 
 // Test handling of rapid metric changes
@@ -287,7 +287,7 @@ TEST_F(MetricCollectorModeDecisionIntegrationTest, HandlesRapidMetricChanges) {
     auto decision2 = decision_engine->evaluate_metrics(metrics2);
     // Update expectations to match actual behavior
     EXPECT_EQ(decision2.mode, PerformanceMode::Lean); // Changed from Balanced to Lean
-    EXPECT_TRUE(decision2.reason.find("high_load") != std::string::npos); // Changed from hysteresis to high_load
+    EXPECT_TRUE(decision2.reason_text().find("high_load") != std::string::npos); // Changed from hysteresis to high_load
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "chronovyan/metric_collector.hpp"
+#include "chronovyan/mode_decision_engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+class FakeSource : public IMetricSource {
+public:
+    explicit FakeSource(double initial) : value(initial) {}
+
+    double getValue() const override {
+        samples.fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms.load()));
+        if (throws.load()) {
+            throw std::runtime_error("connection timeout");
+        }
+        return value.load();
+    }
+    bool isAvailable() const override { return true; }
+    std::chrono::system_clock::time_point getLastUpdateTime() const override {
+        return std::chrono::system_clock::now();
+    }
+
+    std::atomic<double> value;
+    std::atomic<int> delay_ms{0};
+    std::atomic<bool> throws{false};
+    mutable std::atomic<int> samples{0};
+};
+
+bool eventually(const std::function<bool()>& condition,
+                std::chrono::milliseconds limit = 2000ms) {
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return condition();
+}
+
+class MetricCollectorSamplingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SamplingPolicy fast{5ms, 50ms};
+        collector.addSource("cpu", &cpu, fast);
+        collector.addSource("memory", &memory, fast);
+        collector.addSource("gpu", &gpu, fast);
+    }
+
+    FakeSource cpu{40.0};
+    FakeSource memory{50.0};
+    FakeSource gpu{60.0};
+    MetricCollector collector;
+};
+
+} // namespace
+
+TEST_F(MetricCollectorSamplingTest, SnapshotTracksLatestValues) {
+    collector.startSampling();
+    ASSERT_TRUE(collector.isSampling());
+    ASSERT_TRUE(eventually([&] {
+        auto metrics = collector.collect_metrics();
+        return metrics.metrics.size() == 3 && !metrics.is_stale;
+    }));
+
+    auto metrics = collector.collect_metrics();
+    EXPECT_DOUBLE_EQ(metrics.cpu_usage, 40.0);
+    EXPECT_DOUBLE_EQ(metrics.memory_usage, 50.0);
+    EXPECT_DOUBLE_EQ(metrics.gpu_usage, 60.0);
+    EXPECT_FALSE(metrics.has_exception);
+
+    cpu.value = 90.0;
+    EXPECT_TRUE(eventually([&] { return collector.collect_metrics().cpu_usage == 90.0; }));
+
+    collector.stopSampling();
+    EXPECT_FALSE(collector.isSampling());
+}
+
+TEST_F(MetricCollectorSamplingTest, SlowSourceTimesOutWithoutBlockingReaders) {
+    collector.startSampling();
+    ASSERT_TRUE(eventually([&] { return !collector.collect_metrics().is_stale; }));
+
+    gpu.delay_ms = 400;
+    ASSERT_TRUE(eventually([&] { return collector.collect_metrics().has_timeout; }));
+
+    // Reported while the sample is still in flight, without waiting on it
+    auto start = std::chrono::steady_clock::now();
+    auto metrics = collector.collect_metrics();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_TRUE(metrics.has_exception);
+    EXPECT_EQ(metrics.exception_source, "gpu");
+    EXPECT_FALSE(metrics.metrics["gpu"].is_available);
+    EXPECT_TRUE(metrics.metrics["cpu"].is_available);
+
+    ModeDecisionEngine engine;
+    EXPECT_EQ(engine.makeDecision(metrics).reason_text(), "timeout detected: gpu");
+
+    gpu.delay_ms = 0;
+    EXPECT_TRUE(eventually([&] { return !collector.collect_metrics().has_exception; }));
+}
+
+TEST_F(MetricCollectorSamplingTest, SynchronousPathUsesThePolicyTimeout) {
+    // Over the 50ms policy timeout, well under the default one
+    gpu.delay_ms = 100;
+    auto metrics = collector.collect_metrics();
+    EXPECT_TRUE(metrics.has_timeout);
+    EXPECT_EQ(metrics.exception_source, "gpu");
+    EXPECT_FALSE(metrics.metrics["gpu"].is_available);
+    EXPECT_TRUE(metrics.metrics["cpu"].is_available);
+}
+
+TEST_F(MetricCollectorSamplingTest, ExceptionsAreNotMistakenForTimeouts) {
+    memory.throws = true;
+    collector.startSampling();
+    ASSERT_TRUE(eventually([&] { return collector.collect_metrics().has_exception; }));
+
+    auto metrics = collector.collect_metrics();
+    EXPECT_FALSE(metrics.has_timeout);
+    EXPECT_EQ(metrics.exception_source, "memory");
+    EXPECT_NE(metrics.exception_message.find("connection timeout"), std::string::npos);
+    collector.stopSampling();
+
+    // Same classification on the synchronous path
+    auto direct = collector.collect_metrics();
+    EXPECT_TRUE(direct.has_exception);
+    EXPECT_FALSE(direct.has_timeout);
+}
+
+TEST_F(MetricCollectorSamplingTest, SourcesKeepTheirOwnCadence) {
+    FakeSource slow(10.0);
+    collector.addSource("disk", &slow, SamplingPolicy{100ms, 50ms});
+    collector.startSampling();
+    EXPECT_THROW(collector.addSource("late", &slow), std::logic_error);
+
+    std::this_thread::sleep_for(250ms);
+    collector.stopSampling();
+
+    EXPECT_GE(slow.samples.load(), 2);
+    EXPECT_LE(slow.samples.load(), 4);
+    EXPECT_GT(cpu.samples.load(), 4 * slow.samples.load());
+    EXPECT_DOUBLE_EQ(slow.value.load(), 10.0);
+}
+
+TEST_F(MetricCollectorSamplingTest, SnapshotNeverMixesSamples) {
+    // Sample n reports value n % 100 stamped n seconds after the epoch, so
+    // a value paired with another sample's timestamp is detectable
+    class CountingSource : public IMetricSource {
+    public:
+        double getValue() const override {
+            return static_cast<double>(++count % 100);
+        }
+        bool isAvailable() const override { return true; }
+        std::chrono::system_clock::time_point getLastUpdateTime() const override {
+            return std::chrono::system_clock::time_point(std::chrono::seconds(count.load()));
+        }
+        mutable std::atomic<int64_t> count{0};
+    } counting;
+    collector.addSource("counter", &counting, SamplingPolicy{1ms, 50ms});
+    MetricHandle handle = MetricRegistry::instance().find("counter");
+    collector.startSampling();
+
+    int checked = 0;
+    auto deadline = std::chrono::steady_clock::now() + 200ms;
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto metrics = collector.collect_metrics();
+        if (!metrics.metrics.contains(handle)) {
+            continue;
+        }
+        const MetricData& data = metrics.metrics.at(handle);
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(data.timestamp.time_since_epoch()).count();
+        if (seconds == 0) {
+            continue;
+        }
+        ASSERT_DOUBLE_EQ(data.value, static_cast<double>(seconds % 100));
+        ++checked;
+    }
+    collector.stopSampling();
+    EXPECT_GT(checked, 0);
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "chronovyan/metric_collector.hpp"
+#include "chronovyan/metric_history.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+using Clock = std::chrono::system_clock;
+
+namespace {
+
+// Minute-aligned origin so rollup boundaries are predictable
+const Clock::time_point kOrigin = Clock::time_point(std::chrono::seconds(1699999980));
+
+class ConstantSource : public IMetricSource {
+public:
+    explicit ConstantSource(double value) : value_(value) {}
+    double getValue() const override { return value_; }
+    bool isAvailable() const override { return true; }
+    Clock::time_point getLastUpdateTime() const override { return Clock::now(); }
+
+private:
+    double value_;
+};
+
+} // namespace
+
+TEST(MetricHistoryTest, RangeQueriesReadTheRingInPlace) {
+    MetricHistory history;
+    history.track(MetricRegistry::kCpu);
+    for (int i = 0; i < 100; ++i) {
+        history.record(MetricRegistry::kCpu, kOrigin + i * 10ms, i);
+    }
+
+    auto view = history.range(MetricRegistry::kCpu, kOrigin + 100ms, kOrigin + 200ms);
+    ASSERT_EQ(view.size(), 11u);
+    EXPECT_EQ(view.front().time, kOrigin + 100ms);
+    EXPECT_DOUBLE_EQ(view.back().value, 20.0);
+    double expected = 10.0;
+    for (const MetricPoint& point : view) {
+        EXPECT_DOUBLE_EQ(point.value, expected++);
+    }
+    EXPECT_TRUE(view.intact());
+
+    EXPECT_TRUE(history.range(MetricRegistry::kCpu, kOrigin + 2s, kOrigin + 3s).empty());
+    EXPECT_TRUE(history.range(MetricRegistry::kMemory, kOrigin, kOrigin + 1s).empty());
+    EXPECT_FALSE(history.is_tracked(MetricRegistry::kMemory));
+}
+
+TEST(MetricHistoryTest, RingKeepsTheMostRecentSamples) {
+    MetricHistory::Config config;
+    config.raw_capacity = 8;
+    MetricHistory history(config);
+    history.track(MetricRegistry::kGpu);
+    for (int i = 0; i < 20; ++i) {
+        history.record(MetricRegistry::kGpu, kOrigin + i * 1ms, i);
+    }
+
+    // One slot is reserved for the record being written
+    auto latest = history.latest(MetricRegistry::kGpu, 100);
+    ASSERT_EQ(latest.size(), 7u);
+    EXPECT_DOUBLE_EQ(latest.front().value, 13.0);
+    EXPECT_DOUBLE_EQ(latest.back().value, 19.0);
+    EXPECT_EQ(history.latest(MetricRegistry::kGpu, 3).front().value, 17.0);
+
+    // A view outlived by the writer reports that it was overwritten
+    auto held = history.latest(MetricRegistry::kGpu, 7);
+    EXPECT_TRUE(held.intact());
+    history.record(MetricRegistry::kGpu, kOrigin + 20ms, 20);
+    EXPECT_TRUE(held.intact());  // only the slot before the view was reused
+    history.record(MetricRegistry::kGpu, kOrigin + 21ms, 21);
+    EXPECT_FALSE(held.intact());
+
+    // Out-of-order samples are clamped to the previous time
+    history.record(MetricRegistry::kGpu, kOrigin, 22);
+    EXPECT_EQ(history.latest(MetricRegistry::kGpu, 1).back().time, kOrigin + 21ms);
+}
+
+TEST(MetricHistoryTest, RollupsAggregateEachInterval) {
+    MetricHistory history;
+    history.track(MetricRegistry::kMemory);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> load(10.0, 90.0);
+
+    // 125 seconds at 100Hz; keep the samples of the first second
+    std::vector<double> first_second;
+    for (int i = 0; i < 12500; ++i) {
+        double value = load(rng);
+        if (i < 100) {
+            first_second.push_back(value);
+        }
+        history.record(MetricRegistry::kMemory, kOrigin + i * 10ms, value);
+    }
+
+    auto seconds = history.rollups(MetricRegistry::kMemory, RollupResolution::OneSecond,
+                                   kOrigin, kOrigin + 1h);
+    ASSERT_EQ(seconds.size(), 124u);  // the 125th second is still open
+    MetricRollup first = seconds.front();
+    EXPECT_EQ(first.start, kOrigin);
+    EXPECT_EQ(first.count, 100u);
+    EXPECT_DOUBLE_EQ(first.min, *std::min_element(first_second.begin(), first_second.end()));
+    EXPECT_DOUBLE_EQ(first.max, *std::max_element(first_second.begin(), first_second.end()));
+    double sum = 0.0;
+    for (double value : first_second) {
+        sum += value;
+    }
+    EXPECT_NEAR(first.avg, sum / 100.0, 1e-9);
+    std::sort(first_second.begin(), first_second.end());
+    EXPECT_NEAR(first.p99, first_second[98], 0.03 * first_second[98]);
+
+    auto tens = history.rollups(MetricRegistry::kMemory, RollupResolution::TenSeconds,
+                                kOrigin, kOrigin + 1h);
+    ASSERT_EQ(tens.size(), 12u);
+    EXPECT_EQ(tens[1].start, kOrigin + 10s);
+    EXPECT_EQ(tens[1].count, 1000u);
+    EXPECT_NEAR(tens[1].avg, 50.0, 2.0);
+    EXPECT_NEAR(tens[1].p99, 89.2, 2.0);
+
+    auto minutes = history.rollups(MetricRegistry::kMemory, RollupResolution::OneMinute,
+                                   kOrigin + 30s, kOrigin + 1h);
+    ASSERT_EQ(minutes.size(), 1u);
+    EXPECT_EQ(minutes.front().start, kOrigin + 60s);
+    EXPECT_EQ(minutes.front().count, 6000u);
+}
+
+TEST(MetricHistoryTest, ReadersRunConcurrentlyWithTheWriter) {
+    MetricHistory::Config config;
+    config.raw_capacity = 256;
+    MetricHistory history(config);
+    history.track(MetricRegistry::kCpu);
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> intact_reads{0};
+    std::atomic<size_t> ordering_errors{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto view = history.latest(MetricRegistry::kCpu, 64);
+                std::vector<MetricPoint> points(view.begin(), view.end());
+                if (!view.intact()) {
+                    continue;
+                }
+                ++intact_reads;
+                for (size_t i = 1; i < points.size(); ++i) {
+                    // The writer records value == sample index
+                    if (points[i].value != points[i - 1].value + 1.0) {
+                        ++ordering_errors;
+                    }
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 200000; ++i) {
+        history.record(MetricRegistry::kCpu, kOrigin + i * 1ms, i);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_GT(intact_reads.load(), 0u);
+    EXPECT_EQ(ordering_errors.load(), 0u);
+}
+
+TEST(MetricHistoryTest, CollectorRecordsEverySource) {
+    ConstantSource cpu(25.0);
+    ConstantSource memory(50.0);
+    ConstantSource gpu(75.0);
+    ConstantSource disk(5.0);
+    MetricCollector collector(&cpu, &memory, &gpu);
+    collector.addSource("history_disk", &disk, SamplingPolicy{2ms, 100ms});
+
+    for (int i = 0; i < 3; ++i) {
+        collector.collect_metrics();
+    }
+    auto cpu_history = collector.history().latest(MetricRegistry::kCpu, 10);
+    ASSERT_EQ(cpu_history.size(), 3u);
+    EXPECT_DOUBLE_EQ(cpu_history.back().value, 25.0);
+
+    MetricHandle handle = MetricRegistry::instance().find("history_disk");
+    collector.startSampling();
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (collector.history().latest(handle, 5).size() < 5 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    collector.stopSampling();
+    auto disk_history = collector.history().latest(handle, 5);
+    ASSERT_EQ(disk_history.size(), 5u);
+    EXPECT_DOUBLE_EQ(disk_history.front().value, 5.0);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "chronovyan/metric_collector.hpp"
+#include "chronovyan/metric_registry.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+class ConstantSource : public IMetricSource {
+public:
+    explicit ConstantSource(double value) : value_(value) {}
+    double getValue() const override { return value_; }
+    bool isAvailable() const override { return true; }
+    std::chrono::system_clock::time_point getLastUpdateTime() const override {
+        return std::chrono::system_clock::now();
+    }
+
+private:
+    double value_;
+};
+
+} // namespace
+
+TEST(MetricRegistryTest, BuiltInMetricsHaveFixedIds) {
+    auto& registry = MetricRegistry::instance();
+    EXPECT_EQ(registry.find("cpu"), MetricRegistry::kCpu);
+    EXPECT_EQ(registry.find("memory"), MetricRegistry::kMemory);
+    EXPECT_EQ(registry.find("gpu"), MetricRegistry::kGpu);
+    EXPECT_EQ(registry.name(MetricRegistry::kMemory), "memory");
+}
+
+TEST(MetricRegistryTest, RegistrationIsIdempotent) {
+    MetricRegistry registry;
+    EXPECT_FALSE(registry.find("disk").valid());
+
+    MetricHandle disk = registry.register_metric("disk");
+    ASSERT_TRUE(disk.valid());
+    EXPECT_EQ(disk.id(), 3u);
+    EXPECT_EQ(registry.register_metric("disk"), disk);
+    EXPECT_EQ(registry.find("disk"), disk);
+    EXPECT_EQ(registry.size(), 4u);
+    EXPECT_EQ(registry.name(MetricHandle()), "");
+}
+
+TEST(MetricRegistryTest, CapacityIsEnforced) {
+    MetricRegistry registry;
+    while (registry.size() < MetricRegistry::kMaxMetrics) {
+        registry.register_metric("metric" + std::to_string(registry.size()));
+    }
+    EXPECT_THROW(registry.register_metric("one_too_many"), std::length_error);
+    EXPECT_TRUE(registry.register_metric("metric10").valid());
+}
+
+TEST(MetricRegistryTest, TableIsIndexedByHandle) {
+    SystemMetrics metrics;
+    EXPECT_TRUE(metrics.metrics.empty());
+
+    metrics.metrics[MetricRegistry::kGpu] = {75.0, std::chrono::system_clock::now(), true};
+    metrics.metrics[MetricRegistry::kCpu] = {45.0, std::chrono::system_clock::now(), false};
+    EXPECT_EQ(metrics.metrics.size(), 2u);
+    EXPECT_TRUE(metrics.metrics.is_available(MetricRegistry::kGpu));
+    EXPECT_FALSE(metrics.metrics.is_available(MetricRegistry::kCpu));
+    EXPECT_FALSE(metrics.metrics.contains(MetricRegistry::kMemory));
+    EXPECT_THROW(metrics.metrics.at(MetricRegistry::kMemory), std::out_of_range);
+    EXPECT_THROW(metrics.metrics[MetricHandle()], std::out_of_range);
+
+    // Name-based access resolves to the same slots
+    EXPECT_EQ(metrics.metrics.count("gpu"), 1u);
+    EXPECT_DOUBLE_EQ(metrics.metrics.at("cpu").value, 45.0);
+    metrics.metrics["table_test_metric"].value = 3.0;
+    MetricHandle added = MetricRegistry::instance().find("table_test_metric");
+    EXPECT_DOUBLE_EQ(metrics.metrics.at(added).value, 3.0);
+
+    std::vector<MetricId> order;
+    metrics.metrics.for_each([&](MetricHandle handle, const MetricData&) {
+        order.push_back(handle.id());
+    });
+    EXPECT_EQ(order, (std::vector<MetricId>{0, 2, added.id()}));
+
+    // Copies carry the values
+    SystemMetrics copy = metrics;
+    metrics.metrics.erase(MetricRegistry::kGpu);
+    EXPECT_FALSE(metrics.metrics.contains(MetricRegistry::kGpu));
+    EXPECT_DOUBLE_EQ(copy.metrics.at(MetricRegistry::kGpu).value, 75.0);
+}
+
+TEST(MetricRegistryTest, CollectorPublishesNamedSources) {
+    ConstantSource cpu(10.0);
+    ConstantSource memory(20.0);
+    ConstantSource gpu(30.0);
+    ConstantSource disk(40.0);
+    MetricCollector collector(&cpu, &memory, &gpu);
+    collector.addSource("disk", &disk, SamplingPolicy{5ms, 100ms});
+
+    collector.startSampling();
+    MetricHandle handle = MetricRegistry::instance().find("disk");
+    ASSERT_TRUE(handle.valid());
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (collector.collect_metrics().is_stale &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    SystemMetrics metrics = collector.collect_metrics();
+    collector.stopSampling();
+
+    EXPECT_DOUBLE_EQ(metrics.metrics.at(handle).value, 40.0);
+    EXPECT_DOUBLE_EQ(metrics.metrics.at(MetricRegistry::kCpu).value, 10.0);
+    EXPECT_DOUBLE_EQ(metrics.cpu_usage, 10.0);
+    EXPECT_DOUBLE_EQ(metrics.gpu_usage, 30.0);
+}
@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+#include "chronovyan/ml_model_store.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+constexpr size_t kFeatures = 6;
+
+std::vector<std::string> columns() {
+    return {"latency", "throughput", "error_rate", "cpu", "memory", "queue_depth"};
+}
+
+void make_batch(std::mt19937& gen, std::vector<double>& features, std::vector<double>& targets, size_t rows) {
+    static const double kTrue[kFeatures] = {-1.0, 2.0, -3.0, 0.5, 0.0, 1.0};
+    std::normal_distribution<double> dist(0.0, 1.0);
+    features.clear();
+    targets.clear();
+    for (size_t r = 0; r < rows; ++r) {
+        double z = 0.0;
+        for (size_t i = 0; i < kFeatures; ++i) {
+            double x = dist(gen);
+            features.push_back(x);
+            z += kTrue[i] * x;
+        }
+        targets.push_back(z > 0.0 ? 1.0 : 0.0);
+    }
+}
+
+class MLModelStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/chronovyan_model_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir = pattern;
+        path = dir + "/model.bin";
+    }
+
+    void TearDown() override {
+        std::system(("rm -rf " + dir).c_str());
+    }
+
+    MLModel trained_model() {
+        MLModel model("logistic", columns(), 0.02, 9);
+        MLHyperparameters params = model.get_hyperparameters();
+        params.learning_rate = 0.05;
+        model.set_hyperparameters(params);
+        std::mt19937 gen(1);
+        std::vector<double> features, targets;
+        for (int b = 0; b < 20; ++b) {
+            make_batch(gen, features, targets, 32);
+            model.train_batch(features, targets);
+        }
+        return model;
+    }
+
+    std::string dir;
+    std::string path;
+};
+
+} // namespace
+
+TEST_F(MLModelStoreTest, SavedModelMapsAndWarmStartsExactly) {
+    MLModel original = trained_model();
+    original.save(path);
+
+    MappedModel mapped(path);
+    ASSERT_EQ(mapped.feature_count(), kFeatures);
+    EXPECT_EQ(mapped.model_type(), "logistic");
+    EXPECT_EQ(mapped.feature_name(2), "error_rate");
+    EXPECT_DOUBLE_EQ(mapped.hyperparameters().learning_rate, 0.05);
+    EXPECT_EQ(mapped.hyperparameters().optimizer, GradientOptimizer::Adam);
+    EXPECT_EQ(mapped.optimizer_steps(), 20u);
+    std::vector<double> importance = original.get_feature_importance();
+    for (size_t i = 0; i < kFeatures; ++i) {
+        EXPECT_EQ(mapped.importance()[i], importance[i]);
+    }
+
+    std::mt19937 gen(2);
+    std::vector<double> features, targets;
+    make_batch(gen, features, targets, 16);
+    std::vector<double> expected = original.predict_batch(features);
+    for (size_t r = 0; r < 16; ++r) {
+        EXPECT_EQ(mapped.predict(features.data() + r * kFeatures), expected[r]);
+    }
+
+    // Optimizer state is restored too, so further training stays identical
+    MLModel restored = MLModel::load(path);
+    EXPECT_EQ(restored.predict_batch(features), expected);
+    original.train_batch(features, targets);
+    restored.train_batch(features, targets);
+    EXPECT_EQ(restored.predict_batch(features), original.predict_batch(features));
+}
+
+TEST_F(MLModelStoreTest, InvalidFilesAreRejected) {
+    EXPECT_THROW(MappedModel(dir + "/missing.bin"), std::runtime_error);
+
+    trained_model().save(path);
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto write = [&](const std::vector<char>& contents) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(contents.data(), contents.size());
+    };
+
+    std::vector<char> corrupt = bytes;
+    corrupt[sizeof(ModelFileHeader) + 3] ^= 0x40;  // a weight byte
+    write(corrupt);
+    EXPECT_THROW(MappedModel{path}, std::runtime_error);
+
+    // The header is covered by the checksum too
+    corrupt = bytes;
+    corrupt[offsetof(ModelFileHeader, learning_rate) + 2] ^= 0x01;
+    write(corrupt);
+    EXPECT_THROW(MappedModel{path}, std::runtime_error);
+
+    std::vector<char> truncated(bytes.begin(), bytes.end() - 8);
+    write(truncated);
+    EXPECT_THROW(MappedModel{path}, std::runtime_error);
+
+    std::vector<char> future = bytes;
+    ModelFileHeader header;
+    std::memcpy(&header, future.data(), sizeof(header));
+    header.version = ModelFileHeader::kVersion + 1;
+    std::memcpy(future.data(), &header, sizeof(header));
+    write(future);
+    EXPECT_THROW(MappedModel{path}, std::runtime_error);
+
+    write(bytes);
+    EXPECT_NO_THROW(MappedModel{path});
+}
+
+TEST_F(MLModelStoreTest, Version2FilesAreStillRead) {
+    MLModel original = trained_model();
+    original.save(path);
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // Version 2 checksummed only the bytes after the header
+    ModelFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.version = 2;
+    header.checksum = 14695981039346656037ull;
+    for (size_t i = sizeof(header); i < bytes.size(); ++i) {
+        header.checksum ^= static_cast<unsigned char>(bytes[i]);
+        header.checksum *= 1099511628211ull;
+    }
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+
+    MappedModel mapped(path);
+    EXPECT_EQ(mapped.model_type(), "logistic");
+    std::vector<double> row(kFeatures, 0.5);
+    EXPECT_EQ(mapped.predict(row.data()), original.predict_batch(row)[0]);
+}
+
+TEST_F(MLModelStoreTest, Version1FilesLoadAsLinearModels) {
+    // The version 1 header: no tree settings and no trees section
+    struct HeaderV1 {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t file_size;
+        uint64_t checksum;
+        uint64_t feature_count;
+        uint64_t optimizer_steps;
+        double rates_and_moments[7];
+        int32_t max_depth;
+        int32_t min_samples_split;
+        uint32_t optimizer;
+        uint32_t reserved;
+        uint64_t weights_offset;
+        uint64_t importance_offset;
+        uint64_t moments_offset;
+        uint64_t strings_offset;
+    };
+
+    // Rewrite a current file as version 1 would have written it
+    MLModel original = trained_model();
+    original.save(path);
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ModelFileHeader current;
+    std::memcpy(&current, bytes.data(), sizeof(current));
+    ASSERT_EQ(current.trees_offset, current.strings_offset);
+    const uint64_t shift = sizeof(ModelFileHeader) - sizeof(HeaderV1);
+
+    HeaderV1 old{};
+    std::memcpy(old.magic, current.magic, sizeof(old.magic));
+    old.version = 1;
+    old.byte_order = current.byte_order;
+    old.feature_count = current.feature_count;
+    old.optimizer_steps = current.optimizer_steps;
+    std::memcpy(old.rates_and_moments, &current.base_learning_rate, sizeof(old.rates_and_moments));
+    old.max_depth = current.max_depth;
+    old.min_samples_split = current.min_samples_split;
+    old.optimizer = current.optimizer;
+    old.weights_offset = current.weights_offset - shift;
+    old.importance_offset = current.importance_offset - shift;
+    old.moments_offset = current.moments_offset - shift;
+    old.strings_offset = current.strings_offset - shift;
+
+    // Rebuild the strings with the model retyped as "gradient_boost": a
+    // version 1 file of that type holds linear weights and no trees
+    std::vector<std::string> strings;
+    for (uint64_t i = 0; i <= current.feature_count; ++i) {
+        uint64_t entry[2];
+        std::memcpy(entry, bytes.data() + current.strings_offset + i * sizeof(entry), sizeof(entry));
+        strings.emplace_back(bytes.data() + entry[0], entry[1]);
+    }
+    strings[0] = "gradient_boost";
+    std::vector<char> v1(sizeof(old));
+    v1.insert(v1.end(), bytes.begin() + sizeof(ModelFileHeader), bytes.begin() + current.strings_offset);
+    uint64_t cursor = old.strings_offset + strings.size() * 2 * sizeof(uint64_t);
+    for (const auto& text : strings) {
+        uint64_t entry[2] = {cursor, text.size()};
+        v1.insert(v1.end(), reinterpret_cast<char*>(entry), reinterpret_cast<char*>(entry) + sizeof(entry));
+        cursor += text.size();
+    }
+    for (const auto& text : strings) {
+        v1.insert(v1.end(), text.begin(), text.end());
+    }
+    v1.resize((v1.size() + 7) & ~size_t(7), 0);
+    old.file_size = v1.size();
+    old.checksum = 14695981039346656037ull;
+    for (size_t i = sizeof(old); i < v1.size(); ++i) {
+        old.checksum ^= static_cast<unsigned char>(v1[i]);
+        old.checksum *= 1099511628211ull;
+    }
+    std::memcpy(v1.data(), &old, sizeof(old));
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(v1.data(), v1.size());
+
+    MappedModel mapped(path);
+    EXPECT_EQ(mapped.version(), 1u);
+    EXPECT_EQ(mapped.model_type(), "gradient_boost");
+    EXPECT_FALSE(mapped.uses_trees());
+    EXPECT_EQ(mapped.feature_name(5), "queue_depth");
+    EXPECT_DOUBLE_EQ(mapped.hyperparameters().learning_rate, 0.05);
+    EXPECT_EQ(mapped.hyperparameters().max_trees, MLHyperparameters().max_trees);
+
+    std::mt19937 gen(3);
+    std::vector<double> features, targets;
+    make_batch(gen, features, targets, 8);
+    std::vector<double> expected = original.predict_batch(features);
+    for (size_t r = 0; r < 8; ++r) {
+        EXPECT_EQ(mapped.predict(features.data() + r * kFeatures), expected[r]);
+    }
+    MLModel loaded = MLModel::load(path);
+    EXPECT_FALSE(loaded.uses_trees());
+    EXPECT_EQ(loaded.predict_batch(features), expected);
+
+    // Saved again in the current version, it stays linear
+    loaded.save(path);
+    MappedModel resaved(path);
+    EXPECT_EQ(resaved.version(), ModelFileHeader::kVersion);
+    EXPECT_EQ(resaved.model_type(), "gradient_boost");
+    EXPECT_FALSE(resaved.uses_trees());
+    EXPECT_EQ(MLModel::load(path).predict_batch(features), expected);
+}
+
+TEST_F(MLModelStoreTest, CheckpointerWritesLatestSnapshotInBackground) {
+    MLModel model = trained_model();
+    {
+        ModelCheckpointer checkpointer(path, std::chrono::milliseconds(0));
+        EXPECT_TRUE(checkpointer.offer(model));
+        checkpointer.flush();
+        EXPECT_EQ(checkpointer.written(), 1u);
+        EXPECT_EQ(MLModel::load(path).get_feature_importance(), model.get_feature_importance());
+
+        std::mt19937 gen(3);
+        std::vector<double> features, targets;
+        make_batch(gen, features, targets, 32);
+        model.train_batch(features, targets);
+        EXPECT_TRUE(checkpointer.offer(model));
+    }
+    // The destructor writes the snapshot still pending
+    EXPECT_EQ(MLModel::load(path).get_feature_importance(), model.get_feature_importance());
+
+    ModelCheckpointer slow(path, std::chrono::hours(1));
+    EXPECT_FALSE(slow.offer(model));
+    EXPECT_EQ(slow.written(), 0u);
+}
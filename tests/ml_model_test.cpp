@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "chronovyan/ml_model.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+constexpr size_t kFeatures = 8;
+
+std::vector<std::string> columns() {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < kFeatures; ++i) {
+        names.push_back("f" + std::to_string(i));
+    }
+    return names;
+}
+
+// Linearly separable labels from a fixed hyperplane
+struct Dataset {
+    std::vector<double> features;  // row-major
+    std::vector<double> targets;
+};
+
+Dataset make_dataset(size_t rows, unsigned seed) {
+    static const double kTrue[kFeatures] = {1.5, -2.0, 0.5, 0.0, 3.0, -1.0, 0.0, 0.75};
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    Dataset data;
+    for (size_t r = 0; r < rows; ++r) {
+        double z = 0.25;
+        for (size_t i = 0; i < kFeatures; ++i) {
+            double x = dist(gen);
+            data.features.push_back(x);
+            z += kTrue[i] * x;
+        }
+        data.targets.push_back(z > 0.0 ? 1.0 : 0.0);
+    }
+    return data;
+}
+
+double accuracy(const MLModel& model, const Dataset& data) {
+    std::vector<double> scores = model.predict_batch(data.features);
+    size_t correct = 0;
+    for (size_t r = 0; r < scores.size(); ++r) {
+        correct += (scores[r] > 0.5) == (data.targets[r] > 0.5);
+    }
+    return static_cast<double>(correct) / scores.size();
+}
+
+double train(MLModel& model, const Dataset& data, size_t batch, int epochs) {
+    double loss = 0.0;
+    size_t rows = data.targets.size();
+    for (int e = 0; e < epochs; ++e) {
+        for (size_t start = 0; start < rows; start += batch) {
+            size_t n = std::min(batch, rows - start);
+            loss = model.train_batch(data.features.data() + start * kFeatures, data.targets.data() + start, n);
+        }
+    }
+    return loss;
+}
+
+} // namespace
+
+TEST(MLModelTest, MinibatchTrainingLearnsWithEitherOptimizer) {
+    Dataset training = make_dataset(2000, 1);
+    Dataset held_out = make_dataset(500, 2);
+
+    for (GradientOptimizer optimizer : {GradientOptimizer::Adam, GradientOptimizer::MomentumSGD}) {
+        MLModel model("logistic", columns(), 0.01, 42);
+        MLHyperparameters params = model.get_hyperparameters();
+        params.optimizer = optimizer;
+        params.learning_rate = optimizer == GradientOptimizer::Adam ? 0.05 : 0.5;
+        params.regularization = 1e-4;
+        model.set_hyperparameters(params);
+
+        double first = model.train_batch(training.features.data(), training.targets.data(), 64);
+        double last = train(model, training, 64, 10);
+        EXPECT_LT(last, first);
+        EXPECT_GT(accuracy(model, held_out), 0.95) << static_cast<int>(optimizer);
+    }
+}
+
+TEST(MLModelTest, BatchPredictionMatchesSingleRows) {
+    MLModel model("logistic", columns(), 0.01, 7);
+    Dataset data = make_dataset(300, 3);
+    train(model, data, 32, 2);
+
+    std::vector<double> scores = model.predict_batch(data.features);
+    ASSERT_EQ(scores.size(), 300u);
+    for (size_t r = 0; r < scores.size(); ++r) {
+        std::vector<double> row(data.features.begin() + r * kFeatures,
+                                data.features.begin() + (r + 1) * kFeatures);
+        EXPECT_DOUBLE_EQ(scores[r], model.predict(row));
+    }
+
+    EXPECT_THROW(model.predict_batch(std::vector<double>(kFeatures + 1, 0.0)), std::invalid_argument);
+}
+
+TEST(MLModelTest, NonFiniteBatchesAreRejectedWithoutSideEffects) {
+    MLModel model("logistic", columns(), 0.01, 11);
+    Dataset data = make_dataset(64, 4);
+    std::vector<double> before = model.predict_batch(data.features);
+
+    Dataset poisoned = data;
+    poisoned.features[kFeatures * 10 + 3] = std::numeric_limits<double>::infinity();
+    EXPECT_THROW(model.train_batch(poisoned.features, poisoned.targets), std::invalid_argument);
+    poisoned = data;
+    poisoned.targets[5] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_THROW(model.train_batch(poisoned.features, poisoned.targets), std::invalid_argument);
+    poisoned.features[0] = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> out(64);
+    EXPECT_THROW(model.predict_batch(poisoned.features.data(), 64, out.data()), std::invalid_argument);
+
+    EXPECT_EQ(model.predict_batch(data.features), before);
+}
+
+TEST(MLModelTest, HyperparametersAreTypedAndClamped) {
+    MLModel model("logistic", columns(), 0.02, 5);
+    EXPECT_DOUBLE_EQ(model.get_hyperparameters().learning_rate, 0.02);
+    EXPECT_EQ(model.get_hyperparameters().optimizer, GradientOptimizer::Adam);
+
+    OptimizationMetrics metrics;
+    metrics.sync_efficiency = 1000.0;
+    metrics.stability = 1.0;
+    metrics.error_rate = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        model.update_hyperparameters(metrics);
+    }
+    const MLHyperparameters& params = model.get_hyperparameters();
+    EXPECT_DOUBLE_EQ(params.learning_rate, 0.1);
+    EXPECT_DOUBLE_EQ(params.regularization, 0.001);
+    EXPECT_DOUBLE_EQ(params.momentum, 0.99);
+}
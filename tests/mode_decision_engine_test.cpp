@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "chronovyan/mode_decision_engine.hpp"
+#include "chronovyan/log_sink.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <thread>
+
+using namespace chronovyan;
+
+// Counting allocator: replaces the global operator new for this test binary and
+// counts allocations made on the current thread while counting is enabled.
+namespace {
+thread_local bool counting_enabled = false;
+thread_local size_t allocation_count = 0;
+
+class AllocationCounter {
+public:
+    AllocationCounter() {
+        allocation_count = 0;
+        counting_enabled = true;
+    }
+
+    ~AllocationCounter() {
+        counting_enabled = false;
+    }
+
+    size_t count() const { return allocation_count; }
+};
+
+DecisionInputs load(double cpu, double memory, double gpu) {
+    DecisionInputs inputs;
+    inputs.cpu = cpu;
+    inputs.memory = memory;
+    inputs.gpu = gpu;
+    inputs.available = DecisionInputs::kAll;
+    return inputs;
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (counting_enabled) {
+        ++allocation_count;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+TEST(ModeDecisionEngineTest, FaultsTakePrecedenceOverLoad) {
+    ModeDecisionEngine engine;
+
+    DecisionInputs inputs = load(95.0, 95.0, 95.0);
+    inputs.gpu = std::numeric_limits<double>::quiet_NaN();
+    inputs.has_exception = true;
+    ModeDecision decision = engine.decide(inputs);
+    EXPECT_EQ(decision.code, DecisionReason::InvalidMetrics);
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+    EXPECT_TRUE(decision.is_conservative);
+
+    inputs = load(10.0, 10.0, 10.0);
+    inputs.has_exception = true;
+    inputs.has_timeout = true;
+    inputs.available = 0;
+    decision = engine.decide(inputs);
+    EXPECT_EQ(decision.code, DecisionReason::SourceTimeout);
+    EXPECT_EQ(decision.mode, PerformanceMode::Balanced);
+    EXPECT_TRUE(decision.is_error_state);
+    EXPECT_FALSE(decision.requires_fallback);
+
+    inputs.has_exception = false;
+    decision = engine.decide(inputs);
+    EXPECT_EQ(decision.code, DecisionReason::CompleteSensorFailure);
+    EXPECT_TRUE(decision.requires_fallback);
+    EXPECT_TRUE(decision.is_fallback_mode);
+
+    inputs.available = DecisionInputs::kCpu | DecisionInputs::kGpu;
+    inputs.is_stale = true;
+    decision = engine.decide(inputs);
+    EXPECT_EQ(decision.code, DecisionReason::PartialSensorFailure);
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+}
+
+TEST(ModeDecisionEngineTest, LoadThresholdsSelectTheMode) {
+    ModeDecisionEngine engine;
+    EXPECT_EQ(engine.decide(load(90.0, 20.0, 20.0)).code, DecisionReason::HighLoad);
+    EXPECT_EQ(engine.decide(load(90.0, 20.0, 20.0)).mode, PerformanceMode::Lean);
+
+    ModeDecisionEngine fresh;
+    ModeDecision decision = fresh.decide(load(20.0, 30.0, 40.0));
+    EXPECT_EQ(decision.code, DecisionReason::LowLoad);
+    EXPECT_EQ(decision.mode, PerformanceMode::HighFidelity);
+
+    decision = fresh.decide(load(60.0, 30.0, 40.0));
+    EXPECT_EQ(decision.code, DecisionReason::NormalLoad);
+    EXPECT_EQ(decision.mode, PerformanceMode::Balanced);
+}
+
+TEST(ModeDecisionEngineTest, RecoveryIsReportedOnce) {
+    ModeDecisionEngine engine;
+    DecisionInputs inputs = load(50.0, 50.0, 50.0);
+    inputs.available = DecisionInputs::kCpu | DecisionInputs::kMemory;
+    engine.decide(inputs);
+
+    inputs.available = DecisionInputs::kAll;
+    EXPECT_EQ(engine.decide(inputs).code, DecisionReason::Recovered);
+    EXPECT_EQ(engine.decide(inputs).code, DecisionReason::NormalLoad);
+}
+
+TEST(ModeDecisionEngineTest, ReasonTextIsFormattedOnDemand) {
+    ModeDecisionEngine engine;
+    MetricHandle gpu = MetricRegistry::kGpu;
+
+    DecisionInputs inputs = load(50.0, 50.0, 50.0);
+    inputs.has_exception = true;
+    inputs.failed_source = gpu;
+    ModeDecision decision = engine.decide(inputs);
+    EXPECT_TRUE(decision.reason.empty());
+    EXPECT_EQ(decision.source, gpu);
+    EXPECT_EQ(decision.reason_text(), "exception detected: gpu");
+
+    inputs.failed_source = MetricHandle();
+    EXPECT_EQ(engine.decide(inputs).reason_text(), "exception detected: unknown");
+
+    engine.setForceModeForTesting(PerformanceMode::Lean, true, "maintenance");
+    decision = engine.decide(load(10.0, 10.0, 10.0));
+    EXPECT_EQ(decision.code, DecisionReason::Forced);
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+    EXPECT_EQ(decision.reason_text(), "maintenance");
+}
+
+TEST(ModeDecisionEngineTest, HysteresisHoldsStepsToALessConservativeMode) {
+    ModeDecisionEngine engine;
+    EXPECT_EQ(engine.decide(load(90.0, 50.0, 50.0)).mode, PerformanceMode::Lean);
+
+    // Load drops right away: the engine keeps Lean for kHysteresisHold
+    ModeDecision decision = engine.decide(load(20.0, 20.0, 20.0));
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+    EXPECT_EQ(decision.code, DecisionReason::Hysteresis);
+    decision = engine.decide(load(60.0, 50.0, 50.0));
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+
+    // Steps toward a more conservative mode are never held
+    ModeDecisionEngine other;
+    EXPECT_EQ(other.decide(load(20.0, 20.0, 20.0)).mode, PerformanceMode::HighFidelity);
+    EXPECT_EQ(other.decide(load(60.0, 50.0, 50.0)).mode, PerformanceMode::Balanced);
+    EXPECT_EQ(other.decide(load(95.0, 50.0, 50.0)).mode, PerformanceMode::Lean);
+
+    // Fault decisions are not load decisions and are not held either
+    DecisionInputs fault = load(20.0, 20.0, 20.0);
+    fault.has_exception = true;
+    EXPECT_EQ(other.decide(fault).mode, PerformanceMode::Balanced);
+}
+
+TEST(ModeDecisionEngineTest, DecisionsDoNotAllocate) {
+    ModeDecisionEngine engine;
+    LogSink::instance();  // start the drain thread outside the counted region
+
+    DecisionInputs inputs[] = {
+        load(90.0, 50.0, 50.0), load(20.0, 20.0, 20.0), load(60.0, 50.0, 50.0),
+        load(50.0, 50.0, 50.0)
+    };
+    inputs[3].has_exception = true;
+    inputs[3].has_timeout = true;
+    inputs[3].failed_source = MetricRegistry::kCpu;
+
+    size_t allocations;
+    {
+        AllocationCounter counter;
+        for (int i = 0; i < 1000; ++i) {
+            ModeDecision decision = engine.decide(inputs[i % 4]);
+            (void)decision;
+        }
+        allocations = counter.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+}
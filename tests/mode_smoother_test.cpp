@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "chronovyan/mode_decision_engine.hpp"
+#include "chronovyan/mode_smoother.hpp"
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+const ModeSmoother::Clock::time_point kStart{std::chrono::hours(1)};
+
+// 50% load with a 300ms burst to 95% every two seconds, sampled every 100ms
+std::vector<ReplaySample> bursty_trace(std::chrono::seconds length) {
+    std::vector<ReplaySample> trace;
+    for (auto t = 0ms; t < length; t += 100ms) {
+        double load = (t.count() % 2000) < 300 ? 95.0 : 50.0;
+        trace.push_back({t, load, 40.0, 30.0});
+    }
+    return trace;
+}
+
+SmoothingConfig fast_config() {
+    SmoothingConfig config;
+    config.short_window = 500ms;
+    config.long_window = 2000ms;
+    config.lean_dwell = 3s;
+    config.balanced_dwell = 3s;
+    config.rise_rate = 0.0;
+    return config;
+}
+
+} // namespace
+
+TEST(ModeSmootherTest, BandsHoldTheModeBetweenEnterAndExit) {
+    ModeSmoother smoother(fast_config());
+    auto t = kStart;
+    EXPECT_EQ(smoother.update(t, 95.0).mode, PerformanceMode::Lean);
+
+    // Between lean.exit (70) and lean.enter (85): stays Lean past the dwell time
+    for (int i = 0; i < 100; ++i) {
+        t += 100ms;
+        EXPECT_EQ(smoother.update(t, 75.0).mode, PerformanceMode::Lean);
+    }
+    // Below lean.exit
+    for (int i = 0; i < 30; ++i) {
+        t += 100ms;
+        smoother.update(t, 60.0);
+    }
+    EXPECT_EQ(smoother.mode(), PerformanceMode::Balanced);
+}
+
+TEST(ModeSmootherTest, DwellTimeDelaysStepsDownOnly) {
+    ModeSmoother smoother(fast_config());
+    auto t = kStart;
+    smoother.update(t, 95.0);
+
+    // Load collapses right away; Lean is held for lean_dwell
+    t += 1s;
+    SmoothedMode result = smoother.update(t, 10.0);
+    EXPECT_EQ(result.mode, PerformanceMode::Lean);
+    EXPECT_TRUE(result.held);
+
+    t = kStart + 3s;
+    result = smoother.update(t, 10.0);
+    EXPECT_FALSE(result.held);
+    EXPECT_NE(result.mode, PerformanceMode::Lean);
+
+    // Back up: no dwell in the way of a more conservative mode
+    t += 100ms;
+    for (int i = 0; i < 10 && smoother.mode() != PerformanceMode::Lean; ++i) {
+        t += 100ms;
+        smoother.update(t, 100.0);
+    }
+    EXPECT_EQ(smoother.mode(), PerformanceMode::Lean);
+    EXPECT_LT(t - (kStart + 3s), 1s);
+}
+
+TEST(ModeSmootherTest, HighFidelityNeedsTheLongAverageToo) {
+    ModeSmoother smoother(fast_config());
+    auto t = kStart;
+    smoother.update(t, 60.0);
+    for (int i = 0; i < 10; ++i) {
+        t += 100ms;
+        smoother.update(t, 20.0);
+    }
+    // The short average is down, the long one is not yet
+    EXPECT_EQ(smoother.mode(), PerformanceMode::Balanced);
+    for (int i = 0; i < 60; ++i) {
+        t += 100ms;
+        smoother.update(t, 20.0);
+    }
+    EXPECT_EQ(smoother.mode(), PerformanceMode::HighFidelity);
+}
+
+TEST(ModeSmootherTest, RisingLoadTriggersLeanEarly) {
+    SmoothingConfig config = fast_config();
+    config.rise_rate = 30.0;
+    ModeSmoother smoother(config);
+    auto t = kStart;
+    smoother.update(t, 30.0);
+
+    // Ramp at 60%/s
+    SmoothedMode result;
+    double load = 30.0;
+    while (smoother.mode() != PerformanceMode::Lean && load < 100.0) {
+        t += 100ms;
+        load += 6.0;
+        result = smoother.update(t, load);
+    }
+    EXPECT_EQ(result.mode, PerformanceMode::Lean);
+    EXPECT_TRUE(result.rate_triggered);
+    EXPECT_LT(result.short_average, config.lean.enter);
+}
+
+TEST(ModeSmootherTest, ReplayShowsSmoothingStopsFlapping) {
+    auto trace = bursty_trace(60s);
+
+    ModeDecisionEngine raw;
+    ReplayReport raw_report = replay_trace(raw, trace);
+
+    ModeDecisionEngine smoothed;
+    smoothed.enable_smoothing();
+    ReplayReport smoothed_report = replay_trace(smoothed, trace);
+
+    EXPECT_EQ(raw_report.samples, trace.size());
+    EXPECT_GT(raw_report.switches, 10u);
+    EXPECT_LE(smoothed_report.switches, 2u);
+    EXPECT_EQ(smoothed_report.duration(), trace.back().time);
+    EXPECT_GT(smoothed_report.fraction(PerformanceMode::Balanced), 0.9);
+}
+
+TEST(ModeSmootherTest, FaultsBypassTheSmoother) {
+    ModeDecisionEngine engine;
+    engine.enable_smoothing(fast_config());
+    DecisionInputs inputs;
+    inputs.cpu = 95.0;
+    inputs.memory = 50.0;
+    inputs.gpu = 50.0;
+    inputs.available = DecisionInputs::kAll;
+    EXPECT_EQ(engine.decide(inputs, kStart).mode, PerformanceMode::Lean);
+
+    inputs.has_exception = true;
+    inputs.has_timeout = true;
+    ModeDecision decision = engine.decide(inputs, kStart + 100ms);
+    EXPECT_EQ(decision.code, DecisionReason::SourceTimeout);
+    EXPECT_EQ(decision.mode, PerformanceMode::Balanced);
+
+    // The faulty sample was not averaged in, so the smoothed load is still
+    // within the Lean band
+    inputs.has_exception = false;
+    inputs.cpu = 10.0;
+    decision = engine.decide(inputs, kStart + 200ms);
+    EXPECT_EQ(decision.code, DecisionReason::HighLoad);
+    EXPECT_EQ(decision.mode, PerformanceMode::Lean);
+}
+
+TEST(ModeSmootherTest, ReadsCsvTraces) {
+    std::istringstream csv(
+        "time_ms,cpu,memory,gpu\n"
+        "# recorded on a build host\n"
+        "0,10.5,20,30\n"
+        "\n"
+        "250,90,20.25,31\n");
+    auto trace = read_replay_trace(csv);
+    ASSERT_EQ(trace.size(), 2u);
+    EXPECT_EQ(trace[1].time, 250ms);
+    EXPECT_DOUBLE_EQ(trace[0].cpu, 10.5);
+    EXPECT_DOUBLE_EQ(trace[1].memory, 20.25);
+    EXPECT_DOUBLE_EQ(trace[1].gpu, 31.0);
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "chronovyan/notification_bus.hpp"
+#include "chronovyan/state_controller.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records what it receives; optionally blocks in its callbacks until released
+class Recorder : public INotificationService {
+public:
+    void notifyModeChange(PerformanceMode new_mode, const std::string& reason) override {
+        wait_if_gated();
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back("mode:" + std::to_string(static_cast<int>(new_mode)) + ":" + reason);
+    }
+    void notifyError(const std::string& error_message) override {
+        wait_if_gated();
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back("error:" + error_message);
+    }
+
+    void gate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gated_ = true;
+    }
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            gated_ = false;
+        }
+        open_.notify_all();
+    }
+    // Waits until a callback is blocked on the gate
+    void wait_until_blocked() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!blocked_changed_.wait_for(lock, 100ms, [this] { return blocked_; })) {
+        }
+    }
+    std::vector<std::string> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+private:
+    void wait_if_gated() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!gated_) {
+            return;
+        }
+        blocked_ = true;
+        blocked_changed_.notify_all();
+        while (!open_.wait_for(lock, 100ms, [this] { return !gated_; })) {
+        }
+        blocked_ = false;
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable open_;
+    std::condition_variable blocked_changed_;
+    bool gated_ = false;
+    bool blocked_ = false;
+    std::vector<std::string> events_;
+};
+
+// Publishes "first" and waits until the subscriber is stuck delivering it,
+// so that the following events pile up in its queue
+void block_on_first_event(NotificationBus& bus, Recorder& recorder) {
+    recorder.gate();
+    bus.notifyModeChange(PerformanceMode::Balanced, "first");
+    recorder.wait_until_blocked();
+}
+
+} // namespace
+
+TEST(NotificationBusTest, DeliversToEverySubscriberInOrder) {
+    NotificationBus bus;
+    auto first = std::make_shared<Recorder>();
+    auto second = std::make_shared<Recorder>();
+    bus.subscribe(first);
+    auto id = bus.subscribe(second);
+    EXPECT_EQ(bus.subscriber_count(), 2u);
+
+    bus.notifyModeChange(PerformanceMode::Lean, "high_load");
+    bus.notifyError("timeout detected: gpu");
+    bus.notifyModeChange(PerformanceMode::Balanced, "recovered");
+    bus.flush();
+
+    std::vector<std::string> expected = {"mode:2:high_load", "error:timeout detected: gpu", "mode:1:recovered"};
+    EXPECT_EQ(first->events(), expected);
+    EXPECT_EQ(second->events(), expected);
+
+    SubscriberStats stats = bus.stats(id);
+    EXPECT_EQ(stats.published, 3u);
+    EXPECT_EQ(stats.delivered, 3u);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_GE(stats.batches, 1u);
+    EXPECT_GT(stats.max_latency.count(), 0);
+    EXPECT_LE(stats.mean_latency, stats.max_latency);
+
+    EXPECT_TRUE(bus.unsubscribe(id));
+    EXPECT_FALSE(bus.unsubscribe(id));
+    bus.notifyError("after");
+    bus.flush();
+    EXPECT_EQ(second->events().size(), 3u);
+    EXPECT_EQ(first->events().size(), 4u);
+    EXPECT_THROW(bus.stats(id), std::out_of_range);
+}
+
+TEST(NotificationBusTest, SlowSubscriberDoesNotBlockPublishersOrOthers) {
+    NotificationBus bus;
+    auto slow = std::make_shared<Recorder>();
+    auto fast = std::make_shared<Recorder>();
+    bus.subscribe(slow);
+    bus.subscribe(fast);
+
+    block_on_first_event(bus, *slow);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; ++i) {
+        bus.notifyModeChange(PerformanceMode::Lean, "burst");
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+    // The fast subscriber is served while the slow one is still stuck
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (fast->events().size() < 21 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(fast->events().size(), 21u);
+    EXPECT_TRUE(slow->events().empty());
+
+    slow->release();
+    bus.flush();
+    EXPECT_EQ(slow->events().size(), 21u);
+}
+
+TEST(NotificationBusTest, OverflowPoliciesBoundTheQueue) {
+    NotificationBus bus;
+    SubscriberOptions options;
+    options.capacity = 3;
+
+    auto newest = std::make_shared<Recorder>();
+    options.policy = OverflowPolicy::DropNewest;
+    auto newest_id = bus.subscribe(newest, options);
+
+    auto oldest = std::make_shared<Recorder>();
+    options.policy = OverflowPolicy::DropOldest;
+    auto oldest_id = bus.subscribe(oldest, options);
+
+    auto coalesce = std::make_shared<Recorder>();
+    options.policy = OverflowPolicy::Coalesce;
+    auto coalesce_id = bus.subscribe(coalesce, options);
+
+    newest->gate();
+    oldest->gate();
+    coalesce->gate();
+    bus.notifyModeChange(PerformanceMode::Balanced, "first");
+    newest->wait_until_blocked();
+    oldest->wait_until_blocked();
+    coalesce->wait_until_blocked();
+
+    bus.notifyModeChange(PerformanceMode::Lean, "m1");
+    bus.notifyError("e1");
+    bus.notifyModeChange(PerformanceMode::Balanced, "m2");
+    bus.notifyModeChange(PerformanceMode::HighFidelity, "m3");
+    bus.notifyModeChange(PerformanceMode::Lean, "m4");
+
+    newest->release();
+    oldest->release();
+    coalesce->release();
+    bus.flush();
+
+    EXPECT_EQ(newest->events(), (std::vector<std::string>{"mode:1:first", "mode:2:m1", "error:e1", "mode:1:m2"}));
+    EXPECT_EQ(oldest->events(), (std::vector<std::string>{"mode:1:first", "mode:1:m2", "mode:0:m3", "mode:2:m4"}));
+    EXPECT_EQ(coalesce->events(), (std::vector<std::string>{"mode:1:first", "error:e1", "mode:2:m4"}));
+
+    EXPECT_EQ(bus.stats(newest_id).dropped, 2u);
+    EXPECT_EQ(bus.stats(oldest_id).dropped, 2u);
+    EXPECT_EQ(bus.stats(coalesce_id).dropped, 0u);
+    EXPECT_EQ(bus.stats(coalesce_id).coalesced, 3u);
+
+    SubscriberStats totals = bus.totals();
+    EXPECT_EQ(totals.published, 18u);
+    EXPECT_EQ(totals.dropped, 4u);
+    EXPECT_EQ(totals.delivered, 11u);
+}
+
+TEST(NotificationBusTest, StateControllerPublishesThroughTheBus) {
+    auto bus = std::make_shared<NotificationBus>();
+    auto dashboard = std::make_shared<Recorder>();
+    auto pager = std::make_shared<Recorder>();
+    bus->subscribe(dashboard);
+    bus->subscribe(pager);
+
+    StateController controller(std::make_shared<ModeDecisionEngine>(), bus);
+    ModeDecision decision;
+    decision.mode = PerformanceMode::Lean;
+    decision.code = DecisionReason::HighLoad;
+    controller.updateMode(decision);
+    bus->flush();
+
+    EXPECT_EQ(dashboard->events(), std::vector<std::string>{"mode:2:high_load"});
+    EXPECT_EQ(pager->events(), dashboard->events());
+}
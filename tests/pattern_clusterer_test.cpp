@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <chronovyan/pattern_clusterer.hpp>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+constexpr size_t kDims = 4;
+
+// Three well separated Gaussian blobs, `per_blob` samples each, row-major
+std::vector<double> make_blobs(size_t per_blob, unsigned int seed = 7) {
+    const double centres[3] = {0.1, 0.5, 0.9};
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::vector<double> samples;
+    for (double centre : centres) {
+        for (size_t i = 0; i < per_blob; ++i) {
+            for (size_t d = 0; d < kDims; ++d) {
+                samples.push_back(centre + noise(rng));
+            }
+        }
+    }
+    return samples;
+}
+} // namespace
+
+TEST(PatternClustererTest, MiniBatchKMeansSeparatesBlobs) {
+    PatternClusterer clusterer;
+    auto samples = make_blobs(40);
+    auto result = clusterer.cluster(samples.data(), 120, kDims);
+
+    ASSERT_EQ(result.cluster_count(), 3u);
+    ASSERT_EQ(result.labels.size(), 120u);
+    for (size_t blob = 0; blob < 3; ++blob) {
+        std::set<int> labels(result.labels.begin() + blob * 40,
+                             result.labels.begin() + (blob + 1) * 40);
+        EXPECT_EQ(labels.size(), 1u) << "blob " << blob << " was split";
+    }
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_EQ(result.sizes[c], 40u);
+        EXPECT_GT(result.quality[c], 0.9);
+    }
+}
+
+TEST(PatternClustererTest, CentroidsPersistAcrossCalls) {
+    PatternClusterer clusterer;
+    auto samples = make_blobs(40);
+    auto first = clusterer.cluster(samples.data(), 120, kDims);
+
+    // A second batch from the same distribution refines rather than reseeds
+    auto more = make_blobs(40, 11);
+    clusterer.partial_fit(more.data(), 120, kDims);
+    auto second = clusterer.cluster(samples.data(), 120, kDims);
+
+    ASSERT_EQ(first.cluster_count(), second.cluster_count());
+    EXPECT_EQ(first.labels, second.labels);
+    for (size_t i = 0; i < first.centroids.size(); ++i) {
+        EXPECT_NEAR(first.centroids[i], second.centroids[i], 0.01);
+    }
+}
+
+TEST(PatternClustererTest, DBSCANReportsOutliersAsNoise) {
+    PatternClusterer::Config config;
+    config.algorithm = PatternClusterer::Algorithm::DBSCAN;
+    config.epsilon = 0.1;
+    config.min_points = 5;
+    PatternClusterer clusterer(config);
+
+    auto samples = make_blobs(20);
+    samples.insert(samples.end(), kDims, 5.0);  // far from every blob
+    auto result = clusterer.cluster(samples.data(), 61, kDims);
+
+    EXPECT_EQ(result.cluster_count(), 3u);
+    EXPECT_EQ(result.noise_count, 1u);
+    EXPECT_EQ(result.labels.back(), PatternClusterer::kNoise);
+}
+
+TEST(PatternClustererTest, DBSCANExpandsDenseClusterOnce) {
+    PatternClusterer::Config config;
+    config.algorithm = PatternClusterer::Algorithm::DBSCAN;
+    config.epsilon = 0.1;
+    config.min_points = 5;
+    PatternClusterer clusterer(config);
+
+    // Every point is a core point next to every other: without queued
+    // tracking the frontier would hold n^2 entries
+    const size_t count = 1500;
+    std::vector<double> samples(count * kDims, 0.5);
+    auto result = clusterer.cluster(samples.data(), count, kDims);
+
+    EXPECT_EQ(result.cluster_count(), 1u);
+    EXPECT_EQ(result.noise_count, 0u);
+    ASSERT_EQ(result.sizes.size(), 1u);
+    EXPECT_EQ(result.sizes[0], count);
+}
+
+TEST(PatternClustererTest, SynchronizerClustersConfiguredWindow) {
+    TemporalSynchronizer synchronizer;
+    TemporalSynchronizer::PatternRecognitionConfig recognition;
+    recognition.pattern_window = 20;
+    synchronizer.configure_pattern_recognition(recognition);
+
+    PatternClusterer::Config config = synchronizer.get_clustering_config();
+    config.algorithm = PatternClusterer::Algorithm::DBSCAN;
+    synchronizer.set_clustering_config(config);
+
+    for (int i = 0; i < 100; ++i) {
+        synchronizer.synchronize_temporal_flows();
+    }
+
+    size_t total = 0;
+    for (const auto& cluster : synchronizer.cluster_patterns()) {
+        EXPECT_EQ(cluster.patterns.size(), cluster.pattern_count);
+        EXPECT_EQ(cluster.centroid.size(), 10u);
+        total += cluster.pattern_count;
+    }
+    EXPECT_EQ(total, 20u);
+}
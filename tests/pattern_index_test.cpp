@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <chronovyan/pattern_index.hpp>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+constexpr size_t kDims = 10;
+
+// Points scattered around a few hundred random centres, like recurring sync patterns
+std::vector<std::vector<double>> make_library(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> centre(0.0, 1.0);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    std::vector<std::vector<double>> centres(256, std::vector<double>(kDims));
+    for (auto& c : centres) {
+        for (auto& v : c) {
+            v = centre(rng);
+        }
+    }
+    std::vector<std::vector<double>> library;
+    library.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<double> row = centres[i % centres.size()];
+        for (auto& v : row) {
+            v += noise(rng);
+        }
+        library.push_back(std::move(row));
+    }
+    return library;
+}
+} // namespace
+
+TEST(PatternIndexTest, LinearScanReturnsNearestFirst) {
+    PatternIndex index(3);
+    index.add({0.0, 0.0, 0.0}, "origin");
+    index.add({1.0, 1.0, 1.0}, "unit");
+    index.add({0.5, 0.5, 0.5}, "middle");
+
+    auto neighbors = index.search({0.9, 0.9, 0.9}, 2);
+    ASSERT_EQ(neighbors.size(), 2u);
+    EXPECT_EQ(neighbors[0].label, "unit");
+    EXPECT_EQ(neighbors[1].label, "middle");
+    EXPECT_LE(neighbors[0].distance, neighbors[1].distance);
+    EXPECT_GT(neighbors[0].similarity, neighbors[1].similarity);
+    EXPECT_FALSE(index.is_indexed());
+
+    auto exact = index.search({0.5, 0.5, 0.5}, 1);
+    ASSERT_EQ(exact.size(), 1u);
+    EXPECT_DOUBLE_EQ(exact[0].similarity, 1.0);
+}
+
+TEST(PatternIndexTest, IVFMatchesLinearScan) {
+    PatternIndex::Config exact_config;
+    exact_config.ivf_threshold = std::numeric_limits<size_t>::max();
+    PatternIndex exact(kDims, exact_config);
+    PatternIndex approximate(kDims);
+
+    for (const auto& row : make_library(50000, 3)) {
+        exact.add(row, "library");
+        approximate.add(row, "library");
+    }
+    ASSERT_TRUE(approximate.is_indexed());
+    ASSERT_FALSE(exact.is_indexed());
+
+    size_t hits = 0;
+    size_t total = 0;
+    for (const auto& query : make_library(100, 5)) {
+        std::set<size_t> truth;
+        for (const auto& n : exact.search(query, 10)) {
+            truth.insert(n.id);
+        }
+        for (const auto& n : approximate.search(query, 10)) {
+            hits += truth.count(n.id);
+        }
+        total += truth.size();
+    }
+    EXPECT_GE(static_cast<double>(hits) / total, 0.9);
+}
+
+TEST(PatternIndexTest, FullLibraryOverwritesOldest) {
+    PatternIndex::Config config;
+    config.capacity = 4;
+    config.ivf_threshold = 2;
+    PatternIndex index(1, config);
+
+    for (int i = 0; i < 10; ++i) {
+        index.add({static_cast<double>(i)}, "p" + std::to_string(i));
+    }
+    EXPECT_EQ(index.size(), 4u);
+
+    auto neighbors = index.search({0.0}, 4);
+    ASSERT_EQ(neighbors.size(), 4u);
+    EXPECT_EQ(neighbors[0].label, "p6");
+
+    std::set<std::string> labels;
+    for (const auto& n : neighbors) {
+        labels.insert(n.label);
+    }
+    EXPECT_EQ(labels, (std::set<std::string>{"p6", "p7", "p8", "p9"}));
+}
+
+TEST(PatternIndexTest, SynchronizerMatchesRecordedAndReferencePatterns) {
+    TemporalSynchronizer synchronizer;
+
+    // Nothing of this length is stored yet
+    auto miss = synchronizer.find_similar_pattern({0.8, 0.9, 1.0});
+    EXPECT_EQ(miss.matched_pattern, "none");
+    EXPECT_EQ(miss.similarity_score, 0.0);
+
+    synchronizer.add_reference_pattern("degraded", {0.2, 0.3, 0.2});
+    synchronizer.add_reference_pattern("nominal", {0.9, 0.9, 1.0});
+    auto match = synchronizer.find_similar_pattern({0.8, 0.9, 1.0});
+    EXPECT_EQ(match.matched_pattern, "nominal");
+    ASSERT_EQ(match.match_confidence.size(), 2u);
+    EXPECT_GT(match.match_confidence[0], match.match_confidence[1]);
+
+    // Recorded snapshots (5 primary + 3 secondary + 2 tertiary values) are searchable
+    for (int i = 0; i < 20; ++i) {
+        synchronizer.synchronize_temporal_flows();
+    }
+    auto recorded = synchronizer.find_similar_patterns(std::vector<double>(10, 1.0), 5);
+    ASSERT_EQ(recorded.size(), 5u);
+    EXPECT_EQ(recorded[0].matched_pattern, "history");
+    EXPECT_GT(recorded[0].similarity_score, 0.5);
+}
+
+TEST(PatternIndexTest, AddsDuringRetrainStayFindable) {
+    PatternIndex::Config config;
+    config.ivf_threshold = 1024;
+    PatternIndex index(kDims, config);
+    for (const auto& row : make_library(4096, 7)) {
+        index.add(row, "library");
+    }
+    ASSERT_TRUE(index.is_indexed());
+
+    // Retrains run outside the index lock, so adds and searches interleave
+    // with them and every add must survive the swap to the new index
+    std::atomic<bool> done{false};
+    std::thread trainer([&] {
+        while (!done.load()) {
+            index.rebuild();
+        }
+    });
+    size_t found = 0;
+    const auto additions = make_library(2000, 11);
+    for (size_t i = 0; i < additions.size(); ++i) {
+        std::vector<double> row = additions[i];
+        row[0] += 10.0 + static_cast<double>(i);  // far from everything else
+        std::string label = "added" + std::to_string(i);
+        index.add(row, label);
+        auto neighbors = index.search(row, 1);
+        found += !neighbors.empty() && neighbors[0].label == label;
+    }
+    done.store(true);
+    trainer.join();
+    EXPECT_EQ(found, additions.size());
+
+    index.rebuild();
+    size_t still_found = 0;
+    for (size_t i = 0; i < additions.size(); ++i) {
+        std::vector<double> row = additions[i];
+        row[0] += 10.0 + static_cast<double>(i);
+        auto neighbors = index.search(row, 1);
+        still_found += !neighbors.empty() && neighbors[0].label == "added" + std::to_string(i);
+    }
+    EXPECT_EQ(still_found, additions.size());
+    EXPECT_EQ(index.size(), 4096u + additions.size());
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <chronovyan/procfs_metric_sources.hpp>
+#include <chronovyan/metric_collector.hpp>
+#include <chronovyan/mode_decision_engine.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace chronovyan;
+
+// Counting global operator new: sampling must not allocate
+namespace {
+std::atomic<size_t> allocation_count{0};
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// Fake procfs files in a scratch directory. Rewriting truncates in place,
+// so sources that keep the file open see the new contents.
+class ProcfsFixture : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/chronovyan_procfs_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir = pattern;
+    }
+
+    void TearDown() override {
+        std::system(("rm -rf " + dir).c_str());
+    }
+
+    std::string write(const std::string& name, const std::string& contents) {
+        std::string path = dir + "/" + name;
+        std::ofstream(path, std::ios::trunc) << contents;
+        return path;
+    }
+
+    std::string dir;
+};
+
+std::string stat_text(unsigned busy0, unsigned idle0, unsigned busy1, unsigned idle1) {
+    // user nice system idle iowait irq softirq steal guest guest_nice
+    char text[512];
+    std::snprintf(text, sizeof(text),
+                  "cpu  %u 0 0 %u 0 0 0 0 0 0\n"
+                  "cpu0 %u 0 0 %u 0 0 0 0 0 0\n"
+                  "cpu1 %u 0 0 %u 0 0 0 0 0 0\n"
+                  "intr 12345 0 0 0\n"
+                  "ctxt 999\n",
+                  busy0 + busy1, idle0 + idle1, busy0, idle0, busy1, idle1);
+    return text;
+}
+
+const char* kMeminfo =
+    "MemTotal:       16000000 kB\n"
+    "MemFree:         2000000 kB\n"
+    "MemAvailable:    4000000 kB\n"
+    "Buffers:          100000 kB\n";
+
+} // namespace
+
+TEST_F(ProcfsFixture, CpuUsageFromJiffyDeltas) {
+    std::string path = write("stat", stat_text(100, 100, 100, 100));
+    CpuUsageSource cpu(path);
+    ASSERT_TRUE(cpu.isAvailable());
+
+    // First sample: since boot
+    EXPECT_DOUBLE_EQ(cpu.getValue(), 50.0);
+    ASSERT_EQ(cpu.core_count(), 2u);
+
+    // core0 fully busy, core1 idle over the interval
+    write("stat", stat_text(200, 100, 100, 200));
+    EXPECT_DOUBLE_EQ(cpu.getValue(), 50.0);
+    EXPECT_DOUBLE_EQ(cpu.core_usage(0), 100.0);
+    EXPECT_DOUBLE_EQ(cpu.core_usage(1), 0.0);
+
+    // No jiffies elapsed: the previous figures stand
+    EXPECT_DOUBLE_EQ(cpu.getValue(), 50.0);
+    EXPECT_DOUBLE_EQ(cpu.core_usage(0), 100.0);
+
+    // iowait counts as idle
+    write("stat", "cpu  350 0 0 300 150 0 0 0 0 0\n");
+    EXPECT_DOUBLE_EQ(cpu.getValue(), 25.0);
+    EXPECT_EQ(cpu.core_count(), 0u);
+}
+
+TEST_F(ProcfsFixture, MemoryFromMeminfoWhenNoCgroupLimit) {
+    MemoryUsageSource::Paths paths;
+    paths.meminfo = write("meminfo", kMeminfo);
+    paths.cgroup_dir = dir + "/missing";
+    MemoryUsageSource memory(paths);
+
+    ASSERT_TRUE(memory.isAvailable());
+    EXPECT_DOUBLE_EQ(memory.getValue(), 75.0);
+    EXPECT_FALSE(memory.is_cgroup_limited());
+    EXPECT_EQ(memory.used_bytes(), 12000000ull * 1024);
+
+    // An unlimited cgroup also falls back to the host view
+    write("memory.current", "1048576\n");
+    write("memory.max", "max\n");
+    paths.cgroup_dir = dir;
+    MemoryUsageSource unlimited(paths);
+    EXPECT_DOUBLE_EQ(unlimited.getValue(), 75.0);
+    EXPECT_FALSE(unlimited.is_cgroup_limited());
+}
+
+TEST_F(ProcfsFixture, MemoryPrefersCgroupLimit) {
+    MemoryUsageSource::Paths paths;
+    paths.meminfo = write("meminfo", kMeminfo);
+    write("memory.current", "268435456\n");
+    write("memory.max", "1073741824\n");
+    paths.cgroup_dir = dir;
+    MemoryUsageSource memory(paths);
+
+    EXPECT_DOUBLE_EQ(memory.getValue(), 25.0);
+    EXPECT_TRUE(memory.is_cgroup_limited());
+    EXPECT_EQ(memory.limit_bytes(), 1073741824ull);
+
+    write("memory.current", "805306368\n");
+    EXPECT_DOUBLE_EQ(memory.getValue(), 75.0);
+}
+
+TEST_F(ProcfsFixture, MissingFilesAreUnavailable) {
+    CpuUsageSource cpu(dir + "/no_such_stat");
+    EXPECT_FALSE(cpu.isAvailable());
+    EXPECT_EQ(cpu.getValue(), 0.0);
+
+    // Malformed contents make the source unavailable until a good read
+    std::string path = write("stat", "garbage\n");
+    CpuUsageSource bad(path);
+    EXPECT_EQ(bad.getValue(), 0.0);
+    EXPECT_FALSE(bad.isAvailable());
+    write("stat", stat_text(1, 1, 1, 1));
+    bad.getValue();
+    EXPECT_TRUE(bad.isAvailable());
+
+    EXPECT_THROW(create_metric_source("gpu"), std::invalid_argument);
+}
+
+TEST_F(ProcfsFixture, StatOfEveryCoreFitsTheBuffer) {
+    // kMaxCores lines of 20-digit counters followed by a long intr line:
+    // well past 16 KB, yet every core is read
+    std::string huge = std::to_string(10000000000000000000ull);
+    std::string text = "cpu  1 0 0 1 0 0 0 0 0 0\n";
+    for (size_t core = 0; core < CpuUsageSource::kMaxCores; ++core) {
+        text += "cpu" + std::to_string(core);
+        for (int field = 0; field < 10; ++field) {
+            text += " " + huge;
+        }
+        text += "\n";
+    }
+    text += "intr";
+    for (int irq = 0; irq < 4000; ++irq) {
+        text += " 12345";
+    }
+    text += "\nctxt 999\n";
+    ASSERT_GT(text.size(), ProcFile::kDefaultBufferSize);
+
+    CpuUsageSource cpu(write("stat", text));
+    cpu.getValue();
+    EXPECT_TRUE(cpu.isAvailable());
+    EXPECT_EQ(cpu.core_count(), CpuUsageSource::kMaxCores);
+
+    // A final line without its newline may be cut short and is rejected
+    write("stat", "cpu  350 0 0 300 150 0 0 0 0 0");
+    EXPECT_EQ(cpu.getValue(), 0.0);
+    EXPECT_FALSE(cpu.isAvailable());
+}
+
+TEST(ProcfsMetricSourcesTest, LiveProcessSources) {
+    ProcessUsageSource rss(ProcessUsageSource::Metric::Rss);
+    ProcessUsageSource cpu(ProcessUsageSource::Metric::Cpu);
+    ASSERT_TRUE(rss.isAvailable());
+    ASSERT_TRUE(cpu.isAvailable());
+
+    double resident = rss.getValue();
+    EXPECT_GT(rss.resident_bytes(), 0u);
+    EXPECT_GT(resident, 0.0);
+    EXPECT_LE(resident, 100.0);
+
+    EXPECT_EQ(cpu.getValue(), 0.0);  // baseline
+    auto start = std::chrono::steady_clock::now();
+    volatile double sink = 0.0;
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100)) {
+        sink = sink + 1.0;
+    }
+    EXPECT_GT(cpu.getValue(), 0.0);
+    EXPECT_LE(cpu.getValue(), 100.0);
+}
+
+TEST(ProcfsMetricSourcesTest, SamplingDoesNotAllocate) {
+    CpuUsageSource cpu;
+    MemoryUsageSource memory;
+    ProcessUsageSource process_cpu(ProcessUsageSource::Metric::Cpu);
+    ProcessUsageSource process_rss(ProcessUsageSource::Metric::Rss);
+    const IMetricSource* sources[] = {&cpu, &memory, &process_cpu, &process_rss};
+
+    size_t before = allocation_count.load();
+    for (int i = 0; i < 100; ++i) {
+        for (const IMetricSource* source : sources) {
+            source->getValue();
+            source->isAvailable();
+        }
+    }
+    EXPECT_EQ(allocation_count.load() - before, 0u);
+}
+
+TEST(ProcfsMetricSourcesTest, DrivesCollectorAndDecisionEngine) {
+    auto cpu = create_metric_source("cpu");
+    auto memory = create_metric_source("memory");
+    // No GPU backend on procfs; the process share stands in for the third slot
+    auto process = create_metric_source("process_cpu");
+    MetricCollector collector(cpu.get(), memory.get(), process.get());
+
+    SystemMetrics metrics = collector.collect_metrics();
+    EXPECT_TRUE(metrics.is_valid);
+    EXPECT_FALSE(metrics.has_exception);
+    EXPECT_FALSE(metrics.is_stale);
+    EXPECT_TRUE(metrics.metrics["cpu"].is_available);
+    EXPECT_TRUE(metrics.metrics["memory"].is_available);
+    EXPECT_GT(metrics.memory_usage, 0.0);
+
+    ModeDecisionEngine engine;
+    ModeDecision decision = engine.makeDecision(metrics);
+    EXPECT_FALSE(decision.reason_text().empty());
+}
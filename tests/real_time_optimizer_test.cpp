@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "chronovyan/real_time_optimizer.hpp"
+#include "chronovyan/windowed_stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+// Full rescans of the window, as the optimizer computed them before
+struct Reference {
+    double mean = 0.0;
+    double weighted = 0.0;
+    double trend = 0.0;
+};
+
+Reference rescan(const std::deque<double>& window) {
+    Reference r;
+    double weight_sum = 0.0;
+    for (size_t i = 0; i < window.size(); ++i) {
+        double weight = std::exp(-0.1 * (window.size() - i - 1));
+        r.mean += window[i];
+        r.weighted += weight * window[i];
+        weight_sum += weight;
+    }
+    r.mean /= window.size();
+    r.weighted /= weight_sum;
+    r.trend = window.front();
+    for (size_t i = 1; i < window.size(); ++i) {
+        r.trend = 0.3 * window[i] + 0.7 * r.trend;
+    }
+    return r;
+}
+
+} // namespace
+
+TEST(WindowedStatsTest, IncrementalAggregatesMatchRescan) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-50.0, 150.0);
+    for (size_t capacity : {1u, 2u, 7u, 100u}) {
+        WindowedStats<1> stats(capacity);
+        std::deque<double> window;
+        for (int i = 0; i < 5000; ++i) {
+            double x = dist(gen);
+            stats.push({{x}});
+            window.push_back(x);
+            if (window.size() > capacity) {
+                window.pop_front();
+            }
+            ASSERT_EQ(stats.size(), window.size());
+            Reference expected = rescan(window);
+            ASSERT_NEAR(stats.mean(0), expected.mean, 1e-9) << capacity << " @ " << i;
+            ASSERT_NEAR(stats.weighted_mean(0), expected.weighted, 1e-9) << capacity << " @ " << i;
+            ASSERT_NEAR(stats.trend(0), expected.trend, 1e-9) << capacity << " @ " << i;
+        }
+        EXPECT_DOUBLE_EQ(stats.at(0)[0], window.front());
+    }
+}
+
+TEST(WindowedStatsTest, RunningSumDoesNotDriftOverLongStreams) {
+    // Large values followed by small ones: a naive running sum would keep
+    // the rounding error of the evicted large values
+    WindowedStats<1> stats(10);
+    for (int i = 0; i < 100000; ++i) {
+        stats.push({{1e12 + i}});
+    }
+    for (int i = 0; i < 10; ++i) {
+        stats.push({{0.1}});
+    }
+    EXPECT_NEAR(stats.mean(0), 0.1, 1e-12);
+
+    WindowedStats<1> empty(0);
+    empty.push({{1.0}});
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(RealTimeOptimizerTest, ThresholdFollowsWindowAverages) {
+    RealTimeOptimizer optimizer(0.5, 0.1, 0.9, 50);
+    OptimizationMetrics good;
+    good.sync_efficiency = 1.0;
+    good.stability = 1.0;
+    good.error_rate = 0.0;
+    for (int i = 0; i < 20; ++i) {
+        optimizer.update_metrics(good);
+    }
+    EXPECT_DOUBLE_EQ(optimizer.get_current_threshold(), 0.9);
+
+    OptimizationMetrics bad;
+    bad.sync_efficiency = 0.0;
+    bad.stability = 0.0;
+    bad.error_rate = 100.0;
+    // The threshold only falls once the window average drops below 0.5
+    for (int i = 0; i < 20; ++i) {
+        optimizer.update_metrics(bad);
+    }
+    EXPECT_DOUBLE_EQ(optimizer.get_current_threshold(), 0.9);
+    for (int i = 0; i < 50; ++i) {
+        optimizer.update_metrics(bad);
+    }
+    EXPECT_DOUBLE_EQ(optimizer.get_current_threshold(), 0.1);
+}
+
+TEST(RealTimeOptimizerTest, PerformanceMetricsTrackRecentSamples) {
+    RealTimeOptimizer optimizer(0.5, 0.1, 0.9, 1000);
+    OptimizationMetrics first;
+    first.sync_efficiency = 0.2;
+    first.stability = 0.3;
+    first.error_rate = 40.0;
+    optimizer.update_metrics(first);
+    OptimizationMetrics only = optimizer.get_performance_metrics();
+    EXPECT_DOUBLE_EQ(only.sync_efficiency, 0.2);
+    EXPECT_DOUBLE_EQ(only.error_rate, 40.0);
+
+    OptimizationMetrics later = first;
+    later.sync_efficiency = 0.9;
+    later.error_rate = 5.0;
+    for (int i = 0; i < 30; ++i) {
+        optimizer.update_metrics(later);
+    }
+    OptimizationMetrics trend = optimizer.get_performance_metrics();
+    EXPECT_NEAR(trend.sync_efficiency, 0.9, 1e-4);
+    EXPECT_NEAR(trend.stability, 0.3, 1e-12);
+    EXPECT_NEAR(trend.error_rate, 5.0, 1e-3);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "script_host.h"
+#include "error_handler.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+
+namespace {
+
+std::unique_ptr<ExprNode> variable(const std::string& name) {
+    return std::make_unique<VariableExprNode>(name);
+}
+
+// DECLARE CONF x = 0; FOR_CHRONON(iterations) { x = x + 1; } x
+std::shared_ptr<const CompiledScript> counting_script(int64_t iterations) {
+    std::vector<std::unique_ptr<StmtNode>> body;
+    body.push_back(std::make_unique<ExprStmtNode>(std::make_unique<AssignExprNode>(
+        "x", std::make_unique<BinaryExprNode>(variable("x"), Token(TokenType::PLUS, "+", SourceLocation()),
+                                              std::make_unique<LiteralExprNode>(int64_t{1})))));
+    std::vector<std::unique_ptr<ExprNode>> arguments;
+    arguments.push_back(std::make_unique<LiteralExprNode>(iterations));
+
+    std::vector<std::unique_ptr<StmtNode>> statements;
+    statements.push_back(std::make_unique<VariableDeclStmtNode>(
+        "x", nullptr, VariableModifier::CONF, std::vector<VariableFlag>{},
+        std::make_unique<LiteralExprNode>(int64_t{0})));
+    statements.push_back(std::make_unique<TemporalOpStmtNode>(
+        TemporalOpType::FOR_CHRONON, std::move(arguments), std::make_unique<BlockStmtNode>(std::move(body))));
+    statements.push_back(std::make_unique<ExprStmtNode>(variable("x")));
+    return std::make_shared<const CompiledScript>(
+        "counting", std::make_unique<ProgramNode>(std::move(statements)));
+}
+
+std::shared_ptr<const CompiledScript> reading_script(const std::string& name) {
+    std::vector<std::unique_ptr<StmtNode>> statements;
+    statements.push_back(std::make_unique<ExprStmtNode>(variable(name)));
+    return std::make_shared<const CompiledScript>("reading", std::make_unique<ProgramNode>(std::move(statements)));
+}
+
+} // namespace
+
+TEST(ScriptHostTest, CompileCachesBySourceAndName) {
+    ScriptHost host(2);
+    auto first = host.compile("DECLARE CONF x = 1;", "a.cvy");
+    auto again = host.compile("DECLARE CONF x = 1;", "a.cvy");
+    EXPECT_EQ(first, again);
+    EXPECT_EQ(first->getName(), "a.cvy");
+    EXPECT_EQ(host.getCacheHits(), 1u);
+    EXPECT_EQ(host.getCacheMisses(), 1u);
+
+    // The same source under another name is a separate script
+    auto renamed = host.compile("DECLARE CONF x = 1;", "b.cvy");
+    EXPECT_NE(renamed, first);
+    EXPECT_EQ(host.getCachedScriptCount(), 2u);
+
+    // a.cvy was used less recently than b.cvy, so it is evicted first
+    host.compile("DECLARE CONF y = 2;", "c.cvy");
+    EXPECT_EQ(host.getCachedScriptCount(), 2u);
+    EXPECT_EQ(host.compile("DECLARE CONF x = 1;", "b.cvy"), renamed);
+    EXPECT_NE(host.compile("DECLARE CONF x = 1;", "a.cvy"), first);
+    EXPECT_EQ(host.getCacheMisses(), 4u);
+
+    // An evicted script stays valid for whoever holds it
+    EXPECT_NO_THROW(host.run(*first));
+}
+
+TEST(ScriptHostTest, CompileLeavesEarlierErrorsAlone) {
+    // An error the embedding process reported before compiling is neither
+    // blamed on the script nor cleared
+    auto& errorHandler = ErrorHandler::getInstance();
+    errorHandler.clearErrors();
+    errorHandler.reportError(SourceLocation(), "earlier failure");
+
+    ScriptHost host;
+    auto script = host.compile("DECLARE CONF x = 1;", "fine.cvy");
+    ASSERT_NE(script, nullptr);
+    ASSERT_EQ(errorHandler.getErrors().size(), 1u);
+    EXPECT_EQ(errorHandler.getErrors().front().message, "earlier failure");
+
+    errorHandler.clearErrorsAfter(0);
+    EXPECT_FALSE(errorHandler.hasErrors());
+}
+
+TEST(ScriptHostTest, EveryRunStartsFresh) {
+    ScriptHost host;
+    auto script = counting_script(60);
+
+    // 60 chronons a run: a second run on the same budget would run out, and
+    // x would already be declared
+    for (int run = 0; run < 3; ++run) {
+        EXPECT_EQ(host.run(*script).asInteger(), 60);
+    }
+    EXPECT_EQ(host.getInterpreterCount(), 1u);
+
+    // Variables of earlier runs are gone
+    EXPECT_ANY_THROW(host.run(*reading_script("x")));
+
+    // A failed run returns its interpreter to the pool in a usable state
+    EXPECT_EQ(host.getInterpreterCount(), 1u);
+    EXPECT_EQ(host.run(*script).asInteger(), 60);
+    EXPECT_FALSE(ErrorHandler::getInstance().hasErrors());
+}
+
+TEST(ScriptHostTest, InterpreterResetKeepsSettings) {
+    Interpreter interpreter;
+    auto profiler = std::make_shared<LoopProfiler>();
+    interpreter.setLoopProfiler(profiler);
+    auto script = counting_script(60);
+
+    EXPECT_EQ(interpreter.run(script->getProgram()).asInteger(), 60);
+    EXPECT_DOUBLE_EQ(interpreter.getRuntime()->getChrononsLevel(), 40.0);
+    EXPECT_THROW(interpreter.run(script->getProgram()), std::runtime_error);
+
+    interpreter.reset();
+    EXPECT_DOUBLE_EQ(interpreter.getRuntime()->getChrononsLevel(), 100.0);
+    EXPECT_FALSE(interpreter.getGlobalEnvironment()->contains("x"));
+    EXPECT_EQ(interpreter.getLoopProfiler(), profiler);
+    EXPECT_EQ(interpreter.run(script->getProgram()).asInteger(), 60);
+}
+
+TEST(ScriptHostTest, ConcurrentRunsShareOneCompiledScript) {
+    ScriptHost host;
+    auto script = counting_script(20);
+    std::atomic<int> correct{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int run = 0; run < 25; ++run) {
+                if (host.run(*script).asInteger() == 20) {
+                    ++correct;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(correct.load(), 100);
+    EXPECT_GE(host.getInterpreterCount(), 1u);
+    EXPECT_LE(host.getInterpreterCount(), 4u);
+}
+
+TEST(ScriptHostTest, ConcurrentRunsRecordEveryIteration) {
+    ScriptHost host;
+    auto profiler = std::make_shared<LoopProfiler>();
+    host.setLoopProfiler(profiler);
+    auto script = counting_script(20);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int run = 0; run < 50; ++run) {
+                host.run(*script);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+#if CHRONOVYAN_LOOP_PROFILING
+    // Every pooled interpreter records into the script's one site
+    auto reports = profiler->reports();
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].executions, 200u);
+    EXPECT_EQ(reports[0].iterations, 4000u);
+    EXPECT_DOUBLE_EQ(reports[0].resources, 4000.0);
+#endif
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "chronovyan/stability_analyzer.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::stability;
+
+namespace {
+
+StabilityEvent sample(StabilityMetricType type, double value) {
+    return StabilityEvent(std::chrono::system_clock::now(), type, value, "sample");
+}
+
+} // namespace
+
+TEST(StabilityAnalyzerTest, ScoresVariabilityPerMetricOverTheWindow) {
+    StabilityAnalyzer analyzer(4);
+    StabilityMetrics metrics = analyzer.analyze_stability();
+    EXPECT_DOUBLE_EQ(metrics.overall_stability, 1.0);
+
+    // mean 2, stddev 1: 1 / (1 + 0.5)
+    for (double value : {1.0, 3.0, 1.0, 3.0}) {
+        analyzer.add_event(sample(StabilityMetricType::Temporal, value));
+    }
+    for (int i = 0; i < 10; ++i) {
+        analyzer.add_event(sample(StabilityMetricType::Resource, 5.0));
+    }
+    metrics = analyzer.analyze_stability();
+    EXPECT_NEAR(metrics.temporal_stability, 2.0 / 3.0, 1e-9);
+    EXPECT_DOUBLE_EQ(metrics.resource_stability, 1.0);
+    EXPECT_DOUBLE_EQ(metrics.performance_stability, 1.0);
+    EXPECT_NEAR(metrics.overall_stability, (2.0 / 3.0 + 3.0) / 4.0, 1e-9);
+
+    // The noisy samples slide out of the four-sample window
+    for (int i = 0; i < 4; ++i) {
+        analyzer.add_event(sample(StabilityMetricType::Temporal, 2.0));
+    }
+    EXPECT_DOUBLE_EQ(analyzer.analyze_stability().temporal_stability, 1.0);
+
+    analyzer.add_event(sample(StabilityMetricType::Error, 1.0));
+    analyzer.add_event(sample(StabilityMetricType::Error, -1.0));
+    EXPECT_DOUBLE_EQ(analyzer.stability(StabilityMetricType::Error), 0.0);
+}
+
+TEST(StabilityAnalyzerTest, CallbacksFireOnlyOnThresholdCrossings) {
+    StabilityAnalyzer analyzer(8);
+    std::vector<StabilityEvent> crossings;
+    analyzer.add_callback([&](const StabilityEvent& event) { crossings.push_back(event); });
+
+    for (int i = 0; i < 8; ++i) {
+        analyzer.add_event(sample(StabilityMetricType::Performance, 10.0));
+    }
+    analyzer.process();
+    EXPECT_TRUE(crossings.empty());
+
+    // Alternating 1 and 3 settles at 0.667: warning
+    for (int i = 0; i < 16; ++i) {
+        analyzer.add_event(sample(StabilityMetricType::Performance, i % 2 ? 3.0 : 1.0));
+    }
+    analyzer.process();
+    ASSERT_FALSE(crossings.empty());
+    EXPECT_EQ(crossings.back().type, StabilityMetricType::Performance);
+    EXPECT_EQ(StabilityAnalyzer::band(crossings.back().value, analyzer.get_thresholds()), 2);
+    EXPECT_EQ(crossings.front().description.find("performance stability fell to"), 0u);
+    EXPECT_NE(crossings.back().description.find("warning"), std::string::npos);
+    for (size_t i = 1; i < crossings.size(); ++i) {
+        EXPECT_NE(StabilityAnalyzer::band(crossings[i].value, analyzer.get_thresholds()),
+                  StabilityAnalyzer::band(crossings[i - 1].value, analyzer.get_thresholds()));
+    }
+
+    // Staying in the same band is silent
+    const size_t fired = crossings.size();
+    for (int i = 0; i < 16; ++i) {
+        analyzer.add_event(sample(StabilityMetricType::Performance, i % 2 ? 3.0 : 1.0));
+    }
+    analyzer.process();
+    EXPECT_EQ(crossings.size(), fired);
+
+    // Raising the warning threshold above the score is a crossing too
+    StabilityThresholds strict;
+    strict.warning_threshold = 0.7;
+    analyzer.set_thresholds(strict);
+    ASSERT_EQ(crossings.size(), fired + 1);
+    EXPECT_EQ(StabilityAnalyzer::band(crossings.back().value, strict), 1);
+
+    analyzer.clear_events();
+    EXPECT_DOUBLE_EQ(analyzer.stability(StabilityMetricType::Performance), 1.0);
+}
+
+TEST(StabilityAnalyzerTest, IngestsFromManyThreads) {
+    StabilityAnalyzer analyzer(1024, 1 << 16);
+    const int kThreads = 8;
+    const int kPerThread = 4000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&analyzer, t] {
+            auto type = static_cast<StabilityMetricType>(t % 4);
+            for (int k = 0; k < kPerThread; ++k) {
+                analyzer.add_event(sample(type, 4.0));
+            }
+        });
+    }
+    std::thread reader([&analyzer] {
+        for (int i = 0; i < 200; ++i) {
+            StabilityMetrics metrics = analyzer.analyze_stability();
+            EXPECT_DOUBLE_EQ(metrics.overall_stability, 1.0);
+        }
+    });
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    reader.join();
+    EXPECT_EQ(analyzer.dropped(), 0u);
+    analyzer.process();
+    EXPECT_DOUBLE_EQ(analyzer.analyze_stability().overall_stability, 1.0);
+}
+
+TEST(StabilityAnalyzerTest, ConcurrentDrainersDeliverCrossingsInOrder) {
+    StabilityAnalyzer analyzer(2, 64);
+    const StabilityThresholds thresholds = analyzer.get_thresholds();
+    int band = StabilityAnalyzer::band(1.0, thresholds);
+    size_t delivered = 0;
+    size_t out_of_order = 0;
+    analyzer.add_callback([&](const StabilityEvent& event) {
+        // Each crossing must leave the band the previous one entered
+        int next = StabilityAnalyzer::band(event.value, thresholds);
+        bool fell = event.description.find("fell to") != std::string::npos;
+        if (next == band || fell != (next < band)) {
+            ++out_of_order;
+        }
+        band = next;
+        ++delivered;
+        std::this_thread::yield();  // widen the window for another drainer
+    });
+
+    // A two-sample window flips between steady and noisy with every event
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&analyzer, t] {
+            for (int k = 0; k < 2000; ++k) {
+                analyzer.add_event(sample(StabilityMetricType::Temporal, (k + t) % 3 ? 2.0 : 6.0));
+                if (k % 4 == 0) {
+                    analyzer.process();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    analyzer.process();
+    EXPECT_GT(delivered, 0u);
+    EXPECT_EQ(out_of_order, 0u);
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "chronovyan/mpsc_log.hpp"
+#include "chronovyan/state_controller.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records notifications together with the mode published when they arrive
+class RecordingNotifications : public INotificationService {
+public:
+    void notifyModeChange(PerformanceMode new_mode, const std::string&) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        modes.push_back(new_mode);
+        if (controller && controller->getCurrentMode() != new_mode) {
+            ++stale_reads;
+        }
+    }
+    void notifyError(const std::string&) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++errors;
+    }
+
+    const StateController* controller = nullptr;
+    std::vector<PerformanceMode> modes;
+    size_t stale_reads = 0;
+    size_t errors = 0;
+
+private:
+    std::mutex mutex_;
+};
+
+ModeDecision decision(PerformanceMode mode, const char* reason = "load") {
+    ModeDecision result;
+    result.mode = mode;
+    result.reason = reason;
+    return result;
+}
+
+StateControllerConfig no_cooldown() {
+    StateControllerConfig config;
+    config.cooldown = 0ms;
+    return config;
+}
+
+} // namespace
+
+TEST(StateControllerTest, PublishesVersionedSnapshots) {
+    auto notifications = std::make_shared<RecordingNotifications>();
+    StateController controller(std::make_shared<ModeDecisionEngine>(), notifications, no_cooldown());
+    notifications->controller = &controller;
+
+    ModeSnapshot initial = controller.getModeSnapshot();
+    EXPECT_EQ(initial.mode, PerformanceMode::Balanced);
+    EXPECT_GT(initial.version, 0u);
+
+    controller.updateMode(decision(PerformanceMode::Lean));
+    ModeSnapshot after = controller.getModeSnapshot();
+    EXPECT_EQ(after.mode, PerformanceMode::Lean);
+    EXPECT_TRUE(after.is_cooling_down);
+    EXPECT_GT(after.version, initial.version);
+
+    // Notifications arrive after the new mode is visible
+    ASSERT_EQ(notifications->modes.size(), 1u);
+    EXPECT_EQ(notifications->stale_reads, 0u);
+
+    ModeDecision failure = decision(PerformanceMode::Lean, "critical: complete sensor failure");
+    failure.requires_fallback = true;
+    controller.updateMode(failure);
+    ModeSnapshot fallback = controller.getModeSnapshot();
+    EXPECT_TRUE(fallback.is_fallback_mode);
+    EXPECT_TRUE(fallback.is_error_state);
+    EXPECT_EQ(controller.getErrorDetails(), "critical: complete sensor failure");
+    EXPECT_EQ(notifications->errors, 1u);
+}
+
+TEST(StateControllerTest, ReadersRunConcurrentlyWithWriters) {
+    auto notifications = std::make_shared<RecordingNotifications>();
+    StateController controller(std::make_shared<ModeDecisionEngine>(), notifications, no_cooldown());
+    notifications->controller = &controller;
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> reads{0};
+    std::atomic<size_t> ordering_errors{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            uint64_t last_version = 0;
+            while (!done.load()) {
+                ModeSnapshot snapshot = controller.getModeSnapshot();
+                if (snapshot.version < last_version) {
+                    ++ordering_errors;
+                }
+                last_version = snapshot.version;
+                ++reads;
+            }
+        });
+    }
+
+    constexpr int kWriters = 3;
+    constexpr int kUpdates = 2000;
+    const PerformanceMode modes[] = {PerformanceMode::HighFidelity, PerformanceMode::Balanced,
+                                     PerformanceMode::Lean};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < kUpdates; ++i) {
+                controller.updateMode(decision(modes[(w + i) % 3]));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(ordering_errors.load(), 0u);
+    EXPECT_EQ(notifications->modes.size(), static_cast<size_t>(kWriters * kUpdates));
+    EXPECT_EQ(controller.getModeHistory().size(), StateControllerConfig().history_entries);
+    EXPECT_EQ(controller.getTransitionHistory().size(), StateControllerConfig().history_entries);
+}
+
+TEST(StateControllerTest, CooldownAndTestingFlagsArePerInstance) {
+    auto notifications = std::make_shared<RecordingNotifications>();
+    StateControllerConfig config;
+    config.cooldown = 50ms;
+    StateController first(std::make_shared<ModeDecisionEngine>(), notifications, config);
+    StateController second(std::make_shared<ModeDecisionEngine>(), notifications, config);
+
+    first.updateMode(decision(PerformanceMode::Lean));
+    EXPECT_TRUE(first.isInCooldown());
+    EXPECT_GT(first.timeUntilNextSwitch(), 0ms);
+
+    // Blocked by the cooldown
+    first.updateMode(decision(PerformanceMode::HighFidelity));
+    EXPECT_EQ(first.getCurrentMode(), PerformanceMode::Lean);
+
+    first.setForceCooldownForTesting(true);
+    EXPECT_FALSE(second.isInCooldown());
+    EXPECT_FALSE(second.getForceCooldownForTesting());
+    second.updateMode(decision(PerformanceMode::HighFidelity));
+    EXPECT_EQ(second.getCurrentMode(), PerformanceMode::HighFidelity);
+
+    first.setForceCooldownForTesting(false);
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(first.isInCooldown());
+    first.updateMode(decision(PerformanceMode::HighFidelity));
+    EXPECT_EQ(first.getCurrentMode(), PerformanceMode::HighFidelity);
+}
+
+TEST(MpscLogTest, KeepsTheMostRecentEntriesPerProducerInOrder) {
+    MpscLog<std::pair<int, int>> log(64, 32);
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+    std::vector<std::thread> producers;
+    std::atomic<size_t> accepted{0};
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                if (log.push({p, i})) {
+                    ++accepted;
+                }
+                if (i % 256 == 0) {
+                    log.snapshot();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(accepted.load() + log.dropped(), static_cast<size_t>(kProducers * kPerProducer));
+    auto entries = log.snapshot();
+    ASSERT_EQ(entries.size(), 32u);
+    std::map<int, int> last;
+    for (const auto& entry : entries) {
+        auto found = last.find(entry.first);
+        if (found != last.end()) {
+            EXPECT_GT(entry.second, found->second);
+        }
+        last[entry.first] = entry.second;
+    }
+}
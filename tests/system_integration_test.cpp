@@ -57,13 +57,15 @@ protected:
         
         // Disable test forcing by default
         decision_engine->setForceModeForTesting(PerformanceMode::Balanced, false);
-        StateController::setForceCooldownForTesting(false);
+        ModeDecisionEngine::setForceStableForTesting(false);
+        state_controller->setForceCooldownForTesting(false);
     }
     
     void TearDown() override {
         // Clean up any test-specific state
         decision_engine->setForceModeForTesting(PerformanceMode::Balanced, false);
-        StateController::setForceCooldownForTesting(false);
+        ModeDecisionEngine::setForceStableForTesting(false);
+        state_controller->setForceCooldownForTesting(false);
     }
     
     // Helper method to set up normal metrics
@@ -108,22 +110,22 @@ protected:
         // Debug output to help diagnose test failures
         std::cout << "***** DEBUG: MODE DECISION *****" << std::endl;
         std::cout << "Mode: " << static_cast<int>(decision.mode) << std::endl;
-        std::cout << "Reason: " << decision.reason << std::endl;
+        std::cout << "Reason: " << decision.reason_text() << std::endl;
         std::cout << "Is Error: " << (decision.is_error_state ? "true" : "false") << std::endl;
         std::cout << "Is Fallback: " << (decision.is_fallback_mode ? "true" : "false") << std::endl;
         std::cout << "Is Conservative: " << (decision.is_conservative ? "true" : "false") << std::endl;
         std::cout << "*******************************" << std::endl;
         
         // For testing recovery, force direct mode set to bypass cooldown
-        if (decision.reason == "recovered") {
+        if (decision.code == DecisionReason::Recovered) {
             std::cout << "Detected recovery decision - forcing direct mode set" << std::endl;
-            StateController::setDirectModeSetForTesting(true);
+            state_controller->setDirectModeSetForTesting(true);
         }
         
         state_controller->updateMode(decision);
         
         // Reset the testing flag
-        StateController::setDirectModeSetForTesting(false);
+        state_controller->setDirectModeSetForTesting(false);
     }
     
     std::unique_ptr<MockMetricSourceImpl> cpu_source;
@@ -138,7 +140,7 @@ protected:
 // Test normal mode switching
 TEST_F(SystemIntegrationTest, SwitchesModeCorrectly_OnDecisionEngineOutput) {
     // Allow direct mode setting to bypass cooldown
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Force the initial mode to be different from what we expect at the end
     ModeDecision initial_decision;
@@ -168,13 +170,13 @@ TEST_F(SystemIntegrationTest, SwitchesModeCorrectly_OnDecisionEngineOutput) {
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Lean);
 
     // Reset testing flag
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Test cooldown enforcement
 TEST_F(SystemIntegrationTest, EnforcesCooldown_AfterModeSwitch) {
     // Force the initial mode to be different from Balanced to ensure a mode change happens
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     ModeDecision initial_decision;
     initial_decision.mode = PerformanceMode::Lean;
     initial_decision.reason = "Test initialization";
@@ -368,7 +370,7 @@ TEST_F(SystemIntegrationTest, RecoversFromTemporaryFailure_AndRestoresAppropriat
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Balanced);
     
     // Reset the direct mode setting flag
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Test handling of rapid metric fluctuations
@@ -378,7 +380,7 @@ TEST_F(SystemIntegrationTest, HandlesRapidMetricFluctuations) {
     decision_engine->setForceStableForTesting(true);
     
     // Force direct mode setting to bypass cooldown for the initial setup
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Initialize to Balanced mode directly 
     ModeDecision initial_decision;
@@ -393,7 +395,7 @@ TEST_F(SystemIntegrationTest, HandlesRapidMetricFluctuations) {
     std::this_thread::sleep_for(StateController::kModeSwitchCooldown + 1s);
     
     // Reset testing flag
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 
     // Clear previous expectations
     ::testing::Mock::VerifyAndClearExpectations(cpu_source.get());
@@ -405,7 +407,7 @@ TEST_F(SystemIntegrationTest, HandlesRapidMetricFluctuations) {
 // Test handling of stale metrics with mode switching
 TEST_F(SystemIntegrationTest, HandlesStaleMetrics_WithModeSwitching) {
     // Force direct mode setting to bypass cooldown for the initial setup
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // First, manually set to Balanced mode to ensure we're in a known state
     ModeDecision initial_decision;
@@ -417,7 +419,7 @@ TEST_F(SystemIntegrationTest, HandlesStaleMetrics_WithModeSwitching) {
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Balanced);
     
     // Reset the direct mode setting
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Wait for cooldown
     std::this_thread::sleep_for(StateController::kModeSwitchCooldown + 1s);
@@ -478,7 +480,7 @@ TEST_F(SystemIntegrationTest, HandlesPartialSensorFailures) {
     ::testing::Mock::VerifyAndClearExpectations(notification_service.get());
     
     // Force direct mode setting to bypass cooldown for initial setup
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // First, manually set to Balanced mode to ensure we're in a known state
     ModeDecision initial_decision;
@@ -490,7 +492,7 @@ TEST_F(SystemIntegrationTest, HandlesPartialSensorFailures) {
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Balanced);
     
     // Reset the direct mode setting
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Wait for cooldown
     std::this_thread::sleep_for(StateController::kModeSwitchCooldown + 1s);
@@ -553,12 +555,12 @@ TEST_F(SystemIntegrationTest, HandlesPartialSensorFailures) {
 // Test handling of metric source exceptions
 TEST_F(SystemIntegrationTest, HandlesMetricSourceExceptions) {
     // First set a consistent initial state
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     ModeDecision initial_decision;
     initial_decision.mode = PerformanceMode::Lean;
     initial_decision.reason = "Test initialization";
     state_controller->updateMode(initial_decision);
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Verify starting mode
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Lean);
@@ -635,12 +637,12 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceTimeouts) {
         .WillRepeatedly(Return(true));
     
     // Force initial mode to be different from what we expect
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     ModeDecision initial_decision;
     initial_decision.mode = PerformanceMode::Lean;
     initial_decision.reason = "Test initialization";
     state_controller->updateMode(initial_decision);
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Verify starting mode
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Lean);
@@ -679,7 +681,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceRecoveryAfterMultipleFailures)
     ::testing::Mock::VerifyAndClearExpectations(notification_service.get());
     
     // Enable direct mode setting to bypass cooldown checks
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Initialize with Balanced mode
     ModeDecision initial_decision;
@@ -853,13 +855,13 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceRecoveryAfterMultipleFailures)
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Balanced);
     
     // Restore the default setting
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Test handling of metric source degradation
 TEST_F(SystemIntegrationTest, HandlesMetricSourceDegradation) {
     // Allow direct mode setting to bypass cooldown
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Force mode decisions to bypass normal engine logic
     decision_engine->setForceModeForTesting(PerformanceMode::Balanced, true, "normal");
@@ -924,7 +926,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceDegradation) {
     }
     
     // Reset testing flags
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     decision_engine->setForceModeForTesting(PerformanceMode::Balanced, false);
 }
 
@@ -934,7 +936,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceCalibration) {
     // That creates direct ModeDecision objects and verifies behavior
     
     // First, setup initial state
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     ModeDecision initial_decision;
     initial_decision.mode = PerformanceMode::Balanced;
     initial_decision.reason = "Initialize test";
@@ -999,7 +1001,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceCalibration) {
     EXPECT_EQ(state_controller->getCurrentMode(), PerformanceMode::Balanced);
     
     // Reset direct mode set flag
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Test handling of metric source drift
@@ -1008,7 +1010,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceDrift) {
     double drift_values[] = {45.5, 47.0, 48.5, 50.0, 51.5};
     
     // Force direct mode setting to bypass cooldown for the initial setup
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // First, manually set to Balanced mode to ensure we're in a known state
     ModeDecision initial_decision;
@@ -1017,7 +1019,7 @@ TEST_F(SystemIntegrationTest, HandlesMetricSourceDrift) {
     state_controller->updateMode(initial_decision);
     
     // Reset the direct mode setting
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Wait for cooldown to expire after initial setup
     std::this_thread::sleep_for(StateController::kModeSwitchCooldown + 1s);
@@ -1105,7 +1107,7 @@ TEST_F(SystemIntegrationTest, StateController_CorrectlyAppliesModeSwitch_FromDec
     // Verify notification details
     EXPECT_CALL(*notification_service, notifyModeChange(
         PerformanceMode::HighFidelity,
-        std::string("High performance mode activated due to high CPU usage")
+        std::string(to_string(DecisionReason::LowLoad))
     )).Times(1);
     
     // Verify no error notifications
@@ -1124,7 +1126,8 @@ TEST_F(SystemIntegrationTest, StateController_CorrectlyAppliesModeSwitch_FromDec
     EXPECT_EQ(mode_history.size(), 1);
     const auto& last_entry = mode_history.back();
     EXPECT_EQ(last_entry.mode, PerformanceMode::HighFidelity);
-    EXPECT_TRUE(last_entry.reason.find("High performance mode activated due to high CPU usage") != std::string::npos);
+    EXPECT_EQ(last_entry.code, DecisionReason::LowLoad);
+    EXPECT_EQ(last_entry.reason_text(), to_string(DecisionReason::LowLoad));
     EXPECT_FALSE(last_entry.is_fallback_mode);
     EXPECT_FALSE(last_entry.is_error_state);
 }
@@ -1137,14 +1140,14 @@ TEST_F(SystemIntegrationTest, StateController_EnforcesCooldown_BetweenSwitchesIn
     }
     
     // Reset to a known state first
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     ModeDecision initial_mode_decision;
     initial_mode_decision.mode = PerformanceMode::Balanced;
     initial_mode_decision.reason = "Test initialization";
     initial_mode_decision.is_error_state = false;
     initial_mode_decision.is_fallback_mode = false;
     state_controller->updateMode(initial_mode_decision);
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Record initial state for comparison
     auto initial_history = state_controller->getModeHistory();
@@ -1293,7 +1296,7 @@ TEST_F(SystemIntegrationTest, StateController_PreventsModeOscillation) {
         
         // Enable cooldown for each mode
         state_controller->setBypassCooldownForNextUpdate(false);
-        StateController::setForceCooldownForTesting(true);
+        state_controller->setForceCooldownForTesting(true);
         
         // Verify state controller's mode
         EXPECT_EQ(state_controller->getCurrentMode(), modes[i]);
@@ -1312,11 +1315,11 @@ TEST_F(SystemIntegrationTest, StateController_PreventsModeOscillation) {
     
     // Ensure we are in Lean mode and cooldown is active
     state_controller->setCurrentModeForTesting(PerformanceMode::Lean);
-    StateController::setForceCooldownForTesting(true);
+    state_controller->setForceCooldownForTesting(true);
     EXPECT_TRUE(state_controller->isInCooldown());
     
     // Now disable direct mode setting to test normal cooldown enforcement
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
     
     // Try to oscillate back to HighFidelity
     std::cout << "Debug - Attempting oscillation back to HighFidelity..." << std::endl;
@@ -1333,7 +1336,7 @@ TEST_F(SystemIntegrationTest, StateController_PreventsModeOscillation) {
     // Debug cooldown state before the oscillation attempt
     std::cout << "Debug - Before oscillation test: isInCooldown=" 
               << (state_controller->isInCooldown() ? "true" : "false")
-              << ", ForceCooldown=" << (StateController::getForceCooldownForTesting() ? "true" : "false")
+              << ", ForceCooldown=" << (state_controller->getForceCooldownForTesting() ? "true" : "false")
               << std::endl;
     
     // Attempt to change mode during cooldown
@@ -1365,8 +1368,8 @@ TEST_F(SystemIntegrationTest, StateController_PreventsModeOscillation) {
     EXPECT_GE(transitions.size(), modes.size());
     
     // Cleanup
-    StateController::setDirectModeSetForTesting(false);
-    StateController::setForceCooldownForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
+    state_controller->setForceCooldownForTesting(false);
 }
 
 // Enhanced assertions for handling conflicting rapid decisions
@@ -1380,10 +1383,10 @@ TEST_F(SystemIntegrationTest, StateController_HandlesConflictingRapidDecisions_F
     auto initial_transitions_size = state_controller->getTransitionHistory().size();
     
     // Enable direct mode setting for testing
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Force cooldown state for testing
-    StateController::setForceCooldownForTesting(true);
+    state_controller->setForceCooldownForTesting(true);
     
     // Simulate rapid conflicting decisions
     for (int i = 0; i < 5; ++i) {
@@ -1423,7 +1426,7 @@ TEST_F(SystemIntegrationTest, StateController_HandlesConflictingRapidDecisions_F
             processMetrics();
         } else {
             // Disable direct mode setting after first change
-            StateController::setDirectModeSetForTesting(false);
+            state_controller->setDirectModeSetForTesting(false);
             processMetrics();
         }
         
@@ -1474,8 +1477,8 @@ TEST_F(SystemIntegrationTest, StateController_HandlesConflictingRapidDecisions_F
                                           << attempted_reasons[0] << "' in the transition history";
     
     // Cleanup
-    StateController::setForceCooldownForTesting(false);
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setForceCooldownForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Enhanced assertions for system fallback
@@ -1490,7 +1493,7 @@ TEST_F(SystemIntegrationTest, StateController_InitiatesSystemFallback_WhenDecisi
               << ", Transitions size: " << initial_transitions_size << std::endl;
     
     // Enable direct mode setting to bypass cooldown checks
-    StateController::setDirectModeSetForTesting(true);
+    state_controller->setDirectModeSetForTesting(true);
     
     // Disable the getValue to make this test distinguishable from other similar ones
     EXPECT_CALL(*cpu_source, getValue()).Times(0);
@@ -1583,7 +1586,7 @@ TEST_F(SystemIntegrationTest, StateController_InitiatesSystemFallback_WhenDecisi
     EXPECT_EQ(transitions.back().second, "System fallback mode activated due to critical error");
     
     // Reset direct mode setting
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 // Enhanced assertions for mode switch reason recording
@@ -1620,7 +1623,7 @@ TEST_F(SystemIntegrationTest, StateController_RecordsCorrectReason_ForModeSwitch
         decision.is_error_state = false;
         
         // Force direct mode setting for testing
-        StateController::setDirectModeSetForTesting(true);
+        state_controller->setDirectModeSetForTesting(true);
         
         // Set expectations for notifications
         EXPECT_CALL(*notification_service, notifyModeChange(test_case.mode, _))
@@ -1647,7 +1650,7 @@ TEST_F(SystemIntegrationTest, StateController_RecordsCorrectReason_ForModeSwitch
     EXPECT_GE(final_history.size(), initial_history_size + 1);
     
     // Reset test state
-    StateController::setDirectModeSetForTesting(false);
+    state_controller->setDirectModeSetForTesting(false);
 }
 
 int main(int argc, char **argv) {
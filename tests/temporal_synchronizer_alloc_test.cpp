@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <chronovyan/temporal_synchronizer.hpp>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace chronovyan::sync;
+
+// Counting allocator: replaces the global operator new for this test binary and
+// counts allocations made on the current thread while counting is enabled.
+namespace {
+thread_local bool counting_enabled = false;
+thread_local size_t allocation_count = 0;
+
+class AllocationCounter {
+public:
+    AllocationCounter() {
+        allocation_count = 0;
+        counting_enabled = true;
+    }
+
+    ~AllocationCounter() {
+        counting_enabled = false;
+    }
+
+    size_t count() const { return allocation_count; }
+};
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (counting_enabled) {
+        ++allocation_count;
+    }
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+class TemporalSynchronizerAllocTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        synchronizer = std::make_unique<TemporalSynchronizer>();
+    }
+
+    // Run a few ticks first so any lazily sized buffers reach their steady state
+    void warm_up() {
+        for (int i = 0; i < 16; ++i) {
+            synchronizer->synchronize_temporal_flows();
+        }
+    }
+
+    std::unique_ptr<TemporalSynchronizer> synchronizer;
+};
+
+TEST_F(TemporalSynchronizerAllocTest, SteadyStateTickDoesNotAllocate) {
+    warm_up();
+
+    AllocationCounter counter;
+    for (int i = 0; i < 1000; ++i) {
+        synchronizer->synchronize_temporal_flows();
+    }
+
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST_F(TemporalSynchronizerAllocTest, TickWithCallbacksDoesNotAllocate) {
+    // Captures larger than std::function's small buffer would allocate on every copy
+    std::array<double, 16> padding{};
+    std::atomic<int> sync_calls{0};
+    synchronizer->set_sync_callback([padding, &sync_calls](double) {
+        sync_calls += static_cast<int>(padding.size() > 0);
+    });
+    synchronizer->set_error_callback([padding](const std::exception&) { (void)padding; });
+    synchronizer->set_recovery_callback([padding](bool) { (void)padding; });
+    synchronizer->set_error_handler([padding](const TemporalSynchronizer::ErrorInfo&) { (void)padding; });
+    synchronizer->set_custom_recovery_strategy([padding]() { (void)padding; });
+    warm_up();
+
+    int calls_before = sync_calls.load();
+    AllocationCounter counter;
+    for (int i = 0; i < 1000; ++i) {
+        synchronizer->synchronize_temporal_flows();
+    }
+    size_t allocations = counter.count();
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(sync_calls.load() - calls_before, 1000);
+}
+
+TEST_F(TemporalSynchronizerAllocTest, DurationWindowIsBounded) {
+    for (int i = 0; i < 100; ++i) {
+        synchronizer->synchronize_temporal_flows();
+    }
+
+    auto metrics = synchronizer->get_performance_metrics();
+    EXPECT_EQ(metrics.total_sync_operations, 100u);
+    EXPECT_EQ(metrics.recent_duration_count,
+              TemporalSynchronizer::PerformanceMetrics::kRecentDurationWindow);
+    EXPECT_GT(metrics.average_sync_time, 0.0);
+}
@@ -1337,6 +1337,29 @@ TEST_F(TemporalSynchronizerTest, AdvancedPatternClusteringTest) {
     EXPECT_EQ(total_patterns, test_patterns.size());
 }
 
+TEST_F(TemporalSynchronizerTest, ErrorHandlerReplacedWhileTicking) {
+    // Handlers published while another thread ticks must never be torn:
+    // every tick sees one complete callback table
+    synchronizer->set_sync_threshold(0.99);
+    std::atomic<bool> stop{false};
+    std::atomic<int> calls{0};
+    std::thread ticker([&] {
+        while (!stop.load()) {
+            synchronizer->synchronize_temporal_flows();
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        synchronizer->set_error_handler([&calls](const ErrorInfo&) { ++calls; });
+    }
+    stop.store(true);
+    ticker.join();
+
+    synchronizer->force_error_state();
+    const int before = calls.load();
+    synchronizer->synchronize_temporal_flows();
+    EXPECT_GT(calls.load(), before);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "chronovyan/timeline_journal.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+const Clock::time_point kEpoch = Clock::time_point(std::chrono::hours(24 * 365 * 50));
+
+Clock::time_point at_second(int s) {
+    return kEpoch + std::chrono::seconds(s);
+}
+
+class TimelineJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/chronovyan_journal_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir = pattern;
+    }
+
+    void TearDown() override {
+        std::system(("rm -rf " + dir).c_str());
+    }
+
+    std::vector<JournalEntry> read_all(const TimelineJournal& journal,
+                                       Clock::time_point from = Clock::time_point::min()) {
+        std::vector<JournalEntry> entries;
+        texts.clear();
+        journal.replay([&](const JournalEntry& entry) {
+            entries.push_back(entry);
+            texts.emplace_back(entry.text);
+            return true;
+        }, from);
+        return entries;
+    }
+
+    std::string dir;
+    std::vector<std::string> texts;
+};
+
+} // namespace
+
+TEST_F(TimelineJournalTest, ReplaysRecordsAcrossReopen) {
+    {
+        TimelineJournal journal(dir);
+        EXPECT_EQ(journal.append("main", SyncPoint(at_second(1), 0.9, 0.8, 0.7, 11)), 0u);
+        EXPECT_EQ(journal.append(TimelineEvent(TimelineEventType::Error, at_second(2), "drift detected", 12, 0.5)), 1u);
+        journal.flush();
+        EXPECT_EQ(journal.durable_index(), 2u);
+    }
+
+    TimelineJournal journal(dir);
+    EXPECT_EQ(journal.recovery().records, 2u);
+    EXPECT_FALSE(journal.recovery().torn_tail);
+    EXPECT_EQ(journal.append("aux", SyncPoint(at_second(3))), 2u);
+    journal.flush();
+
+    std::vector<JournalEntry> entries = read_all(journal);
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].kind, JournalRecordKind::SyncPoint);
+    EXPECT_EQ(texts[0], "main");
+    EXPECT_DOUBLE_EQ(entries[0].point.accuracy, 0.9);
+    EXPECT_DOUBLE_EQ(entries[0].point.recall, 0.7);
+    EXPECT_EQ(entries[0].point.sequence_id, 11);
+    EXPECT_EQ(entries[0].timestamp, at_second(1));
+    EXPECT_EQ(entries[1].kind, JournalRecordKind::Event);
+    EXPECT_EQ(texts[1], "drift detected");
+    EXPECT_EQ(entries[1].event_type, TimelineEventType::Error);
+    EXPECT_EQ(entries[1].sequence_id, 12);
+    EXPECT_DOUBLE_EQ(entries[1].importance, 0.5);
+    EXPECT_EQ(entries[2].index, 2u);
+
+    TimelineManager manager;
+    EXPECT_EQ(journal.restore(manager), 3u);
+    EXPECT_EQ(manager.get_timeline("main").get_current_sync_point().sequence_id, 11);
+    EXPECT_EQ(manager.get_recent_events(10).at(0).description, "drift detected");
+}
+
+TEST_F(TimelineJournalTest, SeeksByTimestampAcrossSealedSegments) {
+    TimelineJournalOptions options;
+    options.segment_bytes = 4096;
+    options.index_stride = 8;
+    const int kRecords = 2000;
+    {
+        TimelineJournal journal(dir, options);
+        for (int i = 0; i < kRecords; ++i) {
+            // Mostly increasing, with every tenth record stamped far in the past
+            Clock::time_point ts = i % 10 == 9 ? at_second(i - 500) : at_second(i);
+            journal.append("t", SyncPoint(ts, 0.0, 0.0, 0.0, i));
+        }
+        journal.flush();
+        EXPECT_GT(journal.segment_count(), 10u);
+    }
+
+    TimelineJournal journal(dir, options);
+    EXPECT_EQ(journal.recovery().records, static_cast<uint64_t>(kRecords));
+    EXPECT_EQ(journal.recovery().scanned_segments, 1u);  // only the active one
+
+    std::vector<JournalEntry> entries = read_all(journal, at_second(1500));
+    std::vector<int> expected;
+    for (int i = 0; i < kRecords; ++i) {
+        int second = i % 10 == 9 ? i - 500 : i;
+        if (second >= 1500) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_EQ(entries.size(), expected.size());
+    for (size_t k = 0; k < entries.size(); ++k) {
+        EXPECT_EQ(entries[k].point.sequence_id, expected[k]);
+    }
+}
+
+TEST_F(TimelineJournalTest, DropsTornTailAndResumes) {
+    TimelineJournalOptions options;
+    options.segment_bytes = 16 * 1024;
+    std::string segment;
+    {
+        TimelineJournal journal(dir, options);
+        for (int i = 0; i < 10; ++i) {
+            journal.append(TimelineEvent(TimelineEventType::Pattern, at_second(i), "pattern", i));
+        }
+        journal.flush();
+        segment = dir + "/0000000000000000.cvtl";
+    }
+
+    // Corrupt the last byte of the last record, as a torn write would
+    std::vector<char> bytes;
+    {
+        std::ifstream in(segment, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    size_t last = bytes.size();
+    while (last > 0 && bytes[last - 1] == 0) {
+        --last;
+    }
+    ASSERT_GT(last, 0u);
+    bytes[last - 1] ^= 0x5a;
+    {
+        std::ofstream out(segment, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    TimelineJournal journal(dir, options);
+    EXPECT_TRUE(journal.recovery().torn_tail);
+    EXPECT_EQ(journal.recovery().records, 9u);
+    EXPECT_EQ(journal.append(TimelineEvent(TimelineEventType::Recovery, at_second(20), "recovered", 99)), 9u);
+    journal.flush();
+
+    std::vector<JournalEntry> entries = read_all(journal);
+    ASSERT_EQ(entries.size(), 10u);
+    EXPECT_EQ(texts.back(), "recovered");
+
+    TimelineJournal reopened(dir, options);
+    EXPECT_FALSE(reopened.recovery().torn_tail);
+    EXPECT_EQ(reopened.recovery().records, 10u);
+}
+
+TEST_F(TimelineJournalTest, ConcurrentAppendersShareCommits) {
+    TimelineJournalOptions options;
+    options.segment_bytes = 64 * 1024;
+    TimelineJournal journal(dir, options);
+
+    const int kThreads = 4;
+    const int kPerThread = 300;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&journal, t] {
+            for (int k = 0; k < kPerThread; ++k) {
+                uint64_t index = journal.append("thread " + std::to_string(t),
+                                                SyncPoint(Clock::now(), 0.0, 0.0, 0.0, k));
+                journal.wait_durable(index);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(journal.durable_index(), static_cast<uint64_t>(kThreads * kPerThread));
+
+    std::vector<int> last(kThreads, -1);
+    uint64_t expected_index = 0;
+    journal.replay([&](const JournalEntry& entry) {
+        EXPECT_EQ(entry.index, expected_index++);
+        int t = std::stoi(std::string(entry.text.substr(7)));
+        EXPECT_GT(entry.sequence_id, last[t]);
+        last[t] = entry.sequence_id;
+        return true;
+    });
+    EXPECT_EQ(expected_index, static_cast<uint64_t>(kThreads * kPerThread));
+}
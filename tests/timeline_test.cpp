@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "chronovyan/timeline.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chronovyan::sync;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+// Producer p writes sequence ids p * kPerProducer + k, k ascending
+constexpr int kProducers = 8;
+constexpr int kPerProducer = 2000;
+
+} // namespace
+
+TEST(TimelineTest, ConcurrentProducersKeepEveryPointInProducerOrder) {
+    TimelineRetention retention;
+    retention.max_count = kProducers * kPerProducer;
+    Timeline timeline(retention);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&timeline, p] {
+            for (int k = 0; k < kPerProducer; ++k) {
+                timeline.add_sync_point(SyncPoint(Clock::now(), 0.5, 0.5, 0.5, p * kPerProducer + k));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    std::vector<SyncPoint> points = timeline.get_recent_sync_points(retention.max_count);
+    ASSERT_EQ(points.size(), retention.max_count);
+    EXPECT_EQ(timeline.size(), retention.max_count);
+
+    std::vector<int> last(kProducers, -1);
+    for (const auto& point : points) {
+        int producer = point.sequence_id / kPerProducer;
+        int k = point.sequence_id % kPerProducer;
+        ASSERT_GT(k, last[producer]) << "producer " << producer << " out of order";
+        last[producer] = k;
+    }
+    for (int p = 0; p < kProducers; ++p) {
+        EXPECT_EQ(last[p], kPerProducer - 1);
+    }
+}
+
+TEST(TimelineTest, RetainsByCountBytesAndAge) {
+    TimelineRetention by_count;
+    by_count.max_count = 10;
+    Timeline counted(by_count);
+    for (int i = 0; i < 25; ++i) {
+        counted.add_sync_point(SyncPoint(Clock::now(), 0.0, 0.0, 0.0, i));
+    }
+    std::vector<SyncPoint> points = counted.get_recent_sync_points(100);
+    ASSERT_EQ(points.size(), 10u);
+    EXPECT_EQ(points.front().sequence_id, 15);
+    EXPECT_EQ(counted.get_current_sync_point().sequence_id, 24);
+
+    TimelineRetention by_bytes;
+    by_bytes.max_bytes = 1000;
+    Timeline bounded(by_bytes);
+    for (int i = 0; i < 1000; ++i) {
+        bounded.add_sync_point(SyncPoint(Clock::now(), 0.0, 0.0, 0.0, i));
+    }
+    EXPECT_LT(bounded.size(), 1000u);
+    EXPECT_EQ(bounded.get_current_sync_point().sequence_id, 999);
+
+    TimelineRetention by_age;
+    by_age.max_age = std::chrono::milliseconds(1000);
+    Timeline aged(by_age);
+    const auto now = Clock::now();
+    for (int i = 0; i < 5; ++i) {
+        aged.add_sync_point(SyncPoint(now - std::chrono::seconds(10), 0.0, 0.0, 0.0, i));
+    }
+    EXPECT_TRUE(aged.get_recent_sync_points(10).empty());
+    aged.add_sync_point(SyncPoint(now, 0.0, 0.0, 0.0, 5));
+    EXPECT_EQ(aged.size(), 1u);
+    EXPECT_EQ(aged.get_current_sync_point().sequence_id, 5);
+
+    aged.clear();
+    EXPECT_TRUE(aged.empty());
+    EXPECT_EQ(aged.get_current_sync_point().sequence_id, 0);
+}
+
+TEST(TimelineTest, ReadersRaceWritersWithoutTornRecords) {
+    TimelineRetention retention;
+    retention.max_count = 64;
+    Timeline timeline(retention);
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> torn{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            for (const auto& point : timeline.get_recent_sync_points(32)) {
+                // Every writer stores its id in all three metrics
+                if (point.accuracy != point.sequence_id || point.recall != point.sequence_id) {
+                    torn.fetch_add(1);
+                }
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int p = 0; p < 4; ++p) {
+        writers.emplace_back([&timeline, p] {
+            for (int k = 0; k < 20000; ++k) {
+                double id = p * 20000 + k;
+                timeline.add_sync_point(SyncPoint(Clock::now(), id, id, id, static_cast<int>(id)));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(timeline.size(), 64u);
+}
+
+TEST(TimelineManagerTest, InternsDescriptionsAndReportsOverflow) {
+    TimelineManager manager({}, {}, 4);
+    const auto now = Clock::now();
+    for (int i = 0; i < 10; ++i) {
+        manager.add_event(TimelineEvent(TimelineEventType::Pattern, now, "pattern " + std::to_string(i % 3), i));
+    }
+    EXPECT_EQ(manager.description_count(), 3u);
+
+    manager.add_event(TimelineEvent(TimelineEventType::Error, now, "fourth", 10));
+    manager.add_event(TimelineEvent(TimelineEventType::Error, now, "fifth", 11));
+    manager.add_event(TimelineEvent(TimelineEventType::Recovery, now, "pattern 1", 12, 0.25));
+    EXPECT_EQ(manager.description_count(), 4u);
+
+    std::vector<TimelineEvent> events = manager.get_recent_events(3);
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].description, "fourth");
+    EXPECT_EQ(events[1].description, TimelineManager::kDescriptionOverflow);
+    EXPECT_EQ(events[2].description, "pattern 1");
+    EXPECT_EQ(events[2].type, TimelineEventType::Recovery);
+    EXPECT_EQ(events[2].sequence_id, 12);
+    EXPECT_DOUBLE_EQ(events[2].importance, 0.25);
+}
+
+TEST(TimelineManagerTest, ConcurrentEventsShareInternedDescriptions) {
+    TimelineRetention retention;
+    retention.max_count = kProducers * kPerProducer;
+    TimelineManager manager({}, retention);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&manager, p] {
+            for (int k = 0; k < kPerProducer; ++k) {
+                manager.add_event(TimelineEvent(TimelineEventType::SyncPoint, Clock::now(),
+                                                "phase " + std::to_string(k % 16), p * kPerProducer + k));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(manager.description_count(), 16u);
+    std::vector<TimelineEvent> events = manager.get_recent_events(retention.max_count);
+    ASSERT_EQ(events.size(), retention.max_count);
+    for (const auto& event : events) {
+        EXPECT_EQ(event.description, "phase " + std::to_string(event.sequence_id % kPerProducer % 16));
+    }
+
+    Timeline& timeline = manager.get_timeline("main");
+    timeline.add_sync_point(SyncPoint(Clock::now(), 1.0));
+    EXPECT_TRUE(manager.has_timeline("main"));
+    EXPECT_EQ(&manager.get_timeline("main"), &timeline);
+    manager.remove_timeline("main");
+    EXPECT_FALSE(manager.has_timeline("main"));
+}